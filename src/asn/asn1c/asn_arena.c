@@ -0,0 +1,297 @@
+/*
+ * Arena (bump) allocation for the ASN.1 support code.
+ */
+#include "asn_arena.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define	ASN_ARENA_ALIGNMENT	16
+#define	ASN_ARENA_CHUNK_SIZE	(16 * 1024)	/* Usable bytes of a regular chunk */
+#define	ASN_ARENA_LARGE_SIZE	(ASN_ARENA_CHUNK_SIZE / 4)	/* Larger allocations get their own chunk */
+#define	ASN_ARENA_KEPT_CHUNKS	4	/* Regular chunks kept by a reset */
+
+#define	ASN_ARENA_ALIGN_UP(n)	\
+	(((n) + (ASN_ARENA_ALIGNMENT - 1)) & ~((size_t)ASN_ARENA_ALIGNMENT - 1))
+
+typedef struct asn_arena_chunk_s {
+	struct asn_arena_chunk_s *next;
+	size_t size;	/* Usable bytes */
+	size_t used;
+} asn_arena_chunk_t;
+
+#define	ASN_ARENA_CHUNK_HEADER	ASN_ARENA_ALIGN_UP(sizeof(asn_arena_chunk_t))
+#define	ASN_ARENA_CHUNK_DATA(c)	((char *)(c) + ASN_ARENA_CHUNK_HEADER)
+
+struct asn_arena_s {
+	asn_arena_chunk_t *chunks;	/* Chunks in use, the first one is bumped */
+	asn_arena_chunk_t *spare;	/* Regular chunks kept for reuse */
+	char *last;	/* Last allocation in the first chunk */
+	size_t used;
+	asn_arena_t *prev;	/* Registry of the live arenas */
+	asn_arena_t *next;
+};
+
+/*
+ * The live arenas are registered so that a pointer can be checked for being
+ * owned by an arena. The registry and the chunk lists are only modified under
+ * the lock. An arena is only used by one thread at a time, and the pointers of
+ * the current arena are checked without locking.
+ */
+static pthread_mutex_t asn_arena_lock = PTHREAD_MUTEX_INITIALIZER;
+static asn_arena_t *asn_arena_registry;
+static int asn_arena_live_count;
+
+static _Thread_local asn_arena_t *asn_arena_current_arena;
+
+static asn_arena_chunk_t *
+asn_arena_find_chunk(const asn_arena_t *arena, const void *ptr) {
+	asn_arena_chunk_t *c;
+	for(c = arena->chunks; c; c = c->next) {
+		const char *data = ASN_ARENA_CHUNK_DATA(c);
+		if((const char *)ptr >= data && (const char *)ptr < data + c->size)
+			return c;
+	}
+	return NULL;
+}
+
+static asn_arena_t *
+asn_arena_find_owner(const void *ptr, asn_arena_chunk_t **chunk) {
+	asn_arena_t *current = asn_arena_current_arena;
+	asn_arena_t *arena;
+	asn_arena_chunk_t *c;
+
+	if(!ptr || __atomic_load_n(&asn_arena_live_count, __ATOMIC_ACQUIRE) == 0)
+		return NULL;
+
+	if(current && (c = asn_arena_find_chunk(current, ptr))) {
+		*chunk = c;
+		return current;
+	}
+
+	pthread_mutex_lock(&asn_arena_lock);
+	for(arena = asn_arena_registry; arena; arena = arena->next) {
+		if(arena != current && (c = asn_arena_find_chunk(arena, ptr))) {
+			*chunk = c;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&asn_arena_lock);
+
+	return arena;
+}
+
+static void *
+asn_arena_alloc(asn_arena_t *arena, size_t size) {
+	asn_arena_chunk_t *c = arena->chunks;
+	char *ptr;
+
+	size = ASN_ARENA_ALIGN_UP(size ? size : 1);
+	if(size < ASN_ARENA_ALIGNMENT)
+		return NULL;	/* Overflow */
+
+	if(!c || c->size - c->used < size) {
+		if(size > ASN_ARENA_LARGE_SIZE) {
+			/* Dedicated chunk, placed behind the one being bumped */
+			c = malloc(ASN_ARENA_CHUNK_HEADER + size);
+			if(!c) return NULL;
+			c->size = size;
+			c->used = size;
+
+			pthread_mutex_lock(&asn_arena_lock);
+			if(arena->chunks) {
+				c->next = arena->chunks->next;
+				arena->chunks->next = c;
+			} else {
+				c->next = NULL;
+				arena->chunks = c;
+			}
+			pthread_mutex_unlock(&asn_arena_lock);
+
+			arena->used += size;
+			return ASN_ARENA_CHUNK_DATA(c);
+		}
+
+		if(arena->spare) {
+			c = arena->spare;
+			arena->spare = c->next;
+		} else {
+			c = malloc(ASN_ARENA_CHUNK_HEADER + ASN_ARENA_CHUNK_SIZE);
+			if(!c) return NULL;
+			c->size = ASN_ARENA_CHUNK_SIZE;
+		}
+		c->used = 0;
+
+		pthread_mutex_lock(&asn_arena_lock);
+		c->next = arena->chunks;
+		arena->chunks = c;
+		pthread_mutex_unlock(&asn_arena_lock);
+	}
+
+	ptr = ASN_ARENA_CHUNK_DATA(c) + c->used;
+	c->used += size;
+	arena->used += size;
+	arena->last = ptr;
+	return ptr;
+}
+
+asn_arena_t *
+asn_arena_new(void) {
+	asn_arena_t *arena = calloc(1, sizeof(*arena));
+	if(!arena) return NULL;
+
+	pthread_mutex_lock(&asn_arena_lock);
+	arena->next = asn_arena_registry;
+	if(asn_arena_registry) asn_arena_registry->prev = arena;
+	asn_arena_registry = arena;
+	__atomic_add_fetch(&asn_arena_live_count, 1, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&asn_arena_lock);
+
+	return arena;
+}
+
+void
+asn_arena_delete(asn_arena_t *arena) {
+	asn_arena_chunk_t *c, *next;
+
+	if(!arena) return;
+
+	pthread_mutex_lock(&asn_arena_lock);
+	if(arena->prev) arena->prev->next = arena->next;
+	else asn_arena_registry = arena->next;
+	if(arena->next) arena->next->prev = arena->prev;
+	__atomic_sub_fetch(&asn_arena_live_count, 1, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&asn_arena_lock);
+
+	if(asn_arena_current_arena == arena)
+		asn_arena_current_arena = NULL;
+
+	for(c = arena->chunks; c; c = next) {
+		next = c->next;
+		free(c);
+	}
+	for(c = arena->spare; c; c = next) {
+		next = c->next;
+		free(c);
+	}
+	free(arena);
+}
+
+void
+asn_arena_reset(asn_arena_t *arena) {
+	asn_arena_chunk_t *c, *next;
+	int kept = 0;
+
+	if(!arena) return;
+
+	for(c = arena->spare; c; c = c->next)
+		kept++;
+
+	pthread_mutex_lock(&asn_arena_lock);
+	c = arena->chunks;
+	arena->chunks = NULL;
+	pthread_mutex_unlock(&asn_arena_lock);
+
+	for(; c; c = next) {
+		next = c->next;
+		if(c->size == ASN_ARENA_CHUNK_SIZE && kept < ASN_ARENA_KEPT_CHUNKS) {
+			c->next = arena->spare;
+			arena->spare = c;
+			kept++;
+		} else {
+			free(c);
+		}
+	}
+
+	arena->last = NULL;
+	arena->used = 0;
+}
+
+size_t
+asn_arena_used(const asn_arena_t *arena) {
+	return arena ? arena->used : 0;
+}
+
+asn_arena_t *
+asn_arena_swap_current(asn_arena_t *arena) {
+	asn_arena_t *previous = asn_arena_current_arena;
+	asn_arena_current_arena = arena;
+	return previous;
+}
+
+asn_arena_t *
+asn_arena_current(void) {
+	return asn_arena_current_arena;
+}
+
+asn_arena_t *
+asn_arena_of(const void *ptr) {
+	asn_arena_chunk_t *chunk;
+	return asn_arena_find_owner(ptr, &chunk);
+}
+
+void *
+asn_mem_calloc(size_t nmemb, size_t size) {
+	asn_arena_t *arena = asn_arena_current_arena;
+	void *ptr;
+
+	if(!arena)
+		return calloc(nmemb, size);
+
+	if(size && nmemb > SIZE_MAX / size)
+		return NULL;
+
+	ptr = asn_arena_alloc(arena, nmemb * size);
+	if(ptr) memset(ptr, 0, nmemb * size);
+	return ptr;
+}
+
+void *
+asn_mem_malloc(size_t size) {
+	asn_arena_t *arena = asn_arena_current_arena;
+	return arena ? asn_arena_alloc(arena, size) : malloc(size);
+}
+
+void *
+asn_mem_realloc(void *ptr, size_t size) {
+	asn_arena_chunk_t *c;
+	asn_arena_t *owner;
+	size_t available;
+	void *nptr;
+
+	if(!ptr)
+		return asn_mem_malloc(size);
+
+	/* Heap memory stays on the heap, so that a tree is not mixed up */
+	owner = asn_arena_find_owner(ptr, &c);
+	if(!owner)
+		return realloc(ptr, size);
+
+	/* The last allocation of the arena grows in place */
+	if(ptr == owner->last && c == owner->chunks) {
+		size_t end = (size_t)((char *)ptr - ASN_ARENA_CHUNK_DATA(c)) + ASN_ARENA_ALIGN_UP(size ? size : 1);
+		if(end <= c->size) {
+			owner->used = owner->used - c->used + end;
+			c->used = end;
+			return ptr;
+		}
+	}
+
+	/*
+	 * The old size is not recorded. Copying up to the end of the allocated
+	 * part of the chunk is enough, and never leaves the chunk.
+	 */
+	available = (size_t)(ASN_ARENA_CHUNK_DATA(c) + c->used - (char *)ptr);
+	nptr = asn_arena_alloc(owner, size);
+	if(nptr) memcpy(nptr, ptr, available < size ? available : size);
+	return nptr;
+}
+
+void
+asn_mem_free(void *ptr) {
+	if(!ptr || asn_arena_of(ptr))
+		return;
+	free(ptr);
+}
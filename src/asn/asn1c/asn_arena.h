@@ -0,0 +1,64 @@
+/*
+ * Arena (bump) allocation for the ASN.1 support code.
+ *
+ * All the memory management of the runtime goes through asn_mem_*() functions.
+ * If an arena is current in the calling thread, memory is bump-allocated from
+ * the arena; otherwise the ordinary malloc path is used. Freeing a pointer that
+ * is owned by an arena is a no-op, the arena is released at once instead.
+ */
+#ifndef	ASN_ARENA_H
+#define	ASN_ARENA_H
+
+#include <stddef.h>
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+typedef struct asn_arena_s asn_arena_t;
+
+/*
+ * Creates an empty arena, memory is acquired on the first allocation.
+ */
+asn_arena_t *asn_arena_new(void);
+
+/*
+ * Releases all the memory of the arena, including the arena itself.
+ */
+void asn_arena_delete(asn_arena_t *arena);
+
+/*
+ * Releases all the allocations of the arena at once. A few chunks are kept
+ * for reuse, so that an arena used for one PDU at a time does not call malloc
+ * in the steady state.
+ */
+void asn_arena_reset(asn_arena_t *arena);
+
+/*
+ * Number of bytes allocated from the arena since the last reset.
+ */
+size_t asn_arena_used(const asn_arena_t *arena);
+
+/*
+ * Sets the current arena of the calling thread (NULL for the malloc path), and
+ * returns the previous one.
+ */
+asn_arena_t *asn_arena_swap_current(asn_arena_t *arena);
+asn_arena_t *asn_arena_current(void);
+
+/*
+ * Returns the arena owning the given pointer, or NULL if the pointer is not
+ * allocated from a live arena.
+ */
+asn_arena_t *asn_arena_of(const void *ptr);
+
+void *asn_mem_calloc(size_t nmemb, size_t size);
+void *asn_mem_malloc(size_t size);
+void *asn_mem_realloc(void *ptr, size_t size);
+void asn_mem_free(void *ptr);
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif	/* ASN_ARENA_H */
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <optional>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -15,6 +16,7 @@
 #include <vector>
 
 #include <lib/app/cli_base.hpp>
+#include <lib/app/node_selector.hpp>
 #include <lib/app/proc_table.hpp>
 #include <utils/common.hpp>
 #include <utils/constants.hpp>
@@ -27,6 +29,7 @@ static struct Options
     bool dumpNodes{};
     std::string nodeName{};
     std::string directCmd{};
+    bool stream{};
 } g_options{};
 
 static std::set<int> FindProcesses()
@@ -46,10 +49,18 @@ static std::set<int> FindProcesses()
     return res;
 }
 
-static uint16_t DiscoverNode(const std::string &node, int &skippedDueToVersion)
+/* Returns the command ports of the processes having the node, or any node matching if a node selector is given */
+static std::set<uint16_t> DiscoverNodes(const std::string &node, int &skippedDueToVersion)
 {
+    std::set<uint16_t> found{};
+    skippedDueToVersion = 0;
+
     if (!io::Exists(cons::PROC_TABLE_DIR))
-        return 0;
+        return found;
+
+    std::optional<app::NodeSelector> selector{};
+    if (app::IsNodeSelector(node))
+        selector = app::NodeSelector{node};
 
     // Find all processes in the environment
     auto processes = FindProcesses();
@@ -64,9 +75,6 @@ static uint16_t DiscoverNode(const std::string &node, int &skippedDueToVersion)
         entries[file] = app::ProcTableEntry::Decode(content);
     }
 
-    uint16_t found = 0;
-    skippedDueToVersion = 0;
-
     for (auto &e : entries)
     {
         // If no such process, it means that this ProcTable file is outdated
@@ -80,12 +88,13 @@ static uint16_t DiscoverNode(const std::string &node, int &skippedDueToVersion)
         // If searching node exists in this file, extract port number from it.
         for (auto &n : e.second.nodes)
         {
-            if (n == node)
+            if (selector ? selector->matches(n) : n == node)
             {
                 if (e.second.major == cons::Major && e.second.minor == cons::Minor && e.second.patch == cons::Patch)
-                    found = e.second.port;
+                    found.insert(e.second.port);
                 else
                     skippedDueToVersion++;
+                break;
             }
         }
     }
@@ -134,19 +143,25 @@ static std::vector<std::string> DumpNames()
 static void ReadOptions(int argc, char **argv)
 {
     opt::OptionsDescription desc{"UERANSIM",  cons::Tag, "Command Line Interface",
-                                 cons::Owner, "nr-cli",  {"<node-name> [option...]", "--dump"},
+                                 cons::Owner, "nr-cli",  {"<node-name|node-selector> [option...]", "--dump"},
                                  {},          true,      false};
 
     opt::OptionItem itemDump = {'d', "dump", "List all UE and gNBs in the environment", std::nullopt};
     opt::OptionItem itemExec = {'e', "exec", "Execute the given command directly without an interactive shell",
                                 "command"};
+    opt::OptionItem itemStream = {'s', "stream",
+                                  "Print the result of each node as it arrives instead of a summary, if a node "
+                                  "selector such as 'imsi-00101000000[0000-9999]' or 'imsi-*' is given",
+                                  std::nullopt};
 
     desc.items.push_back(itemDump);
     desc.items.push_back(itemExec);
+    desc.items.push_back(itemStream);
 
     opt::OptionsResult opt{argc, argv, desc, false, nullptr};
 
     g_options.dumpNodes = opt.hasFlag(itemDump);
+    g_options.stream = opt.hasFlag(itemStream);
 
     if (!g_options.dumpNodes)
     {
@@ -172,6 +187,18 @@ static void ReadOptions(int argc, char **argv)
             opt.showError("Node name is too long");
             return;
         }
+        if (app::IsNodeSelector(g_options.nodeName))
+        {
+            try
+            {
+                app::NodeSelector{g_options.nodeName};
+            }
+            catch (const std::runtime_error &e)
+            {
+                opt.showError(e.what());
+                return;
+            }
+        }
 
         g_options.directCmd = opt.getOption(itemExec);
         if (opt.hasFlag(itemExec) && g_options.directCmd.size() < 3)
@@ -182,39 +209,57 @@ static void ReadOptions(int argc, char **argv)
     }
 }
 
-static bool HandleMessage(const app::CliMessage &msg, bool isOneShot)
+/* Prints the message, and returns true if it is the final response of the command */
+static bool HandleMessage(const app::CliMessage &msg, bool &hasError)
 {
     if (msg.type == app::CliMessage::Type::ERROR)
     {
         std::cerr << "ERROR: " << msg.value << std::endl;
-        if (isOneShot)
-            exit(1);
+        hasError = true;
         return true;
     }
 
     if (msg.type == app::CliMessage::Type::ECHO)
     {
         std::cout << msg.value << std::endl;
-        return true;
+        return false;
     }
 
     if (msg.type == app::CliMessage::Type::RESULT)
     {
         std::cout << msg.value << std::endl;
-        if (isOneShot)
-            exit(0);
         return true;
     }
 
     return false;
 }
 
-[[noreturn]] static void SendCommand(uint16_t port)
+/* Sends the command to all the processes, and waits for their responses. Returns false if any of them failed. */
+static bool ExecuteCommand(app::CliServer &server, const std::set<uint16_t> &ports, const std::string &command)
+{
+    for (uint16_t port : ports)
+    {
+        server.sendMessage(app::CliMessage::Command(InetAddress{cons::CMD_SERVER_IP, port}, command,
+                                                    g_options.nodeName, g_options.stream));
+    }
+
+    bool hasError = false;
+    size_t pending = ports.size();
+    while (pending > 0)
+    {
+        if (HandleMessage(server.receiveMessage(), hasError))
+            pending--;
+    }
+    return !hasError;
+}
+
+[[noreturn]] static void SendCommand(const std::set<uint16_t> &ports)
 {
     app::CliServer server{};
 
     if (g_options.directCmd.empty())
     {
+        // The nodes are discovered once for the whole session
         while (true)
         {
             std::cout << "\x1b[1m";
@@ -233,22 +278,12 @@ static bool HandleMessage(const app::CliMessage &msg, bool isOneShot)
             if (line.empty())
                 continue;
 
-            server.sendMessage(
-                app::CliMessage::Command(InetAddress{cons::CMD_SERVER_IP, port}, line, g_options.nodeName));
-
-            while (!HandleMessage(server.receiveMessage(), false))
-            {
-                // empty
-            }
+            ExecuteCommand(server, ports, line);
         }
     }
     else
     {
-        server.sendMessage(
-            app::CliMessage::Command(InetAddress{cons::CMD_SERVER_IP, port}, g_options.directCmd, g_options.nodeName));
-
-        while (true)
-            HandleMessage(server.receiveMessage(), true);
+        exit(ExecuteCommand(server, ports, g_options.directCmd) ? 0 : 1);
     }
 }
 
@@ -283,19 +318,19 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    uint16_t cmdPort{};
+    std::set<uint16_t> cmdPorts{};
     int skippedDueToVersion{};
 
     try
     {
-        cmdPort = DiscoverNode(g_options.nodeName, skippedDueToVersion);
+        cmdPorts = DiscoverNodes(g_options.nodeName, skippedDueToVersion);
     }
     catch (const std::runtime_error &e)
     {
         throw std::runtime_error("Node discovery failure: " + std::string{e.what()});
     }
 
-    if (cmdPort == 0)
+    if (cmdPorts.empty())
     {
         std::cerr << "ERROR: No node found with name: " << g_options.nodeName << std::endl;
         if (skippedDueToVersion > 0)
@@ -304,6 +339,6 @@ int main(int argc, char **argv)
         return 1;
     }
 
-    SendCommand(cmdPort);
+    SendCommand(cmdPorts);
     return 0;
 }
\ No newline at end of file
@@ -10,15 +10,21 @@
 #include <stdexcept>
 #include <unordered_map>
 
+#include <arpa/inet.h>
 #include <unistd.h>
 
 #include <gnb/gnb.hpp>
+#include <gnb/gtp/server.hpp>
+#include <gnb/sctp/task.hpp>
 #include <lib/app/base_app.hpp>
 #include <lib/app/cli_base.hpp>
 #include <lib/app/cli_cmd.hpp>
+#include <lib/app/node_selector.hpp>
 #include <lib/app/proc_table.hpp>
+#include <utils/common.hpp>
 #include <utils/constants.hpp>
 #include <utils/io.hpp>
+#include <utils/libc_error.hpp>
 #include <utils/options.hpp>
 #include <utils/yaml_utils.hpp>
 #include <yaml-cpp/yaml.h>
@@ -27,13 +33,27 @@ static app::CliServer *g_cliServer = nullptr;
 static nr::gnb::GnbConfig *g_refConfig = nullptr;
 static std::unordered_map<std::string, nr::gnb::GNodeB *> g_gnbMap{};
 static app::CliResponseTask *g_cliRespTask = nullptr;
+static nr::gnb::GnbSharedBase *g_shared = nullptr;
 
 static struct Options
 {
     std::string configFile{};
     bool disableCmd{};
+    int count{};
+    std::optional<std::string> logLevel{};
+    bool asyncLog{};
+    std::optional<std::string> binaryLog{};
+    std::optional<uint16_t> metricsPort{};
+    std::optional<std::string> metricsCsv{};
 } g_options{};
 
+static std::string GetGnbName(const nr::gnb::GnbConfig &config)
+{
+    // NOTE: Avoid using "/" dir separator character.
+    return "UERANSIM-gnb-" + std::to_string(config.plmn.mcc) + "-" + std::to_string(config.plmn.mnc) + "-" +
+           std::to_string(config.getGnbId());
+}
+
 static nr::gnb::GnbConfig *ReadConfigYaml()
 {
     auto *result = new nr::gnb::GnbConfig();
@@ -56,9 +76,43 @@ static nr::gnb::GnbConfig *ReadConfigYaml()
         result->gtpAdvertiseIp = yaml::GetIp4(config, "gtpAdvertiseIp");
 
     result->ignoreStreamIds = yaml::GetBool(config, "ignoreStreamIds");
+    if (yaml::HasField(config, "checkAsnConstraints"))
+        result->checkAsnConstraints = yaml::GetBool(config, "checkAsnConstraints");
+
+    if (yaml::HasField(config, "rls"))
+    {
+        auto rls = config["rls"];
+        if (yaml::HasField(rls, "rto"))
+            result->rlsArq.rto = yaml::GetInt32(rls, "rto", 10, 60000);
+        if (yaml::HasField(rls, "maxRetransmission"))
+            result->rlsArq.maxRetransmission = yaml::GetInt32(rls, "maxRetransmission", 0, 32);
+    }
+
+    if (yaml::HasField(config, "propagation"))
+    {
+        auto propagation = config["propagation"];
+        std::string model = yaml::GetString(propagation, "model");
+        if (model == "linear")
+            result->propagation.model = rls::EPropagationModel::LINEAR;
+        else if (model == "free-space")
+            result->propagation.model = rls::EPropagationModel::FREE_SPACE;
+        else if (model == "log-distance")
+            result->propagation.model = rls::EPropagationModel::LOG_DISTANCE;
+        else
+            throw std::runtime_error("Invalid propagation model: " + model);
+
+        if (yaml::HasField(propagation, "txPower"))
+            result->propagation.txPower = yaml::GetInt32(propagation, "txPower", -50, 80);
+        if (yaml::HasField(propagation, "frequency"))
+            result->propagation.frequency = yaml::GetInt32(propagation, "frequency", 1, 100000);
+        if (yaml::HasField(propagation, "exponent"))
+            result->propagation.exponent = propagation["exponent"].as<double>();
+        if (yaml::HasField(propagation, "minDbm"))
+            result->propagation.minDbm = yaml::GetInt32(propagation, "minDbm", -200, 0);
+    }
     result->pagingDrx = EPagingDrx::V128;
-    result->name = "UERANSIM-gnb-" + std::to_string(result->plmn.mcc) + "-" + std::to_string(result->plmn.mnc) + "-" +
-                   std::to_string(result->getGnbId()); // NOTE: Avoid using "/" dir separator character.
+    result->name = GetGnbName(*result);
+    result->prefixLogger = g_options.count > 1;
 
     for (auto &amfConfig : yaml::GetSequence(config, "amfConfigs"))
     {
@@ -93,21 +147,78 @@ static void ReadOptions(int argc, char **argv)
                                  false};
 
     opt::OptionItem itemConfigFile = {'c', "config", "Use specified configuration file for gNB", "config-file"};
+    opt::OptionItem itemCount = {'n', "num-of-gNB",
+                                 "Generate specified number of gNBs with incremented gNB ID and link IP address",
+                                 "num"};
     opt::OptionItem itemDisableCmd = {'l', "disable-cmd", "Disable command line functionality for this instance",
                                       std::nullopt};
+    opt::OptionItem itemLogLevel = {std::nullopt, "log-level",
+                                    "Discard logs below the given level (debug, info, warn, error)", "level"};
+    opt::OptionItem itemAsyncLog = {std::nullopt, "async-log", "Format and write the logs in a background thread",
+                                    std::nullopt};
+    opt::OptionItem itemBinaryLog = {std::nullopt, "binary-log",
+                                     "Write the logs unformatted to the given file instead of the console, decoded by "
+                                     "nr-logdec",
+                                     "file"};
+    opt::OptionItem itemMetricsPort = {std::nullopt, "metrics-port",
+                                       "Serve the metrics in Prometheus format on the given port of 127.0.0.1",
+                                       "port"};
+    opt::OptionItem itemMetricsCsv = {std::nullopt, "metrics-csv",
+                                      "Write the metrics to the given CSV file every second", "file"};
 
     desc.items.push_back(itemConfigFile);
+    desc.items.push_back(itemCount);
     desc.items.push_back(itemDisableCmd);
+    desc.items.push_back(itemLogLevel);
+    desc.items.push_back(itemAsyncLog);
+    desc.items.push_back(itemBinaryLog);
+    desc.items.push_back(itemMetricsPort);
+    desc.items.push_back(itemMetricsCsv);
 
     opt::OptionsResult opt{argc, argv, desc, false, nullptr};
 
     if (opt.hasFlag(itemDisableCmd))
         g_options.disableCmd = true;
     g_options.configFile = opt.getOption(itemConfigFile);
+    if (opt.hasFlag(itemLogLevel))
+        g_options.logLevel = opt.getOption(itemLogLevel);
+    g_options.asyncLog = opt.hasFlag(itemAsyncLog);
+    if (opt.hasFlag(itemBinaryLog))
+        g_options.binaryLog = opt.getOption(itemBinaryLog);
 
     try
     {
+        if (opt.hasFlag(itemCount))
+        {
+            g_options.count = utils::ParseInt(opt.getOption(itemCount));
+            if (g_options.count <= 0)
+                throw std::runtime_error("Invalid number of gNBs");
+            if (g_options.count > nr::gnb::SharedGtpServer::MAX_NODES)
+                throw std::runtime_error("Number of gNBs is too big");
+        }
+        else
+        {
+            g_options.count = 1;
+        }
+
+        app::ConfigureLogging(g_options.logLevel, g_options.asyncLog, g_options.binaryLog);
+
+        if (opt.hasFlag(itemMetricsPort))
+        {
+            int port = utils::ParseInt(opt.getOption(itemMetricsPort));
+            if (port <= 0 || port > 65535)
+                throw std::runtime_error("Invalid metrics port");
+            g_options.metricsPort = static_cast<uint16_t>(port);
+        }
+        if (opt.hasFlag(itemMetricsCsv))
+            g_options.metricsCsv = opt.getOption(itemMetricsCsv);
+        app::StartMetrics(g_options.metricsPort, g_options.metricsCsv);
+
         g_refConfig = ReadConfigYaml();
+
+        int64_t maxGnbId = (1LL << g_refConfig->gnbIdLength) - 1;
+        if (static_cast<int64_t>(g_refConfig->getGnbId()) + g_options.count - 1 > maxGnbId)
+            throw std::runtime_error("gNB ID overflow, use a smaller gNB ID or number of gNBs");
     }
     catch (const std::runtime_error &e)
     {
@@ -116,6 +227,81 @@ static void ReadOptions(int argc, char **argv)
     }
 }
 
+static std::string IncrementIp4(const std::string &address, int delta)
+{
+    in_addr addr{};
+    if (inet_pton(AF_INET, address.c_str(), &addr) != 1)
+        throw std::runtime_error("IPv4 address is required in multi-gNB mode: " + address);
+
+    uint32_t value = ntohl(addr.s_addr);
+    if (value + static_cast<uint32_t>(delta) < value)
+        throw std::runtime_error("IPv4 address overflow: " + address);
+    addr.s_addr = htonl(value + static_cast<uint32_t>(delta));
+
+    char buffer[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &addr, buffer, sizeof(buffer));
+    return buffer;
+}
+
+static nr::gnb::GnbConfig *GetConfigByGnb(int gnbIndex)
+{
+    auto *c = new nr::gnb::GnbConfig(*g_refConfig);
+
+    // gNB ID is incremented, the cell ID is kept
+    c->nci = g_refConfig->nci + (static_cast<int64_t>(gnbIndex) << (36 - g_refConfig->gnbIdLength));
+    c->portalIp = IncrementIp4(g_refConfig->portalIp, gnbIndex);
+    c->teidBase = nr::gnb::SharedGtpServer::TeidBase(gnbIndex);
+    c->name = GetGnbName(*c);
+
+    return c;
+}
+
+static void CreateSharedBase()
+{
+    g_shared = new nr::gnb::GnbSharedBase();
+    g_shared->logBase = new LogBase("logs/ueransim-gnb.log");
+    g_shared->sctpTask = new nr::gnb::SctpTask(g_shared->logBase);
+
+    try
+    {
+        g_shared->gtpServer = new nr::gnb::SharedGtpServer(g_refConfig->gtpIp);
+    }
+    catch (const LibError &e)
+    {
+        std::cerr << "ERROR: GTP/UDP socket could not be created. " << e.what() << std::endl;
+        exit(1);
+    }
+}
+
+static void DispatchBulkCommand(const app::CliMessage &msg, const app::GnbCliCommand &cmd)
+{
+    std::vector<nr::gnb::GNodeB *> targets{};
+    try
+    {
+        app::NodeSelector selector{msg.nodeName};
+        for (auto &gnb : g_gnbMap)
+            if (selector.matches(gnb.first))
+                targets.push_back(gnb.second);
+    }
+    catch (const std::runtime_error &e)
+    {
+        g_cliServer->sendMessage(app::CliMessage::Error(msg.clientAddr, e.what()));
+        return;
+    }
+
+    if (targets.empty())
+    {
+        g_cliServer->sendMessage(app::CliMessage::Error(msg.clientAddr, "No node matches: " + msg.nodeName));
+        return;
+    }
+
+    // The responses are collected by the response task, and the gNBs execute the command in parallel in their own tasks
+    g_cliRespTask->push(new app::NwCliBulkStart(msg.clientAddr, static_cast<int>(targets.size()),
+                                                msg.type == app::CliMessage::Type::STREAM_COMMAND));
+    for (auto *gnb : targets)
+        gnb->pushCommand(std::make_unique<app::GnbCliCommand>(cmd), msg.clientAddr);
+}
+
 static void ReceiveCommand(app::CliMessage &msg)
 {
     if (msg.value.empty())
@@ -157,6 +343,12 @@ static void ReceiveCommand(app::CliMessage &msg)
         return;
     }
 
+    if (app::IsNodeSelector(msg.nodeName))
+    {
+        DispatchBulkCommand(msg, *cmd);
+        return;
+    }
+
     if (g_gnbMap.count(msg.nodeName) == 0)
     {
         g_cliServer->sendMessage(app::CliMessage::Error(msg.clientAddr, "Node not found: " + msg.nodeName));
@@ -182,7 +374,7 @@ static void Loop()
         return;
     }
 
-    if (msg.type != app::CliMessage::Type::COMMAND)
+    if (msg.type != app::CliMessage::Type::COMMAND && msg.type != app::CliMessage::Type::STREAM_COMMAND)
         return;
 
     if (msg.value.size() > 0xFFFF)
@@ -213,8 +405,33 @@ int main(int argc, char **argv)
         g_cliRespTask = new app::CliResponseTask(g_cliServer);
     }
 
-    auto *gnb = new nr::gnb::GNodeB(g_refConfig, nullptr, g_cliRespTask);
-    g_gnbMap[g_refConfig->name] = gnb;
+    if (g_options.count == 1)
+    {
+        auto *gnb = new nr::gnb::GNodeB(g_refConfig, nullptr, g_cliRespTask);
+        g_gnbMap[g_refConfig->name] = gnb;
+    }
+    else
+    {
+        // Simulated gNBs share the SCTP task, the GTP-U socket and the logs
+        CreateSharedBase();
+
+        for (int i = 0; i < g_options.count; i++)
+        {
+            nr::gnb::GnbConfig *config;
+            try
+            {
+                config = GetConfigByGnb(i);
+            }
+            catch (const std::runtime_error &e)
+            {
+                std::cerr << "ERROR: " << e.what() << std::endl;
+                exit(1);
+            }
+
+            auto *gnb = new nr::gnb::GNodeB(config, nullptr, g_cliRespTask, g_shared);
+            g_gnbMap[config->name] = gnb;
+        }
+    }
 
     if (!g_options.disableCmd)
     {
@@ -222,7 +439,14 @@ int main(int argc, char **argv)
         g_cliRespTask->start();
     }
 
-    gnb->start();
+    if (g_shared)
+    {
+        g_shared->sctpTask->start();
+        g_shared->gtpServer->start();
+    }
+
+    for (auto &gnb : g_gnbMap)
+        gnb.second->start();
 
     while (true)
         Loop();
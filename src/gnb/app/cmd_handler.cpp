@@ -15,6 +15,7 @@
 #include <gnb/rrc/task.hpp>
 #include <gnb/sctp/task.hpp>
 #include <utils/common.hpp>
+#include <utils/metrics.hpp>
 #include <utils/printer.hpp>
 //Pradnya
 #include <iostream>
@@ -27,12 +28,12 @@ namespace nr::gnb
 
 void GnbCmdHandler::sendResult(const InetAddress &address, const std::string &output)
 {
-    m_base->cliCallbackTask->push(new app::NwCliSendResponse(address, output, false));
+    m_base->cliCallbackTask->push(new app::NwCliSendResponse(address, output, false, m_base->config->name));
 }
 
 void GnbCmdHandler::sendError(const InetAddress &address, const std::string &output)
 {
-    m_base->cliCallbackTask->push(new app::NwCliSendResponse(address, output, true));
+    m_base->cliCallbackTask->push(new app::NwCliSendResponse(address, output, true, m_base->config->name));
 }
 
 void GnbCmdHandler::pauseTasks()
@@ -124,7 +125,9 @@ void GnbCmdHandler::handleCmdImpl(NmGnbCliCommand &msg)
         else
         {
             auto amf = m_base->ngapTask->m_amfCtx[msg.cmd->amfId];
-            sendResult(msg.address, ToJson(*amf).dumpYaml());
+            Json json = ToJson(*amf);
+            json.put("streams", m_base->sctpTask->getStreamStatus(amf->ctxId));
+            sendResult(msg.address, json.dumpYaml());
         }
         break;
     }
@@ -198,6 +201,12 @@ void GnbCmdHandler::handleCmdImpl(NmGnbCliCommand &msg)
         sendResult(msg.address, "handover successful");
         break;
     }     
+    case app::GnbCliCommand::METRICS: {
+        std::string output = metrics::Registry::Instance().renderSummary();
+        utils::Trim(output);
+        sendResult(msg.address, output);
+        break;
+    }
     }
 }
 
@@ -16,7 +16,7 @@ namespace nr::gnb
 
 GnbAppTask::GnbAppTask(TaskBase *base) : m_base{base}, m_statusInfo{}
 {
-    m_logger = m_base->logBase->makeUniqueLogger("app");
+    m_logger = m_base->logBase->makeUniqueLogger(m_base->config->getLoggerPrefix() + "app");
 }
 
 void GnbAppTask::onStart()
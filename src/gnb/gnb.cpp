@@ -8,6 +8,7 @@
 
 #include "gnb.hpp"
 #include "app/task.hpp"
+#include "gtp/server.hpp"
 #include "gtp/task.hpp"
 #include "ngap/task.hpp"
 #include "rls/task.hpp"
@@ -19,41 +20,51 @@
 namespace nr::gnb
 {
 
-GNodeB::GNodeB(GnbConfig *config, app::INodeListener *nodeListener, NtsTask *cliCallbackTask)
+GNodeB::GNodeB(GnbConfig *config, app::INodeListener *nodeListener, NtsTask *cliCallbackTask,
+               GnbSharedBase *shared)
 {
     auto *base = new TaskBase();
     base->config = config;
-    base->logBase = new LogBase("logs/" + config->name + ".log");
+    base->logBase = shared ? shared->logBase : new LogBase("logs/" + config->name + ".log");
     base->nodeListener = nodeListener;
     base->cliCallbackTask = cliCallbackTask;
+    base->shared = shared;
 
     base->appTask = new GnbAppTask(base);
-    base->sctpTask = new SctpTask(base);
+    base->sctpTask = shared ? shared->sctpTask : new SctpTask(base->logBase);
     base->ngapTask = new NgapTask(base);
     base->rrcTask = new GnbRrcTask(base);
     base->gtpTask = new GtpTask(base);
     base->rlsTask = new GnbRlsTask(base);
 
+    if (shared && shared->gtpServer)
+        shared->gtpServer->addNode(config->teidBase, base->gtpTask);
+
     taskBase = base;
 }
 
 GNodeB::~GNodeB()
 {
+    bool isShared = taskBase->shared != nullptr;
+
     taskBase->appTask->quit();
-    taskBase->sctpTask->quit();
+    if (!isShared)
+        taskBase->sctpTask->quit();
     taskBase->ngapTask->quit();
     taskBase->rrcTask->quit();
     taskBase->gtpTask->quit();
     taskBase->rlsTask->quit();
 
     delete taskBase->appTask;
-    delete taskBase->sctpTask;
+    if (!isShared)
+        delete taskBase->sctpTask;
     delete taskBase->ngapTask;
     delete taskBase->rrcTask;
     delete taskBase->gtpTask;
     delete taskBase->rlsTask;
 
-    delete taskBase->logBase;
+    if (!isShared)
+        delete taskBase->logBase;
 
     delete taskBase;
 }
@@ -61,7 +72,8 @@ GNodeB::~GNodeB()
 void GNodeB::start()
 {
     taskBase->appTask->start();
-    taskBase->sctpTask->start();
+    if (taskBase->shared == nullptr)
+        taskBase->sctpTask->start();
     taskBase->ngapTask->start();
     taskBase->rrcTask->start();
     taskBase->rlsTask->start();
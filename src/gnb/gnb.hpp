@@ -25,7 +25,9 @@ class GNodeB
     TaskBase *taskBase;
 
   public:
-    GNodeB(GnbConfig *config, app::INodeListener *nodeListener, NtsTask *cliCallbackTask);
+    /* If shared resources are given, the gNB uses them instead of creating its own SCTP task, GTP-U socket and logs */
+    GNodeB(GnbConfig *config, app::INodeListener *nodeListener, NtsTask *cliCallbackTask,
+           GnbSharedBase *shared = nullptr);
     virtual ~GNodeB();
 
   public:
@@ -61,6 +61,9 @@ bool EncodeGtpMessage(const GtpMessage &gtp, OctetString &stream)
 {
     int initialLength = stream.length();
 
+    // Fixed and optional headers, and the PDU session container fit in 64 octets
+    stream.reserve(initialLength + 64 + gtp.payload.length());
+
     bool pn = gtp.nPduNum.has_value();
     bool s = gtp.seq.has_value();
     bool e = !gtp.extHeaders.empty();
@@ -281,7 +284,7 @@ std::unique_ptr<PduSessionInformation> PduSessionInformation::Decode(const Octet
         if ((read - 2) % 4 != 0)
         {
             size_t padding = 4 - ((read - 2) % 4);
-            stream.readOctetString(padding);
+            stream.skip(static_cast<int>(padding));
         }
 
         return res;
@@ -319,7 +322,7 @@ std::unique_ptr<PduSessionInformation> PduSessionInformation::Decode(const Octet
         if ((read - 2) % 4 != 0)
         {
             size_t padding = 4 - ((read - 2) % 4);
-            stream.readOctetString(padding);
+            stream.skip(static_cast<int>(padding));
         }
 
         return res;
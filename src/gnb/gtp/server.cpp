@@ -0,0 +1,45 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "server.hpp"
+
+#include <stdexcept>
+
+#include <utils/constants.hpp>
+
+namespace nr::gnb
+{
+
+SharedGtpServer::SharedGtpServer(const std::string &address)
+    : udp::UdpServerTask(address, cons::GtpPort, nullptr), m_nodes(MAX_NODES)
+{
+}
+
+uint32_t SharedGtpServer::TeidBase(int nodeIndex)
+{
+    if (nodeIndex < 0 || nodeIndex >= MAX_NODES)
+        throw std::runtime_error("Invalid GTP-U node index");
+    return static_cast<uint32_t>(nodeIndex) << TEID_INDEX_SHIFT;
+}
+
+void SharedGtpServer::addNode(uint32_t teidBase, NtsTask *gtpTask)
+{
+    m_nodes[teidBase >> TEID_INDEX_SHIFT] = gtpTask;
+}
+
+void SharedGtpServer::onReceive(OctetString &&packet, const InetAddress &fromAddress)
+{
+    // TEID is at octets 4..7 of the mandatory GTPv1-U header. Malformed packets are dropped by the GTP task.
+    uint32_t teid = packet.length() >= 8 ? packet.get4UI(4) : 0;
+
+    NtsTask *target = m_nodes[teid >> TEID_INDEX_SHIFT];
+    if (target != nullptr)
+        target->push(new udp::NwUdpServerReceive(std::move(packet), fromAddress));
+}
+
+} // namespace nr::gnb
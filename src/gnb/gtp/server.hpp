@@ -0,0 +1,49 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <lib/udp/server_task.hpp>
+#include <utils/nts.hpp>
+
+namespace nr::gnb
+{
+
+/**
+ * GTP-U socket shared by the gNBs simulated in the same process (nr-gnb -n). The downlink TEID space is partitioned
+ * among the gNBs by the upper bits, and each received packet is pushed to the GTP task of the gNB owning its TEID.
+ * <p>
+ * All the nodes must be added before the task is started.
+ */
+class SharedGtpServer : public udp::UdpServerTask
+{
+  public:
+    static constexpr const int MAX_NODES = 512;
+    static constexpr const int TEID_INDEX_SHIFT = 23;
+
+  private:
+    std::vector<NtsTask *> m_nodes;
+
+  public:
+    explicit SharedGtpServer(const std::string &address);
+    ~SharedGtpServer() override = default;
+
+  protected:
+    void onReceive(OctetString &&packet, const InetAddress &fromAddress) override;
+
+  public:
+    static uint32_t TeidBase(int nodeIndex);
+
+    void addNode(uint32_t teidBase, NtsTask *gtpTask);
+};
+
+} // namespace nr::gnb
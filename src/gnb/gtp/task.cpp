@@ -9,28 +9,53 @@
 #include "task.hpp"
 
 #include <gnb/gtp/proto.hpp>
+#include <gnb/gtp/server.hpp>
 #include <gnb/rls/task.hpp>
 #include <utils/constants.hpp>
 #include <utils/libc_error.hpp>
+#include <utils/metrics.hpp>
 
 #include <asn/ngap/ASN_NGAP_QosFlowSetupRequestItem.h>
 
+static auto &g_ulPackets = metrics::Registry::Instance().counter("gtp_packets_total", "GTP-U data packets",
+                                                                  "direction=\"uplink\"");
+static auto &g_dlPackets = metrics::Registry::Instance().counter("gtp_packets_total", "GTP-U data packets",
+                                                                  "direction=\"downlink\"");
+static auto &g_ulBytes = metrics::Registry::Instance().counter("gtp_bytes_total", "GTP-U user plane payload bytes",
+                                                                "direction=\"uplink\"");
+static auto &g_dlBytes = metrics::Registry::Instance().counter("gtp_bytes_total", "GTP-U user plane payload bytes",
+                                                                "direction=\"downlink\"");
+static auto &g_ulDrops = metrics::Registry::Instance().counter(
+    "gtp_packets_dropped_total", "GTP-U data packets dropped by the rate limiter", "direction=\"uplink\"");
+static auto &g_dlDrops = metrics::Registry::Instance().counter(
+    "gtp_packets_dropped_total", "GTP-U data packets dropped by the rate limiter", "direction=\"downlink\"");
+static auto &g_packetSize = metrics::Registry::Instance().histogram(
+    "gtp_packet_size_bytes", "Size of the GTP-U user plane payloads", {64, 128, 256, 512, 1024, 1500});
+
 namespace nr::gnb
 {
 
 GtpTask::GtpTask(TaskBase *base)
-    : m_base{base}, m_udpServer{}, m_ueContexts{},
+    : m_base{base}, m_udpServer{}, m_ownsUdpServer{}, m_ueContexts{},
       m_rateLimiter(std::make_unique<RateLimiter>()), m_pduSessions{}, m_sessionTree{}
 {
-    m_logger = m_base->logBase->makeUniqueLogger("gtp");
+    m_logger = m_base->logBase->makeUniqueLogger(m_base->config->getLoggerPrefix() + "gtp");
 }
 
 void GtpTask::onStart()
 {
+    // In multi-gNB mode the socket is shared, and downlink packets are dispatched to this task by the TEID
+    if (m_base->shared && m_base->shared->gtpServer)
+    {
+        m_udpServer = m_base->shared->gtpServer;
+        return;
+    }
+
     try
     {
         m_udpServer = new udp::UdpServerTask(m_base->config->gtpIp, cons::GtpPort, this);
         m_udpServer->start();
+        m_ownsUdpServer = true;
     }
     catch (const LibError &e)
     {
@@ -40,8 +65,11 @@ void GtpTask::onStart()
 
 void GtpTask::onQuit()
 {
-    m_udpServer->quit();
-    delete m_udpServer;
+    if (m_ownsUdpServer)
+    {
+        m_udpServer->quit();
+        delete m_udpServer;
+    }
 
     m_ueContexts.clear();
 }
@@ -195,8 +223,16 @@ void GtpTask::handleUplinkData(int ueId, int psi, OctetString &&pdu)
 
     auto &pduSession = m_pduSessions[sessionInd];
 
-    if (m_rateLimiter->allowUplinkPacket(sessionInd, static_cast<int64_t>(pdu.length())))
+    if (!m_rateLimiter->allowUplinkPacket(sessionInd, static_cast<int64_t>(pdu.length())))
     {
+        g_ulDrops.inc();
+    }
+    else
+    {
+        g_ulPackets.inc();
+        g_ulBytes.inc(pdu.length());
+        g_packetSize.observe(pdu.length());
+
         gtp::GtpMessage gtp{};
         gtp.payload = std::move(pdu);
         gtp.msgType = gtp::GtpMessage::MT_G_PDU;
@@ -238,8 +274,16 @@ void GtpTask::handleUdpReceive(const udp::NwUdpServerReceive &msg)
         return;
     }
 
-    if (m_rateLimiter->allowDownlinkPacket(sessionInd, gtp->payload.length()))
+    if (!m_rateLimiter->allowDownlinkPacket(sessionInd, gtp->payload.length()))
     {
+        g_dlDrops.inc();
+    }
+    else
+    {
+        g_dlPackets.inc();
+        g_dlBytes.inc(gtp->payload.length());
+        g_packetSize.observe(gtp->payload.length());
+
         auto *w = new NmGnbGtpToRls(NmGnbGtpToRls::DATA_PDU_DELIVERY);
         w->ueId = GetUeId(sessionInd);
         w->psi = GetPsi(sessionInd);
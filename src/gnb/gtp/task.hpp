@@ -30,6 +30,7 @@ class GtpTask : public NtsTask
     std::unique_ptr<Logger> m_logger;
 
     udp::UdpServerTask *m_udpServer;
+    bool m_ownsUdpServer;
     std::unordered_map<int, std::unique_ptr<GtpUeContext>> m_ueContexts;
     std::unique_ptr<IRateLimiter> m_rateLimiter;
     std::unordered_map<uint64_t, std::unique_ptr<PduSessionResource>> m_pduSessions;
@@ -101,7 +101,7 @@ void NgapTask::receiveContextModification(int amfId, ASN_NGAP_UEContextModificat
     if (ie)
     {
         int64_t old = ue->amfUeNgapId;
-        ue->amfUeNgapId = asn::GetSigned64(ie->AMF_UE_NGAP_ID_1);
+        updateUeAmfId(ue, asn::GetSigned64(ie->AMF_UE_NGAP_ID_1));
         m_logger->debug("AMF-UE-NGAP-ID changed from %ld to %ld", old, ue->amfUeNgapId);
     }
 
@@ -24,7 +24,7 @@ inline std::string EncodeXer(const asn_TYPE_descriptor_t &desc, T *pdu)
         return {};
 
     std::string s{reinterpret_cast<char *>(res.buffer), reinterpret_cast<char *>(res.buffer) + res.result.encoded};
-    free(res.buffer);
+    asn_mem_free(res.buffer);
     return s;
 }
 
@@ -39,7 +39,7 @@ inline bool Encode(const asn_TYPE_descriptor_t &desc, T *pdu, ssize_t &encoded,
     encoded = res.result.encoded;
     buffer = new uint8_t[encoded];
     std::memcpy(buffer, res.buffer, encoded);
-    free(res.buffer);
+    asn_mem_free(res.buffer);
 
     return true;
 }
@@ -53,7 +53,7 @@ inline OctetString EncodeS(const asn_TYPE_descriptor_t &desc, T *pdu)
     {
         std::vector<uint8_t> v(encoded);
         memcpy(v.data(), buffer, encoded);
-        free(buffer);
+        delete[] buffer;
         return OctetString{std::move(v)};
     }
     return OctetString{};
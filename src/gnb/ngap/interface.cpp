@@ -343,12 +343,8 @@ void NgapTask::handleXnHandover(int asAmfId, int64_t amfUeNgapId, int64_t ranUeN
 
     /* Encode and send the PDU */
 
-    char errorBuffer[1024];
-    size_t len;
-
-    if (asn_check_constraints(&asn_DEF_ASN_NGAP_NGAP_PDU, pdu, errorBuffer, &len) != 0)
+    if (!checkPduConstraints(pdu))
     {
-        m_logger->err("NGAP PDU ASN constraint validation failed");
         asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
         return;
     }
@@ -359,21 +355,10 @@ void NgapTask::handleXnHandover(int asAmfId, int64_t amfUeNgapId, int64_t ranUeN
         m_logger->err("NGAP APER encoding failed");
     else
     {
-        auto *msg = new NmGnbSctp(NmGnbSctp::SEND_MESSAGE);
-        msg->clientId = ctxtId;
-        msg->stream = ue->uplinkStream;
-        msg->buffer = UniqueBuffer{buffer, static_cast<size_t>(encoded)};
-        m_base->sctpTask->push(msg);
+        m_base->sctpTask->sendMessage(ctxtId, ue->uplinkStream, UniqueBuffer{buffer, static_cast<size_t>(encoded)});
 
         if (m_base->nodeListener)
-        {
-            std::string xer = ngap_encode::EncodeXer(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
-            if (xer.length() > 0)
-            {
-                m_base->nodeListener->onSend(app::NodeType::GNB, m_base->config->name, app::NodeType::AMF, amf_name,
-                                             app::ConnectionType::NGAP, xer);
-            }
-        }
+            notifyNodeListener(true, amf_name, *pdu);
     }
 
     asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
@@ -483,7 +468,11 @@ void NgapTask::receiveOverloadStop(int amfId, ASN_NGAP_OverloadStop *msg)
 {
     m_logger->debug("AMF overload stop received");
 
-    // TODO
+    auto *amf = findAmfContext(amfId);
+    if (amf == nullptr)
+        return;
+
+    amf->overloadInfo = {};
 }
 
 } // namespace nr::gnb
\ No newline at end of file
@@ -10,6 +10,11 @@
 
 #include <utils/common.hpp>
 
+static inline size_t RanIdSlot(long ranUeNgapId, size_t tableSize)
+{
+    return static_cast<size_t>(ranUeNgapId) & (tableSize - 1);
+}
+
 namespace nr::gnb
 {
 
@@ -41,12 +46,17 @@ void NgapTask::createUeContext(int ueId)
 
     m_ueCtx[ctx->ctxId] = ctx;
 
-    // Perform AMF selection
-    auto *amf = selectAmf(ueId);
-    if (amf == nullptr)
-        m_logger->err("AMF selection for UE[%d] failed. Could not find a suitable AMF.", ueId);
-    else
-        ctx->associatedAmfId = amf->ctxId;
+    // RAN-UE-NGAP-IDs are allocated sequentially, so a slot is only occupied if the table is smaller than the range
+    // of the IDs in use. In that case the table is grown until there is no collision.
+    while (m_ueByRanId[RanIdSlot(ctx->ranUeNgapId, m_ueByRanId.size())] != nullptr)
+    {
+        std::vector<NgapUeContext *> table(m_ueByRanId.size() * 2);
+        for (auto *ue : m_ueByRanId)
+            if (ue != nullptr)
+                table[RanIdSlot(ue->ranUeNgapId, table.size())] = ue;
+        m_ueByRanId = std::move(table);
+    }
+    m_ueByRanId[RanIdSlot(ctx->ranUeNgapId, m_ueByRanId.size())] = ctx;
 }
 
 NgapUeContext *NgapTask::findUeContext(int ctxId)
@@ -63,22 +73,63 @@ NgapUeContext *NgapTask::findUeByRanId(long ranUeNgapId)
 {
     if (ranUeNgapId <= 0)
         return nullptr;
-    // TODO: optimize
-    for (auto &ue : m_ueCtx)
-        if (ue.second->ranUeNgapId == ranUeNgapId)
-            return ue.second;
-    return nullptr;
+    auto *ue = m_ueByRanId[RanIdSlot(ranUeNgapId, m_ueByRanId.size())];
+    if (ue == nullptr || ue->ranUeNgapId != ranUeNgapId)
+        return nullptr;
+    return ue;
 }
 
-NgapUeContext *NgapTask::findUeByAmfId(long amfUeNgapId)
+NgapUeContext *NgapTask::findUeByAmfId(int amfCtxId, int64_t amfUeNgapId)
 {
     if (amfUeNgapId <= 0)
         return nullptr;
-    // TODO: optimize
-    for (auto &ue : m_ueCtx)
-        if (ue.second->amfUeNgapId == amfUeNgapId)
-            return ue.second;
-    return nullptr;
+    auto amf = m_ueByAmfId.find(amfCtxId);
+    if (amf == m_ueByAmfId.end())
+        return nullptr;
+    auto ue = amf->second.find(amfUeNgapId);
+    if (ue == amf->second.end())
+        return nullptr;
+    return ue->second;
+}
+
+void NgapTask::updateUeAmfId(NgapUeContext *ue, int64_t amfUeNgapId)
+{
+    if (ue->amfUeNgapId > 0)
+    {
+        auto amf = m_ueByAmfId.find(ue->associatedAmfId);
+        if (amf != m_ueByAmfId.end())
+        {
+            auto it = amf->second.find(ue->amfUeNgapId);
+            if (it != amf->second.end() && it->second == ue)
+                amf->second.erase(it);
+        }
+    }
+
+    ue->amfUeNgapId = amfUeNgapId;
+    if (amfUeNgapId > 0)
+        m_ueByAmfId[ue->associatedAmfId][amfUeNgapId] = ue;
+}
+
+void NgapTask::associateUeWithAmf(NgapUeContext *ue, NgapAmfContext *amf)
+{
+    // The AMF-UE-NGAP-ID is only meaningful for the previous AMF
+    updateUeAmfId(ue, -1);
+
+    auto previous = m_amfCtx.find(ue->associatedAmfId);
+    if (previous != m_amfCtx.end() && previous->second->activeUes > 0)
+        previous->second->activeUes--;
+
+    ue->associatedAmfId = amf ? amf->ctxId : 0;
+    if (amf)
+    {
+        amf->activeUes++;
+        amf->selections++;
+    }
+
+    // UE-associated signalling is spread over the outbound streams by RAN-UE-NGAP-ID, so that a slow procedure of a
+    // UE does not block the others. Stream 0 is reserved for non-UE-associated signalling.
+    int outStreams = amf ? amf->association.outStreams : 0;
+    ue->uplinkStream = outStreams > 1 ? 1 + static_cast<int>(ue->ranUeNgapId % (outStreams - 1)) : 0;
 }
 
 NgapUeContext *NgapTask::findUeByNgapIdPair(int amfCtxId, const NgapIdPair &idPair)
@@ -106,7 +157,7 @@ NgapUeContext *NgapTask::findUeByNgapIdPair(int amfCtxId, const NgapIdPair &idPa
 
     if (!ranId.has_value())
     {
-        auto ue = findUeByAmfId(amfId.value());
+        auto ue = findUeByAmfId(amfCtxId, amfId.value());
         if (ue == nullptr)
         {
             sendErrorIndication(amfCtxId, NgapCause::RadioNetwork_inconsistent_remote_UE_NGAP_ID);
@@ -124,7 +175,7 @@ NgapUeContext *NgapTask::findUeByNgapIdPair(int amfCtxId, const NgapIdPair &idPa
     }
 
     if (ue->amfUeNgapId == -1)
-        ue->amfUeNgapId = amfId.value();
+        updateUeAmfId(ue, amfId.value());
     else if (ue->amfUeNgapId != amfId.value())
     {
         sendErrorIndication(amfCtxId, NgapCause::RadioNetwork_inconsistent_remote_UE_NGAP_ID);
@@ -139,9 +190,15 @@ void NgapTask::deleteUeContext(int ueId)
     auto *ue = m_ueCtx[ueId];
     if (ue)
     {
+        associateUeWithAmf(ue, nullptr);
+
+        auto &slot = m_ueByRanId[RanIdSlot(ue->ranUeNgapId, m_ueByRanId.size())];
+        if (slot == ue)
+            slot = nullptr;
+
         delete ue;
-        m_ueCtx.erase(ueId);
     }
+    m_ueCtx.erase(ueId);
 }
 
 void NgapTask::deleteAmfContext(int amfId)
@@ -151,6 +208,7 @@ void NgapTask::deleteAmfContext(int amfId)
     {
         delete amf;
         m_amfCtx.erase(amfId);
+        m_ueByAmfId.erase(amfId);
     }
 }
 
@@ -24,7 +24,8 @@
 namespace nr::gnb
 {
 
-void NgapTask::handleInitialNasTransport(int ueId, const OctetString &nasPdu, long rrcEstablishmentCause)
+void NgapTask::handleInitialNasTransport(int ueId, const OctetString &nasPdu, long rrcEstablishmentCause,
+                                         const std::optional<Guami> &registeredAmf, const NetworkSlice &requestedNssai)
 {
     m_logger->debug("Initial NAS message received from UE[%d]", ueId);
 
@@ -39,9 +40,16 @@ void NgapTask::handleInitialNasTransport(int ueId, const OctetString &nasPdu, lo
     auto *ueCtx = findUeContext(ueId);
     if (ueCtx == nullptr)
         return;
-    auto *amfCtx = findAmfContext(ueCtx->associatedAmfId);
+
+    ueCtx->establishmentCause = rrcEstablishmentCause;
+
+    auto *amfCtx = selectAmf(ueId, rrcEstablishmentCause, registeredAmf, requestedNssai);
     if (amfCtx == nullptr)
+    {
+        m_logger->err("AMF selection for UE[%d] failed. Could not find a suitable AMF.", ueId);
         return;
+    }
+    associateUeWithAmf(ueCtx, amfCtx);
 
     if (amfCtx->state != EAmfState::CONNECTED)
     {
@@ -49,11 +57,6 @@ void NgapTask::handleInitialNasTransport(int ueId, const OctetString &nasPdu, lo
         return;
     }
 
-    amfCtx->nextStream = (amfCtx->nextStream + 1) % amfCtx->association.outStreams;
-    if ((amfCtx->nextStream == 0) && (amfCtx->association.outStreams > 1))
-        amfCtx->nextStream += 1;
-    ueCtx->uplinkStream = amfCtx->nextStream;
-
     auto *ieEstablishmentCause = asn::New<ASN_NGAP_InitialUEMessage_IEs>();
     ieEstablishmentCause->id = ASN_NGAP_ProtocolIE_ID_id_RRCEstablishmentCause;
     ieEstablishmentCause->criticality = ASN_NGAP_Criticality_ignore;
@@ -179,9 +182,13 @@ void NgapTask::receiveRerouteNasRequest(int amfId, ASN_NGAP_RerouteNASRequest *m
     if (newAmf == nullptr)
     {
         m_logger->err("AMF selection for re-allocation failed. Could not find a suitable AMF.");
+        asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, ngapPdu);
         return;
     }
 
+    if (newAmf->ctxId != ue->associatedAmfId)
+        associateUeWithAmf(ue, newAmf);
+
     sendNgapUeAssociated(ue->ctxId, ngapPdu);
 }
 
@@ -8,21 +8,187 @@
 
 #include "task.hpp"
 
+#include <asn/rrc/ASN_RRC_EstablishmentCause.h>
+
 namespace nr::gnb
 {
 
-NgapAmfContext *NgapTask::selectAmf(int ueId)
+static bool SupportsPlmnAndSlice(const NgapAmfContext &amf, const Plmn &plmn, const NetworkSlice &nssai)
+{
+    for (auto *plmnSupport : amf.plmnSupportList)
+    {
+        if (!(plmnSupport->plmn == plmn))
+            continue;
+        if (nssai.slices.empty())
+            return true;
+        for (auto &slice : nssai.slices)
+            for (auto &supported : plmnSupport->sliceSupportList.slices)
+                if (slice == supported)
+                    return true;
+    }
+    return false;
+}
+
+static bool ServesAmfSet(const NgapAmfContext &amf, const Plmn &plmn, int amfRegionId, int amfSetId)
+{
+    for (auto *served : amf.servedGuamiList)
+        if (served->guami.plmn == plmn && served->guami.amfRegionId == amfRegionId &&
+            served->guami.amfSetId == amfSetId)
+            return true;
+    return false;
+}
+
+static bool ServesGuami(const NgapAmfContext &amf, const Guami &guami)
+{
+    for (auto *served : amf.servedGuamiList)
+        if (served->guami.plmn == guami.plmn && served->guami.amfRegionId == guami.amfRegionId &&
+            served->guami.amfSetId == guami.amfSetId && served->guami.amfPointer == guami.amfPointer)
+            return true;
+    return false;
+}
+
+/* Whether the overload action of the AMF rejects the given RRC establishment cause (TS 38.413 8.7.6) */
+static bool IsRejectedByOverloadAction(const OverloadInfo &overload, long cause)
+{
+    if (overload.status != EOverloadStatus::OVERLOADED)
+        return false;
+
+    switch (overload.indication.action)
+    {
+    case EOverloadAction::REJECT_NON_EMERGENCY_MO_DATA:
+        return cause == ASN_RRC_EstablishmentCause_mo_Data;
+    case EOverloadAction::REJECT_SIGNALLING:
+        return cause == ASN_RRC_EstablishmentCause_mo_Signalling;
+    case EOverloadAction::ONLY_EMERGENCY_AND_MT:
+        return cause != ASN_RRC_EstablishmentCause_emergency && cause != ASN_RRC_EstablishmentCause_mt_Access;
+    case EOverloadAction::ONLY_HIGH_PRI_AND_MT:
+        return cause != ASN_RRC_EstablishmentCause_highPriorityAccess &&
+               cause != ASN_RRC_EstablishmentCause_mps_PriorityAccess &&
+               cause != ASN_RRC_EstablishmentCause_mcs_PriorityAccess &&
+               cause != ASN_RRC_EstablishmentCause_mt_Access;
+    default:
+        return false;
+    }
+}
+
+/* Whether the AMF is less loaded than the other one, relative to their capacities */
+static bool IsLessLoaded(const NgapAmfContext &amf, const NgapAmfContext &other)
+{
+    // An AMF with zero capacity only receives UEs if there is no other option
+    if ((amf.relativeCapacity > 0) != (other.relativeCapacity > 0))
+        return amf.relativeCapacity > 0;
+    if (amf.relativeCapacity == 0)
+        return amf.activeUes < other.activeUes;
+
+    // (amf.activeUes + 1) / amf.relativeCapacity < (other.activeUes + 1) / other.relativeCapacity
+    return static_cast<int64_t>(amf.activeUes + 1) * other.relativeCapacity <
+           static_cast<int64_t>(other.activeUes + 1) * amf.relativeCapacity;
+}
+
+NgapAmfContext *NgapTask::selectWeighted(std::vector<NgapAmfContext *> &candidates, long rrcEstablishmentCause)
 {
-    // todo:
-    for (auto &amf : m_amfCtx)
-        return amf.second; // return the first one
+    bool reducible = rrcEstablishmentCause != ASN_RRC_EstablishmentCause_emergency &&
+                     rrcEstablishmentCause != ASN_RRC_EstablishmentCause_mt_Access;
+
+    while (!candidates.empty())
+    {
+        // Overloaded AMFs are only used if there is no other candidate
+        size_t best = 0;
+        for (size_t i = 1; i < candidates.size(); i++)
+        {
+            bool overloaded = candidates[i]->overloadInfo.status == EOverloadStatus::OVERLOADED;
+            bool bestOverloaded = candidates[best]->overloadInfo.status == EOverloadStatus::OVERLOADED;
+            if (overloaded != bestOverloaded ? !overloaded : IsLessLoaded(*candidates[i], *candidates[best]))
+                best = i;
+        }
+
+        auto *amf = candidates[best];
+        auto &overload = amf->overloadInfo;
+
+        bool divert = IsRejectedByOverloadAction(overload, rrcEstablishmentCause);
+        if (!divert && reducible && overload.status == EOverloadStatus::OVERLOADED &&
+            overload.indication.loadReductionPerc > 0)
+        {
+            // Traffic load reduction, the indicated percentage of the selections is diverted
+            overload.reductionCredit += overload.indication.loadReductionPerc;
+            if (overload.reductionCredit >= 100)
+            {
+                overload.reductionCredit -= 100;
+                divert = true;
+            }
+        }
+
+        if (!divert)
+            return amf;
+
+        amf->divertedByOverload++;
+        candidates.erase(candidates.begin() + static_cast<std::ptrdiff_t>(best));
+    }
     return nullptr;
 }
 
+NgapAmfContext *NgapTask::selectAmf(int ueId, long rrcEstablishmentCause, const std::optional<Guami> &registeredAmf,
+                                    const NetworkSlice &requestedNssai)
+{
+    auto &plmn = m_base->config->plmn;
+    auto &nssai = requestedNssai.slices.empty() ? m_base->config->nssai : requestedNssai;
+
+    std::vector<NgapAmfContext *> candidates{};
+    for (auto &item : m_amfCtx)
+    {
+        auto *amf = item.second;
+        if (amf->state == EAmfState::CONNECTED && SupportsPlmnAndSlice(*amf, plmn, nssai))
+            candidates.push_back(amf);
+    }
+
+    if (registeredAmf.has_value())
+    {
+        // The AMF the UE is registered to is preferred, then the other AMFs of the same set
+        std::vector<NgapAmfContext *> registered{}, sameSet{};
+        for (auto *amf : candidates)
+        {
+            if (ServesGuami(*amf, *registeredAmf))
+                registered.push_back(amf);
+            else if (ServesAmfSet(*amf, registeredAmf->plmn, registeredAmf->amfRegionId, registeredAmf->amfSetId))
+                sameSet.push_back(amf);
+        }
+
+        auto *amf = selectWeighted(registered, rrcEstablishmentCause);
+        if (amf == nullptr)
+            amf = selectWeighted(sameSet, rrcEstablishmentCause);
+        if (amf)
+            return amf;
+    }
+
+    return selectWeighted(candidates, rrcEstablishmentCause);
+}
+
 NgapAmfContext *NgapTask::selectNewAmfForReAllocation(int ueId, int initiatedAmfId, int amfSetId)
 {
-    // TODO an arbitrary AMF is selected for now
-    return findAmfContext(initiatedAmfId);
+    auto &plmn = m_base->config->plmn;
+
+    // Another AMF of the indicated set is preferred, the initiating AMF is kept if there is none
+    std::vector<NgapAmfContext *> candidates{};
+    for (auto &item : m_amfCtx)
+    {
+        auto *amf = item.second;
+        if (amf->state != EAmfState::CONNECTED || amf->ctxId == initiatedAmfId)
+            continue;
+
+        bool inSet = false;
+        for (auto *served : amf->servedGuamiList)
+            inSet |= served->guami.plmn == plmn && served->guami.amfSetId == amfSetId;
+        if (inSet)
+            candidates.push_back(amf);
+    }
+
+    auto *ue = findUeContext(ueId);
+    long cause = ASN_RRC_EstablishmentCause_mo_Signalling;
+    if (ue)
+        cause = ue->establishmentCause;
+
+    auto *amf = selectWeighted(candidates, cause);
+    return amf ? amf : findAmfContext(initiatedAmfId);
 }
 
 } // namespace nr::gnb
@@ -100,10 +100,8 @@ void NgapTask::receiveSessionResourceSetupRequest(int amfId, ASN_NGAP_PDUSession
             ie = asn::ngap::GetProtocolIe(transfer, ASN_NGAP_ProtocolIE_ID_id_QosFlowSetupRequestList);
             if (ie)
             {
-                auto *ptr = asn::New<ASN_NGAP_QosFlowSetupRequestList>();
-                asn::DeepCopy(asn_DEF_ASN_NGAP_QosFlowSetupRequestList, ie->QosFlowSetupRequestList, ptr);
-
-                resource->qosFlows = asn::WrapUnique(ptr, asn_DEF_ASN_NGAP_QosFlowSetupRequestList);
+                resource->qosFlows =
+                    asn::UniqueCopy(ie->QosFlowSetupRequestList, asn_DEF_ASN_NGAP_QosFlowSetupRequestList);
             }
 
             auto error = setupPduSessionResource(resource);
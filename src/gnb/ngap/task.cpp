@@ -13,12 +13,16 @@
 #include <gnb/app/task.hpp>
 #include <gnb/sctp/task.hpp>
 
+static constexpr const size_t RAN_ID_TABLE_INITIAL_SIZE = 1024; // Must be a power of two
+
 namespace nr::gnb
 {
 
-NgapTask::NgapTask(TaskBase *base) : m_base{base}, m_ueNgapIdCounter{}, m_downlinkTeidCounter{}, m_isInitialized{}
+NgapTask::NgapTask(TaskBase *base)
+    : m_base{base}, m_ueByRanId(RAN_ID_TABLE_INITIAL_SIZE), m_ueByAmfId{}, m_ueNgapIdCounter{},
+      m_downlinkTeidCounter{base->config->teidBase}, m_isInitialized{}, m_asnArena{}
 {
-    m_logger = base->logBase->makeUniqueLogger("ngap");
+    m_logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "ngap");
 }
 
 void NgapTask::onStart()
@@ -55,7 +59,7 @@ void NgapTask::onLoop()
         switch (w->present)
         {
         case NmGnbRrcToNgap::INITIAL_NAS_DELIVERY: {
-            handleInitialNasTransport(w->ueId, w->pdu, w->rrcEstablishmentCause);
+            handleInitialNasTransport(w->ueId, w->pdu, w->rrcEstablishmentCause, w->registeredAmf, w->requestedNssai);
             break;
         }
         case NmGnbRrcToNgap::UPLINK_NAS_DELIVERY: {
@@ -105,6 +109,8 @@ void NgapTask::onQuit()
         delete i.second;
     m_ueCtx.clear();
     m_amfCtx.clear();
+    m_ueByRanId.clear();
+    m_ueByAmfId.clear();
 }
 
 } // namespace nr::gnb
@@ -10,10 +10,12 @@
 
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include <gnb/nts.hpp>
 #include <gnb/types.hpp>
 #include <lib/app/monitor.hpp>
+#include <lib/asn/arena.hpp>
 #include <utils/logger.hpp>
 #include <utils/nts.hpp>
 
@@ -52,9 +54,12 @@ class NgapTask : public NtsTask
 
     std::unordered_map<int, NgapAmfContext *> m_amfCtx;
     std::unordered_map<int, NgapUeContext *> m_ueCtx;
+    std::vector<NgapUeContext *> m_ueByRanId; // Direct indexed by (RAN-UE-NGAP-ID mod size)
+    std::unordered_map<int, std::unordered_map<int64_t, NgapUeContext *>> m_ueByAmfId; // AMF ctx ID to AMF-UE-NGAP-ID
     long m_ueNgapIdCounter;
     uint32_t m_downlinkTeidCounter;
     bool m_isInitialized;
+    asn::Arena m_asnArena; // Received PDUs and the PDUs built while handling them
 
     friend class GnbCmdHandler;
 
@@ -74,8 +79,10 @@ class NgapTask : public NtsTask
     void createUeContext(int ueId);
     NgapUeContext *findUeContext(int ctxId);
     NgapUeContext *findUeByRanId(long ranUeNgapId);
-    NgapUeContext *findUeByAmfId(long amfUeNgapId);
+    NgapUeContext *findUeByAmfId(int amfCtxId, int64_t amfUeNgapId);
     NgapUeContext *findUeByNgapIdPair(int amfCtxId, const NgapIdPair &idPair);
+    void updateUeAmfId(NgapUeContext *ue, int64_t amfUeNgapId);
+    void associateUeWithAmf(NgapUeContext *ue, NgapAmfContext *amf);
     void deleteUeContext(int ueId);
     void deleteAmfContext(int amfId);
 
@@ -98,9 +105,12 @@ class NgapTask : public NtsTask
     void sendNgapUeAssociated(int ueId, ASN_NGAP_NGAP_PDU *pdu);
     void handleSctpMessage(int amfId, uint16_t stream, const UniqueBuffer &buffer);
     bool handleSctpStreamId(int amfId, int stream, const ASN_NGAP_NGAP_PDU &pdu);
+    bool checkPduConstraints(ASN_NGAP_NGAP_PDU *pdu);
+    void notifyNodeListener(bool isSend, const std::string &amfName, const ASN_NGAP_NGAP_PDU &pdu);
 
     /* NAS transport */
-    void handleInitialNasTransport(int ueId, const OctetString &nasPdu, long rrcEstablishmentCause);
+    void handleInitialNasTransport(int ueId, const OctetString &nasPdu, long rrcEstablishmentCause,
+                                   const std::optional<Guami> &registeredAmf, const NetworkSlice &requestedNssai);
     void handleUplinkNasTransport(int ueId, const OctetString &nasPdu);
     void receiveDownlinkNasTransport(int amfId, ASN_NGAP_DownlinkNASTransport *msg);
     void deliverDownlinkNas(int ueId, OctetString &&nasPdu);
@@ -119,8 +129,10 @@ class NgapTask : public NtsTask
     void sendContextRelease(int ueId, NgapCause cause);
 
     /* NAS Node Selection */
-    NgapAmfContext *selectAmf(int ueId);
+    NgapAmfContext *selectAmf(int ueId, long rrcEstablishmentCause, const std::optional<Guami> &registeredAmf,
+                              const NetworkSlice &requestedNssai);
     NgapAmfContext *selectNewAmfForReAllocation(int ueId, int initiatedAmfId, int amfSetId);
+    NgapAmfContext *selectWeighted(std::vector<NgapAmfContext *> &candidates, long rrcEstablishmentCause);
 
     /* Radio resource control */
     void handleRadioLinkFailure(int ueId);
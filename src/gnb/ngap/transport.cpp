@@ -15,6 +15,7 @@
 #include <gnb/sctp/task.hpp>
 #include <lib/asn/ngap.hpp>
 #include <lib/asn/utils.hpp>
+#include <utils/metrics.hpp>
 
 #include <asn/ngap/ASN_NGAP_AMF-UE-NGAP-ID.h>
 #include <asn/ngap/ASN_NGAP_InitiatingMessage.h>
@@ -26,6 +27,17 @@
 #include <asn/ngap/ASN_NGAP_UserLocationInformation.h>
 #include <asn/ngap/ASN_NGAP_UserLocationInformationNR.h>
 
+static auto &g_sentNonUe = metrics::Registry::Instance().counter("ngap_messages_sent_total", "NGAP PDUs sent to AMFs",
+                                                                  "signalling=\"non_ue\"");
+static auto &g_sentUe = metrics::Registry::Instance().counter("ngap_messages_sent_total", "NGAP PDUs sent to AMFs",
+                                                               "signalling=\"ue_associated\"");
+static auto &g_received =
+    metrics::Registry::Instance().counter("ngap_messages_received_total", "NGAP PDUs received from AMFs");
+static auto &g_encodeFailures = metrics::Registry::Instance().counter(
+    "ngap_codec_failures_total", "NGAP PDUs that could not be encoded or decoded", "operation=\"encode\"");
+static auto &g_decodeFailures = metrics::Registry::Instance().counter(
+    "ngap_codec_failures_total", "NGAP PDUs that could not be encoded or decoded", "operation=\"decode\"");
+
 static e_ASN_NGAP_Criticality FindCriticalityOfUserIe(ASN_NGAP_NGAP_PDU *pdu, ASN_NGAP_ProtocolIE_ID_t ieId)
 {
     auto procedureCode =
@@ -81,6 +93,26 @@ static e_ASN_NGAP_Criticality FindCriticalityOfUserIe(ASN_NGAP_NGAP_PDU *pdu, AS
     return ASN_NGAP_Criticality_ignore;
 }
 
+static int GetProcedureCode(const ASN_NGAP_NGAP_PDU &pdu)
+{
+    switch (pdu.present)
+    {
+    case ASN_NGAP_NGAP_PDU_PR_initiatingMessage:
+        return static_cast<int>(pdu.choice.initiatingMessage->procedureCode);
+    case ASN_NGAP_NGAP_PDU_PR_successfulOutcome:
+        return static_cast<int>(pdu.choice.successfulOutcome->procedureCode);
+    case ASN_NGAP_NGAP_PDU_PR_unsuccessfulOutcome:
+        return static_cast<int>(pdu.choice.unsuccessfulOutcome->procedureCode);
+    default:
+        return -1;
+    }
+}
+
+static std::string RenderNgapXer(const void *pdu)
+{
+    return nr::gnb::ngap_encode::EncodeXer(asn_DEF_ASN_NGAP_NGAP_PDU, reinterpret_cast<const ASN_NGAP_NGAP_PDU *>(pdu));
+}
+
 namespace nr::gnb
 {
 
@@ -93,12 +125,8 @@ void NgapTask::sendNgapNonUe(int associatedAmf, ASN_NGAP_NGAP_PDU *pdu)
         return;
     }
 
-    char errorBuffer[1024];
-    size_t len;
-
-    if (asn_check_constraints(&asn_DEF_ASN_NGAP_NGAP_PDU, pdu, errorBuffer, &len) != 0)
+    if (!checkPduConstraints(pdu))
     {
-        m_logger->err("NGAP PDU ASN constraint validation failed");
         asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
         return;
     }
@@ -106,24 +134,17 @@ void NgapTask::sendNgapNonUe(int associatedAmf, ASN_NGAP_NGAP_PDU *pdu)
     ssize_t encoded;
     uint8_t *buffer;
     if (!ngap_encode::Encode(asn_DEF_ASN_NGAP_NGAP_PDU, pdu, encoded, buffer))
+    {
+        g_encodeFailures.inc();
         m_logger->err("NGAP APER encoding failed");
+    }
     else
     {
-        auto *msg = new NmGnbSctp(NmGnbSctp::SEND_MESSAGE);
-        msg->clientId = amf->ctxId;
-        msg->stream = 0;
-        msg->buffer = UniqueBuffer{buffer, static_cast<size_t>(encoded)};
-        m_base->sctpTask->push(msg);
+        g_sentNonUe.inc();
+        m_base->sctpTask->sendMessage(amf->ctxId, 0, UniqueBuffer{buffer, static_cast<size_t>(encoded)});
 
         if (m_base->nodeListener)
-        {
-            std::string xer = ngap_encode::EncodeXer(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
-            if (xer.length() > 0)
-            {
-                m_base->nodeListener->onSend(app::NodeType::GNB, m_base->config->name, app::NodeType::AMF, amf->amfName,
-                                             app::ConnectionType::NGAP, xer);
-            }
-        }
+            notifyNodeListener(true, amf->amfName, *pdu);
     }
 
     asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
@@ -184,12 +205,8 @@ void NgapTask::sendNgapUeAssociated(int ueId, ASN_NGAP_NGAP_PDU *pdu)
 
     /* Encode and send the PDU */
 
-    char errorBuffer[1024];
-    size_t len;
-
-    if (asn_check_constraints(&asn_DEF_ASN_NGAP_NGAP_PDU, pdu, errorBuffer, &len) != 0)
+    if (!checkPduConstraints(pdu))
     {
-        m_logger->err("NGAP PDU ASN constraint validation failed");
         asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
         return;
     }
@@ -197,24 +214,17 @@ void NgapTask::sendNgapUeAssociated(int ueId, ASN_NGAP_NGAP_PDU *pdu)
     ssize_t encoded;
     uint8_t *buffer;
     if (!ngap_encode::Encode(asn_DEF_ASN_NGAP_NGAP_PDU, pdu, encoded, buffer))
+    {
+        g_encodeFailures.inc();
         m_logger->err("NGAP APER encoding failed");
+    }
     else
     {
-        auto *msg = new NmGnbSctp(NmGnbSctp::SEND_MESSAGE);
-        msg->clientId = amf->ctxId;
-        msg->stream = ue->uplinkStream;
-        msg->buffer = UniqueBuffer{buffer, static_cast<size_t>(encoded)};
-        m_base->sctpTask->push(msg);
+        g_sentUe.inc();
+        m_base->sctpTask->sendMessage(amf->ctxId, ue->uplinkStream, UniqueBuffer{buffer, static_cast<size_t>(encoded)});
 
         if (m_base->nodeListener)
-        {
-            std::string xer = ngap_encode::EncodeXer(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
-            if (xer.length() > 0)
-            {
-                m_base->nodeListener->onSend(app::NodeType::GNB, m_base->config->name, app::NodeType::AMF, amf->amfName,
-                                             app::ConnectionType::NGAP, xer);
-            }
-        }
+            notifyNodeListener(true, amf->amfName, *pdu);
     }
 
     asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
@@ -226,24 +236,23 @@ void NgapTask::handleSctpMessage(int amfId, uint16_t stream, const UniqueBuffer
     if (amf == nullptr)
         return;
 
+    // The received PDU, and the responses built by the handlers are all released at the end of this function
+    asn::ArenaScope arenaScope{m_asnArena};
+
     auto *pdu = ngap_encode::Decode<ASN_NGAP_NGAP_PDU>(asn_DEF_ASN_NGAP_NGAP_PDU, buffer.data(), buffer.size());
     if (pdu == nullptr)
     {
+        g_decodeFailures.inc();
         m_logger->err("APER decoding failed for SCTP message");
         asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
         sendErrorIndication(amfId, NgapCause::Protocol_transfer_syntax_error);
         return;
     }
 
+    g_received.inc();
+
     if (m_base->nodeListener)
-    {
-        std::string xer = ngap_encode::EncodeXer(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
-        if (xer.length() > 0)
-        {
-            m_base->nodeListener->onReceive(app::NodeType::GNB, m_base->config->name, app::NodeType::AMF, amf->amfName,
-                                            app::ConnectionType::NGAP, xer);
-        }
-    }
+        notifyNodeListener(false, amf->amfName, *pdu);
 
     if (!handleSctpStreamId(amf->ctxId, stream, *pdu))
     {
@@ -331,6 +340,47 @@ void NgapTask::handleSctpMessage(int amfId, uint16_t stream, const UniqueBuffer
     asn::Free(asn_DEF_ASN_NGAP_NGAP_PDU, pdu);
 }
 
+bool NgapTask::checkPduConstraints(ASN_NGAP_NGAP_PDU *pdu)
+{
+    // Debugging stage only, the PDUs built by the gNB are valid by construction
+    if (!m_base->config->checkAsnConstraints)
+        return true;
+
+    char errorBuffer[1024];
+    size_t len = sizeof(errorBuffer);
+
+    if (asn_check_constraints(&asn_DEF_ASN_NGAP_NGAP_PDU, pdu, errorBuffer, &len) != 0)
+    {
+        m_logger->err("NGAP PDU ASN constraint validation failed: %s", errorBuffer);
+        return false;
+    }
+    return true;
+}
+
+void NgapTask::notifyNodeListener(bool isSend, const std::string &amfName, const ASN_NGAP_NGAP_PDU &pdu)
+{
+    std::optional<int64_t> ranUeId{}, amfUeId{};
+
+    auto *ranUeIdIe =
+        asn::ngap::FindProtocolIeInPdu(pdu, asn_DEF_ASN_NGAP_RAN_UE_NGAP_ID, ASN_NGAP_ProtocolIE_ID_id_RAN_UE_NGAP_ID);
+    if (ranUeIdIe != nullptr)
+        ranUeId = *reinterpret_cast<ASN_NGAP_RAN_UE_NGAP_ID_t *>(ranUeIdIe);
+
+    auto *amfUeIdIe =
+        asn::ngap::FindProtocolIeInPdu(pdu, asn_DEF_ASN_NGAP_AMF_UE_NGAP_ID, ASN_NGAP_ProtocolIE_ID_id_AMF_UE_NGAP_ID);
+    if (amfUeIdIe != nullptr)
+        amfUeId = asn::GetSigned64(*reinterpret_cast<ASN_NGAP_AMF_UE_NGAP_ID_t *>(amfUeIdIe));
+
+    app::NodeMessage message{&pdu, RenderNgapXer, GetProcedureCode(pdu), ranUeId, amfUeId};
+
+    if (isSend)
+        m_base->nodeListener->onSend(app::NodeType::GNB, m_base->config->name, app::NodeType::AMF, amfName,
+                                     app::ConnectionType::NGAP, message);
+    else
+        m_base->nodeListener->onReceive(app::NodeType::GNB, m_base->config->name, app::NodeType::AMF, amfName,
+                                        app::ConnectionType::NGAP, message);
+}
+
 bool NgapTask::handleSctpStreamId(int amfId, int stream, const ASN_NGAP_NGAP_PDU &pdu)
 {
     if (m_base->config->ignoreStreamIds)
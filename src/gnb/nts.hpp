@@ -108,6 +108,7 @@ struct NmGnbRlsToRls : NtsMessage
     // DOWNLINK_DATA
     // UPLINK_DATA
     // UPLINK_RRC
+    // RADIO_LINK_FAILURE
     int ueId{};
 
     // RECEIVE_RLS_MESSAGE
@@ -123,9 +124,6 @@ struct NmGnbRlsToRls : NtsMessage
     // UPLINK_RRC
     OctetString data;
 
-    // DOWNLINK_RRC
-    uint32_t pduId{};
-
     // DOWNLINK_RRC
     // UPLINK_RRC
     rrc::RrcChannel rrcChannel{};
@@ -204,6 +202,8 @@ struct NmGnbRrcToNgap : NtsMessage
 
     // INITIAL_NAS_DELIVERY
     long rrcEstablishmentCause{};
+    std::optional<Guami> registeredAmf{};
+    NetworkSlice requestedNssai{};
 
     explicit NmGnbRrcToNgap(PR present) : NtsMessage(NtsMessageType::GNB_RRC_TO_NGAP), present(present)
     {
@@ -8,25 +8,17 @@
 
 #include "ctl_task.hpp"
 
-#include <stdexcept>
 #include <utils/common.hpp>
 
-static constexpr const size_t MAX_PDU_COUNT = 4096;
-static constexpr const int MAX_PDU_TTL = 3000;
-
-static constexpr const int TIMER_ID_ACK_CONTROL = 1;
-static constexpr const int TIMER_ID_ACK_SEND = 2;
-
-static constexpr const int TIMER_PERIOD_ACK_CONTROL = 1500;
-static constexpr const int TIMER_PERIOD_ACK_SEND = 2250;
+static constexpr const int TIMER_ID_ARQ = 1;
 
 namespace nr::gnb
 {
 
 RlsControlTask::RlsControlTask(TaskBase *base, uint64_t sti)
-    : m_sti{sti}, m_mainTask{}, m_udpTask{}, m_pduMap{}, m_pendingAck{}
+    : m_sti{sti}, m_mainTask{}, m_udpTask{}, m_arq{this, base->config->rlsArq}, m_arqTimerSet{}
 {
-    m_logger = base->logBase->makeUniqueLogger("rls-ctl");
+    m_logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "rls-ctl");
 }
 
 void RlsControlTask::initialize(NtsTask *mainTask, RlsUdpTask *udpTask)
@@ -37,8 +29,6 @@ void RlsControlTask::initialize(NtsTask *mainTask, RlsUdpTask *udpTask)
 
 void RlsControlTask::onStart()
 {
-    setTimer(TIMER_ID_ACK_CONTROL, TIMER_PERIOD_ACK_CONTROL);
-    setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
 }
 
 void RlsControlTask::onLoop()
@@ -66,7 +56,7 @@ void RlsControlTask::onLoop()
             handleDownlinkDataDelivery(w->ueId, w->psi, std::move(w->data));
             break;
         case NmGnbRlsToRls::DOWNLINK_RRC:
-            handleDownlinkRrcDelivery(w->ueId, w->pduId, w->rrcChannel, std::move(w->data));
+            handleDownlinkRrcDelivery(w->ueId, w->rrcChannel, std::move(w->data));
             break;
         default:
             m_logger->unhandledNts(msg);
@@ -76,15 +66,10 @@ void RlsControlTask::onLoop()
     }
     case NtsMessageType::TIMER_EXPIRED: {
         auto *w = dynamic_cast<NmTimerExpired *>(msg);
-        if (w->timerId == TIMER_ID_ACK_CONTROL)
-        {
-            setTimer(TIMER_ID_ACK_CONTROL, TIMER_PERIOD_ACK_CONTROL);
-            onAckControlTimerExpired();
-        }
-        else if (w->timerId == TIMER_ID_ACK_SEND)
+        if (w->timerId == TIMER_ID_ARQ)
         {
-            setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
-            onAckSendTimerExpired();
+            m_arqTimerSet = false;
+            m_arq.timerCycle(utils::CurrentTimeMillis(), m_sti);
         }
         break;
     }
@@ -93,6 +78,8 @@ void RlsControlTask::onLoop()
         break;
     }
 
+    setArqTimer();
+
     delete msg;
 }
 
@@ -109,6 +96,8 @@ void RlsControlTask::handleSignalDetected(int ueId)
 
 void RlsControlTask::handleSignalLost(int ueId)
 {
+    m_arq.removeEndPoint(ueId);
+
     auto *w = new NmGnbRlsToRls(NmGnbRlsToRls::SIGNAL_LOST);
     w->ueId = ueId;
     m_mainTask->push(w);
@@ -118,15 +107,13 @@ void RlsControlTask::handleRlsMessage(int ueId, rls::RlsMessage &msg)
 {
     if (msg.msgType == rls::EMessageType::PDU_TRANSMISSION_ACK)
     {
-        auto &m = (rls::RlsPduTransmissionAck &)msg;
-        for (auto pduId : m.pduIds)
-            m_pduMap.erase(pduId);
+        m_arq.receiveAck(ueId, (rls::RlsPduTransmissionAck &)msg, utils::CurrentTimeMillis());
     }
     else if (msg.msgType == rls::EMessageType::PDU_TRANSMISSION)
     {
         auto &m = (rls::RlsPduTransmission &)msg;
-        if (m.pduId != 0)
-            m_pendingAck[ueId].push_back(m.pduId);
+        if (!m_arq.receivePdu(ueId, m, utils::CurrentTimeMillis()))
+            return; // Duplicate PDU
 
         if (m.pduType == rls::EPduType::DATA)
         {
@@ -155,50 +142,21 @@ void RlsControlTask::handleRlsMessage(int ueId, rls::RlsMessage &msg)
     }
 }
 
-void RlsControlTask::handleDownlinkRrcDelivery(int ueId, uint32_t pduId, rrc::RrcChannel channel, OctetString &&data)
+void RlsControlTask::handleDownlinkRrcDelivery(int ueId, rrc::RrcChannel channel, OctetString &&data)
 {
-    if (ueId == 0 && pduId != 0)
+    if (ueId == 0)
     {
-        // PDU ID must be not set in case of broadcast
-        throw std::runtime_error("");
-    }
-
-    if (pduId != 0)
-    {
-        if (m_pduMap.count(pduId))
-        {
-            m_pduMap.clear();
-
-            auto *w = new NmGnbRlsToRls(NmGnbRlsToRls::RADIO_LINK_FAILURE);
-            w->rlfCause = rls::ERlfCause::PDU_ID_EXISTS;
-            m_mainTask->push(w);
-            return;
-        }
-
-        if (m_pduMap.size() > MAX_PDU_COUNT)
-        {
-            m_pduMap.clear();
+        // Broadcast PDUs are not acknowledged
+        rls::RlsPduTransmission msg{m_sti};
+        msg.pduType = rls::EPduType::RRC;
+        msg.pdu = std::move(data);
+        msg.payload = static_cast<uint32_t>(channel);
 
-            auto *w = new NmGnbRlsToRls(NmGnbRlsToRls::RADIO_LINK_FAILURE);
-            w->rlfCause = rls::ERlfCause::PDU_ID_FULL;
-            m_mainTask->push(w);
-            return;
-        }
-
-        m_pduMap[pduId].endPointId = ueId;
-        m_pduMap[pduId].id = pduId;
-        m_pduMap[pduId].pdu = data.copy();
-        m_pduMap[pduId].rrcChannel = channel;
-        m_pduMap[pduId].sentTime = utils::CurrentTimeMillis();
+        m_udpTask->send(ueId, msg);
+        return;
     }
 
-    rls::RlsPduTransmission msg{m_sti};
-    msg.pduType = rls::EPduType::RRC;
-    msg.pdu = std::move(data);
-    msg.payload = static_cast<uint32_t>(channel);
-    msg.pduId = pduId;
-
-    m_udpTask->send(ueId, msg);
+    m_arq.sendReliable(ueId, channel, std::move(data), m_sti, utils::CurrentTimeMillis());
 }
 
 void RlsControlTask::handleDownlinkDataDelivery(int ueId, int psi, OctetString &&data)
@@ -207,54 +165,37 @@ void RlsControlTask::handleDownlinkDataDelivery(int ueId, int psi, OctetString &
     msg.pduType = rls::EPduType::DATA;
     msg.pdu = std::move(data);
     msg.payload = static_cast<uint32_t>(psi);
-    msg.pduId = 0;
 
-    m_udpTask->send(ueId, msg);
+    m_arq.sendUnreliable(ueId, msg);
 }
 
-void RlsControlTask::onAckControlTimerExpired()
+void RlsControlTask::setArqTimer()
 {
-    int64_t current = utils::CurrentTimeMillis();
-
-    std::vector<uint32_t> transmissionFailureIds;
-    std::vector<rls::PduInfo> transmissionFailures;
-
-    for (auto &pdu : m_pduMap)
+    if (!m_arqTimerSet && m_arq.hasTimer())
     {
-        auto delta = current - pdu.second.sentTime;
-        if (delta > MAX_PDU_TTL)
-        {
-            transmissionFailureIds.push_back(pdu.first);
-            transmissionFailures.push_back(std::move(pdu.second));
-        }
-    }
-
-    for (auto id : transmissionFailureIds)
-        m_pduMap.erase(id);
-
-    if (!transmissionFailures.empty())
-    {
-        auto *w = new NmGnbRlsToRls(NmGnbRlsToRls::TRANSMISSION_FAILURE);
-        w->pduList = std::move(transmissionFailures);
-        m_mainTask->push(w);
+        m_arqTimerSet = true;
+        setTimer(TIMER_ID_ARQ, m_arq.getTickPeriod());
     }
 }
 
-void RlsControlTask::onAckSendTimerExpired()
+void RlsControlTask::sendRlsMessage(int ueId, const rls::RlsMessage &msg)
 {
-    auto copy = m_pendingAck;
-    m_pendingAck.clear();
-
-    for (auto &item : copy)
-    {
-        if (!item.second.empty())
-            continue;
+    m_udpTask->send(ueId, msg);
+}
 
-        rls::RlsPduTransmissionAck msg{m_sti};
-        msg.pduIds = std::move(item.second);
+void RlsControlTask::transmissionFailure(std::vector<rls::PduInfo> &&pduList)
+{
+    auto *w = new NmGnbRlsToRls(NmGnbRlsToRls::TRANSMISSION_FAILURE);
+    w->pduList = std::move(pduList);
+    m_mainTask->push(w);
+}
 
-        m_udpTask->send(item.first, msg);
-    }
+void RlsControlTask::radioLinkFailure(int ueId, rls::ERlfCause cause)
+{
+    auto *w = new NmGnbRlsToRls(NmGnbRlsToRls::RADIO_LINK_FAILURE);
+    w->ueId = ueId;
+    w->rlfCause = cause;
+    m_mainTask->push(w);
 }
 
 } // namespace nr::gnb
@@ -12,20 +12,21 @@
 
 #include <gnb/nts.hpp>
 #include <gnb/types.hpp>
+#include <lib/rls/rls_arq.hpp>
 #include <utils/nts.hpp>
 
 namespace nr::gnb
 {
 
-class RlsControlTask : public NtsTask
+class RlsControlTask : public NtsTask, private rls::IArqConsumer
 {
   private:
     std::unique_ptr<Logger> m_logger;
     uint64_t m_sti;
     NtsTask *m_mainTask;
     RlsUdpTask *m_udpTask;
-    std::unordered_map<uint32_t, rls::PduInfo> m_pduMap;
-    std::unordered_map<int, std::vector<uint32_t>> m_pendingAck;
+    rls::RlsArq m_arq;
+    bool m_arqTimerSet;
 
   public:
     explicit RlsControlTask(TaskBase *base, uint64_t sti);
@@ -43,10 +44,14 @@ class RlsControlTask : public NtsTask
     void handleSignalDetected(int ueId);
     void handleSignalLost(int ueId);
     void handleRlsMessage(int ueId, rls::RlsMessage &msg);
-    void handleDownlinkRrcDelivery(int ueId, uint32_t pduId, rrc::RrcChannel channel, OctetString &&data);
+    void handleDownlinkRrcDelivery(int ueId, rrc::RrcChannel channel, OctetString &&data);
     void handleDownlinkDataDelivery(int ueId, int psi, OctetString &&data);
-    void onAckControlTimerExpired();
-    void onAckSendTimerExpired();
+    void setArqTimer();
+
+    /* ARQ consumer */
+    void sendRlsMessage(int ueId, const rls::RlsMessage &msg) override;
+    void transmissionFailure(std::vector<rls::PduInfo> &&pduList) override;
+    void radioLinkFailure(int ueId, rls::ERlfCause cause) override;
 };
 
 } // namespace nr::gnb
\ No newline at end of file
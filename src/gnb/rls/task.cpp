@@ -17,7 +17,7 @@ namespace nr::gnb
 
 GnbRlsTask::GnbRlsTask(TaskBase *base) : m_base{base}
 {
-    m_logger = m_base->logBase->makeUniqueLogger("rls");
+    m_logger = m_base->logBase->makeUniqueLogger(m_base->config->getLoggerPrefix() + "rls");
     m_sti = utils::Random64();
 
     m_udpTask = new RlsUdpTask(base, m_sti, base->config->phyLocation);
@@ -72,11 +72,11 @@ void GnbRlsTask::onLoop()
             break;
         }
         case NmGnbRlsToRls::RADIO_LINK_FAILURE: {
-            m_logger->debug("radio link failure [%d]", (int)w->rlfCause);
+            m_logger->debug("radio link failure [%d] for UE[%d]", (int)w->rlfCause, w->ueId);
             break;
         }
         case NmGnbRlsToRls::TRANSMISSION_FAILURE: {
-            m_logger->debug("transmission failure [%s]", "");
+            m_logger->debug("transmission failure [%d]", w->pduList.size());
             break;
         }
         default: {
@@ -94,7 +94,6 @@ void GnbRlsTask::onLoop()
             auto *m = new NmGnbRlsToRls(NmGnbRlsToRls::DOWNLINK_RRC);
             m->ueId = w->ueId;
             m->rrcChannel = w->channel;
-            m->pduId = 0;
             m->data = std::move(w->pdu);
             m_ctlTask->push(m);
             break;
@@ -8,7 +8,6 @@
 
 #include "udp_task.hpp"
 
-#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <set>
@@ -24,27 +23,14 @@ static constexpr const int LOOP_PERIOD = 1000;
 static constexpr const int RECEIVE_TIMEOUT = 200;
 static constexpr const int HEARTBEAT_THRESHOLD = 2000; // (LOOP_PERIOD + RECEIVE_TIMEOUT)'dan büyük olmalı
 
-static constexpr const int MIN_ALLOWED_DBM = -120;
-
-static int EstimateSimulatedDbm(const Vector3 &myPos, const Vector3 &uePos)
-{
-    int deltaX = myPos.x - uePos.x;
-    int deltaY = myPos.y - uePos.y;
-    int deltaZ = myPos.z - uePos.z;
-
-    int distance = static_cast<int>(std::sqrt(deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ));
-    if (distance == 0)
-        return -1; // 0 may be confusing for people
-    return -distance;
-}
-
 namespace nr::gnb
 {
 
 RlsUdpTask::RlsUdpTask(TaskBase *base, uint64_t sti, Vector3 phyLocation)
-    : m_server{}, m_ctlTask{}, m_sti{sti}, m_phyLocation{phyLocation}, m_lastLoop{}, m_stiToUe{}, m_ueMap{}, m_newIdCounter{}
+    : m_server{}, m_ctlTask{}, m_sti{sti}, m_phyLocation{phyLocation}, m_propagation{base->config->propagation},
+      m_lastLoop{}, m_stiToUe{}, m_ueMap{}, m_newIdCounter{}
 {
-    m_logger = base->logBase->makeUniqueLogger("rls-udp");
+    m_logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "rls-udp");
 
     try
     {
@@ -75,7 +61,11 @@ void RlsUdpTask::onLoop()
     InetAddress peerAddress;
 
     int size = m_server->Receive(buffer, BUFFER_SIZE, RECEIVE_TIMEOUT, peerAddress);
-    if (size > 0)
+    if (size > 0 && buffer[0] == rls::COMPACT_DATA_INDICATOR)
+    {
+        receiveCompactData(peerAddress, OctetView{buffer, static_cast<size_t>(size)});
+    }
+    else if (size > 0)
     {
         auto rlsMsg = rls::DecodeRlsMessage(OctetView{buffer, static_cast<size_t>(size)});
         if (rlsMsg == nullptr)
@@ -94,24 +84,31 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
 {
     if (msg->msgType == rls::EMessageType::HEARTBEAT)
     {
-        int dbm = EstimateSimulatedDbm(m_phyLocation, ((const rls::RlsHeartBeat &)*msg).simPos);
-        if (dbm < MIN_ALLOWED_DBM)
+        rls::RlsHeartBeatAck ack{m_sti};
+        ack.simPos = m_phyLocation;
+        ack.range = m_propagation.getRange();
+
+        ack.dbm = m_propagation.estimateDbm(m_phyLocation, ((const rls::RlsHeartBeat &)*msg).simPos);
+        if (ack.dbm == rls::OUT_OF_RANGE_DBM)
         {
-            // if the simulated signal strength is such low, then ignore this message
+            // The UE is out of range, only let it know the position and range of this cell
+            sendRlsPdu(addr, ack);
             return;
         }
 
+        int ueId;
         if (m_stiToUe.count(msg->sti))
         {
-            int ueId = m_stiToUe[msg->sti];
+            ueId = m_stiToUe[msg->sti];
             m_ueMap[ueId].address = addr;
             m_ueMap[ueId].lastSeen = utils::CurrentTimeMillis();
         }
         else
         {
-            int ueId = ++m_newIdCounter;
+            ueId = ++m_newIdCounter;
 
             m_stiToUe[msg->sti] = ueId;
+            m_ueMap[ueId].sti = msg->sti;
             m_ueMap[ueId].address = addr;
             m_ueMap[ueId].lastSeen = utils::CurrentTimeMillis();
 
@@ -120,8 +117,9 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
             m_ctlTask->push(w);
         }
 
-        rls::RlsHeartBeatAck ack{m_sti};
-        ack.dbm = dbm;
+        m_ueMap[ueId].peerHandle = ((const rls::RlsHeartBeat &)*msg).handle;
+
+        ack.handle = static_cast<uint32_t>(ueId);
 
         sendRlsPdu(addr, ack);
         return;
@@ -147,6 +145,43 @@ void RlsUdpTask::sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg)
     m_server->Send(addr, stream.data(), static_cast<size_t>(stream.length()));
 }
 
+void RlsUdpTask::receiveCompactData(const InetAddress &addr, const OctetView &stream)
+{
+    uint32_t handle;
+    if (!rls::DecodeCompactDataHandle(stream, handle))
+    {
+        m_logger->err("Unable to decode RLS message");
+        return;
+    }
+
+    auto it = m_ueMap.find(static_cast<int>(handle));
+    if (it == m_ueMap.end() || it->second.address != addr)
+    {
+        // Unknown or stale handle, ignore the message
+        return;
+    }
+
+    auto rlsMsg = rls::DecodeCompactData(stream, it->second.sti);
+    if (rlsMsg == nullptr)
+    {
+        m_logger->err("Unable to decode RLS message");
+        return;
+    }
+
+    auto *w = new NmGnbRlsToRls(NmGnbRlsToRls::RECEIVE_RLS_MESSAGE);
+    w->ueId = it->first;
+    w->msg = std::move(rlsMsg);
+    m_ctlTask->push(w);
+}
+
+void RlsUdpTask::sendCompactData(const InetAddress &addr, uint32_t handle, const rls::RlsPduTransmission &msg)
+{
+    uint8_t header[rls::COMPACT_HEADER_MAX_SIZE];
+    size_t headerSize = rls::EncodeCompactDataHeader(msg, handle, header);
+
+    m_server->Send(addr, header, headerSize, msg.pdu.data(), static_cast<size_t>(msg.pdu.length()));
+}
+
 void RlsUdpTask::heartbeatCycle(int64_t time)
 {
     std::set<int> lostUeId{};
@@ -184,8 +219,21 @@ void RlsUdpTask::send(int ueId, const rls::RlsMessage &msg)
 {
     if (ueId == 0)
     {
+        if (rls::IsCompactFramingApplicable(msg))
+        {
+            for (auto &ue : m_ueMap)
+                send(ue.first, msg);
+            return;
+        }
+
+        // Broadcast, the same datagram is encoded once and sent to every UE
+        if (m_ueMap.empty())
+            return;
+
+        OctetString stream;
+        rls::EncodeRlsMessage(msg, stream);
         for (auto &ue : m_ueMap)
-            send(ue.first, msg);
+            m_server->Send(ue.second.address, stream.data(), static_cast<size_t>(stream.length()));
         return;
     }
 
@@ -195,7 +243,11 @@ void RlsUdpTask::send(int ueId, const rls::RlsMessage &msg)
         return;
     }
 
-    sendRlsPdu(m_ueMap[ueId].address, msg);
+    auto &ue = m_ueMap[ueId];
+    if (ue.peerHandle != 0 && rls::IsCompactFramingApplicable(msg))
+        sendCompactData(ue.address, ue.peerHandle, (const rls::RlsPduTransmission &)msg);
+    else
+        sendRlsPdu(ue.address, msg);
 }
 
 } // namespace nr::gnb
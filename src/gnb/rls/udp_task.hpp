@@ -13,6 +13,7 @@
 #include <vector>
 
 #include <gnb/types.hpp>
+#include <lib/rls/propagation.hpp>
 #include <lib/rls/rls_pdu.hpp>
 #include <lib/udp/server.hpp>
 #include <utils/nts.hpp>
@@ -28,6 +29,7 @@ class RlsUdpTask : public NtsTask
         uint64_t sti{};
         InetAddress address;
         int64_t lastSeen{};
+        uint32_t peerHandle{}; // Handle of this cell at the UE, used for compact framing
     };
 
   private:
@@ -36,6 +38,7 @@ class RlsUdpTask : public NtsTask
     NtsTask *m_ctlTask;
     uint64_t m_sti;
     Vector3 m_phyLocation;
+    rls::PropagationModel m_propagation;
     int64_t m_lastLoop;
     std::unordered_map<uint64_t, int> m_stiToUe;
     std::unordered_map<int, UeInfo> m_ueMap;
@@ -52,7 +55,9 @@ class RlsUdpTask : public NtsTask
 
   private:
     void receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::RlsMessage> &&msg);
+    void receiveCompactData(const InetAddress &addr, const OctetView &stream);
     void sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg);
+    void sendCompactData(const InetAddress &addr, uint32_t handle, const rls::RlsPduTransmission &msg);
     void heartbeatCycle(int64_t time);
 
   public:
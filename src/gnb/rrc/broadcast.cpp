@@ -108,15 +108,39 @@ void GnbRrcTask::onBroadcastTimerExpired()
 }
 
 void GnbRrcTask::triggerSysInfoBroadcast()
+{
+    if (!m_sysInfoValid)
+        encodeSysInfo();
+
+    if (m_mibPdu.length() > 0)
+        sendBroadcastPdu(rrc::RrcChannel::BCCH_BCH, m_mibPdu);
+    if (m_sib1Pdu.length() > 0)
+        sendBroadcastPdu(rrc::RrcChannel::BCCH_DL_SCH, m_sib1Pdu);
+}
+
+void GnbRrcTask::invalidateSysInfo()
+{
+    m_sysInfoValid = false;
+}
+
+void GnbRrcTask::encodeSysInfo()
 {
     auto *mib = ConstructMibMessage(m_isBarred, m_intraFreqReselectAllowed);
     auto *sib1 = ConstructSib1Message(m_cellReserved, m_config->tac, m_config->nci, m_config->plmn, m_aiBarringSet);
 
-    sendRrcMessage(mib);
-    sendRrcMessage(sib1);
+    m_mibPdu = rrc::encode::EncodeS(asn_DEF_ASN_RRC_BCCH_BCH_Message, mib);
+    m_sib1Pdu = rrc::encode::EncodeS(asn_DEF_ASN_RRC_BCCH_DL_SCH_Message, sib1);
 
     asn::Free(asn_DEF_ASN_RRC_BCCH_BCH_Message, mib);
     asn::Free(asn_DEF_ASN_RRC_BCCH_DL_SCH_Message, sib1);
+
+    if (m_mibPdu.length() == 0)
+        m_logger->err("RRC BCCH-BCH encoding failed.");
+    if (m_sib1Pdu.length() == 0)
+        m_logger->err("RRC BCCH-DL-SCH encoding failed.");
+
+    // Failed encodings are retried on the next broadcast
+    m_sysInfoValid = m_mibPdu.length() > 0 && m_sib1Pdu.length() > 0;
 }
 
 } // namespace nr::gnb
\ No newline at end of file
@@ -19,6 +19,9 @@ namespace nr::gnb
 
 void GnbRrcTask::handleUplinkRrc(int ueId, rrc::RrcChannel channel, const OctetString &rrcPdu)
 {
+    // The received PDU, and the responses built by the handlers are all released at the end of this function
+    asn::ArenaScope arenaScope{m_asnArena};
+
     switch (channel)
     {
     case rrc::RrcChannel::BCCH_BCH: {
@@ -65,35 +68,12 @@ void GnbRrcTask::handleUplinkRrc(int ueId, rrc::RrcChannel channel, const OctetS
     }
 }
 
-void GnbRrcTask::sendRrcMessage(ASN_RRC_BCCH_BCH_Message *msg)
+void GnbRrcTask::sendBroadcastPdu(rrc::RrcChannel channel, const OctetString &pdu)
 {
-    OctetString pdu = rrc::encode::EncodeS(asn_DEF_ASN_RRC_BCCH_BCH_Message, msg);
-    if (pdu.length() == 0)
-    {
-        m_logger->err("RRC BCCH-BCH encoding failed.");
-        return;
-    }
-
     auto *w = new NmGnbRrcToRls(NmGnbRrcToRls::RRC_PDU_DELIVERY);
     w->ueId = 0;
-    w->channel = rrc::RrcChannel::BCCH_BCH;
-    w->pdu = std::move(pdu);
-    m_base->rlsTask->push(w);
-}
-
-void GnbRrcTask::sendRrcMessage(ASN_RRC_BCCH_DL_SCH_Message *msg)
-{
-    OctetString pdu = rrc::encode::EncodeS(asn_DEF_ASN_RRC_BCCH_DL_SCH_Message, msg);
-    if (pdu.length() == 0)
-    {
-        m_logger->err("RRC BCCH-DL-SCH encoding failed.");
-        return;
-    }
-
-    auto *w = new NmGnbRrcToRls(NmGnbRrcToRls::RRC_PDU_DELIVERY);
-    w->ueId = 0;
-    w->channel = rrc::RrcChannel::BCCH_DL_SCH;
-    w->pdu = std::move(pdu);
+    w->channel = channel;
+    w->pdu = pdu.copy();
     m_base->rlsTask->push(w);
 }
 
@@ -9,7 +9,9 @@
 #include "task.hpp"
 
 #include <gnb/ngap/task.hpp>
+#include <lib/asn/rrc.hpp>
 #include <lib/rrc/encode.hpp>
+#include <utils/metrics.hpp>
 
 #include <asn/ngap/ASN_NGAP_FiveG-S-TMSI.h>
 #include <asn/rrc/ASN_RRC_BCCH-BCH-Message.h>
@@ -23,6 +25,8 @@
 #include <asn/rrc/ASN_RRC_Paging.h>
 #include <asn/rrc/ASN_RRC_PagingRecord.h>
 #include <asn/rrc/ASN_RRC_PagingRecordList.h>
+#include <asn/rrc/ASN_RRC_RegisteredAMF.h>
+#include <asn/rrc/ASN_RRC_S-NSSAI.h>
 #include <asn/rrc/ASN_RRC_RRCRelease-IEs.h>
 #include <asn/rrc/ASN_RRC_RRCRelease.h>
 #include <asn/rrc/ASN_RRC_RRCSetup-IEs.h>
@@ -36,11 +40,19 @@
 #include <asn/rrc/ASN_RRC_ULInformationTransfer-IEs.h>
 #include <asn/rrc/ASN_RRC_ULInformationTransfer.h>
 
+static auto &g_setupRequests =
+    metrics::Registry::Instance().counter("rrc_setup_requests_total", "RRC Setup Requests received from UEs");
+static auto &g_setupsSent = metrics::Registry::Instance().counter("rrc_setups_sent_total", "RRC Setups sent to UEs");
+static auto &g_setupsCompleted =
+    metrics::Registry::Instance().counter("rrc_setups_completed_total", "RRC Setup Completes received from UEs");
+
 namespace nr::gnb
 {
 
 void GnbRrcTask::receiveRrcSetupRequest(int ueId, const ASN_RRC_RRCSetupRequest &msg)
 {
+    g_setupRequests.inc();
+
     auto *ue = tryFindUe(ueId);
     if (ue)
     {
@@ -89,6 +101,7 @@ void GnbRrcTask::receiveRrcSetupRequest(int ueId, const ASN_RRC_RRCSetupRequest
                         rrc::encode::EncodeS(asn_DEF_ASN_RRC_CellGroupConfig, &masterCellGroup));
 
     m_logger->info("RRC Setup for UE[%d]", ueId);
+    g_setupsSent.inc();
     sendRrcMessage(ueId, pdu);
 }
 
@@ -98,12 +111,47 @@ void GnbRrcTask::receiveRrcSetupComplete(int ueId, const ASN_RRC_RRCSetupComplet
     if (!ue)
         return;
 
+    g_setupsCompleted.inc();
+
     auto setupComplete = msg.criticalExtensions.choice.rrcSetupComplete;
 
     auto *w = new NmGnbRrcToNgap(NmGnbRrcToNgap::INITIAL_NAS_DELIVERY);
     w->ueId = ueId;
     w->pdu = asn::GetOctetString(setupComplete->dedicatedNAS_Message);
     w->rrcEstablishmentCause = ue->establishmentCause;
+
+    // Optional information for the AMF selection
+    if (setupComplete->registeredAMF)
+    {
+        int amfId = asn::GetBitStringInt<24>(setupComplete->registeredAMF->amf_Identifier);
+
+        Guami guami{};
+        guami.plmn = setupComplete->registeredAMF->plmn_Identity
+                         ? asn::rrc::GetPlmnId(*setupComplete->registeredAMF->plmn_Identity)
+                         : m_config->plmn;
+        guami.amfRegionId = (amfId >> 16) & 0xFF;
+        guami.amfSetId = (amfId >> 6) & 0x3FF;
+        guami.amfPointer = amfId & 0x3F;
+        w->registeredAmf = guami;
+    }
+    if (setupComplete->s_NSSAI_List)
+    {
+        asn::ForeachItem(*setupComplete->s_NSSAI_List, [w](auto &item) {
+            SingleSlice slice{};
+            if (item.present == ASN_RRC_S_NSSAI_PR_sst)
+                slice.sst = static_cast<uint8_t>(asn::GetBitStringInt<8>(item.choice.sst));
+            else if (item.present == ASN_RRC_S_NSSAI_PR_sst_SD)
+            {
+                int64_t value = asn::GetBitStringLong<32>(item.choice.sst_SD);
+                slice.sst = static_cast<uint8_t>((value >> 24) & 0xFF);
+                slice.sd = octet3{static_cast<int>(value & 0xFFFFFF)};
+            }
+            else
+                return;
+            w->requestedNssai.addIfNotExists(slice);
+        });
+    }
+
     m_base->ngapTask->push(w);
 }
 
@@ -21,9 +21,9 @@ static constexpr const int TIMER_PERIOD_SI_BROADCAST = 10'000;
 namespace nr::gnb
 {
 
-GnbRrcTask::GnbRrcTask(TaskBase *base) : m_base{base}, m_ueCtx{}, m_tidCounter{}
+GnbRrcTask::GnbRrcTask(TaskBase *base) : m_base{base}, m_ueCtx{}, m_tidCounter{}, m_asnArena{}
 {
-    m_logger = base->logBase->makeUniqueLogger("rrc");
+    m_logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "rrc");
     m_config = m_base->config;
 }
 
@@ -55,6 +55,7 @@ void GnbRrcTask::onLoop()
         {
         case NmGnbNgapToRrc::RADIO_POWER_ON: {
             m_isBarred = false;
+            invalidateSysInfo();
             triggerSysInfoBroadcast();
             break;
         }
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include <gnb/nts.hpp>
+#include <lib/asn/arena.hpp>
 #include <utils/logger.hpp>
 #include <utils/nts.hpp>
 
@@ -47,12 +48,18 @@ class GnbRrcTask : public NtsTask
 
     std::unordered_map<int, RrcUeContext *> m_ueCtx;
     int m_tidCounter;
+    asn::Arena m_asnArena; // Received PDUs and the PDUs built while handling them
 
     bool m_isBarred = true;
     bool m_cellReserved = false;
     UacAiBarringSet m_aiBarringSet = {};
     bool m_intraFreqReselectAllowed = true;
 
+    /* Encoded system information, rebuilt only when the content above changes */
+    OctetString m_mibPdu{};
+    OctetString m_sib1Pdu{};
+    bool m_sysInfoValid = false;
+
     friend class GnbCmdHandler;
 
   public:
@@ -82,8 +89,7 @@ class GnbRrcTask : public NtsTask
     void receiveUplinkInformationTransfer(int ueId, const ASN_RRC_ULInformationTransfer &msg);
 
     /* RRC channel send message */
-    void sendRrcMessage(ASN_RRC_BCCH_BCH_Message *msg);
-    void sendRrcMessage(ASN_RRC_BCCH_DL_SCH_Message *msg);
+    void sendBroadcastPdu(rrc::RrcChannel channel, const OctetString &pdu);
     void sendRrcMessage(int ueId, ASN_RRC_DL_CCCH_Message *msg);
     void sendRrcMessage(int ueId, ASN_RRC_DL_DCCH_Message *msg);
     void sendRrcMessage(ASN_RRC_PCCH_Message *msg);
@@ -97,6 +103,8 @@ class GnbRrcTask : public NtsTask
     /* System Information Broadcast related */
     void onBroadcastTimerExpired();
     void triggerSysInfoBroadcast();
+    void invalidateSysInfo();
+    void encodeSysInfo();
 
     /* Service Access Point */
     void handleRlsSapMessage(NmGnbRlsToRrc &msg);
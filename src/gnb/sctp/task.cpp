@@ -8,12 +8,21 @@
 
 #include "task.hpp"
 
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
-#include <thread>
 #include <utility>
 
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 // #define MOCKED_PACKETS
 
+static constexpr const int MAX_EPOLL_EVENTS = 64;
+static constexpr const int EPOLL_TIMEOUT = 100;
+static constexpr const int MAX_RECEIVE_BATCH = 64; // Per association and loop, so that one AMF cannot starve the others
+
 #ifdef MOCKED_PACKETS
 static std::string MOCK_LIST[] = {
     std::string(
@@ -55,19 +64,12 @@ class SctpHandler : public sctp::ISctpHandler
   private:
     void onAssociationSetup(int associationId, int inStreams, int outStreams) override
     {
-        auto *w = new NmGnbSctp(NmGnbSctp::ASSOCIATION_SETUP);
-        w->clientId = clientId;
-        w->associationId = associationId;
-        w->inStreams = inStreams;
-        w->outStreams = outStreams;
-        sctpTask->push(w);
+        sctpTask->receiveAssociationSetup(clientId, associationId, inStreams, outStreams);
     }
 
     void onAssociationShutdown() override
     {
-        auto *w = new NmGnbSctp(NmGnbSctp::ASSOCIATION_SHUTDOWN);
-        w->clientId = clientId;
-        sctpTask->push(w);
+        sctpTask->receiveAssociationShutdown(clientId);
     }
 
     void onMessage(const uint8_t *buffer, size_t length, uint16_t stream) override
@@ -75,94 +77,115 @@ class SctpHandler : public sctp::ISctpHandler
         auto *data = new uint8_t[length];
         std::memcpy(data, buffer, length);
 
-        auto *w = new NmGnbSctp(NmGnbSctp::RECEIVE_MESSAGE);
-        w->clientId = clientId;
-        w->buffer = UniqueBuffer{data, length};
-        w->stream = stream;
-        sctpTask->push(w);
+        sctpTask->receiveClientReceive(clientId, stream, UniqueBuffer{data, length});
     }
 
     void onUnhandledNotification() override
     {
-        auto *w = new NmGnbSctp(NmGnbSctp::UNHANDLED_NOTIFICATION);
-        w->clientId = clientId;
-        sctpTask->push(w);
+        sctpTask->receiveUnhandledNotification(clientId);
     }
 };
 
-[[noreturn]] static void ReceiverThread(std::pair<sctp::SctpClient *, sctp::ISctpHandler *> *args)
-{
-    sctp::SctpClient *client = args->first;
-    sctp::ISctpHandler *handler = args->second;
-
-    delete args;
-
-    while (true)
-        client->receive(handler);
-}
-
-SctpTask::SctpTask(TaskBase *base) : m_base{base}, m_clients{}
+SctpTask::SctpTask(LogBase *logBase)
+    : m_clients{}, m_sockets{}, m_epollFd{-1}, m_wakeFd{-1}, m_outboxMutex{}, m_outbox{}, m_sending{}
 {
-    m_logger = base->logBase->makeUniqueLogger("sctp");
+    m_logger = logBase->makeUniqueLogger("sctp");
 }
 
 void SctpTask::onStart()
 {
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epollFd < 0 || m_wakeFd < 0)
+    {
+        m_logger->err("SCTP event loop could not be created: %s", strerror(errno));
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = m_wakeFd;
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &ev) < 0)
+        m_logger->err("SCTP event loop could not be created: %s", strerror(errno));
 }
 
 void SctpTask::onLoop()
 {
-    NtsMessage *msg = take();
-    if (!msg)
-        return;
+    // Control messages are only polled here, the task waits on epoll instead
+    NtsMessage *msg = poll();
+    bool hadMessage = msg != nullptr;
 
-    switch (msg->msgType)
+    if (msg)
     {
-    case NtsMessageType::GNB_SCTP: {
-        auto *w = dynamic_cast<NmGnbSctp *>(msg);
-        switch (w->present)
+        switch (msg->msgType)
         {
-        case NmGnbSctp::CONNECTION_REQUEST: {
-            receiveSctpConnectionSetupRequest(w->clientId, w->localAddress, w->localPort, w->remoteAddress,
-                                              w->remotePort, w->ppid, w->associatedTask);
-            break;
-        }
-        case NmGnbSctp::CONNECTION_CLOSE: {
-            receiveConnectionClose(w->clientId);
-            break;
-        }
-        case NmGnbSctp::ASSOCIATION_SETUP: {
-            receiveAssociationSetup(w->clientId, w->associationId, w->inStreams, w->outStreams);
-            break;
-        }
-        case NmGnbSctp::ASSOCIATION_SHUTDOWN: {
-            receiveAssociationShutdown(w->clientId);
-            break;
-        }
-        case NmGnbSctp::RECEIVE_MESSAGE: {
-            receiveClientReceive(w->clientId, w->stream, std::move(w->buffer));
-            break;
-        }
-        case NmGnbSctp::SEND_MESSAGE: {
-            receiveSendMessage(w->clientId, w->stream, std::move(w->buffer));
-            break;
-        }
-        case NmGnbSctp::UNHANDLED_NOTIFICATION: {
-            receiveUnhandledNotification(w->clientId);
+        case NtsMessageType::GNB_SCTP: {
+            auto *w = dynamic_cast<NmGnbSctp *>(msg);
+            switch (w->present)
+            {
+            case NmGnbSctp::CONNECTION_REQUEST: {
+                receiveSctpConnectionSetupRequest(w->clientId, w->localAddress, w->localPort, w->remoteAddress,
+                                                  w->remotePort, w->ppid, w->associatedTask);
+                break;
+            }
+            case NmGnbSctp::CONNECTION_CLOSE: {
+                receiveConnectionClose(w->clientId);
+                break;
+            }
+            case NmGnbSctp::SEND_MESSAGE: {
+                receiveSendMessage(w->clientId, w->stream, std::move(w->buffer));
+                break;
+            }
+            default:
+                m_logger->unhandledNts(msg);
+                break;
+            }
             break;
         }
         default:
             m_logger->unhandledNts(msg);
             break;
         }
-        break;
+
+        delete msg;
     }
-    default:
-        m_logger->unhandledNts(msg);
-        break;
+
+    flushOutbox();
+
+    if (m_epollFd < 0)
+        return;
+
+    epoll_event events[MAX_EPOLL_EVENTS];
+    int n = epoll_wait(m_epollFd, events, MAX_EPOLL_EVENTS, hadMessage ? 0 : EPOLL_TIMEOUT);
+    if (n < 0)
+    {
+        if (errno != EINTR)
+            m_logger->err("SCTP event loop failure: %s", strerror(errno));
+        return;
     }
 
-    delete msg;
+    for (int i = 0; i < n; i++)
+    {
+        int fd = events[i].data.fd;
+        if (fd == m_wakeFd)
+        {
+            uint64_t value;
+            while (read(m_wakeFd, &value, sizeof(value)) > 0)
+            {
+            }
+            flushOutbox();
+            continue;
+        }
+
+        // The entry may be removed by an earlier event of the same batch, therefore it is looked up for each event
+        auto it = m_sockets.find(fd);
+        if (it != m_sockets.end() && (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)))
+            receiveReadable(it->second);
+
+        it = m_sockets.find(fd);
+        if (it != m_sockets.end() && (events[i].events & EPOLLOUT))
+            flushPending(it->second);
+    }
 }
 
 void SctpTask::onQuit()
@@ -170,20 +193,140 @@ void SctpTask::onQuit()
     for (auto &client : m_clients)
     {
         ClientEntry *entry = client.second;
-        DeleteClientEntry(entry);
+        if (entry != nullptr)
+            DeleteClientEntry(entry);
     }
     m_clients.clear();
+    m_sockets.clear();
+
+    if (m_wakeFd >= 0)
+        close(m_wakeFd);
+    if (m_epollFd >= 0)
+        close(m_epollFd);
 }
 
 void SctpTask::DeleteClientEntry(ClientEntry *entry)
 {
     entry->associatedTask = nullptr;
-    delete entry->receiverThread;
     delete entry->client;
     delete entry->handler;
     delete entry;
 }
 
+void SctpTask::sendMessage(int clientId, uint16_t stream, UniqueBuffer &&buffer)
+{
+    bool wasEmpty;
+    {
+        std::lock_guard<std::mutex> lock(m_outboxMutex);
+        wasEmpty = m_outbox.empty();
+        m_outbox.push_back(OutgoingMessage{clientId, stream, std::move(buffer)});
+    }
+
+    // A single wake-up is enough for the whole batch
+    if (wasEmpty && m_wakeFd >= 0)
+    {
+        uint64_t value = 1;
+        if (write(m_wakeFd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+            m_logger->err("SCTP event loop wake-up failed: %s", strerror(errno));
+    }
+}
+
+void SctpTask::flushOutbox()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_outboxMutex);
+        if (m_outbox.empty())
+            return;
+        std::swap(m_outbox, m_sending);
+    }
+
+    for (auto &msg : m_sending)
+        receiveSendMessage(msg.clientId, msg.stream, std::move(msg.buffer));
+    m_sending.clear();
+}
+
+void SctpTask::flushPending(ClientEntry *entry)
+{
+    try
+    {
+        while (!entry->pending.empty())
+        {
+            auto &msg = entry->pending.front();
+            if (!entry->client->trySend(msg.stream, msg.buffer.data(), msg.buffer.size()))
+                return; // Still full, wait for the next EPOLLOUT
+
+            auto &stats = GetStreamStats(entry, msg.stream);
+            stats.queued--;
+            stats.sent++;
+            entry->pending.pop_front();
+        }
+    }
+    catch (const sctp::SctpError &exc)
+    {
+        m_logger->err("SCTP send failed (clientId: %d). %s", entry->id, exc.what());
+        removeClient(entry, true);
+        return;
+    }
+
+    watchWritable(entry, false);
+}
+
+void SctpTask::receiveReadable(ClientEntry *entry)
+{
+    try
+    {
+        for (int i = 0; i < MAX_RECEIVE_BATCH; i++)
+        {
+            // The association may be shut down by a notification received in this batch
+            if (m_sockets.count(entry->client->getSocket()) == 0)
+                return;
+            if (!entry->client->receive(entry->handler))
+                return;
+        }
+    }
+    catch (const sctp::SctpError &exc)
+    {
+        m_logger->err("SCTP receive failed (clientId: %d). %s", entry->id, exc.what());
+        removeClient(entry, true);
+    }
+}
+
+void SctpTask::watchWritable(ClientEntry *entry, bool enable)
+{
+    if (entry->waitingWritable == enable)
+        return;
+
+    epoll_event ev{};
+    ev.events = EPOLLIN | (enable ? EPOLLOUT : 0u);
+    ev.data.fd = entry->client->getSocket();
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_MOD, ev.data.fd, &ev) < 0)
+    {
+        m_logger->err("SCTP event loop failure: %s", strerror(errno));
+        return;
+    }
+
+    entry->waitingWritable = enable;
+}
+
+void SctpTask::removeClient(ClientEntry *entry, bool notifyShutdown)
+{
+    int sd = entry->client->getSocket();
+    if (m_sockets.erase(sd) == 0)
+        return;
+
+    epoll_ctl(m_epollFd, EPOLL_CTL_DEL, sd, nullptr);
+    entry->pending.clear();
+    entry->waitingWritable = false;
+
+    // The entry itself is deleted upon CONNECTION_CLOSE from the associated task
+    if (notifyShutdown)
+    {
+        auto *msg = new NmGnbSctp(NmGnbSctp::ASSOCIATION_SHUTDOWN);
+        msg->clientId = entry->id;
+        entry->associatedTask->push(msg);
+    }
+}
+
 void SctpTask::receiveSctpConnectionSetupRequest(int clientId, const std::string &localAddress, uint16_t localPort,
                                                  const std::string &remoteAddress, uint16_t remotePort,
                                                  sctp::PayloadProtocolId ppid, NtsTask *associatedTask)
@@ -206,6 +349,7 @@ void SctpTask::receiveSctpConnectionSetupRequest(int clientId, const std::string
     try
     {
         client->connect(remoteAddress, remotePort);
+        client->setNonBlocking();
     }
     catch (const sctp::SctpError &exc)
     {
@@ -214,20 +358,29 @@ void SctpTask::receiveSctpConnectionSetupRequest(int clientId, const std::string
         return;
     }
 
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = client->getSocket();
+    if (m_epollFd < 0 || epoll_ctl(m_epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) < 0)
+    {
+        m_logger->err("SCTP socket could not be registered: %s", strerror(errno));
+        delete client;
+        return;
+    }
+
     m_logger->info("SCTP connection established (%s:%d)", remoteAddress.c_str(), remotePort);
 
     sctp::ISctpHandler *handler = new SctpHandler(this, clientId);
 
     auto *entry = new ClientEntry;
     m_clients[clientId] = entry;
+    m_sockets[client->getSocket()] = entry;
 
     entry->id = clientId;
     entry->client = client;
     entry->handler = handler;
     entry->associatedTask = associatedTask;
-    entry->receiverThread = new ScopedThread(
-        [](void *arg) { ReceiverThread(reinterpret_cast<std::pair<sctp::SctpClient *, sctp::ISctpHandler *> *>(arg)); },
-        new std::pair<sctp::SctpClient *, sctp::ISctpHandler *>(client, handler));
+    entry->waitingWritable = false;
 }
 
 void SctpTask::receiveAssociationSetup(int clientId, int associationId, int inStreams, int outStreams)
@@ -241,6 +394,8 @@ void SctpTask::receiveAssociationSetup(int clientId, int associationId, int inSt
         return;
     }
 
+    entry->streams.resize(static_cast<size_t>(std::max(outStreams, 1)));
+
     // Notify the relevant task
     auto *msg = new NmGnbSctp(NmGnbSctp::ASSOCIATION_SETUP);
     msg->clientId = clientId;
@@ -261,10 +416,8 @@ void SctpTask::receiveAssociationShutdown(int clientId)
         return;
     }
 
-    // Notify the relevant task
-    auto *msg = new NmGnbSctp(NmGnbSctp::ASSOCIATION_SHUTDOWN);
-    msg->clientId = clientId;
-    entry->associatedTask->push(msg);
+    // Stop watching the socket, and notify the relevant task
+    removeClient(entry, true);
 }
 
 void SctpTask::receiveClientReceive(int clientId, uint16_t stream, UniqueBuffer &&buffer)
@@ -302,28 +455,85 @@ void SctpTask::receiveConnectionClose(int clientId)
         return;
     }
 
+    removeClient(entry, false);
+    m_clients.erase(clientId);
     DeleteClientEntry(entry);
 }
 
+SctpTask::StreamStats &SctpTask::GetStreamStats(ClientEntry *entry, uint16_t stream)
+{
+    if (stream >= entry->streams.size())
+        entry->streams.resize(static_cast<size_t>(stream) + 1);
+    return entry->streams[stream];
+}
+
+Json SctpTask::getStreamStatus(int clientId)
+{
+    auto it = m_clients.find(clientId);
+    if (it == m_clients.end() || it->second == nullptr)
+        return Json::Arr({});
+
+    Json json = Json::Arr({});
+    auto &streams = it->second->streams;
+    for (size_t i = 0; i < streams.size(); i++)
+    {
+        json.push(Json::Obj({
+            {"stream", static_cast<int>(i)},
+            {"queued", streams[i].queued},
+            {"max-queued", streams[i].maxQueued},
+            {"sent", streams[i].sent},
+        }));
+    }
+    return json;
+}
+
 void SctpTask::receiveSendMessage(int clientId, uint16_t stream, UniqueBuffer &&buffer)
 {
-    ClientEntry *entry = m_clients[clientId];
-    if (entry == nullptr)
+    auto it = m_clients.find(clientId);
+    if (it == m_clients.end() || it->second == nullptr)
     {
         m_logger->warn("Client entry not found for id: %d", clientId);
         return;
     }
 
+    ClientEntry *entry = it->second;
+    if (m_sockets.count(entry->client->getSocket()) == 0)
+        return; // Association is already down, waiting for CONNECTION_CLOSE
+
 #ifdef MOCKED_PACKETS
     {
         std::string ss = MOCK_LIST[++MOCK_INDEX];
         OctetString data = OctetString::FromHex(ss);
         auto *copy = new uint8_t[data.length()];
         std::memcpy(copy, data.data(), data.length());
-        receiveClientReceive(clientId, 0, copy, data.length());
+        receiveClientReceive(clientId, 0, UniqueBuffer{copy, static_cast<size_t>(data.length())});
     }
 #else
-    entry->client->send(stream, buffer.data(), 0, buffer.size());
+    // Keep the order of the messages, if there are already pending ones
+    if (entry->pending.empty())
+    {
+        try
+        {
+            if (entry->client->trySend(stream, buffer.data(), buffer.size()))
+            {
+                GetStreamStats(entry, stream).sent++;
+                return;
+            }
+        }
+        catch (const sctp::SctpError &exc)
+        {
+            m_logger->err("SCTP send failed (clientId: %d). %s", clientId, exc.what());
+            removeClient(entry, true);
+            return;
+        }
+    }
+
+    auto &stats = GetStreamStats(entry, stream);
+    stats.queued++;
+    stats.maxQueued = std::max(stats.maxQueued, stats.queued);
+
+    entry->pending.push_back(PendingMessage{stream, std::move(buffer)});
+    watchWritable(entry, true);
 #endif
 }
 
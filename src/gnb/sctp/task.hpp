@@ -8,41 +8,81 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
-#include <thread>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include <gnb/nts.hpp>
 #include <lib/sctp/sctp.hpp>
+#include <utils/json.hpp>
 #include <utils/logger.hpp>
 #include <utils/nts.hpp>
-#include <utils/scoped_thread.hpp>
+#include <utils/unique_buffer.hpp>
 
 namespace nr::gnb
 {
 
+/**
+ * All the SCTP associations of the gNB are served by this single task. The sockets are non-blocking and multiplexed
+ * with epoll, instead of a receiver thread per association.
+ * <p>
+ * The task is not bound to a gNB, in multi-gNB mode a single instance serves the associations of all the simulated gNBs.
+ * Received messages are delivered to the associated task directly. Outgoing messages are queued by sendMessage() from
+ * any thread and written by this task in batches. A message that does not fit in the socket buffer is kept in the
+ * pending queue of the association, and sent when the socket becomes writable again.
+ */
 class SctpTask : public NtsTask
 {
   private:
+    struct OutgoingMessage
+    {
+        int clientId;
+        uint16_t stream;
+        UniqueBuffer buffer;
+    };
+
+    struct PendingMessage
+    {
+        uint16_t stream;
+        UniqueBuffer buffer;
+    };
+
+    struct StreamStats
+    {
+        int queued{};    // Messages waiting in the pending queue
+        int maxQueued{}; // High-water mark of the pending queue
+        int64_t sent{};
+    };
+
     struct ClientEntry
     {
         int id;
         sctp::SctpClient *client;
-        ScopedThread *receiverThread;
         sctp::ISctpHandler *handler;
         NtsTask *associatedTask;
+        std::deque<PendingMessage> pending;
+        bool waitingWritable;
+        std::vector<StreamStats> streams;
     };
 
   private:
-    TaskBase *m_base;
     std::unique_ptr<Logger> m_logger;
     std::unordered_map<int, ClientEntry *> m_clients;
+    std::unordered_map<int, ClientEntry *> m_sockets;
+    int m_epollFd;
+    int m_wakeFd;
+
+    std::mutex m_outboxMutex;
+    std::vector<OutgoingMessage> m_outbox;
+    std::vector<OutgoingMessage> m_sending;
 
     friend class GnbCmdHandler;
+    friend class SctpHandler;
 
   public:
-    explicit SctpTask(TaskBase *base);
+    explicit SctpTask(LogBase *logBase);
     ~SctpTask() override = default;
 
   protected:
@@ -53,6 +93,14 @@ class SctpTask : public NtsTask
   private:
     static void DeleteClientEntry(ClientEntry *entry);
 
+  private:
+    void flushOutbox();
+    void flushPending(ClientEntry *entry);
+    void receiveReadable(ClientEntry *entry);
+    void watchWritable(ClientEntry *entry, bool enable);
+    void removeClient(ClientEntry *entry, bool notifyShutdown);
+    static StreamStats &GetStreamStats(ClientEntry *entry, uint16_t stream);
+
   private:
     void receiveSctpConnectionSetupRequest(int clientId, const std::string &localAddress, uint16_t localPort,
                                            const std::string &remoteAddress, uint16_t remotePort,
@@ -63,6 +111,13 @@ class SctpTask : public NtsTask
     void receiveUnhandledNotification(int clientId);
     void receiveConnectionClose(int clientId);
     void receiveSendMessage(int clientId, uint16_t stream, UniqueBuffer &&buffer);
+
+  public:
+    /* Thread-safe, the message is written to the association by the SCTP task */
+    void sendMessage(int clientId, uint16_t stream, UniqueBuffer &&buffer);
+
+    /* Per-stream statistics of the association. The task must be paused while this is called. */
+    Json getStreamStatus(int clientId);
 };
 
 } // namespace nr::gnb
\ No newline at end of file
@@ -30,6 +30,7 @@ Json ToJson(const GnbConfig &v)
         {"gtp-ip", v.gtpIp},
         {"paging-drx", ToJson(v.pagingDrx)},
         {"ignore-sctp-id", v.ignoreStreamIds},
+        {"check-asn-constraints", v.checkAsnConstraints},
     });
 }
 
@@ -41,6 +42,12 @@ Json ToJson(const NgapAmfContext &v)
         {"address", v.address + ":" + std::to_string(v.port)},
         {"state", ToJson(v.state).str()},
         {"capacity", v.relativeCapacity},
+        {"load", Json::Obj({
+                     {"active-ue", v.activeUes},
+                     {"selections", v.selections},
+                     {"diverted-by-overload", v.divertedByOverload},
+                 })},
+        {"overload", ToJson(v.overloadInfo)},
         {"association", ToJson(v.association)},
         {"served-guami", ::ToJson(v.servedGuamiList)},
         {"served-plmn", ::ToJson(v.plmnSupportList)},
@@ -62,6 +69,35 @@ Json ToJson(const EAmfState &v)
     }
 }
 
+Json ToJson(const OverloadInfo &v)
+{
+    if (v.status == EOverloadStatus::NOT_OVERLOADED)
+        return "NOT_OVERLOADED";
+    return Json::Obj({
+        {"action", ToJson(v.indication.action)},
+        {"load-reduction", v.indication.loadReductionPerc},
+    });
+}
+
+Json ToJson(const EOverloadAction &v)
+{
+    switch (v)
+    {
+    case EOverloadAction::UNSPECIFIED_OVERLOAD:
+        return "UNSPECIFIED";
+    case EOverloadAction::REJECT_NON_EMERGENCY_MO_DATA:
+        return "REJECT_NON_EMERGENCY_MO_DATA";
+    case EOverloadAction::REJECT_SIGNALLING:
+        return "REJECT_SIGNALLING";
+    case EOverloadAction::ONLY_EMERGENCY_AND_MT:
+        return "ONLY_EMERGENCY_AND_MT";
+    case EOverloadAction::ONLY_HIGH_PRI_AND_MT:
+        return "ONLY_HIGH_PRI_AND_MT";
+    default:
+        return "?";
+    }
+}
+
 Json ToJson(const EPagingDrx &v)
 {
     switch (v)
@@ -10,6 +10,8 @@
 
 #include <lib/app/monitor.hpp>
 #include <lib/asn/utils.hpp>
+#include <lib/rls/propagation.hpp>
+#include <lib/rls/rls_arq.hpp>
 #include <utils/common_types.hpp>
 #include <utils/logger.hpp>
 #include <utils/network.hpp>
@@ -28,6 +30,7 @@ class NgapTask;
 class GnbRrcTask;
 class GnbRlsTask;
 class SctpTask;
+class SharedGtpServer;
 
 enum class EAmfState
 {
@@ -57,8 +60,6 @@ struct ServedGuami
     std::string backupAmfName{};
 };
 
-// TODO: update cli and json for overload related types
-
 enum class EOverloadAction
 {
     UNSPECIFIED_OVERLOAD,
@@ -87,13 +88,15 @@ struct OverloadInfo
 
     EOverloadStatus status{};
     Indication indication{};
+
+    // Accumulated percentage of the traffic reduction, a selection is diverted each time it exceeds 100
+    int reductionCredit{};
 };
 
 struct NgapAmfContext
 {
     int ctxId{};
     SctpAssociation association{};
-    int nextStream{}; // next available SCTP stream for uplink
     std::string address{};
     uint16_t port{};
     std::string amfName{};
@@ -102,6 +105,11 @@ struct NgapAmfContext
     OverloadInfo overloadInfo{};
     std::vector<ServedGuami *> servedGuamiList{};
     std::vector<PlmnSupport *> plmnSupportList{};
+
+    /* Load counters, used by the AMF selection */
+    int activeUes{};
+    int64_t selections{};
+    int64_t divertedByOverload{};
 };
 
 struct RlsUeContext
@@ -131,6 +139,7 @@ struct NgapUeContext
     int associatedAmfId{};
     int uplinkStream{};
     int downlinkStream{};
+    long establishmentCause{};
     AggregateMaximumBitRate ueAmbr{};
 
     explicit NgapUeContext(int ctxId) : ctxId(ctxId)
@@ -309,11 +318,16 @@ struct GnbConfig
     std::string gtpIp{};
     std::optional<std::string> gtpAdvertiseIp{};
     bool ignoreStreamIds{};
+    bool checkAsnConstraints{};
+    rls::ArqConfig rlsArq{};
+    rls::PropagationConfig propagation{};
 
     /* Assigned by program */
     std::string name{};
     EPagingDrx pagingDrx{};
     Vector3 phyLocation{};
+    bool prefixLogger{};
+    uint32_t teidBase{}; // First downlink TEID of this gNB, the TEID space is partitioned in multi-gNB mode
 
     [[nodiscard]] inline uint32_t getGnbId() const
     {
@@ -324,6 +338,21 @@ struct GnbConfig
     {
         return static_cast<int>(nci & static_cast<uint64_t>((1 << (36 - gnbIdLength)) - 1));
     }
+
+    [[nodiscard]] std::string getLoggerPrefix() const
+    {
+        if (!prefixLogger)
+            return "";
+        return name + "|";
+    }
+};
+
+/* Resources shared by all the gNBs simulated in the same process (nr-gnb -n) */
+struct GnbSharedBase
+{
+    LogBase *logBase{};
+    SctpTask *sctpTask{};
+    SharedGtpServer *gtpServer{};
 };
 
 struct TaskBase
@@ -332,6 +361,7 @@ struct TaskBase
     LogBase *logBase{};
     app::INodeListener *nodeListener{};
     NtsTask *cliCallbackTask{};
+    GnbSharedBase *shared{};
 
     GnbAppTask *appTask{};
     GtpTask *gtpTask{};
@@ -345,6 +375,8 @@ Json ToJson(const GnbStatusInfo &v);
 Json ToJson(const GnbConfig &v);
 Json ToJson(const NgapAmfContext &v);
 Json ToJson(const EAmfState &v);
+Json ToJson(const OverloadInfo &v);
+Json ToJson(const EOverloadAction &v);
 Json ToJson(const EPagingDrx &v);
 Json ToJson(const SctpAssociation &v);
 Json ToJson(const ServedGuami &v);
@@ -12,11 +12,17 @@
 #include <csignal>
 #include <cstdio>
 #include <exception>
+#include <stdexcept>
 #include <vector>
 
+#include <lib/app/metrics_server.hpp>
+#include <utils/async_log.hpp>
+#include <utils/logger.hpp>
+
 static std::atomic_int g_instanceCount{};
 static std::vector<void (*)()> g_runAtExit{};
 static std::vector<std::string> g_deleteAtExit{};
+static app::MetricsCsvTask *g_metricsCsvTask{};
 
 extern "C" void BaseSignalHandler(int num)
 {
@@ -51,4 +57,44 @@ void DeleteAtExit(const std::string &file)
     g_deleteAtExit.push_back(file);
 }
 
+void ConfigureLogging(const std::optional<std::string> &minLevel, bool async,
+                      const std::optional<std::string> &binaryFile)
+{
+    if (minLevel.has_value())
+    {
+        if (*minLevel == "debug")
+            Logger::SetMinSeverity(Severity::DEBUG);
+        else if (*minLevel == "info")
+            Logger::SetMinSeverity(Severity::INFO);
+        else if (*minLevel == "warn")
+            Logger::SetMinSeverity(Severity::WARN);
+        else if (*minLevel == "error")
+            Logger::SetMinSeverity(Severity::ERR);
+        else
+            throw std::runtime_error("Invalid log level: " + *minLevel);
+    }
+
+    if (binaryFile.has_value())
+        logging::StartAsync(binaryFile);
+    else if (async)
+        logging::StartAsync(std::nullopt);
+}
+
+void StartMetrics(const std::optional<uint16_t> &port, const std::optional<std::string> &csvFile)
+{
+    // The tasks live until the process exits
+    if (port.has_value())
+    {
+        auto *serverTask = new MetricsServerTask(*port);
+        serverTask->start();
+    }
+
+    if (csvFile.has_value())
+    {
+        g_metricsCsvTask = new MetricsCsvTask(*csvFile);
+        g_metricsCsvTask->start();
+        RunAtExit([]() { g_metricsCsvTask->quit(); });
+    }
+}
+
 } // namespace app
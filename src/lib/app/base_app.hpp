@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -21,4 +23,12 @@ void RunAtExit(void (*fun)());
 
 void DeleteAtExit(const std::string &file);
 
+/* Must be called before creating any logger. Throws std::runtime_error if the level is invalid. */
+void ConfigureLogging(const std::optional<std::string> &minLevel, bool async,
+                      const std::optional<std::string> &binaryFile);
+
+/* Starts the Prometheus endpoint on the loopback interface and the periodic CSV dump of the metrics, if given. Throws
+ * LibError if the port cannot be bound or the file cannot be created. */
+void StartMetrics(const std::optional<uint16_t> &port, const std::optional<std::string> &csvFile);
+
 } // namespace app
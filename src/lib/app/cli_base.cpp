@@ -8,6 +8,9 @@
 
 #include "cli_base.hpp"
 
+#include <algorithm>
+
+#include <utils/common.hpp>
 #include <utils/octet_string.hpp>
 #include <utils/octet_view.hpp>
 
@@ -15,6 +18,12 @@
 #define CMD_RCV_TIMEOUT 2500
 #define CMD_MIN_LENGTH (3 + 4 + 4 + 1)
 
+// Leaves room for the header of the message in the client's receive buffer
+#define BULK_MAX_OUTPUT 7168
+// Nodes removed while processing a bulk command never respond, so the command is finished after this inactivity
+#define BULK_INACTIVITY_TIMEOUT 5000
+#define BULK_LISTED_NODES 3
+
 namespace app
 {
 
@@ -67,4 +76,116 @@ void CliServer::sendMessage(const CliMessage &msg)
     m_socket.send(msg.clientAddr, stream.data(), static_cast<size_t>(stream.length()));
 }
 
+void CliResponseTask::onLoop()
+{
+    auto *msg = take();
+    if (msg != nullptr)
+    {
+        if (msg->msgType == NtsMessageType::CLI_SEND_RESPONSE)
+        {
+            receiveResponse(*dynamic_cast<NwCliSendResponse *>(msg));
+        }
+        else if (msg->msgType == NtsMessageType::CLI_BULK_START)
+        {
+            auto *w = dynamic_cast<NwCliBulkStart *>(msg);
+            BulkCommand bulk{};
+            bulk.address = w->address;
+            bulk.nodeCount = w->nodeCount;
+            bulk.stream = w->stream;
+            bulk.lastActivity = utils::CurrentTimeMillis();
+            m_bulks.push_back(std::move(bulk));
+        }
+        delete msg;
+    }
+
+    int64_t now = utils::CurrentTimeMillis();
+    for (size_t i = 0; i < m_bulks.size();)
+    {
+        if (now - m_bulks[i].lastActivity > BULK_INACTIVITY_TIMEOUT)
+            finishBulk(i);
+        else
+            i++;
+    }
+}
+
+void CliResponseTask::receiveResponse(NwCliSendResponse &msg)
+{
+    auto it = std::find_if(m_bulks.begin(), m_bulks.end(),
+                           [&msg](const BulkCommand &bulk) { return bulk.address == msg.address; });
+    if (it == m_bulks.end())
+    {
+        cliServer->sendMessage(msg.isError ? CliMessage::Error(msg.address, msg.output)
+                                           : CliMessage::Result(msg.address, msg.output));
+        return;
+    }
+
+    auto &bulk = *it;
+    bulk.received++;
+    if (msg.isError)
+        bulk.failed++;
+    bulk.lastActivity = utils::CurrentTimeMillis();
+
+    std::string output = msg.isError ? "ERROR: " + msg.output : msg.output;
+
+    if (bulk.stream)
+    {
+        cliServer->sendMessage(CliMessage::Echo(msg.address, "[" + msg.nodeName + "] " + output));
+    }
+    else
+    {
+        auto groupIt = bulk.groupIndex.find(output);
+        if (groupIt == bulk.groupIndex.end())
+        {
+            bulk.groupIndex[output] = bulk.groups.size();
+            bulk.groups.emplace_back(output, std::vector<std::string>{msg.nodeName});
+        }
+        else
+        {
+            bulk.groups[groupIt->second].second.push_back(msg.nodeName);
+        }
+    }
+
+    if (bulk.received >= bulk.nodeCount)
+        finishBulk(static_cast<size_t>(it - m_bulks.begin()));
+}
+
+void CliResponseTask::finishBulk(size_t index)
+{
+    auto &bulk = m_bulks[index];
+
+    int missing = bulk.nodeCount - bulk.received;
+
+    std::string output = std::to_string(bulk.nodeCount) + " node(s): " + std::to_string(bulk.received - bulk.failed) +
+                         " succeeded, " + std::to_string(bulk.failed) + " failed";
+    if (missing > 0)
+        output += ", " + std::to_string(missing) + " did not respond";
+
+    for (size_t i = 0; i < bulk.groups.size(); i++)
+    {
+        auto &nodes = bulk.groups[i].second;
+
+        std::string part = "\n[" + std::to_string(nodes.size()) + " node(s)] ";
+        for (size_t j = 0; j < nodes.size() && j < BULK_LISTED_NODES; j++)
+            part += (j > 0 ? ", " : "") + nodes[j];
+        if (nodes.size() > BULK_LISTED_NODES)
+            part += " and " + std::to_string(nodes.size() - BULK_LISTED_NODES) + " more";
+        part += "\n" + bulk.groups[i].first;
+
+        if (output.size() + part.size() > BULK_MAX_OUTPUT)
+        {
+            output += "\n... " + std::to_string(bulk.groups.size() - i) +
+                      " more distinct output(s) omitted, use --stream to see all";
+            break;
+        }
+        output += part;
+    }
+
+    if (bulk.failed > 0 || missing > 0)
+        cliServer->sendMessage(CliMessage::Error(bulk.address, output));
+    else
+        cliServer->sendMessage(CliMessage::Result(bulk.address, output));
+
+    m_bulks.erase(m_bulks.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
 } // namespace app
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -28,7 +29,8 @@ struct CliMessage
         ECHO,
         ERROR,
         RESULT,
-        COMMAND
+        COMMAND,
+        STREAM_COMMAND, // Command whose results are sent one by one as ECHO, if addressed to many nodes
     } type{};
 
     std::string nodeName{};
@@ -65,10 +67,10 @@ struct CliMessage
         return m;
     }
 
-    static CliMessage Command(InetAddress addr, std::string msg, std::string node = "")
+    static CliMessage Command(InetAddress addr, std::string msg, std::string node = "", bool stream = false)
     {
         CliMessage m{};
-        m.type = Type::COMMAND;
+        m.type = stream ? Type::STREAM_COMMAND : Type::COMMAND;
         m.value = std::move(msg);
         m.nodeName = std::move(node);
         m.clientAddr = addr;
@@ -102,20 +104,51 @@ struct NwCliSendResponse : NtsMessage
     InetAddress address{};
     std::string output{};
     bool isError{};
+    std::string nodeName{};
+
+    NwCliSendResponse(const InetAddress &address, std::string output, bool isError, std::string nodeName = "")
+        : NtsMessage(NtsMessageType::CLI_SEND_RESPONSE), address(address), output(std::move(output)), isError(isError),
+          nodeName(std::move(nodeName))
+    {
+    }
+};
+
+/* Announces that the next responses to the client are for a command dispatched to many nodes */
+struct NwCliBulkStart : NtsMessage
+{
+    InetAddress address{};
+    int nodeCount{};
+    bool stream{};
 
-    NwCliSendResponse(const InetAddress &address, std::string output, bool isError)
-        : NtsMessage(NtsMessageType::CLI_SEND_RESPONSE), address(address), output(std::move(output)), isError(isError)
+    NwCliBulkStart(const InetAddress &address, int nodeCount, bool stream)
+        : NtsMessage(NtsMessageType::CLI_BULK_START), address(address), nodeCount(nodeCount), stream(stream)
     {
     }
 };
 
 class CliResponseTask : public NtsTask
 {
+  private:
+    struct BulkCommand
+    {
+        InetAddress address{};
+        int nodeCount{};
+        bool stream{};
+        int received{};
+        int failed{};
+        int64_t lastActivity{};
+
+        // Nodes grouped by their identical outputs, in the order of arrival
+        std::vector<std::pair<std::string, std::vector<std::string>>> groups{};
+        std::unordered_map<std::string, size_t> groupIndex{};
+    };
+
   private:
     app::CliServer *cliServer;
+    std::vector<BulkCommand> m_bulks;
 
   public:
-    explicit CliResponseTask(CliServer *cliServer) : cliServer(cliServer)
+    explicit CliResponseTask(CliServer *cliServer) : cliServer(cliServer), m_bulks{}
     {
     }
 
@@ -123,22 +156,14 @@ class CliResponseTask : public NtsTask
     void onStart() override
     {
     }
-    void onLoop() override
-    {
-        auto *msg = take();
-        if (msg == nullptr)
-            return;
-        if (msg->msgType == NtsMessageType::CLI_SEND_RESPONSE)
-        {
-            auto *w = dynamic_cast<NwCliSendResponse *>(msg);
-            cliServer->sendMessage(w->isError ? CliMessage::Error(w->address, w->output)
-                                              : CliMessage::Result(w->address, w->output));
-        }
-        delete msg;
-    }
+    void onLoop() override;
     void onQuit() override
     {
     }
+
+  private:
+    void receiveResponse(NwCliSendResponse &msg);
+    void finishBulk(size_t index);
 };
 
 } // namespace app
@@ -141,6 +141,21 @@ static opt::OptionsDescription DescForPsEstablish(const std::string &subCommand,
     return res;
 }
 
+static opt::OptionsDescription DescForTrace(const std::string &subCommand, const CmdEntry &entry)
+{
+    std::string example1 = "--last 16";
+    std::string example2 = "--chrome /tmp/ue-trace.json";
+
+    auto res = opt::OptionsDescription{
+        {},  {}, entry.descriptionText, {}, subCommand, {entry.usageText}, {example1, example2}, entry.helpIfEmpty,
+        true};
+
+    res.items.emplace_back('n', "last", "Number of the most recent events to show, up to 64 (default 32)", "count");
+    res.items.emplace_back(std::nullopt, "chrome",
+                           "Write all the events in Chrome trace format to the given file on the UE host", "file");
+    return res;
+}
+
 namespace app
 {
 
@@ -154,6 +169,7 @@ static OrderedMap<std::string, CmdEntry> g_gnbCmdEntries = {
     {"ue-release", {"Request a UE context release for the given UE", "<ue-id>", DefaultDesc, false}},
     {"handover", {"Perform handover for the given UE", "<ue-id>", DefaultDesc, false}}, // Pradnya
     {"handover-prepare", {"Prepare for handover for the given UE", "<ue-id>", DefaultDesc, false}},
+    {"metrics", {"Show the metrics of the nr-gnb process", "", DefaultDesc, false}},
 };
 
 static OrderedMap<std::string, CmdEntry> g_ueCmdEntries = {
@@ -162,6 +178,8 @@ static OrderedMap<std::string, CmdEntry> g_ueCmdEntries = {
     {"timers", {"Dump current status of the timers in the UE", "", DefaultDesc, false}},
     {"rls-state", {"Show status information about RLS", "", DefaultDesc, false}},
     {"coverage", {"Dump available cells and PLMNs in the coverage", "", DefaultDesc, false}},
+    {"trace", {"Dump the recent events of the UE", "[option...]", DescForTrace, false}},
+    {"metrics", {"Show the metrics of the nr-ue process, i.e. summed up for all UEs", "", DefaultDesc, false}},
     {"ps-establish",
      {"Trigger a PDU session establishment procedure", "<session-type> [options]", DescForPsEstablish, true}},
     {"ps-list", {"List all PDU sessions", "", DefaultDesc, false}},
@@ -237,6 +255,10 @@ static std::unique_ptr<GnbCliCommand> GnbCliParseImpl(const std::string &subCmd,
         return cmd;
         //return std::make_unique<GnbCliCommand>(GnbCliCommand::);
     }
+    else if (subCmd == "metrics")
+    {
+        return std::make_unique<GnbCliCommand>(GnbCliCommand::METRICS);
+    }
  
     return nullptr;
 }
@@ -352,6 +374,27 @@ static std::unique_ptr<UeCliCommand> UeCliParseImpl(const std::string &subCmd, c
     {
         return std::make_unique<UeCliCommand>(UeCliCommand::COVERAGE);
     }
+    else if (subCmd == "trace")
+    {
+        auto cmd = std::make_unique<UeCliCommand>(UeCliCommand::TRACE);
+        if (options.positionalCount() > 0)
+            CMD_ERR("No positional argument is expected")
+        cmd->traceCount = 32;
+        if (options.hasFlag('n', "last"))
+        {
+            // Limited, since the whole output must fit into a single CLI response
+            if (!utils::TryParseInt(options.getOption('n', "last"), cmd->traceCount) || cmd->traceCount <= 0 ||
+                cmd->traceCount > 64)
+                CMD_ERR("Invalid number of events, it must be between 1 and 64")
+        }
+        if (options.hasFlag(std::nullopt, "chrome"))
+            cmd->traceFile = options.getOption(std::nullopt, "chrome");
+        return cmd;
+    }
+    else if (subCmd == "metrics")
+    {
+        return std::make_unique<UeCliCommand>(UeCliCommand::METRICS);
+    }
 
     return nullptr;
 }
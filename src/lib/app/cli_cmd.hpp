@@ -31,6 +31,7 @@ struct GnbCliCommand
         UE_RELEASE_REQ,
         HANDOVERPREPARE,  //Pradnya
         HANDOVER,        
+        METRICS,
     } present;
 
     // AMF_INFO
@@ -69,6 +70,8 @@ struct UeCliCommand
         DE_REGISTER,
         RLS_STATE,
         COVERAGE,
+        TRACE,
+        METRICS,
     } present;
 
     // DE_REGISTER
@@ -83,6 +86,10 @@ struct UeCliCommand
     std::optional<std::string> apn{};
     bool isEmergency{};
 
+    // TRACE
+    int traceCount{};
+    std::optional<std::string> traceFile{};
+
     explicit UeCliCommand(PR present) : present(present)
     {
     }
@@ -0,0 +1,187 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "metrics_server.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <utils/common.hpp>
+#include <utils/libc_error.hpp>
+#include <utils/metrics.hpp>
+
+static constexpr const int ACCEPT_TIMEOUT_MS = 500;
+static constexpr const int CLIENT_TIMEOUT_MS = 1000;
+static constexpr const size_t MAX_REQUEST_SIZE = 4096;
+
+static constexpr const int TIMER_ID_CSV_DUMP = 1;
+static constexpr const int CSV_DUMP_INTERVAL_MS = 1000;
+
+static void SendAll(int fd, const std::string &data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            return;
+        sent += static_cast<size_t>(n);
+    }
+}
+
+static std::string HttpResponse(const std::string &status, const std::string &contentType, const std::string &body)
+{
+    std::string res = "HTTP/1.0 " + status + "\r\n";
+    res += "Content-Type: " + contentType + "\r\n";
+    res += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    res += "Connection: close\r\n\r\n";
+    res += body;
+    return res;
+}
+
+namespace app
+{
+
+MetricsServerTask::MetricsServerTask(uint16_t port) : m_fd{-1}
+{
+    m_fd = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (m_fd < 0)
+        throw LibError("Metrics socket could not be created:", errno);
+
+    int reuse = 1;
+    ::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (::bind(m_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 || ::listen(m_fd, 8) < 0)
+    {
+        int err = errno;
+        ::close(m_fd);
+        m_fd = -1;
+        throw LibError("Metrics server could not listen on 127.0.0.1:" + std::to_string(port) + ":", err);
+    }
+}
+
+MetricsServerTask::~MetricsServerTask() = default;
+
+void MetricsServerTask::onStart()
+{
+}
+
+void MetricsServerTask::onLoop()
+{
+    pollfd pfd{};
+    pfd.fd = m_fd;
+    pfd.events = POLLIN;
+
+    if (::poll(&pfd, 1, ACCEPT_TIMEOUT_MS) <= 0 || !(pfd.revents & POLLIN))
+        return;
+
+    int clientFd = ::accept(m_fd, nullptr, nullptr);
+    if (clientFd < 0)
+        return;
+
+    serveClient(clientFd);
+    ::close(clientFd);
+}
+
+void MetricsServerTask::serveClient(int clientFd)
+{
+    timeval tv{};
+    tv.tv_sec = CLIENT_TIMEOUT_MS / 1000;
+    tv.tv_usec = (CLIENT_TIMEOUT_MS % 1000) * 1000;
+    ::setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    // Only the request line matters, the headers are read until the end but ignored
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_SIZE)
+    {
+        ssize_t n = ::recv(clientFd, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            break;
+        request.append(buffer, static_cast<size_t>(n));
+    }
+
+    std::string requestLine = request.substr(0, request.find("\r\n"));
+    size_t pathStart = requestLine.find(' ');
+    size_t pathEnd = pathStart == std::string::npos ? pathStart : requestLine.find(' ', pathStart + 1);
+    std::string method = requestLine.substr(0, pathStart);
+    std::string path =
+        pathStart == std::string::npos ? "" : requestLine.substr(pathStart + 1, pathEnd - pathStart - 1);
+
+    if (method != "GET")
+        SendAll(clientFd, HttpResponse("405 Method Not Allowed", "text/plain", "Only GET is supported\n"));
+    else if (path != "/metrics" && path != "/")
+        SendAll(clientFd, HttpResponse("404 Not Found", "text/plain", "Metrics are served at /metrics\n"));
+    else
+        SendAll(clientFd, HttpResponse("200 OK", "text/plain; version=0.0.4",
+                                       metrics::Registry::Instance().renderPrometheus()));
+}
+
+void MetricsServerTask::onQuit()
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_fd = -1;
+}
+
+MetricsCsvTask::MetricsCsvTask(const std::string &file) : m_stream{file, std::ios::out | std::ios::trunc}
+{
+    if (!m_stream)
+        throw LibError("Metrics CSV file could not be created: " + file, errno);
+
+    m_stream << metrics::Registry::CsvHeader();
+    m_stream.flush();
+}
+
+MetricsCsvTask::~MetricsCsvTask() = default;
+
+void MetricsCsvTask::onStart()
+{
+    setTimer(TIMER_ID_CSV_DUMP, CSV_DUMP_INTERVAL_MS);
+}
+
+void MetricsCsvTask::onLoop()
+{
+    NtsMessage *msg = take();
+    if (!msg)
+        return;
+
+    if (msg->msgType == NtsMessageType::TIMER_EXPIRED)
+    {
+        dump();
+        setTimer(TIMER_ID_CSV_DUMP, CSV_DUMP_INTERVAL_MS);
+    }
+
+    delete msg;
+}
+
+void MetricsCsvTask::onQuit()
+{
+    // The last values are dumped as well, so that the totals of the run are not lost
+    dump();
+    m_stream.close();
+}
+
+void MetricsCsvTask::dump()
+{
+    m_stream << metrics::Registry::Instance().renderCsv(utils::CurrentTimeMillis());
+    m_stream.flush();
+}
+
+} // namespace app
@@ -0,0 +1,66 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include <utils/nts.hpp>
+
+namespace app
+{
+
+/**
+ * Serves the metrics registry in Prometheus text format over HTTP on the loopback interface.
+ * <p>
+ * The requests are served one by one on the task thread, which is enough for a scraper polling every few seconds.
+ */
+class MetricsServerTask : public NtsTask
+{
+  private:
+    int m_fd;
+
+  public:
+    /* Throws LibError if the port cannot be bound */
+    explicit MetricsServerTask(uint16_t port);
+    ~MetricsServerTask() override;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+
+  private:
+    void serveClient(int clientFd);
+};
+
+/**
+ * Appends all the series of the metrics registry to a CSV file periodically, for offline analysis of the test runs.
+ */
+class MetricsCsvTask : public NtsTask
+{
+  private:
+    std::ofstream m_stream;
+
+  public:
+    /* Throws LibError if the file cannot be created */
+    explicit MetricsCsvTask(const std::string &file);
+    ~MetricsCsvTask() override;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+
+  private:
+    void dump();
+};
+
+} // namespace app
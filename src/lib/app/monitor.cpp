@@ -7,3 +7,46 @@
 //
 
 #include "monitor.hpp"
+
+namespace app
+{
+
+NodeMessage::NodeMessage(const void *pdu, XerRenderer xerRenderer, int procedureCode, std::optional<int64_t> ranUeId,
+                         std::optional<int64_t> amfUeId)
+    : m_pdu{pdu}, m_xerRenderer{xerRenderer}, m_procedureCode{procedureCode}, m_ranUeId{ranUeId}, m_amfUeId{amfUeId}
+{
+}
+
+int NodeMessage::procedureCode() const
+{
+    return m_procedureCode;
+}
+
+std::optional<int64_t> NodeMessage::ranUeId() const
+{
+    return m_ranUeId;
+}
+
+std::optional<int64_t> NodeMessage::amfUeId() const
+{
+    return m_amfUeId;
+}
+
+std::string NodeMessage::xer() const
+{
+    if (m_pdu == nullptr || m_xerRenderer == nullptr)
+        return {};
+    return m_xerRenderer(m_pdu);
+}
+
+Json NodeMessage::json() const
+{
+    return Json::Obj({
+        {"procedure-code", m_procedureCode},
+        {"ran-ue-ngap-id", m_ranUeId.has_value() ? Json{*m_ranUeId} : Json{nullptr}},
+        {"amf-ue-ngap-id", m_amfUeId.has_value() ? Json{*m_amfUeId} : Json{nullptr}},
+        {"xer", xer()},
+    });
+}
+
+} // namespace app
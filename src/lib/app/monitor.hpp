@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
 
+#include <utils/json.hpp>
+
 namespace app
 {
 
@@ -39,6 +42,40 @@ enum class StateType
     RRC
 };
 
+/**
+ * Signalling message reported to the node listeners. The procedure code and the UE IDs are extracted up front, while
+ * the full dump of the PDU is only rendered on demand, so that listeners filtering the messages cost almost nothing.
+ * <p>
+ * The message refers to the PDU being sent or received, hence it is only valid during the listener call. A listener
+ * that needs the dump later on should render it during the call.
+ */
+class NodeMessage
+{
+  public:
+    typedef std::string (*XerRenderer)(const void *pdu);
+
+  private:
+    const void *m_pdu;
+    XerRenderer m_xerRenderer;
+    int m_procedureCode;
+    std::optional<int64_t> m_ranUeId;
+    std::optional<int64_t> m_amfUeId;
+
+  public:
+    NodeMessage(const void *pdu, XerRenderer xerRenderer, int procedureCode, std::optional<int64_t> ranUeId,
+                std::optional<int64_t> amfUeId);
+
+  public:
+    /* -1 if the message has no procedure code */
+    [[nodiscard]] int procedureCode() const;
+    [[nodiscard]] std::optional<int64_t> ranUeId() const;
+    [[nodiscard]] std::optional<int64_t> amfUeId() const;
+
+    /* Rendered on each call, empty if the PDU cannot be rendered */
+    [[nodiscard]] std::string xer() const;
+    [[nodiscard]] Json json() const;
+};
+
 class INodeListener
 {
   public:
@@ -46,10 +83,10 @@ class INodeListener
                              const std::string &objectId) = 0;
 
     virtual void onReceive(NodeType subjectType, const std::string &subjectId, NodeType objectType,
-                           const std::string &objectId, ConnectionType connectionType, std::string message) = 0;
+                           const std::string &objectId, ConnectionType connectionType, const NodeMessage &message) = 0;
 
     virtual void onSend(NodeType subjectType, const std::string &subjectId, NodeType objectType,
-                        const std::string &objectId, ConnectionType connectionType, std::string message) = 0;
+                        const std::string &objectId, ConnectionType connectionType, const NodeMessage &message) = 0;
 
     virtual void onSwitch(NodeType subjectType, const std::string &subjectId, StateType stateType,
                           const std::string &fromState, const std::string &toState) = 0;
@@ -0,0 +1,158 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "node_selector.hpp"
+
+#include <stdexcept>
+
+#include <utils/common.hpp>
+
+static constexpr const size_t MAX_NUMBER_WIDTH = 18;
+
+static bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+namespace app
+{
+
+bool IsNodeSelector(const std::string &str)
+{
+    return str.find_first_of("*?[") != std::string::npos;
+}
+
+NodeSelector::NodeSelector(const std::string &pattern) : m_tokens{}
+{
+    size_t i = 0;
+    while (i < pattern.size())
+    {
+        char c = pattern[i];
+
+        if (c == '*')
+        {
+            // Consecutive stars are redundant
+            if (m_tokens.empty() || m_tokens.back().type != ETokenType::ANY_SEQUENCE)
+                m_tokens.push_back({ETokenType::ANY_SEQUENCE});
+            i++;
+        }
+        else if (c == '?')
+        {
+            m_tokens.push_back({ETokenType::ANY_CHAR});
+            i++;
+        }
+        else if (c == '[')
+        {
+            size_t end = pattern.find(']', i + 1);
+            if (end == std::string::npos || end == i + 1)
+                throw std::runtime_error("Malformed node selector, unclosed or empty bracket: " + pattern);
+
+            std::string content = pattern.substr(i + 1, end - i - 1);
+            size_t dash = content.find('-');
+
+            bool isNumeric = dash != std::string::npos && dash > 0 && dash < content.size() - 1 &&
+                             utils::IsNumeric(content.substr(0, dash)) && utils::IsNumeric(content.substr(dash + 1)) &&
+                             content.size() > 3;
+
+            Token token{};
+            if (isNumeric)
+            {
+                std::string lo = content.substr(0, dash);
+                std::string hi = content.substr(dash + 1);
+                if (lo.size() > MAX_NUMBER_WIDTH || hi.size() > MAX_NUMBER_WIDTH)
+                    throw std::runtime_error("Malformed node selector, number range is too wide: " + pattern);
+
+                token.type = ETokenType::NUMBER_RANGE;
+                token.min = std::stoll(lo);
+                token.max = std::stoll(hi);
+                token.minWidth = lo.size() == hi.size() ? hi.size() : 1;
+                token.maxWidth = hi.size();
+                if (token.min > token.max)
+                    throw std::runtime_error("Malformed node selector, empty number range: " + pattern);
+            }
+            else
+            {
+                token.type = ETokenType::CHAR_SET;
+                for (size_t j = 0; j < content.size(); j++)
+                {
+                    if (j + 2 < content.size() && content[j + 1] == '-')
+                    {
+                        for (int k = content[j]; k <= content[j + 2]; k++)
+                            token.chars += static_cast<char>(k);
+                        j += 2;
+                    }
+                    else
+                        token.chars += content[j];
+                }
+            }
+
+            m_tokens.push_back(token);
+            i = end + 1;
+        }
+        else
+        {
+            if (m_tokens.empty() || m_tokens.back().type != ETokenType::LITERAL)
+                m_tokens.push_back({ETokenType::LITERAL});
+            m_tokens.back().chars += c;
+            i++;
+        }
+    }
+}
+
+bool NodeSelector::matches(const std::string &name) const
+{
+    return matchFrom(0, name, 0);
+}
+
+bool NodeSelector::matchFrom(size_t tokenIndex, const std::string &name, size_t pos) const
+{
+    if (tokenIndex == m_tokens.size())
+        return pos == name.size();
+
+    auto &token = m_tokens[tokenIndex];
+
+    switch (token.type)
+    {
+    case ETokenType::LITERAL:
+        return name.compare(pos, token.chars.size(), token.chars) == 0 &&
+               matchFrom(tokenIndex + 1, name, pos + token.chars.size());
+    case ETokenType::ANY_CHAR:
+        return pos < name.size() && matchFrom(tokenIndex + 1, name, pos + 1);
+    case ETokenType::CHAR_SET:
+        return pos < name.size() && token.chars.find(name[pos]) != std::string::npos &&
+               matchFrom(tokenIndex + 1, name, pos + 1);
+    case ETokenType::ANY_SEQUENCE:
+        for (size_t i = pos; i <= name.size(); i++)
+            if (matchFrom(tokenIndex + 1, name, i))
+                return true;
+        return false;
+    case ETokenType::NUMBER_RANGE: {
+        int64_t value = 0;
+        for (size_t width = 1; width <= token.maxWidth && pos + width <= name.size(); width++)
+        {
+            char c = name[pos + width - 1];
+            if (!IsDigit(c))
+                break;
+            value = value * 10 + (c - '0');
+
+            if (width < token.minWidth)
+                continue;
+            // Leading zeros are only allowed for the fixed width ranges
+            if (token.minWidth != token.maxWidth && width > 1 && name[pos] == '0')
+                break;
+            if (value >= token.min && value <= token.max && matchFrom(tokenIndex + 1, name, pos + width))
+                return true;
+        }
+        return false;
+    }
+    }
+
+    return false;
+}
+
+} // namespace app
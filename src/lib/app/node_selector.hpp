@@ -0,0 +1,63 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace app
+{
+
+/* Returns true if the node name contains any of the pattern characters, i.e. '*', '?' or '[' */
+bool IsNodeSelector(const std::string &str);
+
+/**
+ * Node name pattern for addressing many nodes with a single CLI command.
+ * <p>
+ * '*' matches any sequence of characters, '?' matches any single character, "[abc]" and "[a-c]" match a single
+ * character in the set, and "[0000-9999]" matches a decimal number in the given range. If the bounds of a numeric
+ * range have the same width, only the numbers of that width are matched, such as imsi-00101000000[0000-9999]
+ */
+class NodeSelector
+{
+  private:
+    enum class ETokenType
+    {
+        LITERAL,
+        ANY_SEQUENCE,
+        ANY_CHAR,
+        CHAR_SET,
+        NUMBER_RANGE,
+    };
+
+    struct Token
+    {
+        ETokenType type{};
+        std::string chars{}; // LITERAL and CHAR_SET
+        int64_t min{};       // NUMBER_RANGE
+        int64_t max{};       // NUMBER_RANGE
+        size_t minWidth{};   // NUMBER_RANGE
+        size_t maxWidth{};   // NUMBER_RANGE
+    };
+
+    std::vector<Token> m_tokens;
+
+  public:
+    /* Throws std::runtime_error if the pattern is malformed */
+    explicit NodeSelector(const std::string &pattern);
+
+  public:
+    [[nodiscard]] bool matches(const std::string &name) const;
+
+  private:
+    [[nodiscard]] bool matchFrom(size_t tokenIndex, const std::string &name, size_t pos) const;
+};
+
+} // namespace app
@@ -0,0 +1,60 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "arena.hpp"
+
+#include <new>
+
+namespace asn
+{
+
+Arena::Arena() : m_arena{asn_arena_new()}, m_depth{}
+{
+    if (m_arena == nullptr)
+        throw std::bad_alloc();
+}
+
+Arena::~Arena()
+{
+    asn_arena_delete(m_arena);
+}
+
+void Arena::reset()
+{
+    asn_arena_reset(m_arena);
+}
+
+size_t Arena::used() const
+{
+    return asn_arena_used(m_arena);
+}
+
+asn_arena_t *Arena::get() const
+{
+    return m_arena;
+}
+
+ArenaScope::ArenaScope(Arena &arena) : m_arena{&arena}, m_previous{asn_arena_swap_current(arena.get())}
+{
+    arena.m_depth++;
+}
+
+ArenaScope::ArenaScope(std::nullptr_t) : m_arena{}, m_previous{asn_arena_swap_current(nullptr)}
+{
+}
+
+ArenaScope::~ArenaScope()
+{
+    asn_arena_swap_current(m_previous);
+
+    // Nested scopes of the same arena release it only once, at the outermost one
+    if (m_arena != nullptr && --m_arena->m_depth == 0)
+        m_arena->reset();
+}
+
+} // namespace asn
@@ -0,0 +1,69 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstddef>
+
+#include <asn_arena.h>
+
+namespace asn
+{
+
+/**
+ * Bump allocator for the ASN.1 structures of one PDU at a time. While an arena is in scope, everything allocated by
+ * the asn1c runtime and the asn:: helpers (decoding, building, encoding) is taken from the arena, freeing those
+ * structures is a no-op, and the whole PDU is released at once when the scope ends.
+ * <p>
+ * An arena is used by a single thread at a time. The memory of the last PDU is reused by the next one.
+ */
+class Arena
+{
+  private:
+    asn_arena_t *m_arena;
+    int m_depth;
+
+    friend class ArenaScope;
+
+  public:
+    Arena();
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+  public:
+    void reset();
+    [[nodiscard]] size_t used() const;
+    [[nodiscard]] asn_arena_t *get() const;
+};
+
+/**
+ * Makes the given arena current for the calling thread until the end of the scope, then releases everything allocated
+ * from it. A scope constructed with nullptr temporarily switches back to the malloc path, e.g. for the structures that
+ * outlive the PDU.
+ * <p>
+ * All the structures allocated in the scope must be dropped at the end of it. Data needed later on must be copied
+ * out, e.g. via UniqueCopy.
+ */
+class ArenaScope
+{
+  private:
+    Arena *m_arena;
+    asn_arena_t *m_previous;
+
+  public:
+    explicit ArenaScope(Arena &arena);
+    explicit ArenaScope(std::nullptr_t);
+    ~ArenaScope();
+
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+};
+
+} // namespace asn
@@ -63,9 +63,9 @@ void SetOctetString(OCTET_STRING_t &target, const OctetString &value)
 void SetBitString(BIT_STRING_t &target, octet4 value)
 {
     if (target.buf)
-        free(target.buf);
+        asn_mem_free(target.buf);
 
-    target.buf = static_cast<uint8_t *>(calloc(4, 1));
+    target.buf = static_cast<uint8_t *>(asn_mem_calloc(4, 1));
     target.buf[0] = value[0];
     target.buf[1] = value[1];
     target.buf[2] = value[2];
@@ -77,8 +77,8 @@ void SetBitString(BIT_STRING_t &target, octet4 value)
 void SetBitString(BIT_STRING_t &target, const OctetString &value)
 {
     if (target.buf)
-        free(target.buf);
-    target.buf = static_cast<uint8_t *>(calloc(value.length(), 1));
+        asn_mem_free(target.buf);
+    target.buf = static_cast<uint8_t *>(asn_mem_calloc(value.length(), 1));
     std::memcpy(target.buf, value.data(), value.length());
     target.size = value.length();
     target.bits_unused = 0;
@@ -154,7 +154,7 @@ void SetUnsigned64(uint64_t value, INTEGER_t &target)
     {
         if (target.buf != nullptr)
         {
-            free(target.buf);
+            asn_mem_free(target.buf);
             target.buf = nullptr;
         }
         target.size = 0;
@@ -167,7 +167,7 @@ void SetSigned64(int64_t value, INTEGER_t &target)
     {
         if (target.buf != nullptr)
         {
-            free(target.buf);
+            asn_mem_free(target.buf);
             target.buf = nullptr;
         }
         target.size = 0;
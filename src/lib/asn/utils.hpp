@@ -16,6 +16,8 @@
 #include <string>
 #include <type_traits>
 
+#include "arena.hpp"
+
 #include <BIT_STRING.h>
 #include <NativeEnumerated.h>
 #include <OCTET_STRING.h>
@@ -33,7 +35,7 @@ namespace asn
 template <typename T>
 inline T *New()
 {
-    return (T *)calloc(1, sizeof(T));
+    return (T *)asn_mem_calloc(1, sizeof(T));
 }
 
 template <typename T>
@@ -52,6 +54,9 @@ inline void MakeNew(T *&p)
 template <typename T>
 inline void Free(asn_TYPE_descriptor_t &desc, T *ptr)
 {
+    // Structures in an arena are released together with the arena, no need to traverse them
+    if (asn_arena_of(ptr) != nullptr)
+        return;
     ASN_STRUCT_FREE(desc, ptr);
 }
 
@@ -87,9 +92,9 @@ inline void SetBitStringInt(int value, BIT_STRING_t &target)
     static_assert(BitCount >= 1 && BitCount <= 32);
 
     if (target.buf != nullptr)
-        free(target.buf);
+        asn_mem_free(target.buf);
     target.size = bits::NearDiv(BitCount, 8) / 8;
-    target.buf = static_cast<uint8_t *>(calloc(1, target.size));
+    target.buf = static_cast<uint8_t *>(asn_mem_calloc(1, target.size));
     target.bits_unused = (8 - (static_cast<int>(BitCount) % 8)) % 8;
     BitBuffer{target.buf}.writeBits(value, BitCount);
 }
@@ -100,9 +105,9 @@ inline void SetBitStringLong(int64_t value, BIT_STRING_t &target)
     static_assert(BitCount >= 1 && BitCount <= 64);
 
     if (target.buf != nullptr)
-        free(target.buf);
+        asn_mem_free(target.buf);
     target.size = bits::NearDiv(BitCount, 8) / 8;
-    target.buf = static_cast<uint8_t *>(calloc(1, target.size));
+    target.buf = static_cast<uint8_t *>(asn_mem_calloc(1, target.size));
     target.bits_unused = (8 - (static_cast<int>(BitCount) % 8)) % 8;
     BitBuffer{target.buf}.writeBits(value, BitCount);
 }
@@ -162,19 +167,23 @@ inline void ForeachItem(const T &list, std::function<void(typename asn::AsnTrait
 template <typename T>
 inline bool DeepCopy(asn_TYPE_descriptor_t &desc, const T &source, T *target)
 {
+    // The copy is allocated where the target is, i.e. in the arena owning the target or on the heap
+    asn_arena_t *previous = asn_arena_swap_current(asn_arena_of(target));
+
     auto res = asn_encode_to_new_buffer(nullptr, ATS_CANONICAL_XER, &desc, &source);
     if (res.buffer == nullptr || res.result.encoded < 0)
+    {
+        asn_arena_swap_current(previous);
         return false; // failure
+    }
 
     std::memset(target, 0, sizeof(T));
 
-    if (xer_decode(nullptr, &desc, reinterpret_cast<void **>(&target), res.buffer, res.result.encoded).code != RC_OK)
-    {
-        free(res.buffer);
-        return false; // failure
-    }
-    free(res.buffer);
-    return true; // success
+    bool decoded =
+        xer_decode(nullptr, &desc, reinterpret_cast<void **>(&target), res.buffer, res.result.encoded).code == RC_OK;
+    asn_mem_free(res.buffer);
+    asn_arena_swap_current(previous);
+    return decoded;
 }
 
 template <typename T>
@@ -209,6 +218,8 @@ inline Unique<T> WrapUnique(T *ptr, asn_TYPE_descriptor_t &desc)
 template <typename T>
 inline Unique<T> UniqueCopy(const T &value, asn_TYPE_descriptor_t &desc)
 {
+    // Unique copies outlive the PDU they are taken from, hence always on the heap
+    ArenaScope scope{nullptr};
     auto *ptr = New<T>();
     DeepCopy(desc, value, ptr);
     return WrapUnique(ptr, desc);
@@ -20,7 +20,7 @@
 namespace crypto
 {
 
-OctetString CalculatePrfPrime(const OctetString &key, const OctetString &input, int outputLength)
+OctetString CalculatePrfPrime(OctetSpan key, OctetSpan input, int outputLength)
 {
     if (key.length() != 32)
         throw std::runtime_error("CalculatePrfPrime, 256-bit key expected");
@@ -56,14 +56,14 @@ OctetString CalculatePrfPrime(const OctetString &key, const OctetString &input,
     return res;
 }
 
-OctetString HmacSha256(const OctetString &key, const OctetString &input)
+OctetString HmacSha256(OctetSpan key, OctetSpan input)
 {
-    std::vector<uint8_t> out(32);
-    HmacSha256(out.data(), input.data(), input.length(), key.data(), key.length());
-    return OctetString{std::move(out)};
+    uint8_t out[32];
+    HmacSha256(out, input.data(), input.size(), key.data(), key.size());
+    return OctetString::FromArray(out, sizeof(out));
 }
 
-OctetString CalculateKdfKey(const OctetString &key, int fc, OctetString *parameters, int numberOfParameter)
+OctetString CalculateKdfKey(OctetSpan key, int fc, OctetString *parameters, int numberOfParameter)
 {
     OctetString inp;
     inp.appendOctet(fc);
@@ -75,7 +75,7 @@ OctetString CalculateKdfKey(const OctetString &key, int fc, OctetString *paramet
     return HmacSha256(key, inp);
 }
 
-OctetString CalculateKdfKey(const OctetString &key, int fc1, int fc2, OctetString *parameters, int numberOfParameter)
+OctetString CalculateKdfKey(OctetSpan key, int fc1, int fc2, OctetString *parameters, int numberOfParameter)
 {
     OctetString inp;
     inp.appendOctet(fc1);
@@ -94,10 +94,10 @@ OctetString EncodeKdfString(const std::string &string)
     // V16.0.0 - B.2.1.2 Character string encoding
     // A character string shall be encoded to an octet string according to UTF-8 encoding rules as specified in
     // IETF RFC 3629 [24] and apply Normalization Form KC (NFKC) as specified in [37].
-    return OctetString{std::vector<uint8_t>{string.c_str(), string.c_str() + string.length()}};
+    return OctetString::FromAscii(string);
 }
 
-std::vector<uint32_t> Snow3g(const OctetString &key, const OctetString &iv, int length)
+std::vector<uint32_t> Snow3g(OctetSpan key, OctetSpan iv, int length)
 {
     std::vector<uint32_t> res(length);
     snow3g::Initialize(reinterpret_cast<const uint32_t *>(key.data()), reinterpret_cast<const uint32_t *>(iv.data()));
@@ -105,7 +105,7 @@ std::vector<uint32_t> Snow3g(const OctetString &key, const OctetString &iv, int
     return res;
 }
 
-std::vector<uint32_t> Zuc(const OctetString &key, const OctetString &iv, int length)
+std::vector<uint32_t> Zuc(OctetSpan key, OctetSpan iv, int length)
 {
     std::vector<uint32_t> res(length);
     zuc::Initialize(key.data(), iv.data());
@@ -124,50 +124,50 @@ void EncryptUea2(const uint8_t *pKey, uint32_t count, uint32_t bearer, uint32_t
     crypto::uea2::F8(pKey, count, bearer, dir, pData, length * 8);
 }
 
-void EncryptEea1(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key)
+void EncryptEea1(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key)
 {
     EncryptUea2(key.data(), count, bearer, direction, message.data(), message.length());
 }
 
-void DecryptEea1(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key)
+void DecryptEea1(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key)
 {
     EncryptEea1(count, bearer, direction, message, key);
 }
 
-uint32_t ComputeMacEia1(uint32_t count, int bearer, int direction, const OctetString &message, const OctetString &key)
+uint32_t ComputeMacEia1(uint32_t count, int bearer, int direction, OctetSpan message, OctetSpan key)
 {
     uint32_t fresh = bearer << 27;
     return ComputeMacUia2(key.data(), count, fresh, direction, message.data(), message.length());
 }
 
-void EncryptEea2(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key)
+void EncryptEea2(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key)
 {
     eea2::Encrypt(count, bearer, direction, message, key);
 }
 
-void DecryptEea2(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key)
+void DecryptEea2(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key)
 {
     eea2::Decrypt(count, bearer, direction, message, key);
 }
 
-uint32_t ComputeMacEia2(uint32_t count, int bearer, int direction, const OctetString &message, const OctetString &key)
+uint32_t ComputeMacEia2(uint32_t count, int bearer, int direction, OctetSpan message, OctetSpan key)
 {
     return eia2::Compute(count, bearer, direction, message, key);
 }
 
-void EncryptEea3(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key)
+void EncryptEea3(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key)
 {
     eea3::EEA3(key.data(), count, bearer, direction, message.length() * 8,
                reinterpret_cast<uint32_t *>(message.data()));
 }
 
-void DecryptEea3(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key)
+void DecryptEea3(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key)
 {
     eea3::EEA3(key.data(), count, bearer, direction, message.length() * 8,
                reinterpret_cast<uint32_t *>(message.data()));
 }
 
-uint32_t ComputeMacEia3(uint32_t count, int bearer, int direction, const OctetString &message, const OctetString &key)
+uint32_t ComputeMacEia3(uint32_t count, int bearer, int direction, OctetSpan message, OctetSpan key)
 {
     return eea3::EIA3(key.data(), count, direction, bearer, message.length() * 8,
                       reinterpret_cast<const uint32_t *>(message.data()));
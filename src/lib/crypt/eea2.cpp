@@ -31,14 +31,14 @@ static void ComputeIv(uint8_t *iv, uint32_t count, int bearer, int direction)
     buf.write(direction);
 }
 
-void Encrypt(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key)
+void Encrypt(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key)
 {
     uint8_t iv[16] = {0};
     ComputeIv(iv, count, bearer, direction);
     Cipher(key.data(), iv, message.data(), message.length());
 }
 
-void Decrypt(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key)
+void Decrypt(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key)
 {
     uint8_t iv[16] = {0};
     ComputeIv(iv, count, bearer, direction);
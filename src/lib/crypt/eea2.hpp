@@ -13,7 +13,7 @@
 namespace crypto::eea2
 {
 
-void Encrypt(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key);
-void Decrypt(uint32_t count, int bearer, int direction, OctetString &message, const OctetString &key);
+void Encrypt(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key);
+void Decrypt(uint32_t count, int bearer, int direction, OctetString &message, OctetSpan key);
 
 } // namespace crypt::eea2
\ No newline at end of file
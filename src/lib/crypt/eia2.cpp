@@ -11,9 +11,10 @@
 
 #include <utils/bits.hpp>
 
-static OctetString GenerateMacInput(uint32_t count, int bearer, int direction, const OctetString &message)
+static OctetString GenerateMacInput(uint32_t count, int bearer, int direction, OctetSpan message)
 {
     OctetString m{};
+    m.reserve(8 + message.length());
     m.appendOctet4(count);
     m.appendOctet(bits::Ranged8({{5, bearer}, {1, direction}, {2, 0}}));
     m.appendOctet3(0);
@@ -24,7 +25,7 @@ static OctetString GenerateMacInput(uint32_t count, int bearer, int direction, c
 namespace crypto::eia2
 {
 
-uint32_t Compute(uint32_t count, int bearer, int direction, const OctetString &message, const OctetString &key)
+uint32_t Compute(uint32_t count, int bearer, int direction, OctetSpan message, OctetSpan key)
 {
     assert(key.length() == 16);
 
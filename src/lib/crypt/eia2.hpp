@@ -13,6 +13,6 @@
 namespace crypto::eia2
 {
 
-uint32_t Compute(uint32_t count, int bearer, int direction, const OctetString &message, const OctetString &key);
+uint32_t Compute(uint32_t count, int bearer, int direction, OctetSpan message, OctetSpan key);
 
 } // namespace crypt::eia2
\ No newline at end of file
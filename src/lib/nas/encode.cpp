@@ -8,21 +8,67 @@
 
 #include "encode.hpp"
 
+#include <memory>
 #include <stdexcept>
+#include <tuple>
 
 namespace nas
 {
 
+template <typename M, typename T>
+static inline void EncodeMandatory(const M &msg, const IeMandatory<M, T> &ie, OctetString &stream)
+{
+    Encode2346(msg.*ie.member, stream);
+}
+
+template <typename M, typename T>
+static inline void EncodeMandatory(const M &msg, const IeMandatory1<M, T> &ie, OctetString &stream)
+{
+    EncodeIe1(0, msg.*ie.member, stream);
+}
+
+template <typename M, typename T, typename U>
+static inline void EncodeMandatory(const M &msg, const IeMandatory1Pair<M, T, U> &ie, OctetString &stream)
+{
+    EncodeIe1(msg.*ie.high, msg.*ie.low, stream);
+}
+
+template <typename M, typename D>
+static inline void EncodeMandatory(const M &, const D &, OctetString &)
+{
+}
+
+template <typename M, typename T>
+static inline void EncodeOptional(const M &msg, const IeOptional<M, T> &ie, OctetString &stream)
+{
+    auto &value = msg.*ie.member;
+    if (value.has_value())
+    {
+        stream.appendOctet(ie.iei);
+        Encode2346(value.value(), stream);
+    }
+}
+
+template <typename M, typename T>
+static inline void EncodeOptional(const M &msg, const IeOptional1<M, T> &ie, OctetString &stream)
+{
+    auto &value = msg.*ie.member;
+    if (value.has_value())
+        EncodeIe1(ie.iei, value.value(), stream);
+}
+
+template <typename M, typename D>
+static inline void EncodeOptional(const M &, const D &, OctetString &)
+{
+}
+
 template <typename T>
-static void EncodeViaBuilder(T &msg, OctetString &stream)
+static void EncodeViaTable(const T &msg, OctetString &stream)
 {
-    NasMessageBuilder builder{};
-    msg.onBuild(builder);
+    static constexpr auto table = T::IeTable();
 
-    for (auto &f : builder.mandatoryEncoders)
-        f(stream);
-    for (auto &f : builder.optionalEncoders)
-        f(stream);
+    std::apply([&msg, &stream](const auto &...ie) { (EncodeMandatory(msg, ie, stream), ...); }, table);
+    std::apply([&msg, &stream](const auto &...ie) { (EncodeOptional(msg, ie, stream), ...); }, table);
 }
 
 static void EncodeMm(PlainMmMessage &msg, OctetString &stream)
@@ -32,88 +78,88 @@ static void EncodeMm(PlainMmMessage &msg, OctetString &stream)
     switch (msg.messageType)
     {
     case EMessageType::REGISTRATION_REQUEST:
-        EncodeViaBuilder((RegistrationRequest &)msg, stream);
+        EncodeViaTable((RegistrationRequest &)msg, stream);
         break;
     case EMessageType::REGISTRATION_ACCEPT:
-        EncodeViaBuilder((RegistrationAccept &)msg, stream);
+        EncodeViaTable((RegistrationAccept &)msg, stream);
         break;
     case EMessageType::REGISTRATION_COMPLETE:
-        EncodeViaBuilder((RegistrationComplete &)msg, stream);
+        EncodeViaTable((RegistrationComplete &)msg, stream);
         break;
     case EMessageType::REGISTRATION_REJECT:
-        EncodeViaBuilder((RegistrationReject &)msg, stream);
+        EncodeViaTable((RegistrationReject &)msg, stream);
         break;
     case EMessageType::DEREGISTRATION_REQUEST_UE_ORIGINATING:
-        EncodeViaBuilder((DeRegistrationRequestUeOriginating &)msg, stream);
+        EncodeViaTable((DeRegistrationRequestUeOriginating &)msg, stream);
         break;
     case EMessageType::DEREGISTRATION_ACCEPT_UE_ORIGINATING:
-        EncodeViaBuilder((DeRegistrationAcceptUeOriginating &)msg, stream);
+        EncodeViaTable((DeRegistrationAcceptUeOriginating &)msg, stream);
         break;
     case EMessageType::DEREGISTRATION_REQUEST_UE_TERMINATED:
-        EncodeViaBuilder((DeRegistrationRequestUeTerminated &)msg, stream);
+        EncodeViaTable((DeRegistrationRequestUeTerminated &)msg, stream);
         break;
     case EMessageType::DEREGISTRATION_ACCEPT_UE_TERMINATED:
-        EncodeViaBuilder((DeRegistrationAcceptUeTerminated &)msg, stream);
+        EncodeViaTable((DeRegistrationAcceptUeTerminated &)msg, stream);
         break;
     case EMessageType::SERVICE_REQUEST:
-        EncodeViaBuilder((ServiceRequest &)msg, stream);
+        EncodeViaTable((ServiceRequest &)msg, stream);
         break;
     case EMessageType::SERVICE_REJECT:
-        EncodeViaBuilder((ServiceReject &)msg, stream);
+        EncodeViaTable((ServiceReject &)msg, stream);
         break;
     case EMessageType::SERVICE_ACCEPT:
-        EncodeViaBuilder((ServiceAccept &)msg, stream);
+        EncodeViaTable((ServiceAccept &)msg, stream);
         break;
     case EMessageType::CONFIGURATION_UPDATE_COMMAND:
-        EncodeViaBuilder((ConfigurationUpdateCommand &)msg, stream);
+        EncodeViaTable((ConfigurationUpdateCommand &)msg, stream);
         break;
     case EMessageType::CONFIGURATION_UPDATE_COMPLETE:
-        EncodeViaBuilder((ConfigurationUpdateComplete &)msg, stream);
+        EncodeViaTable((ConfigurationUpdateComplete &)msg, stream);
         break;
     case EMessageType::AUTHENTICATION_REQUEST:
-        EncodeViaBuilder((AuthenticationRequest &)msg, stream);
+        EncodeViaTable((AuthenticationRequest &)msg, stream);
         break;
     case EMessageType::AUTHENTICATION_RESPONSE:
-        EncodeViaBuilder((AuthenticationResponse &)msg, stream);
+        EncodeViaTable((AuthenticationResponse &)msg, stream);
         break;
     case EMessageType::AUTHENTICATION_REJECT:
-        EncodeViaBuilder((AuthenticationReject &)msg, stream);
+        EncodeViaTable((AuthenticationReject &)msg, stream);
         break;
     case EMessageType::AUTHENTICATION_FAILURE:
-        EncodeViaBuilder((AuthenticationFailure &)msg, stream);
+        EncodeViaTable((AuthenticationFailure &)msg, stream);
         break;
     case EMessageType::AUTHENTICATION_RESULT:
-        EncodeViaBuilder((AuthenticationResult &)msg, stream);
+        EncodeViaTable((AuthenticationResult &)msg, stream);
         break;
     case EMessageType::IDENTITY_REQUEST:
-        EncodeViaBuilder((IdentityRequest &)msg, stream);
+        EncodeViaTable((IdentityRequest &)msg, stream);
         break;
     case EMessageType::IDENTITY_RESPONSE:
-        EncodeViaBuilder((IdentityResponse &)msg, stream);
+        EncodeViaTable((IdentityResponse &)msg, stream);
         break;
     case EMessageType::SECURITY_MODE_COMMAND:
-        EncodeViaBuilder((SecurityModeCommand &)msg, stream);
+        EncodeViaTable((SecurityModeCommand &)msg, stream);
         break;
     case EMessageType::SECURITY_MODE_COMPLETE:
-        EncodeViaBuilder((SecurityModeComplete &)msg, stream);
+        EncodeViaTable((SecurityModeComplete &)msg, stream);
         break;
     case EMessageType::SECURITY_MODE_REJECT:
-        EncodeViaBuilder((SecurityModeReject &)msg, stream);
+        EncodeViaTable((SecurityModeReject &)msg, stream);
         break;
     case EMessageType::FIVEG_MM_STATUS:
-        EncodeViaBuilder((FiveGMmStatus &)msg, stream);
+        EncodeViaTable((FiveGMmStatus &)msg, stream);
         break;
     case EMessageType::NOTIFICATION:
-        EncodeViaBuilder((Notification &)msg, stream);
+        EncodeViaTable((Notification &)msg, stream);
         break;
     case EMessageType::NOTIFICATION_RESPONSE:
-        EncodeViaBuilder((NotificationResponse &)msg, stream);
+        EncodeViaTable((NotificationResponse &)msg, stream);
         break;
     case EMessageType::UL_NAS_TRANSPORT:
-        EncodeViaBuilder((UlNasTransport &)msg, stream);
+        EncodeViaTable((UlNasTransport &)msg, stream);
         break;
     case EMessageType::DL_NAS_TRANSPORT:
-        EncodeViaBuilder((DlNasTransport &)msg, stream);
+        EncodeViaTable((DlNasTransport &)msg, stream);
         break;
     default:
         throw std::runtime_error("invalid NAS message type");
@@ -136,52 +182,52 @@ static void EncodeSm(SmMessage &msg, OctetString &stream)
     switch (msg.messageType)
     {
     case EMessageType::PDU_SESSION_ESTABLISHMENT_REQUEST:
-        EncodeViaBuilder((PduSessionEstablishmentRequest &)msg, stream);
+        EncodeViaTable((PduSessionEstablishmentRequest &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_ESTABLISHMENT_ACCEPT:
-        EncodeViaBuilder((PduSessionEstablishmentAccept &)msg, stream);
+        EncodeViaTable((PduSessionEstablishmentAccept &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_ESTABLISHMENT_REJECT:
-        EncodeViaBuilder((PduSessionEstablishmentReject &)msg, stream);
+        EncodeViaTable((PduSessionEstablishmentReject &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_AUTHENTICATION_COMMAND:
-        EncodeViaBuilder((PduSessionAuthenticationCommand &)msg, stream);
+        EncodeViaTable((PduSessionAuthenticationCommand &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_AUTHENTICATION_COMPLETE:
-        EncodeViaBuilder((PduSessionAuthenticationComplete &)msg, stream);
+        EncodeViaTable((PduSessionAuthenticationComplete &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_AUTHENTICATION_RESULT:
-        EncodeViaBuilder((PduSessionAuthenticationResult &)msg, stream);
+        EncodeViaTable((PduSessionAuthenticationResult &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_MODIFICATION_REQUEST:
-        EncodeViaBuilder((PduSessionModificationRequest &)msg, stream);
+        EncodeViaTable((PduSessionModificationRequest &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_MODIFICATION_REJECT:
-        EncodeViaBuilder((PduSessionModificationReject &)msg, stream);
+        EncodeViaTable((PduSessionModificationReject &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_MODIFICATION_COMMAND:
-        EncodeViaBuilder((PduSessionModificationCommand &)msg, stream);
+        EncodeViaTable((PduSessionModificationCommand &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_MODIFICATION_COMPLETE:
-        EncodeViaBuilder((PduSessionModificationComplete &)msg, stream);
+        EncodeViaTable((PduSessionModificationComplete &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_MODIFICATION_COMMAND_REJECT:
-        EncodeViaBuilder((PduSessionModificationCommandReject &)msg, stream);
+        EncodeViaTable((PduSessionModificationCommandReject &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_RELEASE_REQUEST:
-        EncodeViaBuilder((PduSessionReleaseRequest &)msg, stream);
+        EncodeViaTable((PduSessionReleaseRequest &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_RELEASE_REJECT:
-        EncodeViaBuilder((PduSessionReleaseReject &)msg, stream);
+        EncodeViaTable((PduSessionReleaseReject &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_RELEASE_COMMAND:
-        EncodeViaBuilder((PduSessionReleaseCommand &)msg, stream);
+        EncodeViaTable((PduSessionReleaseCommand &)msg, stream);
         break;
     case EMessageType::PDU_SESSION_RELEASE_COMPLETE:
-        EncodeViaBuilder((PduSessionReleaseComplete &)msg, stream);
+        EncodeViaTable((PduSessionReleaseComplete &)msg, stream);
         break;
     case EMessageType::FIVEG_SM_STATUS:
-        EncodeViaBuilder((FiveGSmStatus &)msg, stream);
+        EncodeViaTable((FiveGSmStatus &)msg, stream);
         break;
     default:
         throw std::runtime_error("invalid NAS message type");
@@ -214,29 +260,85 @@ static SecuredMmMessage *DecodeSecuredMmMessage(const OctetView &stream, ESecuri
     return p;
 }
 
+template <typename M, typename T>
+static inline void DecodeMandatory(M &msg, const IeMandatory<M, T> &ie, const OctetView &stream)
+{
+    msg.*ie.member = DecodeIe2346<T>(stream);
+}
+
+template <typename M, typename T>
+static inline void DecodeMandatory(M &msg, const IeMandatory1<M, T> &ie, const OctetView &stream)
+{
+    msg.*ie.member = DecodeIe1<T>(stream);
+}
+
+template <typename M, typename T, typename U>
+static inline void DecodeMandatory(M &msg, const IeMandatory1Pair<M, T, U> &ie, const OctetView &stream)
+{
+    int octet = stream.readI();
+    msg.*ie.high = T::Decode((octet >> 4) & 0xF);
+    msg.*ie.low = U::Decode(octet & 0xF);
+}
+
+template <typename M, typename D>
+static inline void DecodeMandatory(M &, const D &, const OctetView &)
+{
+}
+
+template <typename M, typename T>
+static inline bool DecodeOptional(M &msg, const IeOptional<M, T> &ie, int iei, const OctetView &stream)
+{
+    if (ie.iei != iei)
+        return false;
+    stream.readI();
+    msg.*ie.member = DecodeIe2346<T>(stream);
+    return true;
+}
+
+template <typename M, typename T>
+static inline bool DecodeOptional(M &msg, const IeOptional1<M, T> &ie, int iei, const OctetView &stream)
+{
+    if (ie.iei != iei)
+        return false;
+    msg.*ie.member = DecodeIe1<T>(stream);
+    return true;
+}
+
+template <typename M, typename D>
+static inline bool DecodeOptional(M &, const D &, int, const OctetView &)
+{
+    return false;
+}
+
 template <typename T>
-static T *DecodeViaBuilder(const OctetView &stream)
+static T *DecodeViaTable(const OctetView &stream)
 {
-    T *p = new T();
+    static constexpr auto table = T::IeTable();
 
-    NasMessageBuilder builder{};
-    p->onBuild(builder);
+    auto p = std::make_unique<T>();
+    auto &msg = *p;
 
-    for (auto &f : builder.mandatoryDecoders)
-        f(stream);
+    std::apply([&msg, &stream](const auto &...ie) { (DecodeMandatory(msg, ie, stream), ...); }, table);
 
     while (stream.hasNext())
     {
         int iei = stream.peekI();
-        if (builder.optionalDecoders.count(iei))
-            builder.optionalDecoders[iei](stream);
-        else if (builder.optionalDecoders.count((iei >> 4) & 0xF))
-            builder.optionalDecoders[(iei >> 4) & 0xF](stream);
-        else
+
+        // The full octet is tried first, then the high half-octet for type 1 IEs
+        bool decoded = std::apply(
+            [&msg, &stream, iei](const auto &...ie) { return (DecodeOptional(msg, ie, iei, stream) || ...); }, table);
+        if (!decoded)
+        {
+            int iei1 = (iei >> 4) & 0xF;
+            decoded = std::apply(
+                [&msg, &stream, iei1](const auto &...ie) { return (DecodeOptional(msg, ie, iei1, stream) || ...); },
+                table);
+        }
+        if (!decoded)
             throw std::runtime_error("Bad constructed NAS message");
     }
 
-    return p;
+    return p.release();
 }
 
 static PlainMmMessage *DecodePlainMmMessage(const OctetView &stream, EMessageType messageType)
@@ -244,61 +346,61 @@ static PlainMmMessage *DecodePlainMmMessage(const OctetView &stream, EMessageTyp
     switch (messageType)
     {
     case EMessageType::REGISTRATION_REQUEST:
-        return DecodeViaBuilder<RegistrationRequest>(stream);
+        return DecodeViaTable<RegistrationRequest>(stream);
     case EMessageType::REGISTRATION_ACCEPT:
-        return DecodeViaBuilder<RegistrationAccept>(stream);
+        return DecodeViaTable<RegistrationAccept>(stream);
     case EMessageType::REGISTRATION_COMPLETE:
-        return DecodeViaBuilder<RegistrationComplete>(stream);
+        return DecodeViaTable<RegistrationComplete>(stream);
     case EMessageType::REGISTRATION_REJECT:
-        return DecodeViaBuilder<RegistrationReject>(stream);
+        return DecodeViaTable<RegistrationReject>(stream);
     case EMessageType::DEREGISTRATION_REQUEST_UE_ORIGINATING:
-        return DecodeViaBuilder<DeRegistrationRequestUeOriginating>(stream);
+        return DecodeViaTable<DeRegistrationRequestUeOriginating>(stream);
     case EMessageType::DEREGISTRATION_ACCEPT_UE_ORIGINATING:
-        return DecodeViaBuilder<DeRegistrationAcceptUeOriginating>(stream);
+        return DecodeViaTable<DeRegistrationAcceptUeOriginating>(stream);
     case EMessageType::DEREGISTRATION_REQUEST_UE_TERMINATED:
-        return DecodeViaBuilder<DeRegistrationRequestUeTerminated>(stream);
+        return DecodeViaTable<DeRegistrationRequestUeTerminated>(stream);
     case EMessageType::DEREGISTRATION_ACCEPT_UE_TERMINATED:
-        return DecodeViaBuilder<DeRegistrationAcceptUeTerminated>(stream);
+        return DecodeViaTable<DeRegistrationAcceptUeTerminated>(stream);
     case EMessageType::SERVICE_REQUEST:
-        return DecodeViaBuilder<ServiceRequest>(stream);
+        return DecodeViaTable<ServiceRequest>(stream);
     case EMessageType::SERVICE_REJECT:
-        return DecodeViaBuilder<ServiceReject>(stream);
+        return DecodeViaTable<ServiceReject>(stream);
     case EMessageType::SERVICE_ACCEPT:
-        return DecodeViaBuilder<ServiceAccept>(stream);
+        return DecodeViaTable<ServiceAccept>(stream);
     case EMessageType::CONFIGURATION_UPDATE_COMMAND:
-        return DecodeViaBuilder<ConfigurationUpdateCommand>(stream);
+        return DecodeViaTable<ConfigurationUpdateCommand>(stream);
     case EMessageType::CONFIGURATION_UPDATE_COMPLETE:
-        return DecodeViaBuilder<ConfigurationUpdateComplete>(stream);
+        return DecodeViaTable<ConfigurationUpdateComplete>(stream);
     case EMessageType::AUTHENTICATION_REQUEST:
-        return DecodeViaBuilder<AuthenticationRequest>(stream);
+        return DecodeViaTable<AuthenticationRequest>(stream);
     case EMessageType::AUTHENTICATION_RESPONSE:
-        return DecodeViaBuilder<AuthenticationResponse>(stream);
+        return DecodeViaTable<AuthenticationResponse>(stream);
     case EMessageType::AUTHENTICATION_REJECT:
-        return DecodeViaBuilder<AuthenticationReject>(stream);
+        return DecodeViaTable<AuthenticationReject>(stream);
     case EMessageType::AUTHENTICATION_FAILURE:
-        return DecodeViaBuilder<AuthenticationFailure>(stream);
+        return DecodeViaTable<AuthenticationFailure>(stream);
     case EMessageType::AUTHENTICATION_RESULT:
-        return DecodeViaBuilder<AuthenticationResult>(stream);
+        return DecodeViaTable<AuthenticationResult>(stream);
     case EMessageType::IDENTITY_REQUEST:
-        return DecodeViaBuilder<IdentityRequest>(stream);
+        return DecodeViaTable<IdentityRequest>(stream);
     case EMessageType::IDENTITY_RESPONSE:
-        return DecodeViaBuilder<IdentityResponse>(stream);
+        return DecodeViaTable<IdentityResponse>(stream);
     case EMessageType::SECURITY_MODE_COMMAND:
-        return DecodeViaBuilder<SecurityModeCommand>(stream);
+        return DecodeViaTable<SecurityModeCommand>(stream);
     case EMessageType::SECURITY_MODE_COMPLETE:
-        return DecodeViaBuilder<SecurityModeComplete>(stream);
+        return DecodeViaTable<SecurityModeComplete>(stream);
     case EMessageType::SECURITY_MODE_REJECT:
-        return DecodeViaBuilder<SecurityModeReject>(stream);
+        return DecodeViaTable<SecurityModeReject>(stream);
     case EMessageType::FIVEG_MM_STATUS:
-        return DecodeViaBuilder<FiveGMmStatus>(stream);
+        return DecodeViaTable<FiveGMmStatus>(stream);
     case EMessageType::NOTIFICATION:
-        return DecodeViaBuilder<Notification>(stream);
+        return DecodeViaTable<Notification>(stream);
     case EMessageType::NOTIFICATION_RESPONSE:
-        return DecodeViaBuilder<NotificationResponse>(stream);
+        return DecodeViaTable<NotificationResponse>(stream);
     case EMessageType::UL_NAS_TRANSPORT:
-        return DecodeViaBuilder<UlNasTransport>(stream);
+        return DecodeViaTable<UlNasTransport>(stream);
     case EMessageType::DL_NAS_TRANSPORT:
-        return DecodeViaBuilder<DlNasTransport>(stream);
+        return DecodeViaTable<DlNasTransport>(stream);
     default:
         throw std::runtime_error("invalid NAS message type");
     }
@@ -309,37 +411,37 @@ static SmMessage *DecodeSmMessage(const OctetView &stream, EMessageType messageT
     switch (messageType)
     {
     case EMessageType::PDU_SESSION_ESTABLISHMENT_REQUEST:
-        return DecodeViaBuilder<PduSessionEstablishmentRequest>(stream);
+        return DecodeViaTable<PduSessionEstablishmentRequest>(stream);
     case EMessageType::PDU_SESSION_ESTABLISHMENT_ACCEPT:
-        return DecodeViaBuilder<PduSessionEstablishmentAccept>(stream);
+        return DecodeViaTable<PduSessionEstablishmentAccept>(stream);
     case EMessageType::PDU_SESSION_ESTABLISHMENT_REJECT:
-        return DecodeViaBuilder<PduSessionEstablishmentReject>(stream);
+        return DecodeViaTable<PduSessionEstablishmentReject>(stream);
     case EMessageType::PDU_SESSION_AUTHENTICATION_COMMAND:
-        return DecodeViaBuilder<PduSessionAuthenticationCommand>(stream);
+        return DecodeViaTable<PduSessionAuthenticationCommand>(stream);
     case EMessageType::PDU_SESSION_AUTHENTICATION_COMPLETE:
-        return DecodeViaBuilder<PduSessionAuthenticationComplete>(stream);
+        return DecodeViaTable<PduSessionAuthenticationComplete>(stream);
     case EMessageType::PDU_SESSION_AUTHENTICATION_RESULT:
-        return DecodeViaBuilder<PduSessionAuthenticationResult>(stream);
+        return DecodeViaTable<PduSessionAuthenticationResult>(stream);
     case EMessageType::PDU_SESSION_MODIFICATION_REQUEST:
-        return DecodeViaBuilder<PduSessionModificationRequest>(stream);
+        return DecodeViaTable<PduSessionModificationRequest>(stream);
     case EMessageType::PDU_SESSION_MODIFICATION_REJECT:
-        return DecodeViaBuilder<PduSessionModificationReject>(stream);
+        return DecodeViaTable<PduSessionModificationReject>(stream);
     case EMessageType::PDU_SESSION_MODIFICATION_COMMAND:
-        return DecodeViaBuilder<PduSessionModificationCommand>(stream);
+        return DecodeViaTable<PduSessionModificationCommand>(stream);
     case EMessageType::PDU_SESSION_MODIFICATION_COMPLETE:
-        return DecodeViaBuilder<PduSessionModificationComplete>(stream);
+        return DecodeViaTable<PduSessionModificationComplete>(stream);
     case EMessageType::PDU_SESSION_MODIFICATION_COMMAND_REJECT:
-        return DecodeViaBuilder<PduSessionModificationCommandReject>(stream);
+        return DecodeViaTable<PduSessionModificationCommandReject>(stream);
     case EMessageType::PDU_SESSION_RELEASE_REQUEST:
-        return DecodeViaBuilder<PduSessionReleaseRequest>(stream);
+        return DecodeViaTable<PduSessionReleaseRequest>(stream);
     case EMessageType::PDU_SESSION_RELEASE_REJECT:
-        return DecodeViaBuilder<PduSessionReleaseReject>(stream);
+        return DecodeViaTable<PduSessionReleaseReject>(stream);
     case EMessageType::PDU_SESSION_RELEASE_COMMAND:
-        return DecodeViaBuilder<PduSessionReleaseCommand>(stream);
+        return DecodeViaTable<PduSessionReleaseCommand>(stream);
     case EMessageType::PDU_SESSION_RELEASE_COMPLETE:
-        return DecodeViaBuilder<PduSessionReleaseComplete>(stream);
+        return DecodeViaTable<PduSessionReleaseComplete>(stream);
     case EMessageType::FIVEG_SM_STATUS:
-        return DecodeViaBuilder<FiveGSmStatus>(stream);
+        return DecodeViaTable<FiveGSmStatus>(stream);
     default:
         throw std::runtime_error("invalid NAS message type");
     }
@@ -14,68 +14,81 @@
 #include "ie4.hpp"
 #include "ie6.hpp"
 
+#include <optional>
+#include <tuple>
+
 namespace nas
 {
 
-struct NasMessageBuilder
+/**
+ * Descriptors of the IEs of a NAS message. Each message type defines a constexpr table of these descriptors via its
+ * IeTable() function, that is walked by the encoder and the decoder at compile time.
+ * <p>
+ * Mandatory IEs are encoded and decoded in the order of the table, and optional IEs follow them. Optional IEs are
+ * recognized by the full IEI octet first, and by the high half-octet for type 1 IEs.
+ */
+template <typename M, typename T>
+struct IeMandatory
 {
-    std::vector<std::function<void(OctetString &)>> mandatoryEncoders{};
-    std::vector<std::function<void(OctetString &)>> optionalEncoders{};
+    T M::*member;
+};
 
-    std::vector<std::function<void(const OctetView &)>> mandatoryDecoders{};
-    std::unordered_map<int, std::function<void(const OctetView &)>> optionalDecoders{};
+template <typename M, typename T>
+struct IeMandatory1
+{
+    T M::*member;
+};
 
-    template <typename T>
-    inline void mandatoryIE(T *ptr)
-    {
-        mandatoryEncoders.push_back([ptr](OctetString &stream) { Encode2346(*ptr, stream); });
-        mandatoryDecoders.push_back([ptr](const OctetView &stream) { *ptr = DecodeIe2346<T>(stream); });
-    }
+template <typename M, typename T, typename U>
+struct IeMandatory1Pair
+{
+    T M::*high;
+    U M::*low;
+};
 
-    template <typename T>
-    inline void mandatoryIE1(T *ptr)
-    {
-        mandatoryEncoders.push_back([ptr](OctetString &stream) { EncodeIe1(0, *ptr, stream); });
-        mandatoryDecoders.push_back([ptr](const OctetView &stream) { *ptr = DecodeIe1<T>(stream); });
-    }
+template <typename M, typename T>
+struct IeOptional
+{
+    int iei;
+    std::optional<T> M::*member;
+};
 
-    template <typename T, typename U>
-    inline void mandatoryIE1(T *ptr1, U *ptr2)
-    {
-        mandatoryEncoders.push_back([ptr1, ptr2](OctetString &stream) { EncodeIe1(*ptr1, *ptr2, stream); });
-        mandatoryDecoders.push_back([ptr1, ptr2](const OctetView &stream) {
-            int octet = stream.readI();
-            *ptr1 = T::Decode((octet >> 4) & 0xF);
-            *ptr2 = U::Decode(octet & 0xF);
-        });
-    }
+template <typename M, typename T>
+struct IeOptional1
+{
+    int iei;
+    std::optional<T> M::*member;
+};
 
-    template <typename T>
-    inline void optionalIE(int iei, std::optional<T> *ptr)
-    {
-        optionalEncoders.push_back([ptr, iei](OctetString &stream) {
-            if (ptr->has_value())
-            {
-                stream.appendOctet(iei);
-                Encode2346(ptr->value(), stream);
-            }
-        });
-        optionalDecoders[iei] = [ptr](const OctetView &stream) {
-            stream.readI();
-            *ptr = DecodeIe2346<T>(stream);
-        };
-    }
+template <typename M, typename T>
+constexpr IeMandatory<M, T> MandatoryIE(T M::*member)
+{
+    return {member};
+}
 
-    template <typename T>
-    inline void optionalIE1(int iei, std::optional<T> *ptr)
-    {
-        optionalEncoders.push_back([ptr, iei](OctetString &stream) {
-            if (ptr->has_value())
-                EncodeIe1(iei, ptr->value(), stream);
-        });
-        optionalDecoders[iei] = [ptr](const OctetView &stream) { *ptr = DecodeIe1<T>(stream); };
-    }
-};
+template <typename M, typename T>
+constexpr IeMandatory1<M, T> MandatoryIE1(T M::*member)
+{
+    return {member};
+}
+
+template <typename M, typename T, typename U>
+constexpr IeMandatory1Pair<M, T, U> MandatoryIE1(T M::*high, U M::*low)
+{
+    return {high, low};
+}
+
+template <typename M, typename T>
+constexpr IeOptional<M, T> OptionalIE(int iei, std::optional<T> M::*member)
+{
+    return {iei, member};
+}
+
+template <typename M, typename T>
+constexpr IeOptional1<M, T> OptionalIE1(int iei, std::optional<T> M::*member)
+{
+    return {iei, member};
+}
 
 struct NasMessage
 {
@@ -126,7 +139,12 @@ struct AuthenticationFailure : PlainMmMessage
     std::optional<IEAuthenticationFailureParameter> authenticationFailureParameter{};
 
     AuthenticationFailure();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = AuthenticationFailure;
+        return std::make_tuple(MandatoryIE(&M::mmCause), OptionalIE(0x30, &M::authenticationFailureParameter));
+    }
 };
 
 struct AuthenticationReject : PlainMmMessage
@@ -134,7 +152,12 @@ struct AuthenticationReject : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     AuthenticationReject();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = AuthenticationReject;
+        return std::make_tuple(OptionalIE(0x78, &M::eapMessage));
+    }
 };
 
 struct AuthenticationRequest : PlainMmMessage
@@ -146,7 +169,13 @@ struct AuthenticationRequest : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     AuthenticationRequest();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = AuthenticationRequest;
+        return std::make_tuple(MandatoryIE1(&M::ngKSI), MandatoryIE(&M::abba), OptionalIE(0x21, &M::authParamRAND),
+                               OptionalIE(0x20, &M::authParamAUTN), OptionalIE(0x78, &M::eapMessage));
+    }
 };
 
 struct AuthenticationResponse : PlainMmMessage
@@ -155,7 +184,12 @@ struct AuthenticationResponse : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     AuthenticationResponse();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = AuthenticationResponse;
+        return std::make_tuple(OptionalIE(0x2D, &M::authenticationResponseParameter), OptionalIE(0x78, &M::eapMessage));
+    }
 };
 
 struct AuthenticationResult : PlainMmMessage
@@ -165,7 +199,12 @@ struct AuthenticationResult : PlainMmMessage
     std::optional<IEAbba> abba{};
 
     AuthenticationResult();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = AuthenticationResult;
+        return std::make_tuple(MandatoryIE1(&M::ngKSI), MandatoryIE(&M::eapMessage), OptionalIE(0x38, &M::abba));
+    }
 };
 
 struct ConfigurationUpdateCommand : PlainMmMessage
@@ -189,25 +228,51 @@ struct ConfigurationUpdateCommand : PlainMmMessage
     std::optional<IESmsIndication> smsIndication{};
 
     ConfigurationUpdateCommand();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = ConfigurationUpdateCommand;
+        return std::make_tuple(OptionalIE1(0xD, &M::configurationUpdateIndication), OptionalIE(0x77, &M::guti),
+                               OptionalIE(0x54, &M::taiList), OptionalIE(0x15, &M::allowedNssai),
+                               OptionalIE(0x27, &M::serviceAreaList), OptionalIE(0x43, &M::networkFullName),
+                               OptionalIE(0x45, &M::networkShortName), OptionalIE(0x46, &M::localTimeZone),
+                               OptionalIE(0x47, &M::universalTimeAndLocalTimeZone),
+                               OptionalIE(0x49, &M::networkDaylightSavingTime), OptionalIE(0x79, &M::ladnInformation),
+                               OptionalIE1(0xB, &M::micoIndication), OptionalIE1(0x9, &M::networkSlicingIndication),
+                               OptionalIE(0x31, &M::configuredNssai), OptionalIE(0x11, &M::rejectedNssai),
+                               OptionalIE(0x76, &M::operatorDefinedAccessCategoryDefinitions),
+                               OptionalIE1(0xF, &M::smsIndication));
+    }
 };
 
 struct ConfigurationUpdateComplete : PlainMmMessage
 {
     ConfigurationUpdateComplete();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        return std::make_tuple();
+    }
 };
 
 struct DeRegistrationAcceptUeOriginating : PlainMmMessage
 {
     DeRegistrationAcceptUeOriginating();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        return std::make_tuple();
+    }
 };
 
 struct DeRegistrationAcceptUeTerminated : PlainMmMessage
 {
     DeRegistrationAcceptUeTerminated();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        return std::make_tuple();
+    }
 };
 
 struct DeRegistrationRequestUeOriginating : PlainMmMessage
@@ -217,7 +282,12 @@ struct DeRegistrationRequestUeOriginating : PlainMmMessage
     IE5gsMobileIdentity mobileIdentity{};
 
     DeRegistrationRequestUeOriginating();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = DeRegistrationRequestUeOriginating;
+        return std::make_tuple(MandatoryIE1(&M::ngKSI, &M::deRegistrationType), MandatoryIE(&M::mobileIdentity));
+    }
 };
 
 struct DeRegistrationRequestUeTerminated : PlainMmMessage
@@ -227,7 +297,13 @@ struct DeRegistrationRequestUeTerminated : PlainMmMessage
     std::optional<IEGprsTimer2> t3346Value{};
 
     DeRegistrationRequestUeTerminated();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = DeRegistrationRequestUeTerminated;
+        return std::make_tuple(MandatoryIE1(&M::deRegistrationType), OptionalIE(0x58, &M::mmCause),
+                               OptionalIE(0x5F, &M::t3346Value));
+    }
 };
 
 struct DlNasTransport : PlainMmMessage
@@ -240,7 +316,14 @@ struct DlNasTransport : PlainMmMessage
     std::optional<IEGprsTimer3> backOffTimerValue{};
 
     DlNasTransport();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = DlNasTransport;
+        return std::make_tuple(MandatoryIE1(&M::payloadContainerType), MandatoryIE(&M::payloadContainer),
+                               OptionalIE(0x12, &M::pduSessionId), OptionalIE(0x24, &M::additionalInformation),
+                               OptionalIE(0x58, &M::mmCause), OptionalIE(0x37, &M::backOffTimerValue));
+    }
 };
 
 struct FiveGMmStatus : PlainMmMessage
@@ -248,7 +331,12 @@ struct FiveGMmStatus : PlainMmMessage
     IE5gMmCause mmCause{};
 
     FiveGMmStatus();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = FiveGMmStatus;
+        return std::make_tuple(MandatoryIE(&M::mmCause));
+    }
 };
 
 struct FiveGSmStatus : SmMessage
@@ -256,7 +344,12 @@ struct FiveGSmStatus : SmMessage
     IE5gSmCause smCause{};
 
     FiveGSmStatus();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = FiveGSmStatus;
+        return std::make_tuple(MandatoryIE(&M::smCause));
+    }
 };
 
 struct IdentityRequest : PlainMmMessage
@@ -264,7 +357,12 @@ struct IdentityRequest : PlainMmMessage
     IE5gsIdentityType identityType{};
 
     IdentityRequest();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = IdentityRequest;
+        return std::make_tuple(MandatoryIE1(&M::identityType));
+    }
 };
 
 struct IdentityResponse : PlainMmMessage
@@ -272,7 +370,12 @@ struct IdentityResponse : PlainMmMessage
     IE5gsMobileIdentity mobileIdentity{};
 
     IdentityResponse();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = IdentityResponse;
+        return std::make_tuple(MandatoryIE(&M::mobileIdentity));
+    }
 };
 
 struct Notification : PlainMmMessage
@@ -280,7 +383,12 @@ struct Notification : PlainMmMessage
     IEAccessType accessType{};
 
     Notification();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = Notification;
+        return std::make_tuple(MandatoryIE1(&M::accessType));
+    }
 };
 
 struct NotificationResponse : PlainMmMessage
@@ -288,7 +396,12 @@ struct NotificationResponse : PlainMmMessage
     std::optional<IEPduSessionStatus> pduSessionStatus{};
 
     NotificationResponse();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = NotificationResponse;
+        return std::make_tuple(OptionalIE(0x50, &M::pduSessionStatus));
+    }
 };
 
 struct PduSessionAuthenticationCommand : SmMessage
@@ -297,7 +410,12 @@ struct PduSessionAuthenticationCommand : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionAuthenticationCommand();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionAuthenticationCommand;
+        return std::make_tuple(MandatoryIE(&M::eapMessage), OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionAuthenticationComplete : SmMessage
@@ -306,7 +424,12 @@ struct PduSessionAuthenticationComplete : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionAuthenticationComplete();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionAuthenticationComplete;
+        return std::make_tuple(MandatoryIE(&M::eapMessage), OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionAuthenticationResult : SmMessage
@@ -315,7 +438,13 @@ struct PduSessionAuthenticationResult : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionAuthenticationResult();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionAuthenticationResult;
+        return std::make_tuple(OptionalIE(0x78, &M::eapMessage),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionEstablishmentAccept : SmMessage
@@ -336,7 +465,19 @@ struct PduSessionEstablishmentAccept : SmMessage
     std::optional<IEDnn> dnn{};
 
     PduSessionEstablishmentAccept();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionEstablishmentAccept;
+        return std::make_tuple(MandatoryIE1(&M::selectedSscMode, &M::selectedPduSessionType),
+                               MandatoryIE(&M::authorizedQoSRules), MandatoryIE(&M::sessionAmbr),
+                               OptionalIE(0x59, &M::smCause), OptionalIE(0x29, &M::pduAddress),
+                               OptionalIE(0x56, &M::rqTimerValue), OptionalIE(0x22, &M::sNssai),
+                               OptionalIE1(0x8, &M::alwaysOnPduSessionIndication),
+                               OptionalIE(0x7F, &M::mappedEpsBearerContexts), OptionalIE(0x78, &M::eapMessage),
+                               OptionalIE(0x79, &M::authorizedQoSFlowDescriptions),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions), OptionalIE(0x25, &M::dnn));
+    }
 };
 
 struct PduSessionEstablishmentReject : SmMessage
@@ -348,7 +489,14 @@ struct PduSessionEstablishmentReject : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionEstablishmentReject();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionEstablishmentReject;
+        return std::make_tuple(MandatoryIE(&M::smCause), OptionalIE(0x37, &M::backOffTimerValue),
+                               OptionalIE1(0xF, &M::allowedSscMode), OptionalIE(0x78, &M::eapMessage),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionEstablishmentRequest : SmMessage
@@ -363,7 +511,18 @@ struct PduSessionEstablishmentRequest : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionEstablishmentRequest();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionEstablishmentRequest;
+        return std::make_tuple(MandatoryIE(&M::integrityProtectionMaximumDataRate),
+                               OptionalIE1(0x9, &M::pduSessionType), OptionalIE1(0xA, &M::sscMode),
+                               OptionalIE(0x28, &M::smCapability),
+                               OptionalIE(0x55, &M::maximumNumberOfSupportedPacketFilters),
+                               OptionalIE1(0xB, &M::alwaysOnPduSessionRequested),
+                               OptionalIE(0x39, &M::smPduDnRequestContainer),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionModificationCommand : SmMessage
@@ -378,7 +537,16 @@ struct PduSessionModificationCommand : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationCommand();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionModificationCommand;
+        return std::make_tuple(OptionalIE(0x59, &M::smCause), OptionalIE(0x2A, &M::sessionAmbr),
+                               OptionalIE(0x56, &M::rqTimerValue), OptionalIE1(0x8, &M::alwaysOnPduSessionIndication),
+                               OptionalIE(0x7A, &M::authorizedQoSRules), OptionalIE(0x7F, &M::mappedEpsBearerContexts),
+                               OptionalIE(0x79, &M::authorizedQoSFlowDescriptions),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionModificationCommandReject : SmMessage
@@ -387,7 +555,12 @@ struct PduSessionModificationCommandReject : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationCommandReject();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionModificationCommandReject;
+        return std::make_tuple(MandatoryIE(&M::smCause), OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionModificationComplete : SmMessage
@@ -395,7 +568,12 @@ struct PduSessionModificationComplete : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationComplete();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionModificationComplete;
+        return std::make_tuple(OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionModificationReject : SmMessage
@@ -405,7 +583,13 @@ struct PduSessionModificationReject : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationReject();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionModificationReject;
+        return std::make_tuple(MandatoryIE(&M::smCause), OptionalIE(0x37, &M::backOffTimerValue),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionModificationRequest : SmMessage
@@ -421,7 +605,19 @@ struct PduSessionModificationRequest : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionModificationRequest();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionModificationRequest;
+        return std::make_tuple(OptionalIE(0x28, &M::smCapability), OptionalIE(0x59, &M::smCause),
+                               OptionalIE(0x55, &M::maximumNumberOfSupportedPacketFilters),
+                               OptionalIE1(0xB, &M::alwaysOnPduSessionRequested),
+                               OptionalIE(0x13, &M::integrityProtectionMaximumDataRate),
+                               OptionalIE(0x7A, &M::requestedQosRules),
+                               OptionalIE(0x79, &M::requestedQosFlowDescriptions),
+                               OptionalIE(0x7F, &M::mappedEpsBearerContexts),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionReleaseCommand : SmMessage
@@ -432,7 +628,14 @@ struct PduSessionReleaseCommand : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionReleaseCommand();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionReleaseCommand;
+        return std::make_tuple(MandatoryIE(&M::smCause), OptionalIE(0x37, &M::backOffTimerValue),
+                               OptionalIE(0x78, &M::eapMessage),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionReleaseComplete : SmMessage
@@ -441,7 +644,13 @@ struct PduSessionReleaseComplete : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionReleaseComplete();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionReleaseComplete;
+        return std::make_tuple(OptionalIE(0x59, &M::smCause),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionReleaseReject : SmMessage
@@ -450,7 +659,12 @@ struct PduSessionReleaseReject : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionReleaseReject();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionReleaseReject;
+        return std::make_tuple(MandatoryIE(&M::smCause), OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct PduSessionReleaseRequest : SmMessage
@@ -459,7 +673,13 @@ struct PduSessionReleaseRequest : SmMessage
     std::optional<IEExtendedProtocolConfigurationOptions> extendedProtocolConfigurationOptions{};
 
     PduSessionReleaseRequest();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = PduSessionReleaseRequest;
+        return std::make_tuple(OptionalIE(0x59, &M::smCause),
+                               OptionalIE(0x7B, &M::extendedProtocolConfigurationOptions));
+    }
 };
 
 struct RegistrationAccept : PlainMmMessage
@@ -491,7 +711,26 @@ struct RegistrationAccept : PlainMmMessage
     std::optional<IEExtendedEmergencyNumberList> extendedEmergencyNumberList{};
 
     RegistrationAccept();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = RegistrationAccept;
+        return std::make_tuple(MandatoryIE(&M::registrationResult), OptionalIE1(0x9, &M::networkSlicingIndication),
+                               OptionalIE1(0xA, &M::nssaiInclusionMode), OptionalIE1(0xB, &M::micoIndication),
+                               OptionalIE(0x77, &M::mobileIdentity), OptionalIE(0x4A, &M::equivalentPLMNs),
+                               OptionalIE(0x54, &M::taiList), OptionalIE(0x15, &M::allowedNSSAI),
+                               OptionalIE(0x11, &M::rejectedNSSAI), OptionalIE(0x31, &M::configuredNSSAI),
+                               OptionalIE(0x21, &M::networkFeatureSupport), OptionalIE(0x50, &M::pduSessionStatus),
+                               OptionalIE(0x26, &M::pduSessionReactivationResult),
+                               OptionalIE(0x72, &M::pduSessionReactivationResultErrorCause),
+                               OptionalIE(0x79, &M::ladnInformation), OptionalIE(0x27, &M::serviceAreaList),
+                               OptionalIE(0x5E, &M::t3512Value), OptionalIE(0x5D, &M::non3gppDeRegistrationTimerValue),
+                               OptionalIE(0x16, &M::t3502Value), OptionalIE(0x34, &M::emergencyNumberList),
+                               OptionalIE(0x7A, &M::extendedEmergencyNumberList),
+                               OptionalIE(0x73, &M::sorTransparentContainer), OptionalIE(0x78, &M::eapMessage),
+                               OptionalIE(0x76, &M::operatorDefinedAccessCategoryDefinitions),
+                               OptionalIE(0x51, &M::negotiatedDrxParameters));
+    }
 };
 
 struct RegistrationComplete : PlainMmMessage
@@ -499,7 +738,12 @@ struct RegistrationComplete : PlainMmMessage
     std::optional<IESorTransparentContainer> sorTransparentContainer{};
 
     RegistrationComplete();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = RegistrationComplete;
+        return std::make_tuple(OptionalIE(0x73, &M::sorTransparentContainer));
+    }
 };
 
 struct RegistrationReject : PlainMmMessage
@@ -510,7 +754,13 @@ struct RegistrationReject : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     RegistrationReject();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = RegistrationReject;
+        return std::make_tuple(MandatoryIE(&M::mmCause), OptionalIE(0x5F, &M::t3346value),
+                               OptionalIE(0x16, &M::t3502value), OptionalIE(0x78, &M::eapMessage));
+    }
 };
 
 struct RegistrationRequest : PlainMmMessage
@@ -540,7 +790,23 @@ struct RegistrationRequest : PlainMmMessage
     std::optional<IELadnIndication> ladnIndication{};
 
     RegistrationRequest();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = RegistrationRequest;
+        return std::make_tuple(MandatoryIE1(&M::nasKeySetIdentifier, &M::registrationType),
+                               MandatoryIE(&M::mobileIdentity), OptionalIE1(0xC, &M::nonCurrentNgKsi),
+                               OptionalIE1(0xB, &M::micoIndication), OptionalIE1(0x9, &M::networkSlicingIndication),
+                               OptionalIE(0x10, &M::mmCapability), OptionalIE(0x2E, &M::ueSecurityCapability),
+                               OptionalIE(0x2F, &M::requestedNSSAI), OptionalIE(0x52, &M::lastVisitedRegisteredTai),
+                               OptionalIE(0x17, &M::s1UeNetworkCapability), OptionalIE(0x40, &M::uplinkDataStatus),
+                               OptionalIE(0x50, &M::pduSessionStatus), OptionalIE(0x2B, &M::ueStatus),
+                               OptionalIE(0x77, &M::additionalGuti), OptionalIE(0x25, &M::allowedPduSessionStatus),
+                               OptionalIE(0x18, &M::uesUsageSetting), OptionalIE(0x51, &M::requestedDrxParameters),
+                               OptionalIE(0x70, &M::epsNasMessageContainer), OptionalIE(0x7E, &M::ladnIndication),
+                               OptionalIE(0x7B, &M::payloadContainer), OptionalIE(0x53, &M::updateType),
+                               OptionalIE(0x71, &M::nasMessageContainer));
+    }
 };
 
 struct SecurityModeCommand : PlainMmMessage
@@ -559,7 +825,16 @@ struct SecurityModeCommand : PlainMmMessage
     OctetString _originalPlainNasPdu{};
 
     SecurityModeCommand();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = SecurityModeCommand;
+        return std::make_tuple(MandatoryIE(&M::selectedNasSecurityAlgorithms), MandatoryIE1(&M::ngKsi),
+                               MandatoryIE(&M::replayedUeSecurityCapabilities), OptionalIE1(0xE, &M::imeiSvRequest),
+                               OptionalIE(0x57, &M::epsNasSecurityAlgorithms),
+                               OptionalIE(0x36, &M::additional5gSecurityInformation), OptionalIE(0x78, &M::eapMessage),
+                               OptionalIE(0x38, &M::abba), OptionalIE(0x19, &M::replayedS1UeNetworkCapability));
+    }
 };
 
 struct SecurityModeComplete : PlainMmMessage
@@ -568,7 +843,12 @@ struct SecurityModeComplete : PlainMmMessage
     std::optional<IENasMessageContainer> nasMessageContainer{};
 
     SecurityModeComplete();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = SecurityModeComplete;
+        return std::make_tuple(OptionalIE(0x77, &M::imeiSv), OptionalIE(0x71, &M::nasMessageContainer));
+    }
 };
 
 struct SecurityModeReject : PlainMmMessage
@@ -576,7 +856,12 @@ struct SecurityModeReject : PlainMmMessage
     IE5gMmCause mmCause{};
 
     SecurityModeReject();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = SecurityModeReject;
+        return std::make_tuple(MandatoryIE(&M::mmCause));
+    }
 };
 
 struct ServiceAccept : PlainMmMessage
@@ -587,7 +872,15 @@ struct ServiceAccept : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     ServiceAccept();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = ServiceAccept;
+        return std::make_tuple(OptionalIE(0x50, &M::pduSessionStatus),
+                               OptionalIE(0x26, &M::pduSessionReactivationResult),
+                               OptionalIE(0x72, &M::pduSessionReactivationResultErrorCause),
+                               OptionalIE(0x78, &M::eapMessage));
+    }
 };
 
 struct ServiceReject : PlainMmMessage
@@ -598,7 +891,13 @@ struct ServiceReject : PlainMmMessage
     std::optional<IEEapMessage> eapMessage{};
 
     ServiceReject();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = ServiceReject;
+        return std::make_tuple(MandatoryIE(&M::mmCause), OptionalIE(0x50, &M::pduSessionStatus),
+                               OptionalIE(0x5f, &M::t3346Value), OptionalIE(0x78, &M::eapMessage));
+    }
 };
 
 struct ServiceRequest : PlainMmMessage
@@ -612,7 +911,15 @@ struct ServiceRequest : PlainMmMessage
     std::optional<IENasMessageContainer> nasMessageContainer{};
 
     ServiceRequest();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = ServiceRequest;
+        return std::make_tuple(MandatoryIE1(&M::serviceType, &M::ngKSI), MandatoryIE(&M::tmsi),
+                               OptionalIE(0x40, &M::uplinkDataStatus), OptionalIE(0x50, &M::pduSessionStatus),
+                               OptionalIE(0x25, &M::allowedPduSessionStatus),
+                               OptionalIE(0x71, &M::nasMessageContainer));
+    }
 };
 
 struct UlNasTransport : PlainMmMessage
@@ -627,7 +934,15 @@ struct UlNasTransport : PlainMmMessage
     std::optional<IEAdditionalInformation> additionalInformation{};
 
     UlNasTransport();
-    void onBuild(NasMessageBuilder &b);
+
+    static constexpr auto IeTable()
+    {
+        using M = UlNasTransport;
+        return std::make_tuple(MandatoryIE1(&M::payloadContainerType), MandatoryIE(&M::payloadContainer),
+                               OptionalIE(0x12, &M::pduSessionId), OptionalIE(0x59, &M::oldPduSessionId),
+                               OptionalIE1(0x8, &M::requestType), OptionalIE(0x22, &M::sNssai),
+                               OptionalIE(0x25, &M::dnn), OptionalIE(0x24, &M::additionalInformation));
+    }
 };
 
 } // namespace nas
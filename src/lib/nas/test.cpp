@@ -0,0 +1,108 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "test.hpp"
+#include "encode.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace nas
+{
+
+struct FlowMessage
+{
+    const char *name;
+    const char *hex;
+};
+
+/**
+ * Plain NAS messages of an initial registration followed by a PDU session establishment, as exchanged between a UE
+ * and a core network. Security protected messages carry the same plain messages after a fixed header, and session
+ * management messages are also decoded separately from the payload containers, as the UE does.
+ */
+static const FlowMessage REGISTRATION_FLOW[] = {
+    {"RegistrationRequest", "7e004179000d0100f1100000000000000000101001002e04f0f0f0f02f050401000001"},
+    {"AuthenticationRequest",
+     "7e00560002000021000102030405060708090a0b0c0d0e0f2010101112131415161718191a1b1c1d1e1f"},
+    {"AuthenticationResponse", "7e00572d10202122232425262728292a2b2c2d2e2f"},
+    {"SecurityModeCommand", "7e005d020004f0f0f0f0e1360102"},
+    {"SecurityModeComplete",
+     "7e005e7100237e004179000d0100f1100000000000000000101001002e04f0f0f0f02f050401000001"},
+    {"RegistrationAccept", "7e0042010177000bf200f110020040c000000154070000f11000000115050401000001210200005e0106"},
+    {"RegistrationComplete", "7e0043"},
+    {"UlNasTransport", "7e00670100082e0101c1ffff91a1120181220401000001250908696e7465726e6574"},
+    {"PduSessionEstablishmentRequest", "2e0101c1ffff91a1"},
+    {"DlNasTransport",
+     "7e006801002e2e0101c2110008010006310101ff09060600010600012905010a2d0002220401000001250908696e7465726e65741201"},
+    {"PduSessionEstablishmentAccept",
+     "2e0101c2110008010006310101ff09060600010600012905010a2d0002220401000001250908696e7465726e6574"},
+};
+
+NasBenchmarkResult RunNasBenchmark(const NasBenchmarkConfig &config)
+{
+    using Clock = std::chrono::steady_clock;
+
+    NasBenchmarkResult res{};
+    int iterations = std::max(config.iterations, 1);
+
+    for (auto &flowMessage : REGISTRATION_FLOW)
+    {
+        OctetString pdu = OctetString::FromHex(flowMessage.hex);
+
+        NasBenchmarkMessageResult r{};
+        r.name = flowMessage.name;
+        r.size = pdu.length();
+
+        auto message = DecodeNasMessage(OctetView{pdu});
+        OctetString encoded{};
+        EncodeNasMessage(*message, encoded);
+        r.roundTrip = encoded == pdu;
+
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            OctetView view{pdu};
+            message = DecodeNasMessage(view);
+        }
+        auto decodeElapsed = Clock::now() - start;
+
+        start = Clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            OctetString stream{};
+            EncodeNasMessage(*message, stream);
+        }
+        auto encodeElapsed = Clock::now() - start;
+
+        r.nsPerDecode = std::chrono::duration<double, std::nano>(decodeElapsed).count() / iterations;
+        r.nsPerEncode = std::chrono::duration<double, std::nano>(encodeElapsed).count() / iterations;
+        res.nsPerFlow += r.nsPerDecode + r.nsPerEncode;
+        res.messages.push_back(std::move(r));
+    }
+
+    return res;
+}
+
+void nasTestMain()
+{
+    NasBenchmarkConfig config{};
+    auto res = RunNasBenchmark(config);
+
+    printf("%-32s %6s %6s %10s %10s\n", "message", "bytes", "match", "decode ns", "encode ns");
+    for (auto &r : res.messages)
+    {
+        printf("%-32s %6d %6s %10.1f %10.1f\n", r.name.c_str(), r.size, r.roundTrip ? "yes" : "NO", r.nsPerDecode,
+               r.nsPerEncode);
+    }
+    printf("%-32s %6s %6s %21.1f\n", "flow", "", "", res.nsPerFlow);
+    fflush(stdout);
+}
+
+} // namespace nas
@@ -0,0 +1,42 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nas
+{
+
+struct NasBenchmarkConfig
+{
+    int iterations = 100000; // Decode and encode count of each message of the flow
+};
+
+struct NasBenchmarkMessageResult
+{
+    std::string name;
+    int size;
+    bool roundTrip; // Re-encoding the decoded message gives the same PDU
+    double nsPerDecode;
+    double nsPerEncode;
+};
+
+struct NasBenchmarkResult
+{
+    std::vector<NasBenchmarkMessageResult> messages;
+    double nsPerFlow; // Decoding and encoding of all messages of the flow once
+};
+
+NasBenchmarkResult RunNasBenchmark(const NasBenchmarkConfig &config);
+
+void nasTestMain();
+
+} // namespace nas
@@ -60,6 +60,103 @@ const char *EnumToString(ERegistrationType v)
     }
 }
 
+const char *EnumToString(EMessageType v)
+{
+    switch (v)
+    {
+    case EMessageType::REGISTRATION_REQUEST:
+        return "REGISTRATION_REQUEST";
+    case EMessageType::REGISTRATION_ACCEPT:
+        return "REGISTRATION_ACCEPT";
+    case EMessageType::REGISTRATION_COMPLETE:
+        return "REGISTRATION_COMPLETE";
+    case EMessageType::REGISTRATION_REJECT:
+        return "REGISTRATION_REJECT";
+    case EMessageType::DEREGISTRATION_REQUEST_UE_ORIGINATING:
+        return "DEREGISTRATION_REQUEST_UE_ORIGINATING";
+    case EMessageType::DEREGISTRATION_ACCEPT_UE_ORIGINATING:
+        return "DEREGISTRATION_ACCEPT_UE_ORIGINATING";
+    case EMessageType::DEREGISTRATION_REQUEST_UE_TERMINATED:
+        return "DEREGISTRATION_REQUEST_UE_TERMINATED";
+    case EMessageType::DEREGISTRATION_ACCEPT_UE_TERMINATED:
+        return "DEREGISTRATION_ACCEPT_UE_TERMINATED";
+    case EMessageType::SERVICE_REQUEST:
+        return "SERVICE_REQUEST";
+    case EMessageType::SERVICE_REJECT:
+        return "SERVICE_REJECT";
+    case EMessageType::SERVICE_ACCEPT:
+        return "SERVICE_ACCEPT";
+    case EMessageType::CONFIGURATION_UPDATE_COMMAND:
+        return "CONFIGURATION_UPDATE_COMMAND";
+    case EMessageType::CONFIGURATION_UPDATE_COMPLETE:
+        return "CONFIGURATION_UPDATE_COMPLETE";
+    case EMessageType::AUTHENTICATION_REQUEST:
+        return "AUTHENTICATION_REQUEST";
+    case EMessageType::AUTHENTICATION_RESPONSE:
+        return "AUTHENTICATION_RESPONSE";
+    case EMessageType::AUTHENTICATION_REJECT:
+        return "AUTHENTICATION_REJECT";
+    case EMessageType::AUTHENTICATION_FAILURE:
+        return "AUTHENTICATION_FAILURE";
+    case EMessageType::AUTHENTICATION_RESULT:
+        return "AUTHENTICATION_RESULT";
+    case EMessageType::IDENTITY_REQUEST:
+        return "IDENTITY_REQUEST";
+    case EMessageType::IDENTITY_RESPONSE:
+        return "IDENTITY_RESPONSE";
+    case EMessageType::SECURITY_MODE_COMMAND:
+        return "SECURITY_MODE_COMMAND";
+    case EMessageType::SECURITY_MODE_COMPLETE:
+        return "SECURITY_MODE_COMPLETE";
+    case EMessageType::SECURITY_MODE_REJECT:
+        return "SECURITY_MODE_REJECT";
+    case EMessageType::FIVEG_MM_STATUS:
+        return "FIVEG_MM_STATUS";
+    case EMessageType::NOTIFICATION:
+        return "NOTIFICATION";
+    case EMessageType::NOTIFICATION_RESPONSE:
+        return "NOTIFICATION_RESPONSE";
+    case EMessageType::UL_NAS_TRANSPORT:
+        return "UL_NAS_TRANSPORT";
+    case EMessageType::DL_NAS_TRANSPORT:
+        return "DL_NAS_TRANSPORT";
+    case EMessageType::PDU_SESSION_ESTABLISHMENT_REQUEST:
+        return "PDU_SESSION_ESTABLISHMENT_REQUEST";
+    case EMessageType::PDU_SESSION_ESTABLISHMENT_ACCEPT:
+        return "PDU_SESSION_ESTABLISHMENT_ACCEPT";
+    case EMessageType::PDU_SESSION_ESTABLISHMENT_REJECT:
+        return "PDU_SESSION_ESTABLISHMENT_REJECT";
+    case EMessageType::PDU_SESSION_AUTHENTICATION_COMMAND:
+        return "PDU_SESSION_AUTHENTICATION_COMMAND";
+    case EMessageType::PDU_SESSION_AUTHENTICATION_COMPLETE:
+        return "PDU_SESSION_AUTHENTICATION_COMPLETE";
+    case EMessageType::PDU_SESSION_AUTHENTICATION_RESULT:
+        return "PDU_SESSION_AUTHENTICATION_RESULT";
+    case EMessageType::PDU_SESSION_MODIFICATION_REQUEST:
+        return "PDU_SESSION_MODIFICATION_REQUEST";
+    case EMessageType::PDU_SESSION_MODIFICATION_REJECT:
+        return "PDU_SESSION_MODIFICATION_REJECT";
+    case EMessageType::PDU_SESSION_MODIFICATION_COMMAND:
+        return "PDU_SESSION_MODIFICATION_COMMAND";
+    case EMessageType::PDU_SESSION_MODIFICATION_COMPLETE:
+        return "PDU_SESSION_MODIFICATION_COMPLETE";
+    case EMessageType::PDU_SESSION_MODIFICATION_COMMAND_REJECT:
+        return "PDU_SESSION_MODIFICATION_COMMAND_REJECT";
+    case EMessageType::PDU_SESSION_RELEASE_REQUEST:
+        return "PDU_SESSION_RELEASE_REQUEST";
+    case EMessageType::PDU_SESSION_RELEASE_REJECT:
+        return "PDU_SESSION_RELEASE_REJECT";
+    case EMessageType::PDU_SESSION_RELEASE_COMMAND:
+        return "PDU_SESSION_RELEASE_COMMAND";
+    case EMessageType::PDU_SESSION_RELEASE_COMPLETE:
+        return "PDU_SESSION_RELEASE_COMPLETE";
+    case EMessageType::FIVEG_SM_STATUS:
+        return "FIVEG_SM_STATUS";
+    default:
+        return "?";
+    }
+}
+
 const char *EnumToString(EMmCause v)
 {
     switch (v)
@@ -28,14 +28,14 @@ UmdPdu *RlcEncoder::DecodeUmd(uint8_t *data, int size, bool isShortSn)
     {
         if (isShortSn)
         {
-            pdu->sn = bits::BitRange8<0, 5>(data[index]);
+            pdu->sn = bits::BitRange8<0, 5>(data[0]);
         }
         else
         {
-            pdu->sn = bits::BitRange8<0, 3>(data[index]);
+            pdu->sn = bits::BitRange8<0, 3>(data[0]);
             pdu->sn <<= 8;
-            index++;
             pdu->sn |= bits::BitRange8<0, 7>(data[index]);
+            index++;
         }
 
         if (si::requiresSo(pdu->si))
@@ -64,11 +64,11 @@ int RlcEncoder::EncodeUmd(uint8_t *buffer, bool isShortSn, ESegmentInfo si, int
     {
         if (isShortSn)
         {
-            octet0 |= sn & 0b11111;
+            octet0 |= sn & 0b111111;
         }
         else
         {
-            octet0 |= (sn >> 8) & 0b111;
+            octet0 |= (sn >> 8) & 0b1111;
             remainingSn = sn & 0b11111111;
         }
     }
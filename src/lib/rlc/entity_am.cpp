@@ -26,8 +26,8 @@ AmEntity::AmEntity(IRlcConsumer *consumer, int snLength, int txMaxSize, int rxMa
     : IRlcEntity(consumer), snLength(snLength), snModulus(1 << snLength), windowSize((1 << snLength) / 2),
       txMaxSize(txMaxSize), rxMaxSize(rxMaxSize), pollPdu(pollPdu), pollByte(pollByte),
       maxRetThreshold(maxRetThreshold), txNext(0), txNextAck(0), pollSn(0), pduWithoutPoll(0), byteWithoutPoll(0),
-      txCurrentSize(0), txBuffer{}, rxCurrentSize(0), rxBuffer{}, retBuffer{}, waitBuffer{}, ackBuffer{}, rxNext(0),
-      rxNextHighest(0), rxHighestStatus(0), rxNextStatusTrigger(0), statusTriggered(false), forcePoll(false),
+      segmentPool{}, txCurrentSize(0), txBuffer{}, txSlots((1 << snLength) / 2), retQueue{}, retCount(0),
+      statusStamp(0), rxCurrentSize(0), rxSlots((1 << snLength) / 2), rxNext(0), rxNextHighest(0), rxHighestStatus(0), rxNextStatusTrigger(0), statusTriggered(false), forcePoll(false),
       tCurrent(0), pollRetransmitTimer(pollRetransmitPeriod), reassemblyTimer(reassemblyPeriod),
       statusProhibitTimer(statusProhibitPeriod)
 {
@@ -49,14 +49,20 @@ void AmEntity::clearEntity()
     byteWithoutPoll = 0;
 
     txCurrentSize = 0;
-    txBuffer.clearAndDelete();
+    for (size_t i = 0; i < txBuffer.getCount(); i++)
+        segmentPool.release(txBuffer[i]);
+    txBuffer.clear();
 
-    rxCurrentSize = 0;
-    rxBuffer.clearAndDelete();
+    for (auto &slot : txSlots)
+        releaseTxSlot(slot);
+
+    retQueue.clear();
+    retCount = 0;
+    statusStamp = 0;
 
-    retBuffer.clearAndDelete();
-    waitBuffer.clearAndDelete();
-    ackBuffer.clearAndDelete();
+    rxCurrentSize = 0;
+    for (auto &slot : rxSlots)
+        func::DiscardRxSlot(slot);
 
     rxNext = 0;
     rxNextHighest = 0;
@@ -103,6 +109,16 @@ bool AmEntity::isInReceiveWindow(int sn)
     return modulusRx(sn) < windowSize;
 }
 
+bool AmEntity::isDelivered(int sn)
+{
+    return isInReceiveWindow(sn) && rxSlot(sn).delivered;
+}
+
+bool AmEntity::hasMissingSegment(int sn)
+{
+    return isInReceiveWindow(sn) && func::HasMissingSegment(rxSlot(sn));
+}
+
 bool AmEntity::windowStalling()
 {
     return !(snCompareTx(txNextAck, txNext) <= 0 && snCompareTx(txNext, (txNextAck + windowSize) % snModulus) < 0);
@@ -110,7 +126,7 @@ bool AmEntity::windowStalling()
 
 bool AmEntity::pollControlForTransmissionOrRetransmission()
 {
-    return (txBuffer.isEmpty() && retBuffer.isEmpty()) || windowStalling();
+    return (txBuffer.isEmpty() && retCount == 0) || windowStalling();
 }
 
 //======================================================================================================
@@ -119,37 +135,148 @@ bool AmEntity::pollControlForTransmissionOrRetransmission()
 
 bool AmEntity::areAllSegmentsInAck(int sn)
 {
-    int ackCount = 0, refCount = -1;
+    auto &slot = txSlot(sn);
+    return slot.head != nullptr && !slot.pendingTx && slot.ackedCount == slot.segmentCount;
+}
 
-    auto cursor = ackBuffer.getFirst();
-    while (cursor != nullptr)
+void AmEntity::addToTxSlot(TxSlot &slot, RlcSduSegment *segment)
+{
+    RlcSduSegment **cursor = &slot.head;
+    while (*cursor != nullptr && (*cursor)->so <= segment->so)
+        cursor = &(*cursor)->next;
+
+    segment->next = *cursor;
+    *cursor = segment;
+    slot.segmentCount++;
+}
+
+void AmEntity::releaseTxSlot(TxSlot &slot)
+{
+    auto segment = slot.head;
+    while (segment != nullptr)
     {
-        RlcSdu *sdu = cursor->value->sdu;
-        if (snCompareTx(sdu->sn, sn) > 0)
+        auto next = segment->next;
+        segmentPool.release(segment);
+        segment = next;
+    }
+    slot = {};
+}
+
+bool AmEntity::findMissingBlock(int startSn, int startSo, int endSn, int endSo, MissingBlock &res)
+{
+    int sn = startSn;
+    int so = startSo;
+
+    // Skip the leading bytes that are already received
+    while (true)
+    {
+        if (snCompareRx(sn, endSn) > 0 || (sn == endSn && so >= endSo))
+            return false;
+
+        auto &slot = rxSlot(sn);
+        if (slot.delivered)
+        {
+            sn = (sn + 1) % snModulus;
+            so = 0;
+            continue;
+        }
+
+        RxPdu *covering = nullptr;
+        for (auto pdu = slot.head; pdu != nullptr && pdu->so <= so; pdu = pdu->next)
+        {
+            if (so < pdu->so + pdu->size)
+            {
+                covering = pdu;
+                break;
+            }
+        }
+
+        if (covering == nullptr)
             break;
-        if (snCompareTx(sdu->sn, sn) == 0)
+
+        if (si::hasLast(covering->si))
+        {
+            sn = (sn + 1) % snModulus;
+            so = 0;
+        }
+        else
         {
-            if (refCount == -1)
-                refCount = sdu->_refCount;
-            ackCount++;
+            so = covering->so + covering->size;
         }
-        cursor = cursor->getNext();
     }
 
-    return ackCount == refCount;
-}
+    res.snStart = sn;
+    res.soStart = so;
 
-int AmEntity::sduListCompare(const RlcSduSegment &a, const RlcSduSegment &b)
-{
-    if (a.sdu->sn == b.sdu->sn)
-        return a.so - b.so;
-    return snCompareTx(a.sdu->sn, b.sdu->sn);
-}
+    // Find the first received byte after the start of the missing block
+    int pointSn = sn;
+    RxPdu *point = nullptr;
+    bool pointDelivered = false;
 
-void AmEntity::insertToList(LinkedList<RlcSduSegment> &list, RlcSduSegment *segment)
-{
-    auto comp = [this](const RlcSduSegment &a, const RlcSduSegment &b) { return sduListCompare(a, b); };
-    func::InsertSortedLinkedList(list, segment, ILambdaComparator<RlcSduSegment, decltype(comp)>{comp});
+    for (auto pdu = rxSlot(sn).head; pdu != nullptr; pdu = pdu->next)
+    {
+        if (pdu->so > so)
+        {
+            point = pdu;
+            break;
+        }
+    }
+
+    if (point == nullptr)
+    {
+        pointSn = (sn + 1) % snModulus;
+        while (snCompareRx(pointSn, endSn) <= 0)
+        {
+            auto &slot = rxSlot(pointSn);
+            if (slot.delivered || slot.head != nullptr)
+            {
+                point = slot.head;
+                pointDelivered = slot.delivered;
+                break;
+            }
+            pointSn = (pointSn + 1) % snModulus;
+        }
+    }
+
+    int pointSo = point != nullptr ? point->so : 0;
+
+    if ((point == nullptr && !pointDelivered) || (pointSn == endSn && pointSo > endSo))
+    {
+        res.snEnd = endSn;
+        res.soEnd = endSo;
+
+        // There is no next
+        res.snNext = -1;
+        res.soNext = -1;
+
+        return true;
+    }
+
+    if (pointSo != 0)
+    {
+        res.snEnd = pointSn;
+        res.soEnd = pointSo - 1;
+
+        if (si::hasLast(point->si))
+        {
+            res.snNext = (pointSn + 1) % snModulus;
+            res.soNext = 0;
+        }
+        else
+        {
+            res.snNext = pointSn;
+            res.soNext = point->so + point->size;
+        }
+    }
+    else
+    {
+        res.snEnd = (pointSn - 1 + snModulus) % snModulus;
+        res.soEnd = 0xFFFF;
+
+        res.snNext = pointSn;
+        res.soNext = 0;
+    }
+    return true;
 }
 
 //======================================================================================================
@@ -177,7 +304,10 @@ void AmEntity::receivePdu(uint8_t *data, int size)
 
         auto *pdu = RlcEncoder::DecodeStatus(data, size, snLength == 12);
         if (pdu)
+        {
             receiveStatusPdu(pdu);
+            delete pdu;
+        }
     }
 }
 
@@ -218,28 +348,33 @@ void AmEntity::receiveAmdPdu(AmdPdu *pdu)
         return;
     }
 
+    auto &slot = rxSlot(pdu->sn);
+
     // if byte segment numbers y to z of the RLC SDU with SN = x have been received before:
     //  discard the received AMD PDU
-    if (func::IsAlreadyReceived(rxBuffer, pdu->sn, pdu->so, pdu->size))
+    if (func::IsAlreadyReceived(slot, pdu->so, pdu->size))
     {
         discard();
         return;
     }
 
+    // The PDU may be reassembled and deleted below, keep the required fields.
+    int x = pdu->sn;
+    bool p = pdu->p;
+
     // Place the received AMD PDU in the reception buffer
-    rxCurrentSize +=
-        func::InsertToRxBuffer(rxBuffer, pdu, ISnCompare([this](int a, int b) { return snCompareRx(a, b); }));
+    rxCurrentSize += func::InsertToRxSlot(slot, pdu);
 
     // Actions when an AMD PDU is placed in the reception buffer
-    actionsOnReception(*pdu);
+    actionsOnReception(x);
 
     // Continue 5.3.4
-    if (pdu->p)
+    if (p)
     {
         int v = (rxNext + windowSize) % snModulus;
 
         // if x < RX_Highest_Status or x >= RX_Next + AM_Window_Size:
-        if (snCompareRx(pdu->sn, rxHighestStatus) < 0 || snCompareRx(pdu->sn, v) >= 0)
+        if (snCompareRx(x, rxHighestStatus) < 0 || snCompareRx(x, v) >= 0)
         {
             // trigger a STATUS report
             statusTriggered = true;
@@ -255,21 +390,21 @@ void AmEntity::receiveAmdPdu(AmdPdu *pdu)
     }
 }
 
-void AmEntity::actionsOnReception(AmdPdu &pdu)
+void AmEntity::actionsOnReception(int x)
 {
-    int x = pdu.sn;
-
     // if x >= RX_Next_Highest update RX_Next_Highest to x+ 1.
     if (snCompareRx(x, rxNextHighest) >= 0)
         rxNextHighest = (x + 1) % snModulus;
 
-    if (func::IsAllSegmentsReceived(rxBuffer, x))
+    auto &slot = rxSlot(x);
+
+    if (func::IsAllSegmentsReceived(slot))
     {
         // Reassemble the RLC SDU from all byte segments with SN = x, remove RLC headers and deliver
         //  the reassembled RLC SDU to upper layer.
         uint8_t reassembleBuffer[REASSEMBLE_BUFFER_LEN];
-        int reassembled = func::Reassemble(rxBuffer, pdu.sn, reassembleBuffer);
-        rxCurrentSize -= reassembled;
+        rxCurrentSize -= slot.storedBytes;
+        int reassembled = func::Reassemble(slot, reassembleBuffer);
         if (reassembled > 0)
             consumer->deliverSdu(this, reassembleBuffer, reassembled);
 
@@ -278,7 +413,7 @@ void AmEntity::actionsOnReception(AmdPdu &pdu)
         if (x == rxHighestStatus)
         {
             int n = rxHighestStatus;
-            while (func::IsDelivered(rxBuffer, n))
+            while (isDelivered(n))
             {
                 n = (n + 1) % snModulus;
             }
@@ -289,13 +424,9 @@ void AmEntity::actionsOnReception(AmdPdu &pdu)
         //  for which not all bytes have been received.
         if (x == rxNext)
         {
-            while (!rxBuffer.isEmpty() && rxBuffer.getFirst()->value->isProcessed &&
-                   rxBuffer.getFirst()->value->sn == rxNext)
+            while (rxSlot(rxNext).delivered)
             {
-                do
-                {
-                    delete rxBuffer.removeFirst();
-                } while (!rxBuffer.isEmpty() && rxBuffer.getFirst()->value->sn == rxNext);
+                func::DiscardRxSlot(rxSlot(rxNext));
                 rxNext = (rxNext + 1) % snModulus;
             }
         }
@@ -308,7 +439,7 @@ void AmEntity::actionsOnReception(AmdPdu &pdu)
             ||
             // if RX_Next_Status_Trigger = RX_Next + 1 and there is no missing byte segment of the SDU
             //  associated with SN = RX_Next before the last byte of all received segments of this SDU; or
-            (rxNextStatusTrigger == (rxNext + 1) % snModulus && !func::HasMissingSegment(rxBuffer, rxNext)) ||
+            (rxNextStatusTrigger == (rxNext + 1) % snModulus && !hasMissingSegment(rxNext)) ||
             // if RX_Next_Status_Trigger falls outside of the receiving window and RX_Next_Status_Trigger
             //  is not equal to RX_Next + AM_Window_Size:
             (!isInReceiveWindow(rxNextStatusTrigger) && rxNextStatusTrigger != (rxNext + windowSize) % snModulus))
@@ -326,7 +457,7 @@ void AmEntity::actionsOnReception(AmdPdu &pdu)
         if (snCompareRx(rxNextHighest, (rxNext + 1) % snModulus) > 0
             // if RX_Next_Highest = RX_Next + 1 and there is at least one missing byte segment of the SDU
             //  associated with SN = RX_Next before the last byte of all received segments of this SDU:
-            || (rxNextHighest == (rxNext + 1) % snModulus && func::HasMissingSegment(rxBuffer, rxNext)))
+            || (rxNextHighest == (rxNext + 1) % snModulus && hasMissingSegment(rxNext)))
         {
 
             // Start t-Reassembly
@@ -348,7 +479,8 @@ void AmEntity::receiveStatusPdu(StatusPdu *pdu)
 
     ackReceived(pdu->ackSn);
 
-    Snset alreadyRetIncremented;
+    // RETX_COUNT is incremented at most once per SDU for each STATUS PDU.
+    statusStamp++;
 
     for (auto &nackBlock : pdu->nackBlocks)
     {
@@ -371,8 +503,7 @@ void AmEntity::receiveStatusPdu(StatusPdu *pdu)
 
         for (int i = 0; i < range; i++)
         {
-            nackReceived((nackSn + i) % snModulus, i == 0 ? soStart : 0, i == range - 1 ? soEnd : -1,
-                         alreadyRetIncremented);
+            nackReceived((nackSn + i) % snModulus, i == 0 ? soStart : 0, i == range - 1 ? soEnd : -1);
         }
 
         // Similar as above
@@ -385,99 +516,54 @@ void AmEntity::receiveStatusPdu(StatusPdu *pdu)
 
 void AmEntity::ackReceived(int ackSn)
 {
-    Snset alreadyDec;
-
-    auto cursor = waitBuffer.getFirst();
-    while (cursor != nullptr)
+    for (int sn = txNextAck; snCompareTx(sn, ackSn) < 0 && snCompareTx(sn, txNext) < 0; sn = (sn + 1) % snModulus)
     {
-        auto segment = cursor->value;
-        if (snCompareTx(segment->sdu->sn, ackSn) < 0)
-        {
-            waitBuffer.removeAndIncrement(cursor);
-            insertToList(ackBuffer, segment);
-        }
-        else
-        {
-            cursor = cursor->getNext();
-        }
-    }
+        auto &slot = txSlot(sn);
+        bool alreadyDec = false;
 
-    cursor = retBuffer.getFirst();
-    while (cursor != nullptr)
-    {
-        auto segment = cursor->value;
-        if (snCompareTx(segment->sdu->sn, ackSn) < 0)
+        for (auto segment = slot.head; segment != nullptr; segment = segment->next)
         {
-            if (!alreadyDec[segment->sdu->sn])
+            if (segment->state == ESegmentState::RET)
             {
-                segment->sdu->retransmissionCount--;
-                alreadyDec[segment->sdu->sn] = true;
+                if (!alreadyDec)
+                {
+                    segment->sdu->retransmissionCount--;
+                    alreadyDec = true;
+                }
+                retCount--;
             }
-            retBuffer.removeAndIncrement(cursor);
-            insertToList(ackBuffer, segment);
-        }
-        else
-        {
-            cursor = cursor->getNext();
+            else if (segment->state != ESegmentState::WAIT)
+            {
+                continue;
+            }
+
+            segment->state = ESegmentState::ACK;
+            slot.ackedCount++;
         }
     }
 }
 
-void AmEntity::nackReceived(int nackSn, int soStart, int soEnd, AmEntity::Snset &alreadyRetIncremented)
+void AmEntity::nackReceived(int nackSn, int soStart, int soEnd)
 {
     if (snCompareTx(txNextAck, nackSn) > 0 || snCompareTx(nackSn, txNext) >= 0)
         return;
 
-    auto cursor = waitBuffer.getFirst();
+    auto &slot = txSlot(nackSn);
 
-    while (cursor != nullptr)
+    for (auto segment = slot.head; segment != nullptr; segment = segment->next)
     {
-        auto segment = cursor->value;
-        if (segment->sdu->sn == nackSn)
-        {
-            if (func::SoOverlap(soStart, soEnd, segment->so, segment->so + segment->size - 1))
-            {
-                waitBuffer.removeAndIncrement(cursor);
-                considerRetransmission(segment, !alreadyRetIncremented[nackSn]);
-                alreadyRetIncremented[nackSn] = true;
-            }
-            else
-            {
-                cursor = cursor->getNext();
-            }
-        }
-        else
-        {
-            cursor = cursor->getNext();
-        }
-    }
-
-    cursor = ackBuffer.getFirst();
-    while (cursor != nullptr)
-    {
-        auto segment = cursor->value;
+        if (segment->state != ESegmentState::WAIT && segment->state != ESegmentState::ACK)
+            continue;
 
-        if (segment->sdu->sn == nackSn)
-        {
-            if (func::SoOverlap(soStart, soEnd, segment->so, segment->so + segment->size - 1))
-            {
-                ackBuffer.removeAndIncrement(cursor);
-                considerRetransmission(segment, !alreadyRetIncremented[nackSn]);
-                alreadyRetIncremented[nackSn] = true;
-            }
-            else
-            {
-                cursor = cursor->getNext();
-            }
-        }
-        else
+        if (func::SoOverlap(soStart, soEnd, segment->so, segment->so + segment->size - 1))
         {
-            cursor = cursor->getNext();
+            considerRetransmission(nackSn, slot, segment, slot.retIncrementStamp != statusStamp);
+            slot.retIncrementStamp = statusStamp;
         }
     }
 }
 
-void AmEntity::considerRetransmission(RlcSduSegment *segment, bool updateRetX)
+void AmEntity::considerRetransmission(int sn, TxSlot &slot, RlcSduSegment *segment, bool updateRetX)
 {
     if (updateRetX)
     {
@@ -485,23 +571,31 @@ void AmEntity::considerRetransmission(RlcSduSegment *segment, bool updateRetX)
         if (segment->sdu->retransmissionCount >= maxRetThreshold)
             consumer->maxRetransmissionReached(this);
     }
-    insertToList(retBuffer, segment);
+
+    if (segment->state == ESegmentState::ACK)
+        slot.ackedCount--;
+
+    segment->state = ESegmentState::RET;
+    retCount++;
+
+    if (!slot.inRetQueue)
+    {
+        slot.inRetQueue = true;
+        retQueue.addLast(sn);
+    }
 }
 
 void AmEntity::checkForSuccessIndication()
 {
-    auto cursor = ackBuffer.getFirst();
-
     // TODO: Currently sequential succ indication, but not immediate.
-    while (cursor != nullptr && cursor->value->sdu->sn == txNextAck && areAllSegmentsInAck(cursor->value->sdu->sn))
+    while (txNextAck != txNext && areAllSegmentsInAck(txNextAck))
     {
-        txCurrentSize -= cursor->value->sdu->size;
-        int sn = cursor->value->sdu->sn;
+        auto &slot = txSlot(txNextAck);
 
-        consumer->sduSuccessfulDelivery(this, cursor->value->sdu->sduId);
+        txCurrentSize -= slot.head->sdu->size;
+        consumer->sduSuccessfulDelivery(this, slot.head->sdu->sduId);
 
-        while (cursor != nullptr && cursor->value->sdu->sn == sn)
-            delete ackBuffer.removeAndIncrement(cursor);
+        releaseTxSlot(slot);
         txNextAck = (txNextAck + 1) % snModulus;
     }
 }
@@ -527,7 +621,7 @@ int AmEntity::createPdu(uint8_t *buffer, int maxSize)
             return res;
     }
 
-    if (!retBuffer.isEmpty())
+    if (retCount > 0)
     {
         int res = createRetPdu(buffer, maxSize);
         if (res != 0)
@@ -554,8 +648,7 @@ int AmEntity::createStatusPdu(uint8_t *buffer, int maxSize, bool noSideEffect)
             break;
 
         MissingBlock missing{};
-        if (!func::FindMissingBlock(rxBuffer, startSn, startSo, (rxHighestStatus - 1 + snModulus) % snModulus, 0xFFFF,
-                                    snModulus, missing))
+        if (!findMissingBlock(startSn, startSo, (rxHighestStatus - 1 + snModulus) % snModulus, 0xFFFF, missing))
             break;
 
         NackBlock block{};
@@ -623,17 +716,16 @@ int AmEntity::createStatusPdu(uint8_t *buffer, int maxSize, bool noSideEffect)
 
     if (!noSideEffect)
     {
-        auto cursor = rxBuffer.getFirst();
-        while (cursor != nullptr)
+        // The SN following the highest delivered SDU below RX_Highest_Status
+        int n = rxHighestStatus;
+        while (n != rxNext)
         {
-            if (snCompareRx(cursor->value->sn, rxHighestStatus) >= 0)
-                break;
-            if (snCompareRx(cursor->value->sn, rxNext) >= 0)
+            n = (n - 1 + snModulus) % snModulus;
+            if (rxSlot(n).delivered)
             {
-                if (cursor->value->isProcessed)
-                    ackSn = (cursor->value->sn + 1) % snModulus;
+                ackSn = (n + 1) % snModulus;
+                break;
             }
-            cursor = cursor->getNext();
         }
     }
 
@@ -652,7 +744,34 @@ int AmEntity::createStatusPdu(uint8_t *buffer, int maxSize, bool noSideEffect)
 
 int AmEntity::createRetPdu(uint8_t *buffer, int maxSize)
 {
-    auto segment = retBuffer.getFirstElement();
+    RlcSduSegment *segment = nullptr;
+    int sn = 0;
+
+    // Find the first segment to be retransmitted. Entries of the queue whose segments are already retransmitted or
+    //  acknowledged are dropped here.
+    while (!retQueue.isEmpty())
+    {
+        sn = retQueue.getFirst();
+        auto &slot = txSlot(sn);
+
+        if (slot.head != nullptr && slot.head->sdu->sn == sn)
+        {
+            for (auto item = slot.head; item != nullptr; item = item->next)
+            {
+                if (item->state == ESegmentState::RET)
+                {
+                    segment = item;
+                    break;
+                }
+            }
+            if (segment != nullptr)
+                break;
+            slot.inRetQueue = false;
+        }
+
+        retQueue.removeFirst();
+    }
+
     if (segment == nullptr)
         return 0;
 
@@ -662,18 +781,18 @@ int AmEntity::createRetPdu(uint8_t *buffer, int maxSize)
     if (headerSize + 1 > maxSize)
         return 0;
 
-    retBuffer.removeFirst();
-
     // Perform segmentation if it is needed
     if (headerSize + segment->size > maxSize)
     {
-        auto next = func::AmPerformSegmentation(segment, maxSize, snLength);
+        auto next = func::AmPerformSegmentation(segmentPool, segment, maxSize, snLength);
         if (next == nullptr)
             return 0;
-        retBuffer.addFirst(next);
+        addToTxSlot(txSlot(sn), next);
+        retCount++;
     }
 
-    insertToList(waitBuffer, segment);
+    segment->state = ESegmentState::WAIT;
+    retCount--;
 
     bool includePoll = pollControlForTransmissionOrRetransmission();
 
@@ -691,10 +810,11 @@ int AmEntity::createTxPdu(uint8_t *buffer, int maxSize)
     if (windowStalling())
         return 0;
 
-    auto segment = txBuffer.getFirstElement();
-    if (segment == nullptr)
+    if (txBuffer.isEmpty())
         return 0;
 
+    auto segment = txBuffer.getFirst();
+
     int headerSize = func::AmdPduHeaderSize(snLength, segment->si);
 
     // Fragmentation is irrelevant since no byte fits the size.
@@ -707,16 +827,26 @@ int AmEntity::createTxPdu(uint8_t *buffer, int maxSize)
     // Perform segmentation if it is needed
     if (headerSize + segment->size > maxSize)
     {
-        auto next = func::AmPerformSegmentation(segment, maxSize, snLength);
+        auto next = func::AmPerformSegmentation(segmentPool, segment, maxSize, snLength);
         if (next == nullptr)
             return 0;
         txBuffer.addFirst(next);
     }
 
+    auto &slot = txSlot(txNext);
+
+    // The first segment of the SDU opens the slot
+    if (segment->so == 0)
+        slot.pendingTx = true;
+
+    segment->state = ESegmentState::WAIT;
+    addToTxSlot(slot, segment);
+
     if (si::hasLast(segment->si))
+    {
+        slot.pendingTx = false;
         txNext = (txNext + 1) % snModulus;
-
-    insertToList(waitBuffer, segment);
+    }
 
     // 5.3.3.2	Transmission of a AMD PDU
     //  Upon notification of a transmission opportunity by lower layer, for each AMD PDU submitted for
@@ -797,7 +927,7 @@ void AmEntity::actionsOnReassemblyTimerExpired()
     // update RX_Highest_Status to the SN of the first RLC SDU with
     //  SN >= RX_Next_Status_Trigger for which not all bytes have been received;
     int sn = rxNextStatusTrigger;
-    while (func::IsDelivered(rxBuffer, sn))
+    while (isDelivered(sn))
         sn = (sn + 1) % snModulus;
     rxHighestStatus = sn;
 
@@ -808,7 +938,7 @@ void AmEntity::actionsOnReassemblyTimerExpired()
     {
         condition = true;
     }
-    else if (rxNextHighest == (rxHighestStatus + 1) % snModulus && func::HasMissingSegment(rxBuffer, rxHighestStatus))
+    else if (rxNextHighest == (rxHighestStatus + 1) % snModulus && hasMissingSegment(rxHighestStatus))
     {
         // or if RX_Next_Highest = RX_Highest_Status + 1 and there is at least one missing byte
         //  segment of the SDU associated with SN = RX_Highest_Status before the last byte
@@ -829,37 +959,47 @@ void AmEntity::actionsOnPollRetransmitTimerExpired()
 {
     if (pollControlForTransmissionOrRetransmission())
     {
+        auto hasWaiting = [this](int sn) {
+            auto &slot = txSlot(sn);
+            if (slot.head == nullptr || slot.head->sdu->sn != sn)
+                return false;
+            for (auto segment = slot.head; segment != nullptr; segment = segment->next)
+                if (segment->state == ESegmentState::WAIT)
+                    return true;
+            return false;
+        };
+
         // 5.3.3.4: Consider the RLC SDU with the highest SN among the RLC SDUs submitted to lower layer for
         // retransmission
-        auto item = func::FirstItemWithSn(waitBuffer, (txNext - 1 + snModulus) % snModulus);
+        int sn = (txNext - 1 + snModulus) % snModulus;
 
         // 5.3.3.4: ... or consider any RLC SDU which has not been positively acknowledged for retransmission.
-        if (item == nullptr)
+        if (txNext == txNextAck || !hasWaiting(sn))
         {
             // The spec says 'any', here we take first one.
-            item = waitBuffer.getFirst();
+            sn = -1;
+            for (int i = txNextAck; i != txNext; i = (i + 1) % snModulus)
+            {
+                if (hasWaiting(i))
+                {
+                    sn = i;
+                    break;
+                }
+            }
         }
 
-        if (item != nullptr)
+        if (sn != -1)
         {
-            auto sn = item->value->sdu->sn;
+            auto &slot = txSlot(sn);
             bool alreadyRetIncremented = false;
-            auto cursor = waitBuffer.getFirst();
 
             // Spec says SDU, not segment. Therefore take all segments.
-            while (cursor != nullptr)
+            for (auto segment = slot.head; segment != nullptr; segment = segment->next)
             {
-                if (snCompareTx(cursor->value->sdu->sn, sn) > 0)
-                    break;
-                if (snCompareTx(cursor->value->sdu->sn, sn) == 0)
+                if (segment->state == ESegmentState::WAIT)
                 {
-                    considerRetransmission(cursor->value, !alreadyRetIncremented);
+                    considerRetransmission(sn, slot, segment, !alreadyRetIncremented);
                     alreadyRetIncremented = true;
-                    waitBuffer.removeAndIncrement(cursor);
-                }
-                else
-                {
-                    cursor = cursor->getNext();
                 }
             }
         }
@@ -877,13 +1017,23 @@ void AmEntity::calculateDataVolume(RlcDataVolume &volume)
     auto txCalc = [this](const RlcSduSegment *v) { return v->size + func::AmdPduHeaderSize(snLength, v->si); };
 
     // Calculate TX
-    volume.transmissionSize = func::ListSum<RlcSduSegment>(txBuffer, txCalc);
+    volume.transmissionSize = func::BufferSum(txBuffer, txCalc);
 
     // Calculate RX
     volume.receptionSize = rxCurrentSize; // An estimation.
 
     // Calculate RETX
-    volume.retransmissionSize = func::ListSum<RlcSduSegment>(retBuffer, txCalc);
+    volume.retransmissionSize = 0;
+    for (size_t i = 0; i < retQueue.getCount(); i++)
+    {
+        int sn = retQueue[i];
+        auto &slot = txSlot(sn);
+        if (slot.head == nullptr || slot.head->sdu->sn != sn)
+            continue;
+        for (auto segment = slot.head; segment != nullptr; segment = segment->next)
+            if (segment->state == ESegmentState::RET)
+                volume.retransmissionSize += txCalc(segment);
+    }
 
     // Calculate STATUS
     volume.statusSize = estimateStatusSize();
@@ -907,26 +1057,27 @@ int AmEntity::estimateStatusSize()
 
 void AmEntity::receiveSdu(uint8_t *data, int size, int sduId)
 {
-    txCurrentSize += func::InsertSduToTransmissionBuffer(data, size, sduId, txBuffer, txCurrentSize, txMaxSize);
+    txCurrentSize +=
+        func::InsertSduToTransmissionBuffer(data, size, sduId, segmentPool, txBuffer, txCurrentSize, txMaxSize);
 }
 
 void AmEntity::discardSdu(int sduId)
 {
-    auto segment = func::FindFirstSduSegmentWithId(txBuffer, sduId);
+    int index = func::FindFirstSduSegmentWithId(txBuffer, sduId);
 
     // SDU not found, do nothing.
-    if (segment == nullptr)
+    if (index == -1)
         return;
 
     // The SDU is already segmented, do nothing.
-    if (segment->value->si != ESegmentInfo::FULL)
+    if (txBuffer[index]->si != ESegmentInfo::FULL)
         return;
 
-    // Remove the segment
-    delete txBuffer.remove(segment);
-
     // TODO, WARNING: not really sure here because this is not included in the a.i
-    txCurrentSize -= segment->value->size;
+    txCurrentSize -= txBuffer[index]->size;
+
+    // Remove the segment
+    segmentPool.release(txBuffer.removeAt(index));
 }
 
 void AmEntity::reestablishment()
@@ -11,17 +11,15 @@
 #include "rlc.hpp"
 #include "utils.hpp"
 
-#include <bitset>
+#include <vector>
 
-#include <utils/linked_list.hpp>
+#include <utils/ring_buffer.hpp>
 
 namespace rlc
 {
 
 class AmEntity : public IRlcEntity
 {
-    using Snset = std::bitset<262144>;
-
     // Configurations
     int snLength;
     int snModulus;
@@ -39,18 +37,24 @@ class AmEntity : public IRlcEntity
     int pduWithoutPoll;
     int byteWithoutPoll;
 
-    // TX buffer
+    // Segment descriptors
+    SegmentPool segmentPool;
+
+    // TX buffer (not yet submitted segments)
     int txCurrentSize;
-    LinkedList<RlcSduSegment> txBuffer;
+    RingBuffer<RlcSduSegment *> txBuffer;
 
-    // RX buffer
-    int rxCurrentSize;
-    LinkedList<AmdPdu> rxBuffer;
+    // Submitted SDUs indexed by SN, covering [TX_Next_Ack, TX_Next)
+    std::vector<TxSlot> txSlots;
 
-    // Other Buffers
-    LinkedList<RlcSduSegment> retBuffer;
-    LinkedList<RlcSduSegment> waitBuffer;
-    LinkedList<RlcSduSegment> ackBuffer;
+    // SNs having segments to be retransmitted, and the number of such segments
+    RingBuffer<int> retQueue;
+    int retCount;
+    int statusStamp;
+
+    // RX buffer indexed by SN, covering the receiving window
+    int rxCurrentSize;
+    std::vector<RxSlot> rxSlots;
 
     // RX state variables
     int rxNext;
@@ -83,21 +87,32 @@ class AmEntity : public IRlcEntity
     [[nodiscard]] int snCompareRx(int a, int b) const;
     [[nodiscard]] int snCompareTx(int a, int b) const;
     bool isInReceiveWindow(int sn);
+    bool isDelivered(int sn);
+    bool hasMissingSegment(int sn);
     bool windowStalling();
     bool pollControlForTransmissionOrRetransmission();
+    [[nodiscard]] inline TxSlot &txSlot(int sn)
+    {
+        return txSlots[sn & (windowSize - 1)];
+    }
+    [[nodiscard]] inline RxSlot &rxSlot(int sn)
+    {
+        return rxSlots[sn & (windowSize - 1)];
+    }
 
     /* Internal */
     bool areAllSegmentsInAck(int sn);
-    int sduListCompare(const RlcSduSegment &a, const RlcSduSegment &b);
-    void insertToList(LinkedList<RlcSduSegment> &list, RlcSduSegment *segment);
+    void addToTxSlot(TxSlot &slot, RlcSduSegment *segment);
+    void releaseTxSlot(TxSlot &slot);
+    bool findMissingBlock(int startSn, int startSo, int endSn, int endSo, MissingBlock &res);
 
     /* PDU receive related */
     void receiveAmdPdu(AmdPdu *pdu);
-    void actionsOnReception(AmdPdu &pdu);
+    void actionsOnReception(int x);
     void receiveStatusPdu(StatusPdu *pdu);
     void ackReceived(int ackSn);
-    void nackReceived(int nackSn, int soStart, int soEnd, Snset &alreadyRetIncremented);
-    void considerRetransmission(RlcSduSegment *segment, bool updateRetX);
+    void nackReceived(int nackSn, int soStart, int soEnd);
+    void considerRetransmission(int sn, TxSlot &slot, RlcSduSegment *segment, bool updateRetX);
     void checkForSuccessIndication();
 
     /* PDU construct related */
@@ -17,7 +17,9 @@ namespace rlc
 void TmEntity::clearEntity()
 {
     txCurrentSize = 0;
-    txBuffer.clearAndDelete();
+    for (size_t i = 0; i < txBuffer.getCount(); i++)
+        segmentPool.release(txBuffer[i]);
+    txBuffer.clear();
 }
 
 void TmEntity::receivePdu(uint8_t *data, int size)
@@ -30,7 +32,7 @@ void TmEntity::receiveSdu(uint8_t *data, int size, int sduId)
     if (txCurrentSize + size > txMaxSize)
         return;
 
-    auto segment = new RlcSduSegment(RlcSdu::NewFromData(data, size, sduId));
+    auto segment = segmentPool.acquire(RlcSdu::NewFromData(data, size, sduId));
     segment->si = ESegmentInfo::FULL;
     segment->so = 0;
     segment->size = size;
@@ -50,17 +52,17 @@ TmEntity::TmEntity(IRlcConsumer *pConsumer, int txMaxSize) : IRlcEntity(pConsume
 
 int TmEntity::createPdu(uint8_t *buffer, int maxSize)
 {
-    auto segment = txBuffer.getFirst();
-    if (segment == nullptr)
+    if (txBuffer.isEmpty())
         return 0;
 
-    if (segment->value->size > maxSize)
+    auto segment = txBuffer.getFirst();
+    if (segment->size > maxSize)
         return 0;
 
-    size_t size = segment->value->size;
-    std::memcpy(buffer, segment->value->sdu->data, size);
+    size_t size = segment->size;
+    std::memcpy(buffer, segment->sdu->data, size);
 
-    delete txBuffer.remove(segment);
+    segmentPool.release(txBuffer.removeFirst());
     txCurrentSize -= size;
 
     return size;
@@ -88,7 +90,7 @@ void TmEntity::timerCycle(int64_t currentTime)
 
 void TmEntity::calculateDataVolume(RlcDataVolume &volume)
 {
-    volume.transmissionSize = func::ListSum<RlcSduSegment>(txBuffer, [](const RlcSduSegment *v) { return v->size; });
+    volume.transmissionSize = func::BufferSum(txBuffer, [](const RlcSduSegment *v) { return v->size; });
     volume.receptionSize = 0;
     volume.retransmissionSize = 0;
     volume.statusSize = 0;
@@ -11,7 +11,7 @@
 #include "rlc.hpp"
 #include "utils.hpp"
 
-#include <utils/linked_list.hpp>
+#include <utils/ring_buffer.hpp>
 
 namespace rlc
 {
@@ -21,9 +21,12 @@ class TmEntity : public IRlcEntity
     // Configurations
     int txMaxSize;
 
+    // Segment descriptors
+    SegmentPool segmentPool;
+
     // TX buffer
     int txCurrentSize;
-    LinkedList<RlcSduSegment> txBuffer;
+    RingBuffer<RlcSduSegment *> txBuffer;
 
     // Timers
     long tCurrent; // Not a timer, but holds the current time in ms.
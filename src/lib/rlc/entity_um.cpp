@@ -20,8 +20,8 @@
 
 rlc::UmEntity::UmEntity(rlc::IRlcConsumer *consumer, int snLength, int tReassemblyPeriod, int txMaxSize, int rxMaxSize)
     : IRlcEntity(consumer), snLength(snLength), snModulus(1 << snLength), windowSize((1 << snLength) / 2),
-      txMaxSize(txMaxSize), rxMaxSize(rxMaxSize), txCurrentSize(0), txNext(0), rxCurrentSize(0), rxNextReassembly(0),
-      rxNextHighest(0), rxTimerTrigger(0), tCurrent(0), reassemblyTimer(tReassemblyPeriod)
+      txMaxSize(txMaxSize), rxMaxSize(rxMaxSize), segmentPool{}, txCurrentSize(0), txBuffer{}, txNext(0),
+      rxCurrentSize(0), rxSlots(1 << snLength), rxNextReassembly(0), rxNextHighest(0), rxTimerTrigger(0), tCurrent(0), reassemblyTimer(tReassemblyPeriod)
 {
     assert(snLength == 6 || snLength == 12);
 
@@ -37,9 +37,13 @@ void rlc::UmEntity::clearEntity()
 {
     // discard all RLC SDUs, RLC SDU segments, and RLC PDUs, if any
     txCurrentSize = 0;
-    txBuffer.clearAndDelete();
+    for (size_t i = 0; i < txBuffer.getCount(); i++)
+        segmentPool.release(txBuffer[i]);
+    txBuffer.clear();
+
     rxCurrentSize = 0;
-    rxBuffer.clearAndDelete();
+    for (auto &slot : rxSlots)
+        func::DiscardRxSlot(slot);
 
     // reset all state variables to their initial values.
     txNext = 0;
@@ -69,22 +73,35 @@ int rlc::UmEntity::snCompareRx(int a, int b) const
     return modulusRx(a) - modulusRx(b);
 }
 
+bool rlc::UmEntity::isDelivered(int sn)
+{
+    return rxSlots[sn].delivered;
+}
+
+int rlc::UmEntity::discardRange(int startSn, int endSn)
+{
+    int decreased = 0;
+    for (int sn = startSn; sn != endSn; sn = (sn + 1) % snModulus)
+        decreased += func::DiscardRxSlot(rxSlots[sn]);
+    return decreased;
+}
+
 //======================================================================================================
 //                                               ACTIONS
 //======================================================================================================
 
-void rlc::UmEntity::actionsOnReception(rlc::UmdPdu &pdu)
+void rlc::UmEntity::actionsOnReception(int x)
 {
-    int x = pdu.sn;
+    auto &slot = rxSlots[x];
 
     // If all byte segments with SN = x are received
-    if (func::IsAllSegmentsReceived(rxBuffer, x))
+    if (func::IsAllSegmentsReceived(slot))
     {
         // Reassemble the RLC SDU from all byte segments with SN = x, remove RLC headers and deliver
         //  the reassembled RLC SDU to upper layer.
         uint8_t reassembleBuffer[REASSEMBLE_BUFFER_LEN];
-        int reassembled = func::Reassemble(rxBuffer, pdu.sn, reassembleBuffer);
-        rxCurrentSize -= reassembled;
+        rxCurrentSize -= slot.storedBytes;
+        int reassembled = func::Reassemble(slot, reassembleBuffer);
         if (reassembled > 0)
             consumer->deliverSdu(this, reassembleBuffer, reassembled);
 
@@ -93,7 +110,7 @@ void rlc::UmEntity::actionsOnReception(rlc::UmdPdu &pdu)
         if (x == rxNextReassembly)
         {
             int n = rxNextReassembly;
-            while (func::IsDelivered(rxBuffer, n))
+            while (isDelivered(n))
             {
                 n = (n + 1) % snModulus;
             }
@@ -103,10 +120,12 @@ void rlc::UmEntity::actionsOnReception(rlc::UmdPdu &pdu)
     else if (snCompareRx(x, rxNextHighest) >= 0)
     {
         // Update RX_Next_Highest to x + 1;
+        int oldWindowStart = (rxNextHighest - windowSize + snModulus) % snModulus;
         rxNextHighest = (x + 1) % snModulus;
 
-        // Discard any UMD PDUs with SN that falls outside of the reassembly window
-        rxCurrentSize -= func::DiscardRxPduIf(rxBuffer, [this](int sn) { return snCompareRx(sn, rxNextHighest) >= 0; });
+        // Discard any UMD PDUs with SN that falls outside of the reassembly window. (Buffered SNs are in the old
+        //  window, so only the part of the old window that is left behind needs to be cleared.)
+        rxCurrentSize -= discardRange(oldWindowStart, (rxNextHighest - windowSize + snModulus) % snModulus);
 
         // If RX_Next_Reassembly falls outside of the reassembly window
         if (snCompareRx(rxNextReassembly, rxNextHighest) >= 0)
@@ -114,7 +133,7 @@ void rlc::UmEntity::actionsOnReception(rlc::UmdPdu &pdu)
             // Set RX_Next_Reassembly to the SN of the first SN >= (RX_Next_Highest – UM_Window_Size)
             //  that has not been reassembled and delivered to upper layer.
             int n = (rxNextHighest - windowSize + snModulus) % snModulus;
-            while (func::IsDelivered(rxBuffer, n))
+            while (isDelivered(n))
             {
                 n = (n + 1) % snModulus;
             }
@@ -140,7 +159,7 @@ void rlc::UmEntity::actionsOnReception(rlc::UmdPdu &pdu)
             condition = true;
         }
         else if (rxNextHighest == (rxNextReassembly + 1) % snModulus &&
-                 !func::HasMissingSegment(rxBuffer, rxNextReassembly))
+                 !func::HasMissingSegment(rxSlots[rxNextReassembly]))
         {
             // if RX_Next_Highest = RX_Next_Reassembly + 1 and there is no missing byte segment
             //  of the RLC SDU associated with SN = RX_Next_Reassembly before the last byte of
@@ -165,7 +184,7 @@ void rlc::UmEntity::actionsOnReception(rlc::UmdPdu &pdu)
             condition = true;
         }
         else if (rxNextHighest == (rxNextReassembly + 1) % snModulus &&
-                 func::HasMissingSegment(rxBuffer, rxNextReassembly))
+                 func::HasMissingSegment(rxSlots[rxNextReassembly]))
         {
             // if RX_Next_Highest = RX_Next_Reassembly + 1 and there is at least one missing byte segment
             //  of the RLC SDU associated with SN = RX_Next_Reassembly before the last byte of all received
@@ -188,18 +207,18 @@ void rlc::UmEntity::actionsOnReassemblyTimerExpired()
 {
     // Update RX_Next_Reassembly to the SN of the first SN >= RX_Timer_Trigger that has not been reassembled
     rxNextReassembly = rxTimerTrigger;
-    while (func::IsDelivered(rxBuffer, rxNextReassembly))
+    while (isDelivered(rxNextReassembly))
         rxNextReassembly = (rxNextReassembly + 1) % snModulus;
 
     // Discard all segments with SN < updated RX_Next_Reassembly
-    rxCurrentSize -= func::DiscardRxPduIf(rxBuffer, [this](int sn) { return snCompareRx(sn, rxNextReassembly) < 0; });
+    rxCurrentSize -= discardRange((rxNextHighest - windowSize + snModulus) % snModulus, rxNextReassembly);
 
     // if RX_Next_Highest > RX_Next_Reassembly + 1;
     if ((snCompareRx(rxNextHighest, (rxNextReassembly + 1) % snModulus) > 0) ||
         // or if RX_Next_Highest = RX_Next_Reassembly + 1 and there is at
         //  least one missing byte segment of the RLC SDU associated with SN = RX_Next_Reassembly
         //  before the last byte of all received segments of this RLC SDU
-        (rxNextHighest == rxNextReassembly + 1 && func::HasMissingSegment(rxBuffer, rxNextReassembly)))
+        (rxNextHighest == (rxNextReassembly + 1) % snModulus && func::HasMissingSegment(rxSlots[rxNextReassembly])))
     {
         // start t-Reassembly
         reassemblyTimer.start(tCurrent);
@@ -222,46 +241,51 @@ void rlc::UmEntity::receivePdu(uint8_t *data, int size)
 
     // If data length == 0, then discard.
     if (pdu->size == 0)
+    {
+        delete pdu;
         return;
+    }
 
     // If it is a full SDU, deliver directly.
     if (pdu->si == ESegmentInfo::FULL)
     {
         consumer->deliverSdu(this, pdu->data, pdu->size);
+        delete pdu;
         return;
     }
 
     // If SO is invalid, then discard.
-    if (si::requiresSo(pdu->si) && pdu->so == 0)
-        return;
-
     // If (RX_Next_Highest – UM_Window_Size) <= SN < RX_Next_Reassembly, then discard.
-    if (snCompareRx(pdu->sn, rxNextReassembly) < 0)
-        return;
-
     // If no room, then discard.
-    if (rxCurrentSize + pdu->size > rxMaxSize)
+    if ((si::requiresSo(pdu->si) && pdu->so == 0) || snCompareRx(pdu->sn, rxNextReassembly) < 0 ||
+        rxCurrentSize + pdu->size > rxMaxSize)
+    {
+        delete pdu;
         return;
+    }
+
+    int x = pdu->sn;
 
     // Place the received UMD PDU in the reception buffer
-    rxCurrentSize +=
-        func::InsertToRxBuffer(rxBuffer, pdu, ISnCompare([this](int a, int b) { return snCompareRx(a, b); }));
+    rxCurrentSize += func::InsertToRxSlot(rxSlots[x], pdu);
 
     // Actions when an UMD PDU is placed in the reception buffer (5.2.2.2.3)
-    actionsOnReception(*pdu);
+    actionsOnReception(x);
 }
 
 void rlc::UmEntity::receiveSdu(uint8_t *data, int size, int sduId)
 {
-    txCurrentSize += func::InsertSduToTransmissionBuffer(data, size, sduId, txBuffer, txCurrentSize, txMaxSize);
+    txCurrentSize +=
+        func::InsertSduToTransmissionBuffer(data, size, sduId, segmentPool, txBuffer, txCurrentSize, txMaxSize);
 }
 
 int rlc::UmEntity::createPdu(uint8_t *buffer, int maxSize)
 {
-    auto segment = txBuffer.getFirstElement();
-    if (segment == nullptr)
+    if (txBuffer.isEmpty())
         return 0;
 
+    auto segment = txBuffer.getFirst();
+
     int headerSize = func::UmdPduHeaderSize(snLength, segment->si);
 
     // Fragmentation is irrelevant since no byte fits the size.
@@ -274,7 +298,7 @@ int rlc::UmEntity::createPdu(uint8_t *buffer, int maxSize)
     // Perform segmentation if it is needed
     if (headerSize + segment->size > maxSize)
     {
-        auto next = func::UmPerformSegmentation(segment, maxSize, snLength);
+        auto next = func::UmPerformSegmentation(segmentPool, segment, maxSize, snLength);
         if (next == nullptr)
             return 0;
         txBuffer.addFirst(next);
@@ -285,8 +309,12 @@ int rlc::UmEntity::createPdu(uint8_t *buffer, int maxSize)
 
     txCurrentSize -= segment->size;
 
-    return RlcEncoder::EncodeUmd(buffer, snLength == 6, segment->si, segment->so, segment->sdu->sn,
-                                 segment->sdu->data + segment->so, segment->size);
+    int written = RlcEncoder::EncodeUmd(buffer, snLength == 6, segment->si, segment->so, segment->sdu->sn,
+                                        segment->sdu->data + segment->so, segment->size);
+
+    // UM has no retransmission, the segment is released as soon as it is submitted.
+    segmentPool.release(segment);
+    return written;
 }
 
 void rlc::UmEntity::timerCycle(int64_t currentTime)
@@ -299,21 +327,21 @@ void rlc::UmEntity::timerCycle(int64_t currentTime)
 
 void rlc::UmEntity::discardSdu(int sduId)
 {
-    auto segment = func::FindFirstSduSegmentWithId(txBuffer, sduId);
+    int index = func::FindFirstSduSegmentWithId(txBuffer, sduId);
 
     // SDU not found, do nothing.
-    if (segment == nullptr)
+    if (index == -1)
         return;
 
     // The SDU is already segmented, do nothing.
-    if (segment->value->si != ESegmentInfo::FULL)
+    if (txBuffer[index]->si != ESegmentInfo::FULL)
         return;
 
-    // Remove the segment
-    delete txBuffer.remove(segment);
-
     // TODO, WARNING: not really sure here because this is not included in the a.i
-    txCurrentSize -= segment->value->size;
+    txCurrentSize -= txBuffer[index]->size;
+
+    // Remove the segment
+    segmentPool.release(txBuffer.removeAt(index));
 }
 
 void rlc::UmEntity::reestablishment()
@@ -326,7 +354,7 @@ void rlc::UmEntity::calculateDataVolume(rlc::RlcDataVolume &volume)
     auto txCalc = [this](const RlcSduSegment *v) { return v->size + func::UmdPduHeaderSize(snLength, v->si); };
 
     // Calculate TX
-    volume.transmissionSize = func::ListSum<RlcSduSegment>(txBuffer, txCalc);
+    volume.transmissionSize = func::BufferSum(txBuffer, txCalc);
 
     // Calculate RX
     volume.receptionSize = rxCurrentSize; // An estimation.
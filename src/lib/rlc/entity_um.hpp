@@ -11,7 +11,9 @@
 #include "rlc.hpp"
 #include "utils.hpp"
 
-#include <utils/linked_list.hpp>
+#include <vector>
+
+#include <utils/ring_buffer.hpp>
 
 namespace rlc
 {
@@ -25,16 +27,19 @@ class UmEntity : public IRlcEntity
     int txMaxSize;
     int rxMaxSize;
 
+    // Segment descriptors
+    SegmentPool segmentPool;
+
     // TX buffer
     int txCurrentSize;
-    LinkedList<RlcSduSegment> txBuffer;
+    RingBuffer<RlcSduSegment *> txBuffer;
 
     // TX state variables
     int txNext; // SN to be assigned for the next newly generated UMD PDU with segment
 
-    // RX buffer
+    // RX buffer indexed by SN
     int rxCurrentSize;
-    LinkedList<UmdPdu> rxBuffer;
+    std::vector<RxSlot> rxSlots;
 
     // RX state variables
     int rxNextReassembly; // Earliest SN that is still considered for reassembly
@@ -56,9 +61,11 @@ class UmEntity : public IRlcEntity
     /* Utils */
     [[nodiscard]] int modulusRx(int num) const;
     [[nodiscard]] int snCompareRx(int a, int b) const;
+    bool isDelivered(int sn);
+    int discardRange(int startSn, int endSn);
 
     /* Actions */
-    void actionsOnReception(UmdPdu &pdu);
+    void actionsOnReception(int x);
     void actionsOnReassemblyTimerExpired();
 
   public:
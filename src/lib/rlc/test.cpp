@@ -9,178 +9,248 @@
 #include "test.hpp"
 #include "rlc.hpp"
 
-#include <utils/nts.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <vector>
 
-enum class EntityType
+namespace rlc
 {
-    TM,
-    UM,
-    AM
-};
-
-static constexpr int SN_LENGTH = 12;
-static constexpr int TX_MAX_SIZE = 1024 * 32;
-static constexpr int RX_MAX_SIZE = 1024 * 32;
-static constexpr int MAX_RET = 8;
-static constexpr int POLL_RETRANSMIT_PERIOD = 400;
-static constexpr int REASSEMBLY_PERIOD = 400;
-static constexpr int STATUS_PROHIBIT_PERIOD = 400;
-
-// UPPER LAYER
-static constexpr int TRANSMISSION_SIZE = 2000;
-
-// LOWER LAYER
-static constexpr int OPPORTUNITY_SIZE_MIN = 10000;
-static constexpr int OPPORTUNITY_SIZE_MAX = 30000;
 
-// GENERAL
-static constexpr int MAX_PACKET_SEND_COUNT = 60000;
-static constexpr EntityType ENTITY = EntityType::AM;
-
-struct NwRadioUplink : NtsMessage
+struct LinkPdu
 {
-    size_t size{};
-    uint8_t *data{};
-
-    NwRadioUplink() : NtsMessage(NtsMessageType::RESERVED_END)
-    {
-    }
-
-    ~NwRadioUplink() override = default;
+    int64_t arrival;
+    std::vector<uint8_t> data;
 };
 
-static uint64_t currentTimeMs()
+/**
+ * One side of the benchmark. The UE side transmits SDUs, the gNB side receives them and only sends STATUS PDUs back.
+ */
+struct BenchmarkPeer : IRlcConsumer
 {
-    auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
-}
+    IRlcEntity *entity{};
+    int64_t *currentTime{};
+
+    // Reception statistics
+    std::vector<int64_t> *submitTimes{};
+    std::vector<bool> received{};
+    std::vector<int64_t> latencies{};
+    int lastReceived = -1;
+    int duplicates = 0;
+    int outOfOrder = 0;
+    bool radioLinkFailure = false;
 
-namespace rlc
-{
+    void deliverSdu(IRlcEntity *e, uint8_t *data, int size) override
+    {
+        if (size < 4)
+            return;
 
-struct RlcTask : NtsTask, IRlcConsumer
-{
-    IRlcEntity *m_pEntity;
-    std::string tag;
-    RlcTask *pair;
+        int index;
+        std::memcpy(&index, data, sizeof(index));
+        if (index < 0 || index >= static_cast<int>(received.size()))
+            return;
+
+        if (received[index])
+        {
+            duplicates++;
+            return;
+        }
+        received[index] = true;
 
-    int packetId;
-    int receivedCounter;
+        if (index < lastReceived)
+            outOfOrder++;
+        lastReceived = std::max(lastReceived, index);
 
-    bool continueTesting = true;
+        latencies.push_back(*currentTime - (*submitTimes)[index]);
+    }
 
-    RlcTask()
+    void maxRetransmissionReached(IRlcEntity *e) override
     {
-        switch (ENTITY)
-        {
-        case EntityType::TM:
-            m_pEntity = NewTmEntity(this, TX_MAX_SIZE);
-            break;
-        case EntityType::UM:
-            m_pEntity = NewUmEntity(this, SN_LENGTH, REASSEMBLY_PERIOD, TX_MAX_SIZE, RX_MAX_SIZE);
-            break;
-        case EntityType::AM:
-            m_pEntity = NewAmEntity(this, SN_LENGTH, TX_MAX_SIZE, RX_MAX_SIZE, -1, -1, MAX_RET, POLL_RETRANSMIT_PERIOD,
-                                    REASSEMBLY_PERIOD, STATUS_PROHIBIT_PERIOD);
-            break;
-        }
+        radioLinkFailure = true;
     }
 
-    void onStart() override
+    void sduSuccessfulDelivery(IRlcEntity *e, int sduId) override
     {
     }
+};
 
-    void onLoop() override
+static IRlcEntity *NewBenchmarkEntity(const RlcBenchmarkConfig &c, IRlcConsumer *consumer)
+{
+    switch (c.entity)
     {
-        NtsMessage *msg = poll();
-        if (msg)
+    case EBenchmarkEntity::TM:
+        return NewTmEntity(consumer, c.txMaxSize);
+    case EBenchmarkEntity::UM:
+        return NewUmEntity(consumer, c.snLength, c.reassemblyPeriod, c.txMaxSize, c.rxMaxSize);
+    default:
+        return NewAmEntity(consumer, c.snLength, c.txMaxSize, c.rxMaxSize, -1, -1, c.maxRet, c.pollRetransmitPeriod,
+                           c.reassemblyPeriod, c.statusProhibitPeriod);
+    }
+}
+
+RlcBenchmarkResult RunRlcBenchmark(const RlcBenchmarkConfig &config)
+{
+    // Time starts from 1, because zero means 'not started' for RLC timers.
+    int64_t currentTime = 1;
+    std::vector<int64_t> submitTimes(config.sduCount);
+
+    BenchmarkPeer tx{}, rx{};
+    tx.entity = NewBenchmarkEntity(config, &tx);
+    rx.entity = NewBenchmarkEntity(config, &rx);
+    tx.currentTime = rx.currentTime = &currentTime;
+    rx.submitTimes = &submitTimes;
+    rx.received.resize(config.sduCount);
+    rx.latencies.reserve(config.sduCount);
+
+    std::deque<LinkPdu> uplink{}, downlink{};
+    std::mt19937 rng{config.seed};
+    std::uniform_real_distribution<double> uniform{0.0, 1.0};
+
+    std::vector<uint8_t> sdu(std::max(config.sduSize, 4));
+    std::vector<uint8_t> buffer(config.opportunitySize);
+
+    RlcBenchmarkResult res{};
+    int submitted = 0;
+    int64_t idleSince = -1;
+
+    auto transmit = [&](IRlcEntity *entity, std::deque<LinkPdu> &link) {
+        bool any = false;
+        for (int i = 0; i < config.opportunitiesPerMs; i++)
         {
-            if (msg->msgType == NtsMessageType::RESERVED_END)
+            int size = entity->createPdu(buffer.data(), config.opportunitySize);
+            if (size <= 0)
+                break;
+            any = true;
+            res.pdusSent++;
+            if (uniform(rng) < config.lossRate)
             {
-                auto w = ((NwRadioUplink *)msg);
-                m_pEntity->receivePdu(w->data, w->size);
-                delete w;
+                res.pdusLost++;
+                continue;
             }
+            link.push_back(LinkPdu{currentTime + config.linkDelay, {buffer.data(), buffer.data() + size}});
         }
+        return any;
+    };
 
-        m_pEntity->timerCycle(currentTimeMs());
-
-        auto opSize = (OPPORTUNITY_SIZE_MAX + OPPORTUNITY_SIZE_MIN) / 2;
-        static uint8_t buffer[OPPORTUNITY_SIZE_MAX];
-
-        auto written = m_pEntity->createPdu(buffer, opSize);
-        if (written)
+    auto receive = [&](IRlcEntity *entity, std::deque<LinkPdu> &link) {
+        while (!link.empty() && link.front().arrival <= currentTime)
         {
-            auto uplink = new NwRadioUplink();
-            uplink->size = written;
-            uplink->data = buffer;
-            pair->push(uplink);
+            entity->receivePdu(link.front().data.data(), static_cast<int>(link.front().data.size()));
+            link.pop_front();
         }
+    };
 
-        if (continueTesting)
-            upperTransmission();
-    }
+    auto startedAt = std::chrono::steady_clock::now();
 
-    void onQuit() override
+    while (currentTime < config.maxDuration && !tx.radioLinkFailure)
     {
-    }
+        tx.entity->timerCycle(currentTime);
+        rx.entity->timerCycle(currentTime);
 
-    void upperTransmission()
-    {
-        packetId++;
+        receive(rx.entity, uplink);
+        receive(tx.entity, downlink);
 
-        if (packetId >= MAX_PACKET_SEND_COUNT)
+        // Offer as many SDUs as the TX buffer accepts
+        while (submitted < config.sduCount)
         {
-            puts("ENOUGH TESTING TODAY");
-            tag = tag + "XX"; // it means transmission is done
-            continueTesting = false;
-            return;
+            RlcDataVolume before{}, after{};
+            tx.entity->calculateDataVolume(before);
+
+            std::memcpy(sdu.data(), &submitted, sizeof(submitted));
+            tx.entity->receiveSdu(sdu.data(), config.sduSize, submitted);
+
+            tx.entity->calculateDataVolume(after);
+            if (after.transmissionSize == before.transmissionSize)
+                break;
+            submitTimes[submitted++] = currentTime;
         }
 
-        static uint8_t packet[TRANSMISSION_SIZE];
+        bool active = transmit(tx.entity, uplink);
+        active |= transmit(rx.entity, downlink);
+        active |= !uplink.empty() || !downlink.empty();
 
-        m_pEntity->receiveSdu(packet, TRANSMISSION_SIZE, packetId);
-    }
+        if (static_cast<int>(rx.latencies.size()) == config.sduCount)
+            break;
 
-    void deliverSdu(IRlcEntity *e, uint8_t *data, int size) override
-    {
-        receivedCounter++;
-        printf("[%s] PDU RECEIVED, TOTAL COUNT %d B\n", tag.c_str(), receivedCounter * TRANSMISSION_SIZE);
-        if (receivedCounter * TRANSMISSION_SIZE == 119998000)
+        // Everything is submitted and the link stays idle longer than any timer, nothing more will be delivered.
+        if (submitted == config.sduCount && !active)
+        {
+            if (idleSince == -1)
+                idleSince = currentTime;
+            if (currentTime - idleSince > 4 * std::max(config.pollRetransmitPeriod, config.reassemblyPeriod))
+                break;
+        }
+        else
         {
-            printf("%ld\n", currentTimeMs());
-            exit(1);
+            idleSince = -1;
         }
 
-        fflush(stdout);
+        currentTime++;
     }
 
-    void maxRetransmissionReached(IRlcEntity *e) override
-    {
-        printf("[%s] RADIO LINK FAILURE\n", tag.c_str());
-        fflush(stdout);
-    }
+    auto elapsed = std::chrono::steady_clock::now() - startedAt;
 
-    void sduSuccessfulDelivery(IRlcEntity *e, int sduId) override
+    res.delivered = static_cast<int>(rx.latencies.size());
+    res.duplicates = rx.duplicates;
+    res.outOfOrder = rx.outOfOrder;
+    res.radioLinkFailure = tx.radioLinkFailure;
+    res.simulatedMs = currentTime;
+    res.wallSeconds = std::chrono::duration<double>(elapsed).count();
+
+    if (res.wallSeconds > 0)
+        res.throughputMbps = res.delivered * static_cast<double>(config.sduSize) * 8.0 / res.wallSeconds / 1e6;
+    if (res.pdusSent > 0)
+        res.nsPerPdu = res.wallSeconds * 1e9 / static_cast<double>(res.pdusSent);
+
+    auto &latencies = rx.latencies;
+    if (!latencies.empty())
     {
-        printf("[%s] SDU %d DELIVERED\n", tag.c_str(), sduId);
-        fflush(stdout);
+        double sum = 0;
+        for (auto l : latencies)
+            sum += static_cast<double>(l);
+        res.meanLatencyMs = sum / static_cast<double>(latencies.size());
+
+        std::sort(latencies.begin(), latencies.end());
+        res.p50LatencyMs = latencies[latencies.size() / 2];
+        res.p99LatencyMs = latencies[latencies.size() * 99 / 100];
+        res.maxLatencyMs = latencies.back();
     }
-};
+
+    delete tx.entity;
+    delete rx.entity;
+
+    return res;
+}
 
 void rlcTestMain()
 {
-    auto ueRlc = new RlcTask();
-    auto gnbRlc = new RlcTask();
+    const EBenchmarkEntity entities[] = {EBenchmarkEntity::UM, EBenchmarkEntity::AM};
+    const double lossRates[] = {0.0, 0.001, 0.01, 0.05, 0.1};
 
-    ueRlc->pair = gnbRlc;
-    gnbRlc->pair = ueRlc;
+    printf("%-4s %6s %9s %6s %6s %9s %8s %6s %6s %6s %10s %9s\n", "mode", "loss", "delivered", "dup", "ooo", "pdus",
+           "lost", "mean", "p50", "p99", "Mbit/s", "ns/pdu");
 
-    ueRlc->tag = "UE";
-    gnbRlc->tag = "GNB";
-
-    printf("%ld\n", currentTimeMs());
-    ueRlc->start();
-    gnbRlc->start();
+    for (auto entity : entities)
+    {
+        for (auto lossRate : lossRates)
+        {
+            RlcBenchmarkConfig config{};
+            config.entity = entity;
+            config.lossRate = lossRate;
+
+            auto r = RunRlcBenchmark(config);
+
+            printf("%-4s %6.3f %9d %6d %6d %9ld %8ld %6.1f %6ld %6ld %10.1f %9.1f%s\n",
+                   entity == EBenchmarkEntity::AM ? "AM" : "UM", lossRate, r.delivered, r.duplicates, r.outOfOrder,
+                   static_cast<long>(r.pdusSent), static_cast<long>(r.pdusLost), r.meanLatencyMs,
+                   static_cast<long>(r.p50LatencyMs), static_cast<long>(r.p99LatencyMs), r.throughputMbps, r.nsPerPdu,
+                   r.radioLinkFailure ? " RLF" : "");
+            fflush(stdout);
+        }
+    }
 }
+
 } // namespace rlc
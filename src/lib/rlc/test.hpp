@@ -8,9 +8,68 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace rlc
 {
 
+enum class EBenchmarkEntity
+{
+    TM,
+    UM,
+    AM
+};
+
+struct RlcBenchmarkConfig
+{
+    EBenchmarkEntity entity = EBenchmarkEntity::AM;
+
+    // Entity configuration
+    int snLength = 12;
+    int txMaxSize = 1024 * 1024;
+    int rxMaxSize = 1024 * 1024;
+    int maxRet = 8;
+    int pollRetransmitPeriod = 40;
+    int reassemblyPeriod = 20;
+    int statusProhibitPeriod = 10;
+
+    // Upper layer
+    int sduSize = 2000;
+    int sduCount = 60000;
+
+    // Lower layer (simulated link, both directions)
+    int opportunitySize = 20000;  // Bytes per transmission opportunity
+    int opportunitiesPerMs = 4;   // Transmission opportunities per ms
+    int linkDelay = 5;            // One-way delay in ms
+    double lossRate = 0.0;        // Probability of losing a PDU on the link
+    uint32_t seed = 1;            // Seed of the loss process
+    int64_t maxDuration = 600000; // Upper bound of the simulated time in ms
+};
+
+struct RlcBenchmarkResult
+{
+    int delivered;
+    int duplicates;
+    int outOfOrder;
+    int64_t pdusSent;
+    int64_t pdusLost;
+    bool radioLinkFailure;
+
+    // Simulated time
+    int64_t simulatedMs;
+    double meanLatencyMs;
+    int64_t p50LatencyMs;
+    int64_t p99LatencyMs;
+    int64_t maxLatencyMs;
+
+    // Processing cost
+    double wallSeconds;
+    double throughputMbps; // Delivered payload per wall-clock second
+    double nsPerPdu;       // Wall-clock time per PDU sent over the link
+};
+
+RlcBenchmarkResult RunRlcBenchmark(const RlcBenchmarkConfig &config);
+
 void rlcTestMain();
 
-}
\ No newline at end of file
+} // namespace rlc
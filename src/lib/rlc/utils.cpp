@@ -15,3 +15,42 @@ int rlc::StatusPdu::calculatedSize(bool isShortSn) const
     uint8_t buffer[32768];
     return RlcEncoder::EncodeStatus(buffer, *this, isShortSn);
 }
+
+rlc::SegmentPool::~SegmentPool()
+{
+    while (freeList != nullptr)
+    {
+        auto next = freeList->next;
+        delete freeList;
+        freeList = next;
+    }
+}
+
+rlc::RlcSduSegment *rlc::SegmentPool::acquire(RlcSdu *sdu)
+{
+    RlcSduSegment *segment = freeList;
+    if (segment != nullptr)
+        freeList = segment->next;
+    else
+        segment = new RlcSduSegment();
+
+    segment->sdu = sdu;
+    segment->size = 0;
+    segment->so = 0;
+    segment->si = ESegmentInfo::FULL;
+    segment->state = ESegmentState::NONE;
+    segment->next = nullptr;
+
+    sdu->_refCount++;
+    return segment;
+}
+
+void rlc::SegmentPool::release(RlcSduSegment *segment)
+{
+    if (--segment->sdu->_refCount == 0)
+        delete segment->sdu;
+
+    segment->sdu = nullptr;
+    segment->next = freeList;
+    freeList = segment;
+}
@@ -77,6 +77,18 @@ struct NackBlock
     int nackRange;
 };
 
+enum class ESegmentState
+{
+    // Not yet submitted to lower layer
+    NONE,
+    // Submitted to lower layer, waiting for a STATUS report
+    WAIT,
+    // Negatively acknowledged or timed out, waiting for retransmission
+    RET,
+    // Positively acknowledged
+    ACK,
+};
+
 struct RxPdu
 {
     ESegmentInfo si;
@@ -86,6 +98,9 @@ struct RxPdu
     int size;
     bool isProcessed;
 
+    // Next PDU with the same SN in the reception buffer (sorted by SO)
+    RxPdu *next{};
+
     virtual ~RxPdu()
     {
         delete[] data;
@@ -142,21 +157,64 @@ class RlcSdu
 
 struct RlcSduSegment
 {
-    RlcSdu *const sdu;
+    RlcSdu *sdu;
     int size;
     int so;
     ESegmentInfo si;
+    ESegmentState state;
 
-    explicit RlcSduSegment(RlcSdu *sdu) : sdu(sdu), size{}, so{}, si{}
-    {
-        sdu->_refCount++;
-    }
+    // Next segment of the same SDU in the transmission slot (sorted by SO), or the next free item in the pool
+    RlcSduSegment *next;
+};
 
-    ~RlcSduSegment()
+/**
+ * Free-list of segment descriptors owned by an RLC entity. Descriptors are recycled instead of being freed, so the
+ * number of allocations is bounded by the peak number of segments in flight.
+ * The SDU reference count is maintained here, and the SDU is deleted when its last segment is released.
+ */
+class SegmentPool
+{
+    RlcSduSegment *freeList;
+
+  public:
+    SegmentPool() : freeList{}
     {
-        if (--sdu->_refCount == 0)
-            delete sdu;
     }
+
+    ~SegmentPool();
+
+    SegmentPool(const SegmentPool &) = delete;
+    SegmentPool &operator=(const SegmentPool &) = delete;
+
+    RlcSduSegment *acquire(RlcSdu *sdu);
+    void release(RlcSduSegment *segment);
+};
+
+/**
+ * Reception buffer entry for one SN. RX PDUs with the same SN are kept in an intrusive list sorted by SO.
+ * After reassembly, the PDUs are freed immediately and only the delivered flag is kept until the SN leaves the window.
+ */
+struct RxSlot
+{
+    RxPdu *head{};
+    int storedBytes{};
+    bool delivered{};
+};
+
+/**
+ * Transmission buffer entry for one SN. Segments submitted to lower layer are kept in an intrusive list sorted by SO.
+ */
+struct TxSlot
+{
+    RlcSduSegment *head{};
+    int segmentCount{};
+    int ackedCount{};
+    // Stamp of the last STATUS PDU that incremented RETX_COUNT of this SDU
+    int retIncrementStamp{};
+    // Not all bytes of the SDU have been submitted to lower layer yet
+    bool pendingTx{};
+    // SN is already queued in the retransmission queue
+    bool inRetQueue{};
 };
 
 class RlcTimer
@@ -204,42 +262,6 @@ class RlcTimer
     }
 };
 
-template <typename T>
-struct IComparator
-{
-    virtual int compare(const T &a, const T &b) const = 0;
-};
-
-template <typename T, typename U>
-struct ILambdaComparator : IComparator<T>
-{
-    const U &u;
-
-    explicit ILambdaComparator(const U &u) : u(u)
-    {
-    }
-
-    int compare(const T &a, const T &b) const override
-    {
-        return u(a, b);
-    }
-};
-
-template <typename TComparator>
-struct ISnCompare : IComparator<int>
-{
-    const TComparator &comp;
-
-    explicit ISnCompare(const TComparator &comp) : comp(comp)
-    {
-    }
-
-    inline int compare(const int &a, const int &b) const override
-    {
-        return comp(a, b);
-    }
-};
-
 struct MissingBlock
 {
     // Start SN and SO of the missing block
@@ -0,0 +1,327 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "mobility.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include <utils/common.hpp>
+#include <utils/io.hpp>
+
+static constexpr const int TIMER_ID_TICK = 1;
+
+static int ToCoordinate(double value)
+{
+    value = std::max(value, static_cast<double>(std::numeric_limits<int>::min()));
+    value = std::min(value, static_cast<double>(std::numeric_limits<int>::max()));
+    return static_cast<int>(std::lround(value));
+}
+
+static double Distance(const Vector3 &a, double x, double y, double z)
+{
+    double dx = a.x - x, dy = a.y - y, dz = a.z - z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+namespace rls
+{
+
+MobilityEngine::MobilityEngine(const MobilityConfig &config)
+    : m_config{config}, m_rng{config.seed}, m_startTime{}, m_lastTick{}, m_x{}, m_y{}, m_z{}, m_vx{}, m_vy{}, m_vz{},
+      m_remaining{}, m_phase{}, m_target{}, m_traceCursor{}, m_traces{}, m_mutex{}, m_published{}
+{
+    if (config.model == EMobilityModel::TRACE)
+        loadTrace(config.traceFile);
+}
+
+void MobilityEngine::loadTrace(const std::string &path)
+{
+    if (!io::Exists(path))
+        throw std::runtime_error("Mobility trace file not found: " + path);
+
+    std::stringstream stream{io::ReadAllText(path)};
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(stream, line))
+    {
+        lineNumber++;
+        utils::Trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::stringstream ls{line};
+        int ueIndex;
+        Waypoint waypoint{};
+        if (!(ls >> ueIndex >> waypoint.time >> waypoint.position.x >> waypoint.position.y >> waypoint.position.z) ||
+            ueIndex < 0 || waypoint.time < 0)
+            throw std::runtime_error("Invalid mobility trace at line " + std::to_string(lineNumber) + ": " + line);
+
+        m_traces[ueIndex].push_back(waypoint);
+    }
+
+    for (auto &trace : m_traces)
+    {
+        std::stable_sort(trace.second.begin(), trace.second.end(),
+                         [](const Waypoint &a, const Waypoint &b) { return a.time < b.time; });
+    }
+}
+
+int MobilityEngine::addUe()
+{
+    size_t index = m_x.size();
+
+    Vector3 position = m_config.position;
+    if (m_config.model == EMobilityModel::RANDOM_WAYPOINT)
+    {
+        auto pick = [this](int a, int b) {
+            return std::uniform_int_distribution<int>{std::min(a, b), std::max(a, b)}(m_rng);
+        };
+        position = Vector3{pick(m_config.areaMin.x, m_config.areaMax.x), pick(m_config.areaMin.y, m_config.areaMax.y),
+                           pick(m_config.areaMin.z, m_config.areaMax.z)};
+    }
+    else if (m_config.model == EMobilityModel::TRACE)
+    {
+        auto it = m_traces.find(static_cast<int>(index));
+        if (it != m_traces.end() && !it->second.empty())
+            position = it->second[0].position;
+    }
+
+    m_x.push_back(position.x);
+    m_y.push_back(position.y);
+    m_z.push_back(position.z);
+    m_vx.push_back(0);
+    m_vy.push_back(0);
+    m_vz.push_back(0);
+    m_remaining.push_back(std::numeric_limits<double>::infinity());
+    m_phase.push_back(EPhase::STOPPED);
+    m_target.push_back(position);
+    m_traceCursor.push_back(0);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_published.push_back(position);
+
+    return static_cast<int>(index);
+}
+
+void MobilityEngine::start(int64_t now)
+{
+    m_startTime = now;
+    m_lastTick = now;
+
+    for (size_t i = 0; i < m_x.size(); i++)
+    {
+        switch (m_config.model)
+        {
+        case EMobilityModel::STATIC:
+            break;
+        case EMobilityModel::LINEAR:
+            m_vx[i] = m_config.velocity.x / 1000.0;
+            m_vy[i] = m_config.velocity.y / 1000.0;
+            m_vz[i] = m_config.velocity.z / 1000.0;
+            m_phase[i] = EPhase::MOVING;
+            break;
+        case EMobilityModel::RANDOM_WAYPOINT:
+            startRandomSegment(i);
+            break;
+        case EMobilityModel::TRACE: {
+            auto it = m_traces.find(static_cast<int>(i));
+            if (it == m_traces.end() || it->second.empty())
+                break;
+            // Waits at the first waypoint until its time
+            m_phase[i] = EPhase::PAUSED;
+            m_remaining[i] = static_cast<double>(it->second[0].time);
+            break;
+        }
+        }
+    }
+}
+
+void MobilityEngine::advance(int64_t now)
+{
+    auto dt = static_cast<double>(std::max(now - m_lastTick, static_cast<int64_t>(0)));
+    m_lastTick = now;
+
+    size_t n = m_x.size();
+    double *x = m_x.data(), *y = m_y.data(), *z = m_z.data();
+    const double *vx = m_vx.data(), *vy = m_vy.data(), *vz = m_vz.data();
+    double *remaining = m_remaining.data();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        z[i] += vz[i] * dt;
+        remaining[i] -= dt;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        if (remaining[i] <= 0)
+            endOfSegment(i, now);
+    }
+
+    publish();
+}
+
+void MobilityEngine::endOfSegment(size_t index, int64_t now)
+{
+    if (m_phase[index] == EPhase::MOVING)
+    {
+        // Snap to the target to avoid accumulating errors
+        m_x[index] = m_target[index].x;
+        m_y[index] = m_target[index].y;
+        m_z[index] = m_target[index].z;
+    }
+
+    m_vx[index] = m_vy[index] = m_vz[index] = 0;
+
+    if (m_config.model == EMobilityModel::RANDOM_WAYPOINT)
+    {
+        if (m_phase[index] == EPhase::MOVING && m_config.pauseTime > 0)
+        {
+            m_phase[index] = EPhase::PAUSED;
+            m_remaining[index] = m_config.pauseTime;
+        }
+        else
+        {
+            startRandomSegment(index);
+        }
+        return;
+    }
+
+    if (m_config.model == EMobilityModel::TRACE)
+    {
+        auto &trace = m_traces[static_cast<int>(index)];
+        auto &cursor = m_traceCursor[index];
+
+        // Waypoints that are passed already (e.g. due to a late tick) are skipped
+        int64_t elapsed = now - m_startTime;
+        while (cursor + 1 < trace.size() && trace[cursor + 1].time <= elapsed)
+            cursor++;
+
+        if (cursor + 1 >= trace.size())
+        {
+            auto &last = trace.back().position;
+            m_x[index] = last.x;
+            m_y[index] = last.y;
+            m_z[index] = last.z;
+            m_phase[index] = EPhase::STOPPED;
+            m_remaining[index] = std::numeric_limits<double>::infinity();
+            return;
+        }
+
+        // Continue from where the UE should be at this time on the next segment
+        auto &from = trace[cursor];
+        auto &to = trace[cursor + 1];
+        double ratio = 0;
+        if (to.time > from.time)
+            ratio = std::clamp(static_cast<double>(elapsed - from.time) / static_cast<double>(to.time - from.time), 0.0,
+                               1.0);
+        m_x[index] = from.position.x + (static_cast<double>(to.position.x) - from.position.x) * ratio;
+        m_y[index] = from.position.y + (static_cast<double>(to.position.y) - from.position.y) * ratio;
+        m_z[index] = from.position.z + (static_cast<double>(to.position.z) - from.position.z) * ratio;
+
+        cursor++;
+        startSegment(index, to.position, static_cast<double>(to.time - elapsed));
+        return;
+    }
+
+    m_phase[index] = EPhase::STOPPED;
+    m_remaining[index] = std::numeric_limits<double>::infinity();
+}
+
+void MobilityEngine::startSegment(size_t index, const Vector3 &target, double duration)
+{
+    duration = std::max(duration, 1.0);
+
+    m_target[index] = target;
+    m_vx[index] = (target.x - m_x[index]) / duration;
+    m_vy[index] = (target.y - m_y[index]) / duration;
+    m_vz[index] = (target.z - m_z[index]) / duration;
+    m_remaining[index] = duration;
+    m_phase[index] = EPhase::MOVING;
+}
+
+void MobilityEngine::startRandomSegment(size_t index)
+{
+    auto pick = [this](int a, int b) {
+        return std::uniform_int_distribution<int>{std::min(a, b), std::max(a, b)}(m_rng);
+    };
+
+    Vector3 target{pick(m_config.areaMin.x, m_config.areaMax.x), pick(m_config.areaMin.y, m_config.areaMax.y),
+                   pick(m_config.areaMin.z, m_config.areaMax.z)};
+    int speed = std::max(pick(m_config.minSpeed, m_config.maxSpeed), 1);
+
+    double distance = Distance(target, m_x[index], m_y[index], m_z[index]);
+    startSegment(index, target, distance * 1000.0 / speed);
+}
+
+void MobilityEngine::publish()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_published.size(); i++)
+        m_published[i] = Vector3{ToCoordinate(m_x[i]), ToCoordinate(m_y[i]), ToCoordinate(m_z[i])};
+}
+
+Vector3 MobilityEngine::getPosition(int index) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (index < 0 || index >= static_cast<int>(m_published.size()))
+        return Vector3{};
+    return m_published[index];
+}
+
+bool MobilityEngine::isStatic() const
+{
+    return m_config.model == EMobilityModel::STATIC;
+}
+
+int MobilityEngine::getTickPeriod() const
+{
+    return std::max(m_config.tickPeriod, 1);
+}
+
+MobilityTask::MobilityTask(MobilityEngine *engine) : m_engine{engine}
+{
+}
+
+void MobilityTask::onStart()
+{
+    m_engine->start(utils::CurrentTimeMillis());
+    setTimer(TIMER_ID_TICK, m_engine->getTickPeriod());
+}
+
+void MobilityTask::onLoop()
+{
+    auto *msg = take();
+    if (msg == nullptr)
+        return;
+
+    if (msg->msgType == NtsMessageType::TIMER_EXPIRED)
+    {
+        auto *w = dynamic_cast<NmTimerExpired *>(msg);
+        if (w->timerId == TIMER_ID_TICK)
+        {
+            m_engine->advance(utils::CurrentTimeMillis());
+            setTimer(TIMER_ID_TICK, m_engine->getTickPeriod());
+        }
+    }
+
+    delete msg;
+}
+
+void MobilityTask::onQuit()
+{
+}
+
+} // namespace rls
@@ -0,0 +1,129 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <utils/common_types.hpp>
+#include <utils/nts.hpp>
+
+namespace rls
+{
+
+enum class EMobilityModel
+{
+    STATIC,
+    LINEAR,          // Constant velocity from the initial position
+    RANDOM_WAYPOINT, // Random destinations and speeds within an area, with optional pauses
+    TRACE            // Timed waypoints of each UE read from a file
+};
+
+struct MobilityConfig
+{
+    EMobilityModel model = EMobilityModel::STATIC;
+    Vector3 position{};  // Initial position for STATIC and LINEAR, and for the UEs without a trace
+    Vector3 velocity{};  // Units per second, only for LINEAR
+    Vector3 areaMin{};   // Only for RANDOM_WAYPOINT
+    Vector3 areaMax{};   // Only for RANDOM_WAYPOINT
+    int minSpeed = 1;    // Units per second, only for RANDOM_WAYPOINT
+    int maxSpeed = 10;   // Units per second, only for RANDOM_WAYPOINT
+    int pauseTime = 0;   // Pause at each destination in milliseconds, only for RANDOM_WAYPOINT
+    std::string traceFile{};
+    int tickPeriod = 100; // Position update period in milliseconds
+    uint32_t seed = 1;
+};
+
+/**
+ * Moves the simulated positions of all the UEs of a process.
+ * <p>
+ * Every model is reduced to straight segments travelled with a constant velocity, so that each tick updates the
+ * positions of all UEs with a single loop over contiguous arrays. Only the UEs reaching the end of their segment are
+ * handled individually. Updated positions are published once per tick, and read by the UEs at any time.
+ * <p>
+ * Trace file consists of "<ue-index> <time-ms> <x> <y> <z>" lines, where the UE index is the order of the UE in the
+ * process, and the time is relative to the start of the engine. Lines starting with '#' are ignored.
+ */
+class MobilityEngine
+{
+  private:
+    enum class EPhase : uint8_t
+    {
+        MOVING,
+        PAUSED,
+        STOPPED
+    };
+
+    struct Waypoint
+    {
+        int64_t time;
+        Vector3 position;
+    };
+
+  private:
+    MobilityConfig m_config;
+    std::mt19937 m_rng;
+    int64_t m_startTime;
+    int64_t m_lastTick;
+
+    /* State of the UEs as separate arrays */
+    std::vector<double> m_x, m_y, m_z;
+    std::vector<double> m_vx, m_vy, m_vz; // Units per millisecond
+    std::vector<double> m_remaining;      // Milliseconds to the end of the current segment
+    std::vector<EPhase> m_phase;
+    std::vector<Vector3> m_target;
+    std::vector<size_t> m_traceCursor;
+
+    std::unordered_map<int, std::vector<Waypoint>> m_traces;
+
+    mutable std::mutex m_mutex;
+    std::vector<Vector3> m_published;
+
+  public:
+    /* Throws std::runtime_error if the trace file is invalid */
+    explicit MobilityEngine(const MobilityConfig &config);
+
+  public:
+    /* UEs must be added before the engine is started. Returns the index of the UE. */
+    int addUe();
+    void start(int64_t now);
+    void advance(int64_t now);
+
+    [[nodiscard]] Vector3 getPosition(int index) const;
+    [[nodiscard]] bool isStatic() const;
+    [[nodiscard]] int getTickPeriod() const;
+
+  private:
+    void loadTrace(const std::string &path);
+    void endOfSegment(size_t index, int64_t now);
+    void startSegment(size_t index, const Vector3 &target, double duration);
+    void startRandomSegment(size_t index);
+    void publish();
+};
+
+class MobilityTask : public NtsTask
+{
+  private:
+    MobilityEngine *m_engine;
+
+  public:
+    explicit MobilityTask(MobilityEngine *engine);
+    ~MobilityTask() override = default;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+};
+
+} // namespace rls
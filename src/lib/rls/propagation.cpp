@@ -0,0 +1,85 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "propagation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr const double MAX_RANGE = 1e9;
+
+namespace rls
+{
+
+PropagationModel::PropagationModel(const PropagationConfig &config)
+    : m_config{config}, m_referenceLoss{}, m_lossFactor{}, m_range{}, m_rangeSquared{}
+{
+    if (config.model == EPropagationModel::LINEAR)
+    {
+        m_range = std::max(-config.minDbm, 0);
+        // Distances are truncated while estimating, so anything below (range + 1) is still in range. Squared
+        // distances are integral, hence the minus one.
+        m_rangeSquared = (static_cast<double>(m_range) + 1.0) * (static_cast<double>(m_range) + 1.0) - 1.0;
+        return;
+    }
+
+    // Free space path loss at 1 metre, with the frequency in MHz
+    m_referenceLoss = 20.0 * std::log10(static_cast<double>(std::max(config.frequency, 1))) - 27.55;
+    m_lossFactor = config.model == EPropagationModel::FREE_SPACE ? 20.0 : 10.0 * std::max(config.exponent, 0.1);
+
+    double budget = static_cast<double>(config.txPower) - static_cast<double>(config.minDbm) - m_referenceLoss;
+    double range = budget < 0 ? 0.0 : std::min(std::pow(10.0, budget / m_lossFactor), MAX_RANGE);
+
+    m_range = static_cast<int>(std::ceil(range));
+    m_rangeSquared = range * range;
+}
+
+int PropagationModel::getRange() const
+{
+    return m_range;
+}
+
+double PropagationModel::DistanceSquared(const Vector3 &a, const Vector3 &b)
+{
+    double dx = static_cast<double>(a.x) - static_cast<double>(b.x);
+    double dy = static_cast<double>(a.y) - static_cast<double>(b.y);
+    double dz = static_cast<double>(a.z) - static_cast<double>(b.z);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+int PropagationModel::dbmOfDistanceSquared(double distanceSquared) const
+{
+    if (distanceSquared > m_rangeSquared)
+        return OUT_OF_RANGE_DBM;
+
+    if (m_config.model == EPropagationModel::LINEAR)
+    {
+        int distance = static_cast<int>(std::sqrt(distanceSquared));
+        if (distance == 0)
+            return -1; // 0 may be confusing for people
+        return -distance;
+    }
+
+    // Distances below a metre are considered as a metre, log10(d) is computed as log10(d^2) / 2
+    double pathLoss = m_referenceLoss + m_lossFactor * 0.5 * std::log10(std::max(distanceSquared, 1.0));
+    int dbm = static_cast<int>(std::floor(static_cast<double>(m_config.txPower) - pathLoss));
+    return dbm < m_config.minDbm ? OUT_OF_RANGE_DBM : dbm;
+}
+
+int PropagationModel::estimateDbm(const Vector3 &a, const Vector3 &b) const
+{
+    return dbmOfDistanceSquared(DistanceSquared(a, b));
+}
+
+void PropagationModel::estimateDbm(const Vector3 &origin, const Vector3 *positions, size_t count, int *out) const
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = dbmOfDistanceSquared(DistanceSquared(origin, positions[i]));
+}
+
+} // namespace rls
@@ -0,0 +1,69 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+
+#include <utils/common_types.hpp>
+
+namespace rls
+{
+
+enum class EPropagationModel
+{
+    LINEAR,      // Signal strength is the negative of the distance (legacy behaviour)
+    FREE_SPACE,  // Free space path loss, distance is in metres
+    LOG_DISTANCE // Log-distance path loss with a configurable exponent, distance is in metres
+};
+
+struct PropagationConfig
+{
+    EPropagationModel model = EPropagationModel::LINEAR;
+    int txPower = 23;       // Transmission power in dBm, not used by LINEAR
+    int frequency = 3500;   // Carrier frequency in MHz, not used by LINEAR
+    double exponent = 3.0;  // Path loss exponent, only used by LOG_DISTANCE
+    int minDbm = -120;      // Weaker signals are considered out of range
+};
+
+static constexpr const int OUT_OF_RANGE_DBM = INT32_MIN;
+
+/**
+ * Estimates the simulated signal strength between two positions.
+ * <p>
+ * The distance at which the signal drops below the minimum is computed once, so that out of range positions are
+ * rejected by comparing the squared distance only, without any sqrt or log evaluation.
+ */
+class PropagationModel
+{
+  private:
+    PropagationConfig m_config;
+    double m_referenceLoss; // Path loss at unit distance in dB
+    double m_lossFactor;    // Path loss per decade of distance in dB
+    int m_range;
+    double m_rangeSquared;
+
+  public:
+    explicit PropagationModel(const PropagationConfig &config);
+
+  public:
+    [[nodiscard]] int getRange() const;
+
+    /* Returns OUT_OF_RANGE_DBM if the positions are out of range */
+    [[nodiscard]] int estimateDbm(const Vector3 &a, const Vector3 &b) const;
+    void estimateDbm(const Vector3 &origin, const Vector3 *positions, size_t count, int *out) const;
+
+    static double DistanceSquared(const Vector3 &a, const Vector3 &b);
+
+  private:
+    [[nodiscard]] int dbmOfDistanceSquared(double distanceSquared) const;
+};
+
+} // namespace rls
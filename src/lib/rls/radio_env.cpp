@@ -0,0 +1,164 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "radio_env.hpp"
+#include "propagation.hpp"
+
+#include <algorithm>
+
+static constexpr const int64_t COORDINATE_BITS = 21;
+static constexpr const int64_t COORDINATE_MASK = (1LL << COORDINATE_BITS) - 1;
+
+static uint64_t MakeBucketKey(int64_t x, int64_t y, int64_t z)
+{
+    return (static_cast<uint64_t>(x & COORDINATE_MASK) << (2 * COORDINATE_BITS)) |
+           (static_cast<uint64_t>(y & COORDINATE_MASK) << COORDINATE_BITS) | static_cast<uint64_t>(z & COORDINATE_MASK);
+}
+
+static bool IsInRange(const Vector3 &position, const Vector3 &cellPosition, int range)
+{
+    // Conservative check, the cell itself makes the final decision
+    double limit = static_cast<double>(range) + 1.0;
+    return rls::PropagationModel::DistanceSquared(position, cellPosition) <= limit * limit;
+}
+
+namespace rls
+{
+
+RadioEnvironment::RadioEnvironment(int bucketSize)
+    : m_mutex{}, m_bucketSize{std::max(bucketSize, 1)}, m_maxRange{}, m_addressToCell{}, m_cells{}, m_buckets{}
+{
+}
+
+int RadioEnvironment::registerCell(const std::string &address)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_addressToCell.find(address);
+    if (it != m_addressToCell.end())
+        return it->second;
+
+    int index = static_cast<int>(m_cells.size());
+    m_cells.emplace_back();
+    m_addressToCell[address] = index;
+    return index;
+}
+
+void RadioEnvironment::updateCell(int index, const Vector3 &position, int range, int64_t now)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (index < 0 || index >= static_cast<int>(m_cells.size()))
+        return;
+
+    auto &cell = m_cells[index];
+    cell.lastUpdate = now;
+
+    uint64_t bucket = bucketOf(position);
+    if (cell.located && cell.bucket == bucket && cell.range == range)
+    {
+        cell.position = position;
+        return;
+    }
+
+    if (cell.located)
+        removeFromBucket(index);
+
+    cell.located = true;
+    cell.position = position;
+    cell.range = range;
+    cell.bucket = bucket;
+    m_buckets[bucket].push_back(index);
+
+    // Ranges are not shrunk, a larger range only costs a few more buckets to visit
+    m_maxRange = std::max(m_maxRange, range);
+}
+
+void RadioEnvironment::findHeartbeatTargets(const Vector3 &position, const std::vector<int> &searchSpace, int64_t now,
+                                            std::vector<int> &out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (int index : searchSpace)
+    {
+        auto &cell = m_cells[index];
+        bool stale = !cell.located || now - cell.lastUpdate > REFRESH_PERIOD;
+        if (stale && now - cell.lastProbe > PROBE_PERIOD)
+        {
+            cell.lastProbe = now;
+            out.push_back(index);
+        }
+    }
+
+    int64_t range = m_maxRange;
+    int64_t minX = bucketCoordinate(position.x - range), maxX = bucketCoordinate(position.x + range);
+    int64_t minY = bucketCoordinate(position.y - range), maxY = bucketCoordinate(position.y + range);
+    int64_t minZ = bucketCoordinate(position.z - range), maxZ = bucketCoordinate(position.z + range);
+
+    double bucketCount = static_cast<double>(maxX - minX + 1) * static_cast<double>(maxY - minY + 1) *
+                         static_cast<double>(maxZ - minZ + 1);
+
+    // Visiting the buckets is pointless if there are more buckets than cells in the area
+    if (bucketCount > static_cast<double>(m_buckets.size()))
+    {
+        for (int index = 0; index < static_cast<int>(m_cells.size()); index++)
+        {
+            auto &cell = m_cells[index];
+            if (cell.located && IsInRange(position, cell.position, cell.range))
+                out.push_back(index);
+        }
+        return;
+    }
+
+    for (int64_t x = minX; x <= maxX; x++)
+    {
+        for (int64_t y = minY; y <= maxY; y++)
+        {
+            for (int64_t z = minZ; z <= maxZ; z++)
+            {
+                auto it = m_buckets.find(MakeBucketKey(x, y, z));
+                if (it == m_buckets.end())
+                    continue;
+                for (int index : it->second)
+                {
+                    auto &cell = m_cells[index];
+                    if (IsInRange(position, cell.position, cell.range))
+                        out.push_back(index);
+                }
+            }
+        }
+    }
+}
+
+int64_t RadioEnvironment::bucketCoordinate(int64_t value) const
+{
+    // Floor division, so that negative coordinates are bucketed consistently
+    int64_t q = value / m_bucketSize;
+    if (value % m_bucketSize != 0 && value < 0)
+        q--;
+    return q;
+}
+
+uint64_t RadioEnvironment::bucketOf(const Vector3 &position) const
+{
+    return MakeBucketKey(bucketCoordinate(position.x), bucketCoordinate(position.y), bucketCoordinate(position.z));
+}
+
+void RadioEnvironment::removeFromBucket(int index)
+{
+    auto it = m_buckets.find(m_cells[index].bucket);
+    if (it == m_buckets.end())
+        return;
+
+    auto &list = it->second;
+    list.erase(std::remove(list.begin(), list.end(), index), list.end());
+    if (list.empty())
+        m_buckets.erase(it);
+}
+
+} // namespace rls
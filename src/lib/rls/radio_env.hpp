@@ -0,0 +1,76 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <utils/common_types.hpp>
+
+namespace rls
+{
+
+/**
+ * Positions and coverage ranges of the cells known to a process. It is shared by all the UEs of the process, so that
+ * each UE only sends heartbeats to the cells in range instead of its whole search space.
+ * <p>
+ * Cells are indexed with a uniform grid. A cell whose position is not known yet, or is not refreshed for a while, is
+ * probed by only one UE at a time. Thread safe.
+ */
+class RadioEnvironment
+{
+  public:
+    static constexpr const int DEFAULT_BUCKET_SIZE = 256;
+    static constexpr const int64_t REFRESH_PERIOD = 10000; // Cell information is probed again after that period
+    static constexpr const int64_t PROBE_PERIOD = 1000;    // At most one probe is sent to a cell in that period
+
+  private:
+    struct Cell
+    {
+        bool located{};
+        Vector3 position{};
+        int range{};
+        uint64_t bucket{};
+        int64_t lastUpdate{};
+        int64_t lastProbe{};
+    };
+
+  private:
+    mutable std::mutex m_mutex;
+    int m_bucketSize;
+    int m_maxRange;
+    std::unordered_map<std::string, int> m_addressToCell;
+    std::vector<Cell> m_cells;
+    std::unordered_map<uint64_t, std::vector<int>> m_buckets;
+
+  public:
+    explicit RadioEnvironment(int bucketSize = DEFAULT_BUCKET_SIZE);
+
+  public:
+    /* Returns the index of the cell with the given address, the cell is created if it does not exist */
+    int registerCell(const std::string &address);
+    void updateCell(int index, const Vector3 &position, int range, int64_t now);
+
+    /**
+     * Appends the indices of the located cells in range of the given position, and the cells of the given search
+     * space that should be probed by the caller. Indices out of the search space should be ignored by the caller.
+     */
+    void findHeartbeatTargets(const Vector3 &position, const std::vector<int> &searchSpace, int64_t now,
+                              std::vector<int> &out);
+
+  private:
+    [[nodiscard]] int64_t bucketCoordinate(int64_t value) const;
+    [[nodiscard]] uint64_t bucketOf(const Vector3 &position) const;
+    void removeFromBucket(int index);
+};
+
+} // namespace rls
@@ -0,0 +1,357 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "rls_arq.hpp"
+
+#include <utils/metrics.hpp>
+
+static auto &g_sentPdus = metrics::Registry::Instance().counter("rls_pdus_sent_total", "Reliable RLS PDUs sent");
+static auto &g_retransmissions =
+    metrics::Registry::Instance().counter("rls_retransmissions_total", "Reliable RLS PDUs retransmitted");
+static auto &g_transmissionFailures = metrics::Registry::Instance().counter(
+    "rls_transmission_failures_total", "Reliable RLS PDUs not acknowledged after the maximum retransmissions");
+static auto &g_radioLinkFailures = metrics::Registry::Instance().counter(
+    "rls_radio_link_failures_total", "Radio link failures declared by the RLS ARQ");
+
+static inline int32_t SnDiff(uint32_t a, uint32_t b)
+{
+    return static_cast<int32_t>(a - b);
+}
+
+namespace rls
+{
+
+RlsArq::RlsArq(IArqConsumer *consumer, const ArqConfig &config)
+    : m_consumer{consumer}, m_config{config}, m_peers{}, m_timers{}, m_failures{}
+{
+}
+
+void RlsArq::sendReliable(int endPointId, rrc::RrcChannel channel, OctetString &&pdu, uint64_t sti, int64_t now)
+{
+    auto &peer = m_peers[endPointId];
+
+    if (peer.backlog.getCount() >= MAX_BACKLOG)
+    {
+        removeEndPoint(endPointId);
+        g_radioLinkFailures.inc();
+        m_consumer->radioLinkFailure(endPointId, ERlfCause::PDU_ID_FULL);
+        return;
+    }
+
+    PduInfo info{};
+    info.pdu = std::move(pdu);
+    info.rrcChannel = channel;
+    info.endPointId = endPointId;
+    info.sentTime = now;
+    peer.backlog.addLast(std::move(info));
+
+    fillWindow(endPointId, peer, sti, now);
+}
+
+void RlsArq::sendUnreliable(int endPointId, RlsPduTransmission &msg)
+{
+    auto it = m_peers.find(endPointId);
+    if (it != m_peers.end())
+        msg.seqState = makeSeqState(it->second);
+
+    m_consumer->sendRlsMessage(endPointId, msg);
+}
+
+bool RlsArq::receivePdu(int endPointId, const RlsPduTransmission &msg, int64_t now)
+{
+    auto &peer = m_peers[endPointId];
+
+    if (msg.seqState.has_value())
+        processSeqState(endPointId, peer, *msg.seqState, now);
+
+    if (!msg.isReliable)
+        return true;
+
+    if (!peer.rxSynced)
+    {
+        peer.rxSynced = true;
+        peer.rxNext = msg.pduId;
+        peer.rxBitmap = 0;
+    }
+
+    // Duplicates are acknowledged as well, since the previous acknowledgement may be lost
+    scheduleAck(endPointId, peer, now);
+
+    int32_t distance = SnDiff(msg.pduId, peer.rxNext);
+    if (distance < 0)
+        return false;
+    if (distance == 0)
+    {
+        slideRx(peer, peer.rxNext + 1);
+        return true;
+    }
+    if (distance > WINDOW_SIZE)
+        return false;
+
+    uint64_t bit = 1ULL << (distance - 1);
+    if (peer.rxBitmap & bit)
+        return false;
+    peer.rxBitmap |= bit;
+    return true;
+}
+
+void RlsArq::receiveAck(int endPointId, const RlsPduTransmissionAck &msg, int64_t now)
+{
+    auto it = m_peers.find(endPointId);
+    if (it != m_peers.end())
+        processSeqState(endPointId, it->second, msg.seqState, now);
+}
+
+void RlsArq::removeEndPoint(int endPointId)
+{
+    auto it = m_peers.find(endPointId);
+    if (it == m_peers.end())
+        return;
+
+    auto &peer = it->second;
+
+    std::vector<PduInfo> failures{};
+    for (uint32_t sn = peer.txBase; sn != peer.txNext; sn++)
+    {
+        auto &entry = txEntryOf(peer, sn);
+        if (entry.inUse)
+            failures.push_back(std::move(entry.info));
+    }
+    while (!peer.backlog.isEmpty())
+        failures.push_back(peer.backlog.removeFirst());
+
+    m_peers.erase(it);
+
+    if (!failures.empty())
+        m_consumer->transmissionFailure(std::move(failures));
+}
+
+void RlsArq::timerCycle(int64_t now, uint64_t sti)
+{
+    m_timers.advance(now, [this, sti, now](const TimerItem &item) { onTimerExpired(item, sti, now); });
+
+    if (!m_failures.empty())
+    {
+        m_consumer->transmissionFailure(std::move(m_failures));
+        m_failures.clear();
+    }
+}
+
+bool RlsArq::hasTimer() const
+{
+    return !m_timers.isEmpty();
+}
+
+int64_t RlsArq::getTickPeriod() const
+{
+    return m_timers.getTickPeriod();
+}
+
+void RlsArq::transmit(int endPointId, Peer &peer, TxEntry &entry, uint64_t sti, int64_t now)
+{
+    RlsPduTransmission msg{sti};
+    msg.pduType = EPduType::RRC;
+    msg.isReliable = true;
+    msg.pduId = entry.info.id;
+    msg.payload = static_cast<uint32_t>(entry.info.rrcChannel);
+    msg.seqState = makeSeqState(peer);
+
+    // The PDU is lent to the message instead of being copied, since sending is synchronous
+    msg.pdu = std::move(entry.info.pdu);
+    m_consumer->sendRlsMessage(endPointId, msg);
+    entry.info.pdu = std::move(msg.pdu);
+
+    (entry.txCount == 0 ? g_sentPdus : g_retransmissions).inc();
+    entry.txCount++;
+    m_timers.schedule(now + m_config.rto, TimerItem{ETimerType::RETRANSMIT, endPointId, entry.info.id, entry.txCount});
+}
+
+void RlsArq::fillWindow(int endPointId, Peer &peer, uint64_t sti, int64_t now)
+{
+    while (!peer.backlog.isEmpty() && SnDiff(peer.txNext, peer.txBase) < WINDOW_SIZE)
+    {
+        auto &entry = txEntryOf(peer, peer.txNext);
+        entry.inUse = true;
+        entry.txCount = 0;
+        entry.fastRetransmit = false;
+        entry.info = peer.backlog.removeFirst();
+        entry.info.id = peer.txNext;
+        peer.txNext++;
+
+        transmit(endPointId, peer, entry, sti, now);
+    }
+}
+
+void RlsArq::releaseTxEntry(Peer &peer, uint32_t sn)
+{
+    auto &entry = txEntryOf(peer, sn);
+    if (entry.inUse && entry.info.id == sn)
+    {
+        entry.inUse = false;
+        entry.info.pdu = {};
+    }
+}
+
+void RlsArq::advanceTxBase(int endPointId, Peer &peer, int64_t now)
+{
+    while (peer.txBase != peer.txNext && !txEntryOf(peer, peer.txBase).inUse)
+        peer.txBase++;
+
+    // Window is opened, remaining PDUs are sent in the next timer cycle
+    if (!peer.backlog.isEmpty() && !peer.flushScheduled && SnDiff(peer.txNext, peer.txBase) < WINDOW_SIZE)
+    {
+        peer.flushScheduled = true;
+        m_timers.schedule(now, TimerItem{ETimerType::FLUSH, endPointId, 0, 0});
+    }
+}
+
+void RlsArq::processSeqState(int endPointId, Peer &peer, const RlsSeqState &state, int64_t now)
+{
+    /* RX side: PDUs before the peer's TX base will never be sent again */
+    if (!peer.rxSynced)
+    {
+        peer.rxSynced = true;
+        peer.rxNext = state.txBase;
+        peer.rxBitmap = 0;
+    }
+    else
+    {
+        slideRx(peer, state.txBase);
+    }
+
+    /* TX side: cumulative and selective acknowledgements */
+    int32_t cumulative = SnDiff(state.rxNext, peer.txBase);
+    if (cumulative < 0 || cumulative > SnDiff(peer.txNext, peer.txBase))
+        return;
+
+    for (uint32_t sn = peer.txBase; sn != state.rxNext; sn++)
+        releaseTxEntry(peer, sn);
+
+    uint32_t highestAcked = state.rxNext;
+    for (uint64_t bitmap = state.rxBitmap, sn = state.rxNext + 1; bitmap != 0; bitmap >>= 1, sn++)
+    {
+        auto sn32 = static_cast<uint32_t>(sn);
+        if ((bitmap & 1) && SnDiff(sn32, peer.txNext) < 0)
+        {
+            releaseTxEntry(peer, sn32);
+            highestAcked = sn32;
+        }
+    }
+
+    // Fast retransmission: PDUs before a selectively acknowledged one are lost. Only the first transmissions are
+    // considered, since the acknowledgement may not reflect the retransmissions yet.
+    for (uint32_t sn = state.rxNext; sn != highestAcked; sn++)
+    {
+        auto &entry = txEntryOf(peer, sn);
+        if (entry.inUse && entry.txCount == 1 && !entry.fastRetransmit)
+        {
+            entry.fastRetransmit = true;
+            m_timers.schedule(now, TimerItem{ETimerType::RETRANSMIT, endPointId, sn, entry.txCount});
+        }
+    }
+
+    advanceTxBase(endPointId, peer, now);
+}
+
+void RlsArq::scheduleAck(int endPointId, Peer &peer, int64_t now)
+{
+    peer.ackPending = true;
+    if (!peer.ackScheduled)
+    {
+        peer.ackScheduled = true;
+        m_timers.schedule(now + ACK_DELAY, TimerItem{ETimerType::ACK, endPointId, 0, 0});
+    }
+}
+
+void RlsArq::onTimerExpired(const TimerItem &item, uint64_t sti, int64_t now)
+{
+    auto it = m_peers.find(item.endPointId);
+    if (it == m_peers.end())
+        return;
+
+    auto &peer = it->second;
+
+    switch (item.type)
+    {
+    case ETimerType::RETRANSMIT: {
+        auto &entry = txEntryOf(peer, item.sn);
+        if (!entry.inUse || entry.info.id != item.sn || entry.txCount != item.txCount)
+            return; // Already acknowledged or retransmitted
+
+        if (entry.txCount > m_config.maxRetransmission)
+        {
+            entry.inUse = false;
+            g_transmissionFailures.inc();
+            m_failures.push_back(std::move(entry.info));
+            advanceTxBase(item.endPointId, peer, now);
+        }
+        else
+        {
+            transmit(item.endPointId, peer, entry, sti, now);
+        }
+        break;
+    }
+    case ETimerType::ACK: {
+        peer.ackScheduled = false;
+        if (peer.ackPending)
+        {
+            // No PDU is sent to the peer meanwhile, so send the acknowledgement standalone
+            RlsPduTransmissionAck msg{sti};
+            msg.seqState = makeSeqState(peer);
+            m_consumer->sendRlsMessage(item.endPointId, msg);
+        }
+        break;
+    }
+    case ETimerType::FLUSH: {
+        peer.flushScheduled = false;
+        fillWindow(item.endPointId, peer, sti, now);
+        break;
+    }
+    }
+}
+
+void RlsArq::slideRx(Peer &peer, uint32_t to)
+{
+    int32_t distance = SnDiff(to, peer.rxNext);
+    if (distance <= 0)
+        return;
+
+    if (distance > WINDOW_SIZE + 1)
+    {
+        peer.rxNext = to;
+        peer.rxBitmap = 0;
+        return;
+    }
+
+    // Bit 0 of the bitmap belongs to (rxNext + 1), so each step tells whether the new rxNext is already received
+    bool received = false;
+    while (SnDiff(to, peer.rxNext) > 0 || received)
+    {
+        received = peer.rxBitmap & 1;
+        peer.rxBitmap >>= 1;
+        peer.rxNext++;
+    }
+}
+
+RlsSeqState RlsArq::makeSeqState(Peer &peer)
+{
+    peer.ackPending = false;
+
+    RlsSeqState state{};
+    state.txBase = peer.txBase;
+    state.rxNext = peer.rxNext;
+    state.rxBitmap = peer.rxBitmap;
+    return state;
+}
+
+RlsArq::TxEntry &RlsArq::txEntryOf(Peer &peer, uint32_t sn)
+{
+    return peer.txWindow[sn % WINDOW_SIZE];
+}
+
+} // namespace rls
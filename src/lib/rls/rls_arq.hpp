@@ -0,0 +1,138 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include "rls_base.hpp"
+#include "rls_pdu.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+#include <utils/ring_buffer.hpp>
+#include <utils/timer_wheel.hpp>
+
+namespace rls
+{
+
+struct ArqConfig
+{
+    int rto = 200;             // Retransmission timeout in milliseconds
+    int maxRetransmission = 4; // Number of retransmissions before a PDU is reported as a transmission failure
+};
+
+class IArqConsumer
+{
+  public:
+    virtual ~IArqConsumer() = default;
+
+    /* Messages must be sent synchronously, they are not valid after the call */
+    virtual void sendRlsMessage(int endPointId, const RlsMessage &msg) = 0;
+    virtual void transmissionFailure(std::vector<PduInfo> &&pduList) = 0;
+    virtual void radioLinkFailure(int endPointId, ERlfCause cause) = 0;
+};
+
+/**
+ * Sliding window ARQ for the reliable RRC PDUs of RLS. Each end point (UE or cell) has its own sequence space.
+ * <p>
+ * Receiver acknowledges the PDUs with a cumulative sequence number and a selective bitmap above it. That
+ * acknowledgement state is piggybacked on every PDU sent to the peer, and it is only sent standalone if no PDU is
+ * sent to the peer within a short delay. Unacknowledged PDUs are retransmitted after RTO, and reported as a
+ * transmission failure after the maximum number of retransmissions.
+ * <p>
+ * Received reliable PDUs are delivered as soon as they arrive, duplicates are filtered out but no reordering is
+ * performed.
+ */
+class RlsArq
+{
+  public:
+    static constexpr const int WINDOW_SIZE = 64; // Bounded by the selective acknowledgement bitmap
+    static constexpr const int MAX_BACKLOG = 128;
+    static constexpr const int ACK_DELAY = 20;
+
+  private:
+    struct TxEntry
+    {
+        bool inUse{};
+        bool fastRetransmit{};
+        int txCount{};
+        PduInfo info{};
+    };
+
+    struct Peer
+    {
+        // TX side
+        uint32_t txBase{};
+        uint32_t txNext{};
+        std::vector<TxEntry> txWindow;
+        RingBuffer<PduInfo> backlog;
+        bool flushScheduled{};
+
+        // RX side
+        bool rxSynced{};
+        uint32_t rxNext{};
+        uint64_t rxBitmap{};
+        bool ackPending{};
+        bool ackScheduled{};
+
+        Peer() : txWindow(WINDOW_SIZE), backlog{}
+        {
+        }
+    };
+
+    enum class ETimerType
+    {
+        RETRANSMIT,
+        ACK,
+        FLUSH
+    };
+
+    struct TimerItem
+    {
+        ETimerType type;
+        int endPointId;
+        uint32_t sn; // Only for RETRANSMIT
+        int txCount; // Only for RETRANSMIT
+    };
+
+  private:
+    IArqConsumer *m_consumer;
+    ArqConfig m_config;
+    std::unordered_map<int, Peer> m_peers;
+    TimerWheel<TimerItem> m_timers;
+    std::vector<PduInfo> m_failures;
+
+  public:
+    RlsArq(IArqConsumer *consumer, const ArqConfig &config);
+
+  public:
+    void sendReliable(int endPointId, rrc::RrcChannel channel, OctetString &&pdu, uint64_t sti, int64_t now);
+    void sendUnreliable(int endPointId, RlsPduTransmission &msg);
+    bool receivePdu(int endPointId, const RlsPduTransmission &msg, int64_t now);
+    void receiveAck(int endPointId, const RlsPduTransmissionAck &msg, int64_t now);
+    void removeEndPoint(int endPointId);
+    void timerCycle(int64_t now, uint64_t sti);
+
+    [[nodiscard]] bool hasTimer() const;
+    [[nodiscard]] int64_t getTickPeriod() const;
+
+  private:
+    void transmit(int endPointId, Peer &peer, TxEntry &entry, uint64_t sti, int64_t now);
+    void fillWindow(int endPointId, Peer &peer, uint64_t sti, int64_t now);
+    void releaseTxEntry(Peer &peer, uint32_t sn);
+    void advanceTxBase(int endPointId, Peer &peer, int64_t now);
+    void processSeqState(int endPointId, Peer &peer, const RlsSeqState &state, int64_t now);
+    void scheduleAck(int endPointId, Peer &peer, int64_t now);
+    void onTimerExpired(const TimerItem &item, uint64_t sti, int64_t now);
+
+    static void slideRx(Peer &peer, uint32_t to);
+    static RlsSeqState makeSeqState(Peer &peer);
+    static TxEntry &txEntryOf(Peer &peer, uint32_t sn);
+};
+
+} // namespace rls
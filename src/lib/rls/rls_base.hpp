@@ -6,6 +6,8 @@
 // and subject to the terms and conditions defined in LICENSE file.
 //
 
+#pragma once
+
 #include "rls_pdu.hpp"
 
 #include <lib/rrc/rrc.hpp>
@@ -24,7 +26,6 @@ struct PduInfo
 
 enum class ERlfCause
 {
-    PDU_ID_EXISTS,
     PDU_ID_FULL,
     SIGNAL_LOST_TO_CONNECTED_CELL
 };
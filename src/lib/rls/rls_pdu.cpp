@@ -13,6 +13,57 @@
 namespace rls
 {
 
+static void EncodeSeqState(const RlsSeqState &state, OctetString &stream)
+{
+    stream.appendOctet4(state.txBase);
+    stream.appendOctet4(state.rxNext);
+    stream.appendOctet8(state.rxBitmap);
+}
+
+static RlsSeqState DecodeSeqState(const OctetView &stream)
+{
+    RlsSeqState state{};
+    state.txBase = stream.read4UI();
+    state.rxNext = stream.read4UI();
+    state.rxBitmap = stream.read8UL();
+    return state;
+}
+
+static inline uint8_t *WriteVarint(uint8_t *p, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        *p++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = static_cast<uint8_t>(value);
+    return p;
+}
+
+static bool ReadVarint(const OctetView &stream, uint64_t &value, int maxOctets)
+{
+    value = 0;
+    for (int i = 0; i < maxOctets; i++)
+    {
+        if (!stream.hasNext())
+            return false;
+        uint8_t octet = stream.read();
+        value |= static_cast<uint64_t>(octet & 0x7F) << (7 * i);
+        if ((octet & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+static bool ReadVarint32(const OctetView &stream, uint32_t &value)
+{
+    uint64_t v;
+    if (!ReadVarint(stream, v, 5) || v > UINT32_MAX)
+        return false;
+    value = static_cast<uint32_t>(v);
+    return true;
+}
+
 void EncodeRlsMessage(const RlsMessage &msg, OctetString &stream)
 {
     stream.appendOctet(0x03); // (Just for old RLS compatibility)
@@ -28,27 +79,36 @@ void EncodeRlsMessage(const RlsMessage &msg, OctetString &stream)
         stream.appendOctet4(m.simPos.x);
         stream.appendOctet4(m.simPos.y);
         stream.appendOctet4(m.simPos.z);
+        stream.appendOctet4(m.handle);
     }
     else if (msg.msgType == EMessageType::HEARTBEAT_ACK)
     {
         auto &m = (const RlsHeartBeatAck &)msg;
         stream.appendOctet4(m.dbm);
+        stream.appendOctet4(m.handle);
+        stream.appendOctet4(m.simPos.x);
+        stream.appendOctet4(m.simPos.y);
+        stream.appendOctet4(m.simPos.z);
+        stream.appendOctet4(m.range);
     }
     else if (msg.msgType == EMessageType::PDU_TRANSMISSION)
     {
         auto &m = (const RlsPduTransmission &)msg;
+        // Header and sequence state are far below 64 octets
+        stream.reserve(stream.length() + 64 + m.pdu.length());
         stream.appendOctet(static_cast<uint8_t>(m.pduType));
+        stream.appendOctet((m.isReliable ? 0b01 : 0) | (m.seqState.has_value() ? 0b10 : 0));
         stream.appendOctet4(m.pduId);
         stream.appendOctet4(m.payload);
+        if (m.seqState.has_value())
+            EncodeSeqState(*m.seqState, stream);
         stream.appendOctet4(m.pdu.length());
         stream.append(m.pdu);
     }
     else if (msg.msgType == EMessageType::PDU_TRANSMISSION_ACK)
     {
         auto &m = (const RlsPduTransmissionAck &)msg;
-        stream.appendOctet4(static_cast<uint32_t>(m.pduIds.size()));
-        for (auto pduId : m.pduIds)
-            stream.appendOctet4(pduId);
+        EncodeSeqState(m.seqState, stream);
     }
 }
 
@@ -74,34 +134,98 @@ std::unique_ptr<RlsMessage> DecodeRlsMessage(const OctetView &stream)
         res->simPos.x = stream.read4I();
         res->simPos.y = stream.read4I();
         res->simPos.z = stream.read4I();
+        res->handle = stream.read4UI();
         return res;
     }
     else if (msgType == EMessageType::HEARTBEAT_ACK)
     {
         auto res = std::make_unique<RlsHeartBeatAck>(sti);
         res->dbm = stream.read4I();
+        res->handle = stream.read4UI();
+        res->simPos.x = stream.read4I();
+        res->simPos.y = stream.read4I();
+        res->simPos.z = stream.read4I();
+        res->range = stream.read4I();
         return res;
     }
     else if (msgType == EMessageType::PDU_TRANSMISSION)
     {
         auto res = std::make_unique<RlsPduTransmission>(sti);
         res->pduType = static_cast<EPduType>((uint8_t)stream.read());
+        int flags = stream.readI();
+        res->isReliable = flags & 0b01;
         res->pduId = stream.read4UI();
         res->payload = stream.read4UI();
+        if (flags & 0b10)
+            res->seqState = DecodeSeqState(stream);
         res->pdu = stream.readOctetString(stream.read4I());
         return res;
     }
     else if (msgType == EMessageType::PDU_TRANSMISSION_ACK)
     {
         auto res = std::make_unique<RlsPduTransmissionAck>(sti);
-        auto count = stream.read4UI();
-        res->pduIds.reserve(count);
-        for (uint32_t i = 0; i < count; i++)
-            res->pduIds.push_back(stream.read4UI());
+        res->seqState = DecodeSeqState(stream);
         return res;
     }
 
     return nullptr;
 }
 
+bool IsCompactFramingApplicable(const RlsMessage &msg)
+{
+    if (msg.msgType != EMessageType::PDU_TRANSMISSION)
+        return false;
+    auto &m = (const RlsPduTransmission &)msg;
+    return m.pduType == EPduType::DATA && !m.isReliable;
+}
+
+size_t EncodeCompactDataHeader(const RlsPduTransmission &msg, uint32_t handle, uint8_t *headroom)
+{
+    // Every field is bounded, so the headroom size is the only bounds check needed
+    uint8_t *p = headroom;
+    *p++ = COMPACT_DATA_INDICATOR;
+    p = WriteVarint(p, handle);
+    *p++ = msg.seqState.has_value() ? 0b10 : 0;
+    p = WriteVarint(p, msg.payload);
+    if (msg.seqState.has_value())
+    {
+        p = WriteVarint(p, msg.seqState->txBase);
+        p = WriteVarint(p, msg.seqState->rxNext);
+        p = WriteVarint(p, msg.seqState->rxBitmap);
+    }
+    return static_cast<size_t>(p - headroom);
+}
+
+bool DecodeCompactDataHandle(const OctetView &stream, uint32_t &handle)
+{
+    if (!stream.hasNext() || stream.read() != COMPACT_DATA_INDICATOR)
+        return false;
+    return ReadVarint32(stream, handle);
+}
+
+std::unique_ptr<RlsPduTransmission> DecodeCompactData(const OctetView &stream, uint64_t sti)
+{
+    auto res = std::make_unique<RlsPduTransmission>(sti);
+    res->pduType = EPduType::DATA;
+
+    if (!stream.hasNext())
+        return nullptr;
+    int flags = stream.readI();
+
+    if (!ReadVarint32(stream, res->payload))
+        return nullptr;
+
+    if (flags & 0b10)
+    {
+        RlsSeqState state{};
+        if (!ReadVarint32(stream, state.txBase) || !ReadVarint32(stream, state.rxNext) ||
+            !ReadVarint(stream, state.rxBitmap, 10))
+            return nullptr;
+        res->seqState = state;
+    }
+
+    res->pdu = stream.readOctetString();
+    return res;
+}
+
 } // namespace rls
@@ -10,6 +10,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 
 #include <utils/common_types.hpp>
 #include <utils/octet_string.hpp>
@@ -39,6 +40,17 @@ enum class EPduType : uint8_t
     DATA
 };
 
+/**
+ * Acknowledgement state of the reliable PDU stream in the reverse direction. It is piggybacked on the PDUs sent to
+ * the peer, or sent standalone in a PDU_TRANSMISSION_ACK message if there is no such PDU.
+ */
+struct RlsSeqState
+{
+    uint32_t txBase{};   // Oldest reliable PDU of the sender still awaiting acknowledgement
+    uint32_t rxNext{};   // All reliable PDUs before this one are received (cumulative acknowledgement)
+    uint64_t rxBitmap{}; // Bit i is set iff the reliable PDU (rxNext + 1 + i) is received (selective acknowledgement)
+};
+
 struct RlsMessage
 {
     const EMessageType msgType;
@@ -47,11 +59,14 @@ struct RlsMessage
     explicit RlsMessage(EMessageType msgType, uint64_t sti) : msgType(msgType), sti(sti)
     {
     }
+
+    virtual ~RlsMessage() = default;
 };
 
 struct RlsHeartBeat : RlsMessage
 {
     Vector3 simPos;
+    uint32_t handle{}; // Handle of the receiver at the sender (see compact framing), zero if not assigned yet
 
     explicit RlsHeartBeat(uint64_t sti) : RlsMessage(EMessageType::HEARTBEAT, sti)
     {
@@ -60,7 +75,10 @@ struct RlsHeartBeat : RlsMessage
 
 struct RlsHeartBeatAck : RlsMessage
 {
-    int dbm{};
+    int dbm{};         // INT32_MIN if the receiver is out of range of the sender
+    uint32_t handle{}; // Handle of the receiver at the sender (see compact framing)
+    Vector3 simPos;    // Position of the sender cell
+    int range{};       // Coverage range of the sender cell
 
     explicit RlsHeartBeatAck(uint64_t sti) : RlsMessage(EMessageType::HEARTBEAT_ACK, sti)
     {
@@ -70,9 +88,11 @@ struct RlsHeartBeatAck : RlsMessage
 struct RlsPduTransmission : RlsMessage
 {
     EPduType pduType{};
-    uint32_t pduId{};
+    bool isReliable{};
+    uint32_t pduId{}; // Sequence number, only meaningful for reliable PDUs
     uint32_t payload{};
     OctetString pdu{};
+    std::optional<RlsSeqState> seqState{};
 
     explicit RlsPduTransmission(uint64_t sti) : RlsMessage(EMessageType::PDU_TRANSMISSION, sti)
     {
@@ -81,7 +101,7 @@ struct RlsPduTransmission : RlsMessage
 
 struct RlsPduTransmissionAck : RlsMessage
 {
-    std::vector<uint32_t> pduIds;
+    RlsSeqState seqState{};
 
     explicit RlsPduTransmissionAck(uint64_t sti) : RlsMessage(EMessageType::PDU_TRANSMISSION_ACK, sti)
     {
@@ -91,4 +111,21 @@ struct RlsPduTransmissionAck : RlsMessage
 void EncodeRlsMessage(const RlsMessage &msg, OctetString &stream);
 std::unique_ptr<RlsMessage> DecodeRlsMessage(const OctetView &stream);
 
+/**
+ * Compact framing for DATA PDUs. Each side tells its peer a short handle in heartbeat messages, so that the peer can
+ * identify itself with that handle instead of the STI. Once a handle is known, DATA PDUs are sent without the version
+ * triplet, STI, PDU ID and length fields, and the remaining header fields are varint encoded.
+ * <p>
+ * The header is written into a caller provided headroom of COMPACT_HEADER_MAX_SIZE octets, so that the PDU itself is
+ * sent from its own buffer without being copied.
+ */
+static constexpr const uint8_t COMPACT_DATA_INDICATOR = 0x04;
+static constexpr const size_t COMPACT_HEADER_MAX_SIZE = 1 + 5 + 1 + 5 + 5 + 5 + 10;
+
+bool IsCompactFramingApplicable(const RlsMessage &msg);
+size_t EncodeCompactDataHeader(const RlsPduTransmission &msg, uint32_t handle, uint8_t *headroom);
+bool DecodeCompactDataHandle(const OctetView &stream, uint32_t &handle);
+// Continues from the stream position left by DecodeCompactDataHandle
+std::unique_ptr<RlsPduTransmission> DecodeCompactData(const OctetView &stream, uint64_t sti);
+
 } // namespace rls
\ No newline at end of file
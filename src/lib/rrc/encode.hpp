@@ -46,7 +46,7 @@ inline OctetString EncodeS(const asn_TYPE_descriptor_t &desc, T *pdu)
     {
         std::vector<uint8_t> v(encoded);
         memcpy(v.data(), buffer, encoded);
-        free(buffer);
+        asn_mem_free(buffer);
         return OctetString{std::move(v)};
     }
     return OctetString{};
@@ -48,9 +48,24 @@ void sctp::SctpClient::send(uint16_t stream, const std::vector<uint8_t> &data)
     send(stream, data.data(), data.size());
 }
 
-void sctp::SctpClient::receive(ISctpHandler *handler)
+bool sctp::SctpClient::trySend(uint16_t stream, const uint8_t *buffer, size_t length)
 {
-    ReceiveMessage(sd, static_cast<uint32_t>(ppid), handler);
+    return TrySendMessage(sd, buffer, length, (int)ppid, stream);
+}
+
+bool sctp::SctpClient::receive(ISctpHandler *handler)
+{
+    return ReceiveMessage(sd, static_cast<uint32_t>(ppid), handler);
+}
+
+void sctp::SctpClient::setNonBlocking()
+{
+    SetNonBlocking(sd);
+}
+
+int sctp::SctpClient::getSocket() const
+{
+    return sd;
 }
 
 void sctp::SctpClient::bind(const std::string &address, uint16_t port)
@@ -33,7 +33,14 @@ class SctpClient
     void send(uint16_t stream, const uint8_t *buffer, size_t length);
     void send(uint16_t stream, const std::vector<uint8_t> &data);
 
-    void receive(ISctpHandler *handler);
+    /* For non-blocking clients. Returns false if the message could not be sent, since the send buffer is full */
+    bool trySend(uint16_t stream, const uint8_t *buffer, size_t length);
+
+    /* Returns false if no message is available, that is only possible for non-blocking clients */
+    bool receive(ISctpHandler *handler);
+
+    void setNonBlocking();
+    [[nodiscard]] int getSocket() const;
 };
 
 } // namespace sctp
\ No newline at end of file
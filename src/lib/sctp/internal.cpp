@@ -12,6 +12,7 @@
 #include <cstring>
 
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/sctp.h>
@@ -152,13 +153,31 @@ void Connect(int sd, const std::string &address, uint16_t port)
         ThrowError("SCTP could not connect: ", errno);
 }
 
+void SetNonBlocking(int sd)
+{
+    int flags = fcntl(sd, F_GETFL, 0);
+    if (flags < 0 || fcntl(sd, F_SETFL, flags | O_NONBLOCK) < 0)
+        ThrowError("SCTP socket could not be set to non-blocking mode: ", errno);
+}
+
 void SendMessage(int sd, const uint8_t *buffer, size_t length, int ppid, uint16_t stream)
 {
     if (sctp_sendmsg(sd, buffer, length, nullptr, 0, htonl(ppid), 0, stream, 0, 0) < 0)
         ThrowError("SCTP send message failure: ", errno);
 }
 
-void ReceiveMessage(int sd, uint32_t ppid, ISctpHandler *handler)
+bool TrySendMessage(int sd, const uint8_t *buffer, size_t length, int ppid, uint16_t stream)
+{
+    if (sctp_sendmsg(sd, buffer, length, nullptr, 0, htonl(ppid), 0, stream, 0, 0) < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return false;
+        ThrowError("SCTP send message failure: ", errno);
+    }
+    return true;
+}
+
+bool ReceiveMessage(int sd, uint32_t ppid, ISctpHandler *handler)
 {
     uint8_t buffer[RECEIVE_BUFFER_SIZE];
     sockaddr_in addr{};
@@ -173,10 +192,14 @@ void ReceiveMessage(int sd, uint32_t ppid, ISctpHandler *handler)
     int r = sctp_recvmsg(sd, (void *)buffer, RECEIVE_BUFFER_SIZE, (sockaddr *)&addr, &fromLen, &info, &flags);
 
     if (r < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return false; // non-blocking socket has no message
         ThrowError("SCTP receive message failure: ", errno);
+    }
 
     if (r == 0)
-        return; // no data
+        return true; // no data
 
     if (!(flags & MSG_EOR))
         ThrowError("SCTP partial message received, which is not handled");
@@ -235,6 +258,8 @@ void ReceiveMessage(int sd, uint32_t ppid, ISctpHandler *handler)
 
         handler->onMessage(buffer, r, info.sinfo_stream);
     }
+
+    return true;
 }
 
 } // namespace sctp
\ No newline at end of file
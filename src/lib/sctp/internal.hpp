@@ -23,7 +23,9 @@ void StartListening(int sd);
 void CloseSocket(int sd);
 void Accept(int sd);
 void Connect(int sd, const std::string &address, uint16_t port);
+void SetNonBlocking(int sd);
 void SendMessage(int sd, const uint8_t *buffer, size_t length, int ppid, uint16_t stream);
-void ReceiveMessage(int sd, uint32_t ppid, ISctpHandler *handler);
+bool TrySendMessage(int sd, const uint8_t *buffer, size_t length, int ppid, uint16_t stream);
+bool ReceiveMessage(int sd, uint32_t ppid, ISctpHandler *handler);
 
 } // namespace sctp
\ No newline at end of file
@@ -31,6 +31,12 @@ void UdpServer::Send(const InetAddress &address, const uint8_t *buffer, size_t b
     socket.send(address, buffer, bufferSize);
 }
 
+void UdpServer::Send(const InetAddress &address, const uint8_t *header, size_t headerSize, const uint8_t *payload,
+                     size_t payloadSize) const
+{
+    socket.send(address, header, headerSize, payload, payloadSize);
+}
+
 UdpServer::~UdpServer()
 {
     socket.close();
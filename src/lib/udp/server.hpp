@@ -27,6 +27,8 @@ class UdpServer
 
     int Receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outPeerAddress) const;
     void Send(const InetAddress &address, const uint8_t *buffer, size_t bufferSize) const;
+    void Send(const InetAddress &address, const uint8_t *header, size_t headerSize, const uint8_t *payload,
+              size_t payloadSize) const;
 };
 
 } // namespace udp
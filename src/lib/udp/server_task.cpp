@@ -41,10 +41,15 @@ void udp::UdpServerTask::onLoop()
     {
         std::vector<uint8_t> v(size);
         std::memcpy(v.data(), buffer, size);
-        targetTask->push(new NwUdpServerReceive(OctetString{std::move(v)}, peerAddress));
+        onReceive(OctetString{std::move(v)}, peerAddress);
     }
 }
 
+void udp::UdpServerTask::onReceive(OctetString &&packet, const InetAddress &fromAddress)
+{
+    targetTask->push(new NwUdpServerReceive(std::move(packet), fromAddress));
+}
+
 void udp::UdpServerTask::onQuit()
 {
     delete server;
@@ -42,6 +42,9 @@ class UdpServerTask : public NtsTask
     void onLoop() override;
     void onQuit() override;
 
+    // Called by the receiver thread for each packet, pushes the packet to the target task by default
+    virtual void onReceive(OctetString &&packet, const InetAddress &fromAddress);
+
   public:
     void send(const InetAddress &to, const OctetString &packet);
 };
@@ -0,0 +1,49 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include <iostream>
+#include <stdexcept>
+
+#include <utils/async_log.hpp>
+#include <utils/constants.hpp>
+#include <utils/options.hpp>
+
+static std::string ReadOptions(int argc, char **argv)
+{
+    opt::OptionsDescription desc{"UERANSIM",  cons::Tag, "Binary log decoder", cons::Owner, "nr-logdec",
+                                 {"<file>"}, {},        true,                 false};
+
+    opt::OptionsResult opt{argc, argv, desc, false, nullptr};
+
+    if (opt.positionalCount() != 1)
+        opt.showError("Exactly one binary log file is expected");
+
+    return opt.getPositional(0);
+}
+
+int main(int argc, char **argv)
+{
+    std::string file = ReadOptions(argc, argv);
+
+    try
+    {
+        logging::BinaryLogReader reader{file};
+
+        std::string line;
+        while (reader.next(line))
+            std::cout << line << "\n";
+        std::cout.flush();
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::cout.flush();
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
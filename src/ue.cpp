@@ -6,6 +6,7 @@
 // and subject to the terms and conditions defined in LICENSE file.
 //
 
+#include <atomic>
 #include <iostream>
 #include <stdexcept>
 
@@ -14,12 +15,16 @@
 #include <lib/app/base_app.hpp>
 #include <lib/app/cli_base.hpp>
 #include <lib/app/cli_cmd.hpp>
+#include <lib/app/node_selector.hpp>
 #include <lib/app/proc_table.hpp>
 #include <lib/app/ue_ctl.hpp>
+#include <ue/subscribers.hpp>
 #include <ue/ue.hpp>
 #include <utils/common.hpp>
 #include <utils/concurrent_map.hpp>
 #include <utils/constants.hpp>
+#include <utils/io.hpp>
+#include <utils/metrics.hpp>
 #include <utils/options.hpp>
 #include <utils/yaml_utils.hpp>
 #include <yaml-cpp/yaml.h>
@@ -28,6 +33,21 @@ static app::CliServer *g_cliServer = nullptr;
 static nr::ue::UeConfig *g_refConfig = nullptr;
 static ConcurrentMap<std::string, nr::ue::UserEquipment *> g_ueMap{};
 static app::CliResponseTask *g_cliRespTask = nullptr;
+static rls::RadioEnvironment g_radioEnv{};
+static rls::MobilityEngine *g_mobility = nullptr;
+static nr::ue::LoadProfile *g_loadProfile = nullptr;
+static std::vector<std::string> g_ueNames{};
+static nr::ue::StateSnapshot *g_snapshot = nullptr;
+static std::vector<nr::ue::SubscriberEntry> g_subscribers{};
+static int64_t g_subscribersLoadTime{};
+static int64_t g_processStartTime{};
+static std::atomic<int> g_startedUeCount{};
+
+static auto &g_uesStarted = metrics::Registry::Instance().gauge("ue_started", "Number of UEs powered on");
+static auto &g_startupDuration = metrics::Registry::Instance().gauge(
+    "ue_startup_duration_ms", "Time from the process start until all the UEs are powered on");
+
+static constexpr const int MAX_UE_COUNT = 16384;
 
 static struct Options
 {
@@ -36,6 +56,14 @@ static struct Options
     bool disableCmd{};
     std::string imsi{};
     int count{};
+    std::optional<std::string> logLevel{};
+    bool asyncLog{};
+    std::optional<std::string> binaryLog{};
+    std::optional<uint16_t> metricsPort{};
+    std::optional<std::string> metricsCsv{};
+    std::optional<std::string> stateFile{};
+    std::optional<std::string> subscribersFile{};
+    std::string traceDumpDir{};
 } g_options{};
 
 struct NwUeControllerCmd : NtsMessage
@@ -80,6 +108,7 @@ class UeControllerTask : public NtsTask
                 if (key.empty())
                     return;
 
+                g_uesStarted.sub(1);
                 if (g_ueMap.removeAndGetSize(key) == 0)
                     exit(0);
 
@@ -97,6 +126,11 @@ class UeControllerTask : public NtsTask
 
 static UeControllerTask *g_controllerTask;
 
+static Vector3 ReadVector3(const YAML::Node &node)
+{
+    return Vector3{yaml::GetInt32(node, "x"), yaml::GetInt32(node, "y"), yaml::GetInt32(node, "z")};
+}
+
 static nr::ue::UeConfig *ReadConfigYaml()
 {
     auto *result = new nr::ue::UeConfig();
@@ -107,8 +141,10 @@ static nr::ue::UeConfig *ReadConfigYaml()
     result->hplmn.mnc = yaml::GetInt32(config, "mnc", 0, 999);
     result->hplmn.isLongMnc = yaml::GetString(config, "mnc", 2, 3).size() == 3;
 
+    std::vector<std::string> gnbSearchList{};
     for (auto &gnbSearchItem : yaml::GetSequence(config, "gnbSearchList"))
-        result->gnbSearchList.push_back(gnbSearchItem.as<std::string>());
+        gnbSearchList.push_back(gnbSearchItem.as<std::string>());
+    result->gnbSearchList = std::make_shared<const std::vector<std::string>>(std::move(gnbSearchList));
 
     if (yaml::HasField(config, "default-nssai"))
     {
@@ -139,6 +175,7 @@ static nr::ue::UeConfig *ReadConfigYaml()
     result->amf = OctetString::FromHex(yaml::GetString(config, "amf", 4, 4));
 
     result->configureRouting = !g_options.noRoutingConfigs;
+    result->traceDumpDir = g_options.traceDumpDir;
 
     // If we have multiple UEs in the same process, then log names should be separated.
     result->prefixLogger = g_options.count > 1;
@@ -168,6 +205,7 @@ static nr::ue::UeConfig *ReadConfigYaml()
     else
         throw std::runtime_error("Invalid OP type: " + opType);
 
+    std::vector<nr::ue::SessionConfig> defaultSessions{};
     if (yaml::HasField(config, "sessions"))
     {
         for (auto &sess : yaml::GetSequence(config, "sessions"))
@@ -201,9 +239,10 @@ static nr::ue::UeConfig *ReadConfigYaml()
 
             s.isEmergency = false;
 
-            result->defaultSessions.push_back(s);
+            defaultSessions.push_back(s);
         }
     }
+    result->defaultSessions = std::make_shared<const std::vector<nr::ue::SessionConfig>>(std::move(defaultSessions));
 
     yaml::AssertHasField(config, "integrityMaxRate");
     {
@@ -233,6 +272,100 @@ static nr::ue::UeConfig *ReadConfigYaml()
         result->uacAcc.cls15 = yaml::GetBool(config["uacAcc"], "class15");
     }
 
+    if (yaml::HasField(config, "rls"))
+    {
+        auto rls = config["rls"];
+        if (yaml::HasField(rls, "rto"))
+            result->rlsArq.rto = yaml::GetInt32(rls, "rto", 10, 60000);
+        if (yaml::HasField(rls, "maxRetransmission"))
+            result->rlsArq.maxRetransmission = yaml::GetInt32(rls, "maxRetransmission", 0, 32);
+    }
+
+    if (yaml::HasField(config, "mobility"))
+    {
+        auto mobility = config["mobility"];
+        auto &c = result->mobility;
+
+        std::string model = yaml::GetString(mobility, "model");
+        if (model == "static")
+            c.model = rls::EMobilityModel::STATIC;
+        else if (model == "linear")
+            c.model = rls::EMobilityModel::LINEAR;
+        else if (model == "random-waypoint")
+            c.model = rls::EMobilityModel::RANDOM_WAYPOINT;
+        else if (model == "trace")
+            c.model = rls::EMobilityModel::TRACE;
+        else
+            throw std::runtime_error("Invalid mobility model: " + model);
+
+        if (yaml::HasField(mobility, "position"))
+            c.position = ReadVector3(mobility["position"]);
+        if (c.model == rls::EMobilityModel::LINEAR)
+            c.velocity = ReadVector3(mobility["velocity"]);
+        if (c.model == rls::EMobilityModel::RANDOM_WAYPOINT)
+        {
+            c.areaMin = ReadVector3(mobility["areaMin"]);
+            c.areaMax = ReadVector3(mobility["areaMax"]);
+            c.minSpeed = yaml::GetInt32(mobility, "minSpeed", 1, std::nullopt);
+            c.maxSpeed = yaml::GetInt32(mobility, "maxSpeed", c.minSpeed, std::nullopt);
+            if (yaml::HasField(mobility, "pauseTime"))
+                c.pauseTime = yaml::GetInt32(mobility, "pauseTime", 0, std::nullopt);
+        }
+        if (c.model == rls::EMobilityModel::TRACE)
+            c.traceFile = yaml::GetString(mobility, "traceFile");
+        if (yaml::HasField(mobility, "tickPeriod"))
+            c.tickPeriod = yaml::GetInt32(mobility, "tickPeriod", 10, 10000);
+        if (yaml::HasField(mobility, "seed"))
+            c.seed = static_cast<uint32_t>(yaml::GetInt64(mobility, "seed", 0, UINT32_MAX));
+    }
+
+    if (yaml::HasField(config, "loadProfile"))
+    {
+        auto load = config["loadProfile"];
+        auto &c = result->loadProfile;
+
+        std::string arrival = yaml::GetString(load, "arrival");
+        if (arrival == "none")
+            c.arrival = nr::ue::ELoadArrival::NONE;
+        else if (arrival == "constant")
+            c.arrival = nr::ue::ELoadArrival::CONSTANT;
+        else if (arrival == "ramp")
+            c.arrival = nr::ue::ELoadArrival::RAMP;
+        else if (arrival == "poisson")
+            c.arrival = nr::ue::ELoadArrival::POISSON;
+        else if (arrival == "bursty")
+            c.arrival = nr::ue::ELoadArrival::BURSTY;
+        else if (arrival == "replay")
+            c.arrival = nr::ue::ELoadArrival::REPLAY;
+        else
+            throw std::runtime_error("Invalid load arrival process: " + arrival);
+
+        if (c.arrival == nr::ue::ELoadArrival::CONSTANT || c.arrival == nr::ue::ELoadArrival::POISSON ||
+            c.arrival == nr::ue::ELoadArrival::RAMP)
+            c.rate = yaml::GetInt32(load, "rate", 1, 100'000);
+        if (c.arrival == nr::ue::ELoadArrival::RAMP)
+        {
+            c.endRate = yaml::GetInt32(load, "endRate", 1, 100'000);
+            c.rampTime = yaml::GetInt32(load, "rampTime", 1, std::nullopt);
+        }
+        if (c.arrival == nr::ue::ELoadArrival::BURSTY)
+        {
+            c.burstSize = yaml::GetInt32(load, "burstSize", 1, std::nullopt);
+            c.burstPeriod = yaml::GetInt32(load, "burstPeriod", 0, std::nullopt);
+        }
+        if (c.arrival == nr::ue::ELoadArrival::REPLAY)
+            c.replayFile = yaml::GetString(load, "replayFile");
+        if (yaml::HasField(load, "seed"))
+            c.seed = static_cast<uint32_t>(yaml::GetInt64(load, "seed", 0, UINT32_MAX));
+
+        if (yaml::HasField(load, "sessionDelay"))
+            c.sessionDelay = yaml::GetInt32(load, "sessionDelay", 0, std::nullopt);
+        if (yaml::HasField(load, "releaseDelay"))
+            c.releaseDelay = yaml::GetInt32(load, "releaseDelay", 0, std::nullopt);
+        if (yaml::HasField(load, "deregisterDelay"))
+            c.deregisterDelay = yaml::GetInt32(load, "deregisterDelay", 0, std::nullopt);
+    }
+
     return result;
 }
 
@@ -250,12 +383,43 @@ static void ReadOptions(int argc, char **argv)
                                       std::nullopt};
     opt::OptionItem itemDisableRouting = {'r', "no-routing-config",
                                           "Do not auto configure routing for UE TUN interface", std::nullopt};
+    opt::OptionItem itemLogLevel = {std::nullopt, "log-level",
+                                    "Discard logs below the given level (debug, info, warn, error)", "level"};
+    opt::OptionItem itemAsyncLog = {std::nullopt, "async-log", "Format and write the logs in a background thread",
+                                    std::nullopt};
+    opt::OptionItem itemBinaryLog = {std::nullopt, "binary-log",
+                                     "Write the logs unformatted to the given file instead of the console, decoded by "
+                                     "nr-logdec",
+                                     "file"};
+    opt::OptionItem itemTraceDir = {std::nullopt, "trace-dir",
+                                    "Write the event trace of a UE to the given directory when it encounters a failure",
+                                    "dir"};
+    opt::OptionItem itemMetricsPort = {std::nullopt, "metrics-port",
+                                       "Serve the metrics in Prometheus format on the given port of 127.0.0.1",
+                                       "port"};
+    opt::OptionItem itemMetricsCsv = {std::nullopt, "metrics-csv",
+                                      "Write the metrics to the given CSV file every second", "file"};
+    opt::OptionItem itemSubscribers = {std::nullopt, "subscribers",
+                                       "Create a UE for each subscriber in the given CSV file, the values not given "
+                                       "in the file are taken from the config file",
+                                       "file"};
+    opt::OptionItem itemStateFile = {std::nullopt, "state-file",
+                                     "Keep the NAS state of the UEs in the given file, and resume from it on restart",
+                                     "file"};
 
     desc.items.push_back(itemConfigFile);
     desc.items.push_back(itemImsi);
     desc.items.push_back(itemCount);
     desc.items.push_back(itemDisableCmd);
     desc.items.push_back(itemDisableRouting);
+    desc.items.push_back(itemLogLevel);
+    desc.items.push_back(itemAsyncLog);
+    desc.items.push_back(itemBinaryLog);
+    desc.items.push_back(itemTraceDir);
+    desc.items.push_back(itemMetricsPort);
+    desc.items.push_back(itemMetricsCsv);
+    desc.items.push_back(itemSubscribers);
+    desc.items.push_back(itemStateFile);
 
     opt::OptionsResult opt{argc, argv, desc, false, nullptr};
 
@@ -266,7 +430,7 @@ static void ReadOptions(int argc, char **argv)
         g_options.count = utils::ParseInt(opt.getOption(itemCount));
         if (g_options.count <= 0)
             throw std::runtime_error("Invalid number of UEs");
-        if (g_options.count > 512)
+        if (g_options.count > MAX_UE_COUNT)
             throw std::runtime_error("Number of UEs is too big");
     }
     else
@@ -274,6 +438,31 @@ static void ReadOptions(int argc, char **argv)
         g_options.count = 1;
     }
 
+    if (opt.hasFlag(itemSubscribers))
+    {
+        g_options.subscribersFile = opt.getOption(itemSubscribers);
+
+        int64_t startTime = utils::CurrentTimeMillis();
+        g_subscribers = nr::ue::LoadSubscriberDatabase(*g_options.subscribersFile);
+        g_subscribersLoadTime = utils::CurrentTimeMillis() - startTime;
+
+        if (g_subscribers.empty())
+            throw std::runtime_error("Subscriber database has no subscribers");
+        if (opt.hasFlag(itemCount))
+        {
+            // The first subscribers are used if the number of UEs is given
+            if (static_cast<size_t>(g_options.count) > g_subscribers.size())
+                throw std::runtime_error("Number of UEs is bigger than the number of subscribers");
+            g_subscribers.resize(static_cast<size_t>(g_options.count));
+        }
+        else
+        {
+            if (g_subscribers.size() > static_cast<size_t>(MAX_UE_COUNT))
+                throw std::runtime_error("Number of subscribers is too big, the number of UEs must be given");
+            g_options.count = static_cast<int>(g_subscribers.size());
+        }
+    }
+
     g_options.imsi = {};
     if (opt.hasFlag(itemImsi))
     {
@@ -282,41 +471,48 @@ static void ReadOptions(int argc, char **argv)
     }
 
     g_options.disableCmd = opt.hasFlag(itemDisableCmd);
-}
 
-static std::string LargeSum(std::string a, std::string b)
-{
-    if (a.length() > b.length())
-        std::swap(a, b);
+    if (opt.hasFlag(itemLogLevel))
+        g_options.logLevel = opt.getOption(itemLogLevel);
+    g_options.asyncLog = opt.hasFlag(itemAsyncLog);
+    if (opt.hasFlag(itemBinaryLog))
+        g_options.binaryLog = opt.getOption(itemBinaryLog);
+    app::ConfigureLogging(g_options.logLevel, g_options.asyncLog, g_options.binaryLog);
 
-    std::string str;
-    size_t n1 = a.length(), n2 = b.length();
+    if (opt.hasFlag(itemMetricsPort))
+    {
+        int port = utils::ParseInt(opt.getOption(itemMetricsPort));
+        if (port <= 0 || port > 65535)
+            throw std::runtime_error("Invalid metrics port");
+        g_options.metricsPort = static_cast<uint16_t>(port);
+    }
+    if (opt.hasFlag(itemMetricsCsv))
+        g_options.metricsCsv = opt.getOption(itemMetricsCsv);
+    app::StartMetrics(g_options.metricsPort, g_options.metricsCsv);
 
-    reverse(a.begin(), a.end());
-    reverse(b.begin(), b.end());
+    if (opt.hasFlag(itemStateFile))
+        g_options.stateFile = opt.getOption(itemStateFile);
 
-    int carry = 0;
-    for (size_t i = 0; i < n1; i++)
+    if (opt.hasFlag(itemTraceDir))
     {
-        int sum = ((a[i] - '0') + (b[i] - '0') + carry);
-        str.push_back(static_cast<char>((sum % 10) + '0'));
-        carry = sum / 10;
+        g_options.traceDumpDir = opt.getOption(itemTraceDir);
+        if (!io::IsDirectory(g_options.traceDumpDir))
+            throw std::runtime_error("Trace directory not found: " + g_options.traceDumpDir);
     }
-    for (size_t i = n1; i < n2; i++)
+}
+
+static void IncrementNumber(std::string &s, int delta)
+{
+    // The serial numbers may not fit into the integer types, hence the delta is added to the digits in place
+    int carry = delta;
+    for (size_t i = s.length(); i > 0 && carry > 0; i--)
     {
-        int sum = ((b[i] - '0') + carry);
-        str.push_back(static_cast<char>((sum % 10) + '0'));
+        int sum = (s[i - 1] - '0') + carry;
+        s[i - 1] = static_cast<char>((sum % 10) + '0');
         carry = sum / 10;
     }
     if (carry)
         throw std::runtime_error("UE serial number overflow");
-    reverse(str.begin(), str.end());
-    return str;
-}
-
-static void IncrementNumber(std::string &s, int delta)
-{
-    s = LargeSum(s, std::to_string(delta));
 }
 
 static nr::ue::UeConfig *GetConfigByUe(int ueIndex)
@@ -337,9 +533,12 @@ static nr::ue::UeConfig *GetConfigByUe(int ueIndex)
     c->defaultSessions = g_refConfig->defaultSessions;
     c->configureRouting = g_refConfig->configureRouting;
     c->prefixLogger = g_refConfig->prefixLogger;
+    c->traceDumpDir = g_refConfig->traceDumpDir;
     c->integrityMaxRate = g_refConfig->integrityMaxRate;
     c->uacAic = g_refConfig->uacAic;
     c->uacAcc = g_refConfig->uacAcc;
+    c->rlsArq = g_refConfig->rlsArq;
+    c->deferSessions = g_loadProfile->defersSessions();
 
     if (c->supi.has_value())
         IncrementNumber(c->supi->value, ueIndex);
@@ -348,9 +547,58 @@ static nr::ue::UeConfig *GetConfigByUe(int ueIndex)
     if (c->imeiSv.has_value())
         IncrementNumber(*c->imeiSv, ueIndex);
 
+    if (!g_subscribers.empty())
+    {
+        // Each subscriber is used by a single UE, hence the values are moved instead of copied
+        auto &sub = g_subscribers[static_cast<size_t>(ueIndex)];
+        if (sub.supi.has_value())
+            c->supi = std::move(sub.supi);
+        if (sub.key.has_value())
+            c->key = std::move(*sub.key);
+        if (sub.opC.has_value())
+        {
+            c->opC = std::move(*sub.opC);
+            c->opType = nr::ue::OpType::OPC;
+        }
+        if (sub.configuredNssai.has_value())
+            c->configuredNssai = std::move(*sub.configuredNssai);
+        if (sub.sessions)
+            c->defaultSessions = std::move(sub.sessions);
+    }
+
     return c;
 }
 
+static void DispatchBulkCommand(const app::CliMessage &msg, const app::UeCliCommand &cmd)
+{
+    std::vector<nr::ue::UserEquipment *> targets{};
+    try
+    {
+        app::NodeSelector selector{msg.nodeName};
+        g_ueMap.invokeForeach([&selector, &targets](const auto &item) {
+            if (selector.matches(item.first))
+                targets.push_back(item.second);
+        });
+    }
+    catch (const std::runtime_error &e)
+    {
+        g_cliServer->sendMessage(app::CliMessage::Error(msg.clientAddr, e.what()));
+        return;
+    }
+
+    if (targets.empty())
+    {
+        g_cliServer->sendMessage(app::CliMessage::Error(msg.clientAddr, "No node matches: " + msg.nodeName));
+        return;
+    }
+
+    // The responses are collected by the response task, and the UEs execute the command in parallel in their own tasks
+    g_cliRespTask->push(new app::NwCliBulkStart(msg.clientAddr, static_cast<int>(targets.size()),
+                                                msg.type == app::CliMessage::Type::STREAM_COMMAND));
+    for (auto *ue : targets)
+        ue->pushCommand(std::make_unique<app::UeCliCommand>(cmd), msg.clientAddr);
+}
+
 static void ReceiveCommand(app::CliMessage &msg)
 {
     if (msg.value.empty())
@@ -392,6 +640,12 @@ static void ReceiveCommand(app::CliMessage &msg)
         return;
     }
 
+    if (app::IsNodeSelector(msg.nodeName))
+    {
+        DispatchBulkCommand(msg, *cmd);
+        return;
+    }
+
     auto *ue = g_ueMap.getOrDefault(msg.nodeName);
     if (ue == nullptr)
     {
@@ -417,7 +671,7 @@ static void Loop()
         return;
     }
 
-    if (msg.type != app::CliMessage::Type::COMMAND)
+    if (msg.type != app::CliMessage::Type::COMMAND && msg.type != app::CliMessage::Type::STREAM_COMMAND)
         return;
 
     if (msg.value.size() > 0xFFFF)
@@ -435,6 +689,37 @@ static void Loop()
     ReceiveCommand(msg);
 }
 
+static void StartUe(nr::ue::UserEquipment *ue)
+{
+    if (ue->isStarted())
+        return;
+    ue->start();
+    g_uesStarted.add(1);
+
+    if (++g_startedUeCount == g_options.count)
+    {
+        int64_t duration = utils::CurrentTimeMillis() - g_processStartTime;
+        g_startupDuration.add(duration);
+        std::cout << "All " << g_options.count << " UE(s) started in " << duration << " ms" << std::endl;
+    }
+}
+
+static class LoadActionHandler : public nr::ue::ILoadActionHandler
+{
+  public:
+    void performLoadAction(int ueIndex, nr::ue::ELoadAction action) override
+    {
+        auto *ue = g_ueMap.getOrDefault(g_ueNames[ueIndex]);
+        if (ue == nullptr)
+            return;
+
+        if (action == nr::ue::ELoadAction::POWER_ON)
+            StartUe(ue);
+        else
+            ue->pushLoadAction(action);
+    }
+} g_loadActionHandler;
+
 static class UeController : public app::IUeController
 {
   public:
@@ -448,6 +733,7 @@ static class UeController : public app::IUeController
 
 int main(int argc, char **argv)
 {
+    g_processStartTime = utils::CurrentTimeMillis();
     app::Initialize();
 
     try
@@ -456,6 +742,13 @@ int main(int argc, char **argv)
         g_refConfig = ReadConfigYaml();
         if (g_options.imsi.length() > 0)
             g_refConfig->supi = Supi::Parse("imsi-" + g_options.imsi);
+        g_mobility = new rls::MobilityEngine(g_refConfig->mobility);
+        g_loadProfile = new nr::ue::LoadProfile(g_refConfig->loadProfile, g_options.count);
+        if (g_options.stateFile.has_value())
+        {
+            g_snapshot = new nr::ue::StateSnapshot(*g_options.stateFile, g_options.count);
+            app::RunAtExit([]() { g_snapshot->sync(); });
+        }
     }
     catch (const std::runtime_error &e)
     {
@@ -464,6 +757,8 @@ int main(int argc, char **argv)
     }
 
     std::cout << cons::Name << std::endl;
+    if (g_options.subscribersFile.has_value())
+        std::cout << g_subscribers.size() << " subscriber(s) loaded in " << g_subscribersLoadTime << " ms" << std::endl;
 
     g_controllerTask = new UeControllerTask();
     g_controllerTask->start();
@@ -474,20 +769,38 @@ int main(int argc, char **argv)
         g_cliRespTask = new app::CliResponseTask(g_cliServer);
     }
 
+    // Only the contexts are created here, the threads, sockets and loggers of a UE are created when it is powered on
+    g_ueNames.reserve(static_cast<size_t>(g_options.count));
     for (int i = 0; i < g_options.count; i++)
     {
         auto *config = GetConfigByUe(i);
-        auto *ue = new nr::ue::UserEquipment(config, &g_ueController, nullptr, g_cliRespTask);
-        g_ueMap.put(config->getNodeName(), ue);
+        auto *ue = new nr::ue::UserEquipment(config, &g_ueController, nullptr, g_cliRespTask, &g_radioEnv, g_mobility,
+                                             g_snapshot, i);
+        g_ueNames.push_back(config->getNodeName());
+        g_ueMap.put(g_ueNames.back(), ue);
     }
 
     if (!g_options.disableCmd)
     {
-        app::CreateProcTable(g_ueMap, g_cliServer->assignedAddress().getPort());
+        app::CreateProcTable(g_ueNames, g_cliServer->assignedAddress().getPort());
         g_cliRespTask->start();
     }
 
-    g_ueMap.invokeForeach([](const auto &ue) { ue.second->start(); });
+    if (!g_mobility->isStatic())
+    {
+        auto *mobilityTask = new rls::MobilityTask(g_mobility);
+        mobilityTask->start();
+    }
+
+    if (g_loadProfile->isImmediate())
+    {
+        g_ueMap.invokeForeach([](const auto &ue) { StartUe(ue.second); });
+    }
+    else
+    {
+        auto *loadTask = new nr::ue::LoadSchedulerTask(g_loadProfile, &g_loadActionHandler);
+        loadTask->start();
+    }
 
     while (true)
         Loop();
@@ -14,6 +14,8 @@
 #include <ue/rrc/task.hpp>
 #include <ue/tun/task.hpp>
 #include <utils/common.hpp>
+#include <utils/io.hpp>
+#include <utils/metrics.hpp>
 #include <utils/printer.hpp>
 
 #define PAUSE_CONFIRM_TIMEOUT 3000
@@ -36,12 +38,12 @@ namespace nr::ue
 
 void UeCmdHandler::sendResult(const InetAddress &address, const std::string &output)
 {
-    m_base->cliCallbackTask->push(new app::NwCliSendResponse(address, output, false));
+    m_base->cliCallbackTask->push(new app::NwCliSendResponse(address, output, false, m_base->config->getNodeName()));
 }
 
 void UeCmdHandler::sendError(const InetAddress &address, const std::string &output)
 {
-    m_base->cliCallbackTask->push(new app::NwCliSendResponse(address, output, true));
+    m_base->cliCallbackTask->push(new app::NwCliSendResponse(address, output, true, m_base->config->getNodeName()));
 }
 
 void UeCmdHandler::pauseTasks()
@@ -220,7 +222,7 @@ void UeCmdHandler::handleCmdImpl(NmUeCliCommand &msg)
     case app::UeCliCommand::RLS_STATE: {
         Json json = Json::Obj({
             {"sti", OctetString::FromOctet8(m_base->rlsTask->m_shCtx->sti).toHexString()},
-            {"gnb-search-space", ::ToJson(m_base->config->gnbSearchList)},
+            {"gnb-search-space", ::ToJson(*m_base->config->gnbSearchList)},
         });
         sendResult(msg.address, json.dumpYaml());
         break;
@@ -267,6 +269,46 @@ void UeCmdHandler::handleCmdImpl(NmUeCliCommand &msg)
         sendResult(msg.address, json.dumpYaml());
         break;
     }
+    case app::UeCliCommand::TRACE: {
+        auto events = m_base->trace->snapshot();
+
+        if (msg.cmd->traceFile.has_value())
+        {
+            try
+            {
+                io::WriteAllText(*msg.cmd->traceFile, TraceToChromeJson(events, m_base->config->getNodeName()));
+            }
+            catch (const std::exception &)
+            {
+                sendError(msg.address, "Trace file could not be written: " + *msg.cmd->traceFile);
+                break;
+            }
+            sendResult(msg.address, std::to_string(events.size()) + " events written to " + *msg.cmd->traceFile);
+            break;
+        }
+
+        if (events.empty())
+        {
+            sendResult(msg.address, "No event recorded");
+            break;
+        }
+
+        size_t first = events.size() > static_cast<size_t>(msg.cmd->traceCount)
+                           ? events.size() - static_cast<size_t>(msg.cmd->traceCount)
+                           : 0;
+        std::string output;
+        for (size_t i = first; i < events.size(); i++)
+            output += TraceEventToString(events[i]) + "\n";
+        utils::Trim(output);
+        sendResult(msg.address, output);
+        break;
+    }
+    case app::UeCliCommand::METRICS: {
+        std::string output = metrics::Registry::Instance().renderSummary();
+        utils::Trim(output);
+        sendResult(msg.address, output);
+        break;
+    }
     }
 }
 
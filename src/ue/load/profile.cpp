@@ -0,0 +1,218 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "profile.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include <utils/common.hpp>
+#include <utils/io.hpp>
+
+static constexpr const int TIMER_ID_NEXT_EVENT = 1;
+
+static bool ParseAction(const std::string &s, nr::ue::ELoadAction &action)
+{
+    if (s == "power-on")
+        action = nr::ue::ELoadAction::POWER_ON;
+    else if (s == "establish")
+        action = nr::ue::ELoadAction::ESTABLISH_SESSIONS;
+    else if (s == "release")
+        action = nr::ue::ELoadAction::RELEASE_SESSIONS;
+    else if (s == "deregister")
+        action = nr::ue::ELoadAction::DE_REGISTER;
+    else
+        return false;
+    return true;
+}
+
+namespace nr::ue
+{
+
+LoadProfile::LoadProfile(const LoadProfileConfig &config, int ueCount)
+    : m_config{config}, m_events{}, m_defersSessions{}
+{
+    if (config.arrival == ELoadArrival::REPLAY)
+        loadReplay(config.replayFile, ueCount);
+    else
+        generateArrivals(ueCount);
+
+    std::stable_sort(m_events.begin(), m_events.end(),
+                     [](const LoadEvent &a, const LoadEvent &b) { return a.time < b.time; });
+
+    // A UE can only be driven between its power on and its de-registration, since it is removed after the latter
+    std::vector<int> phase(static_cast<size_t>(ueCount)); // 0: off, 1: on, 2: removed
+    std::vector<LoadEvent> events;
+    events.reserve(m_events.size());
+
+    for (auto &event : m_events)
+    {
+        int &state = phase[static_cast<size_t>(event.ueIndex)];
+        if (event.action == ELoadAction::POWER_ON)
+        {
+            if (state != 0)
+                continue;
+            state = 1;
+        }
+        else
+        {
+            if (state != 1)
+                continue;
+            if (event.action == ELoadAction::DE_REGISTER)
+                state = 2;
+            if (event.action == ELoadAction::ESTABLISH_SESSIONS)
+                m_defersSessions = true;
+        }
+        events.push_back(event);
+    }
+
+    m_events = std::move(events);
+}
+
+void LoadProfile::generateArrivals(int ueCount)
+{
+    std::mt19937 rng{m_config.seed};
+    std::exponential_distribution<double> interArrival{static_cast<double>(m_config.rate)};
+
+    double time = 0.0;
+    for (int i = 0; i < ueCount; i++)
+    {
+        int64_t powerOn;
+        switch (m_config.arrival)
+        {
+        case ELoadArrival::CONSTANT:
+            powerOn = std::llround(i * 1000.0 / m_config.rate);
+            break;
+        case ELoadArrival::RAMP: {
+            powerOn = std::llround(time);
+            double progress = std::min(time / m_config.rampTime, 1.0);
+            double rate = m_config.rate + (m_config.endRate - m_config.rate) * progress;
+            time += 1000.0 / rate;
+            break;
+        }
+        case ELoadArrival::POISSON:
+            powerOn = std::llround(time);
+            time += interArrival(rng) * 1000.0;
+            break;
+        case ELoadArrival::BURSTY:
+            powerOn = static_cast<int64_t>(i / m_config.burstSize) * m_config.burstPeriod;
+            break;
+        default:
+            powerOn = 0;
+            break;
+        }
+
+        m_events.push_back(LoadEvent{powerOn, i, ELoadAction::POWER_ON});
+
+        if (m_config.sessionDelay >= 0)
+            m_events.push_back(LoadEvent{powerOn + m_config.sessionDelay, i, ELoadAction::ESTABLISH_SESSIONS});
+        if (m_config.releaseDelay >= 0)
+            m_events.push_back(LoadEvent{powerOn + m_config.releaseDelay, i, ELoadAction::RELEASE_SESSIONS});
+        if (m_config.deregisterDelay >= 0)
+            m_events.push_back(LoadEvent{powerOn + m_config.deregisterDelay, i, ELoadAction::DE_REGISTER});
+    }
+}
+
+void LoadProfile::loadReplay(const std::string &path, int ueCount)
+{
+    if (!io::Exists(path))
+        throw std::runtime_error("Load replay file not found: " + path);
+
+    std::stringstream stream{io::ReadAllText(path)};
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(stream, line))
+    {
+        lineNumber++;
+        utils::Trim(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::stringstream ls{line};
+        LoadEvent event{};
+        std::string action;
+        if (!(ls >> event.ueIndex >> event.time >> action) || event.ueIndex < 0 || event.time < 0 ||
+            !ParseAction(action, event.action))
+            throw std::runtime_error("Invalid load replay at line " + std::to_string(lineNumber) + ": " + line);
+
+        // The replay may be written for a larger population than the process has
+        if (event.ueIndex < ueCount)
+            m_events.push_back(event);
+    }
+}
+
+const std::vector<LoadEvent> &LoadProfile::getEvents() const
+{
+    return m_events;
+}
+
+bool LoadProfile::defersSessions() const
+{
+    return m_defersSessions;
+}
+
+bool LoadProfile::isImmediate() const
+{
+    if (m_config.arrival == ELoadArrival::REPLAY)
+        return false;
+    return std::all_of(m_events.begin(), m_events.end(),
+                       [](const LoadEvent &e) { return e.action == ELoadAction::POWER_ON && e.time == 0; });
+}
+
+LoadSchedulerTask::LoadSchedulerTask(const LoadProfile *profile, ILoadActionHandler *handler)
+    : m_profile{profile}, m_handler{handler}, m_startTime{}, m_cursor{}
+{
+}
+
+void LoadSchedulerTask::onStart()
+{
+    m_startTime = utils::CurrentTimeMillis();
+    dispatchDueEvents();
+}
+
+void LoadSchedulerTask::onLoop()
+{
+    auto *msg = take();
+    if (msg == nullptr)
+        return;
+
+    if (msg->msgType == NtsMessageType::TIMER_EXPIRED)
+    {
+        auto *w = dynamic_cast<NmTimerExpired *>(msg);
+        if (w->timerId == TIMER_ID_NEXT_EVENT)
+            dispatchDueEvents();
+    }
+
+    delete msg;
+}
+
+void LoadSchedulerTask::onQuit()
+{
+}
+
+void LoadSchedulerTask::dispatchDueEvents()
+{
+    auto &events = m_profile->getEvents();
+    int64_t elapsed = utils::CurrentTimeMillis() - m_startTime;
+
+    while (m_cursor < events.size() && events[m_cursor].time <= elapsed)
+    {
+        m_handler->performLoadAction(events[m_cursor].ueIndex, events[m_cursor].action);
+        m_cursor++;
+    }
+
+    // A single timer is armed for the next event, events falling in the same millisecond are dispatched together
+    if (m_cursor < events.size())
+        setTimer(TIMER_ID_NEXT_EVENT, events[m_cursor].time - elapsed);
+}
+
+} // namespace nr::ue
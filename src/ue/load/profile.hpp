@@ -0,0 +1,118 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <utils/nts.hpp>
+
+namespace nr::ue
+{
+
+enum class ELoadArrival
+{
+    NONE,     // All the UEs are switched on at once
+    CONSTANT, // Fixed inter-arrival time
+    RAMP,     // Arrival rate changes linearly, then stays at the final rate
+    POISSON,  // Exponentially distributed inter-arrival times
+    BURSTY,   // Groups of UEs switched on at the same time, periodically
+    REPLAY    // Timed procedures of each UE read from a file
+};
+
+enum class ELoadAction
+{
+    POWER_ON,
+    ESTABLISH_SESSIONS,
+    RELEASE_SESSIONS,
+    DE_REGISTER
+};
+
+struct LoadProfileConfig
+{
+    ELoadArrival arrival = ELoadArrival::NONE;
+    int rate = 10;          // UEs per second for CONSTANT and POISSON, and the initial rate for RAMP
+    int endRate = 10;       // UEs per second, only for RAMP
+    int rampTime = 10'000;  // Milliseconds, only for RAMP
+    int burstSize = 10;     // Only for BURSTY
+    int burstPeriod = 1000; // Milliseconds, only for BURSTY
+    std::string replayFile{};
+    uint32_t seed = 1;
+
+    /* Procedures of each UE, in milliseconds after its power on. Negative values disable the step. */
+    int sessionDelay = -1;    // Establishes the default PDU sessions, instead of right after the registration
+    int releaseDelay = -1;    // Releases all the PDU sessions
+    int deregisterDelay = -1; // Switch-off de-registration, the UE is removed afterwards
+};
+
+struct LoadEvent
+{
+    int64_t time; // Milliseconds relative to the start of the schedule
+    int ueIndex;
+    ELoadAction action;
+};
+
+/**
+ * Timeline of the procedures of all the UEs of a process, built once at startup.
+ * <p>
+ * The arrival process determines the power on time of each UE, and the other procedures of the UE follow it with the
+ * configured delays. Replay file consists of "<ue-index> <time-ms> <action>" lines, where the action is one of
+ * 'power-on', 'establish', 'release' and 'deregister', and the time is relative to the start of the schedule. UEs
+ * without a 'power-on' line are never switched on. Lines starting with '#' are ignored.
+ */
+class LoadProfile
+{
+  private:
+    LoadProfileConfig m_config;
+    std::vector<LoadEvent> m_events;
+    bool m_defersSessions;
+
+  public:
+    /* Throws std::runtime_error if the replay file is invalid */
+    LoadProfile(const LoadProfileConfig &config, int ueCount);
+
+  public:
+    [[nodiscard]] const std::vector<LoadEvent> &getEvents() const;
+    [[nodiscard]] bool defersSessions() const;
+    [[nodiscard]] bool isImmediate() const;
+
+  private:
+    void generateArrivals(int ueCount);
+    void loadReplay(const std::string &path, int ueCount);
+};
+
+class ILoadActionHandler
+{
+  public:
+    virtual void performLoadAction(int ueIndex, ELoadAction action) = 0;
+};
+
+class LoadSchedulerTask : public NtsTask
+{
+  private:
+    const LoadProfile *m_profile;
+    ILoadActionHandler *m_handler;
+    int64_t m_startTime;
+    size_t m_cursor;
+
+  public:
+    LoadSchedulerTask(const LoadProfile *profile, ILoadActionHandler *handler);
+    ~LoadSchedulerTask() override = default;
+
+  protected:
+    void onStart() override;
+    void onLoop() override;
+    void onQuit() override;
+
+  private:
+    void dispatchDueEvents();
+};
+
+} // namespace nr::ue
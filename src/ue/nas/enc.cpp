@@ -37,12 +37,12 @@ static nas::ESecurityHeaderType MakeSecurityHeaderType(const NasSecurityContext
 }
 
 static OctetString EncryptData(nas::ETypeOfCipheringAlgorithm alg, const NasCount &count, bool is3gppAccess,
-                               const OctetString &data, const OctetString &key)
+                               OctetSpan data, OctetSpan key)
 {
     int bearer = is3gppAccess ? 1 : 2;
     int direction = 0;
 
-    OctetString msg = data.copy();
+    OctetString msg = OctetString::FromSpan(data);
 
     switch (alg)
     {
@@ -74,8 +74,8 @@ static std::unique_ptr<nas::SecuredMmMessage> Encrypt(NasSecurityContext &ctx, O
     auto intAlg = ctx.integrity;
     auto encAlg = ctx.ciphering;
 
-    auto encryptedData =
-        bypassCiphering ? plainNasMessage.copy() : EncryptData(encAlg, count, is3gppAccess, plainNasMessage, encKey);
+    auto encryptedData = bypassCiphering ? std::move(plainNasMessage)
+                                         : EncryptData(encAlg, count, is3gppAccess, plainNasMessage, encKey);
     auto mac = ComputeMac(intAlg, count, is3gppAccess, true, intKey, encryptedData);
 
     auto secured = std::make_unique<nas::SecuredMmMessage>();
@@ -91,9 +91,9 @@ static std::unique_ptr<nas::SecuredMmMessage> Encrypt(NasSecurityContext &ctx, O
 }
 
 static OctetString DecryptData(nas::ETypeOfCipheringAlgorithm alg, const NasCount &count, bool is3gppAccess,
-                               const OctetString &key, nas::ESecurityHeaderType sht, const OctetString &data)
+                               OctetSpan key, nas::ESecurityHeaderType sht, OctetSpan data)
 {
-    OctetString msg = data.copy();
+    OctetString msg = OctetString::FromSpan(data);
 
     if (sht != nas::ESecurityHeaderType::INTEGRITY_PROTECTED_AND_CIPHERED &&
         sht != nas::ESecurityHeaderType::INTEGRITY_PROTECTED_AND_CIPHERED_WITH_NEW_SECURITY_CONTEXT)
@@ -158,12 +158,15 @@ std::unique_ptr<nas::NasMessage> Decrypt(NasSecurityContext &ctx, const nas::Sec
 }
 
 uint32_t ComputeMac(nas::ETypeOfIntegrityProtectionAlgorithm alg, NasCount count, bool is3gppAccess, bool isUplink,
-                    const OctetString &key, const OctetString &plainMessage)
+                    OctetSpan key, OctetSpan plainMessage)
 {
     if (alg == nas::ETypeOfIntegrityProtectionAlgorithm::IA0)
         return 0;
 
-    auto data = OctetString::Concat(OctetString::FromOctet(count.sqn), plainMessage);
+    OctetString data{};
+    data.reserve(1 + plainMessage.length());
+    data.appendOctet(count.sqn);
+    data.append(plainMessage);
 
     int bearer = is3gppAccess ? 1 : 2;
     int direction = isUplink ? 0 : 1;
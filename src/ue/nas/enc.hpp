@@ -19,6 +19,6 @@ std::unique_ptr<nas::SecuredMmMessage> Encrypt(NasSecurityContext &ctx, const na
 std::unique_ptr<nas::NasMessage> Decrypt(NasSecurityContext &ctx, const nas::SecuredMmMessage &msg);
 
 uint32_t ComputeMac(nas::ETypeOfIntegrityProtectionAlgorithm alg, NasCount count, bool is3gppAccess, bool isUplink,
-                    const OctetString &key, const OctetString &plainMessage);
+                    OctetSpan key, OctetSpan plainMessage);
 
 } // namespace nr::ue::nas_enc
@@ -422,6 +422,7 @@ void NasMm::receiveAuthenticationResult(const nas::AuthenticationResult &msg)
 void NasMm::receiveAuthenticationReject(const nas::AuthenticationReject &msg)
 {
     m_logger->err("Authentication Reject received");
+    m_base->trace->recordFailure(ETraceFailure::AUTHENTICATION_REJECT);
 
     // The RAND and RES* values stored in the ME shall be deleted and timer T3516, if running, shall be stopped
     m_usim->m_rand = {};
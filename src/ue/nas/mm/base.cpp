@@ -71,12 +71,13 @@ void NasMm::onStart(NasSm *sm, Usim *usim)
     m_sm = sm;
     m_usim = usim;
 
+    restoreSnapshot();
     triggerMmCycle();
 }
 
 void NasMm::onQuit()
 {
-    // TODO
+    saveSnapshot();
 }
 
 void NasMm::triggerMmCycle()
@@ -227,6 +228,9 @@ void NasMm::switchMmState(EMmSubState subState)
 
     onSwitchRmState(oldRmState, m_rmState);
 
+    if (m_rmState != oldRmState)
+        m_base->trace->record(ETraceEvent::RM_STATE, static_cast<int>(oldRmState), static_cast<int>(m_rmState));
+
     if (m_base->nodeListener)
     {
         m_base->nodeListener->onSwitch(app::NodeType::UE, m_base->config->getNodeName(), app::StateType::RM,
@@ -241,6 +245,9 @@ void NasMm::switchMmState(EMmSubState subState)
 
     m_lastTimeMmStateChange = utils::CurrentTimeMillis();
 
+    if (subState != oldSubState)
+        m_base->trace->record(ETraceEvent::MM_STATE, static_cast<int>(oldSubState), static_cast<int>(subState));
+
     onSwitchMmState(oldState, m_mmState, oldSubState, m_mmSubState);
 
     if (m_base->nodeListener)
@@ -263,7 +270,10 @@ void NasMm::switchCmState(ECmState state)
     m_cmState = state;
 
     if (state != oldState)
+    {
         m_logger->info("UE switches to state [%s]", ToJson(state).str().c_str());
+        m_base->trace->record(ETraceEvent::CM_STATE, static_cast<int>(oldState), static_cast<int>(state));
+    }
 
     onSwitchCmState(oldState, m_cmState);
 
@@ -294,7 +304,10 @@ void NasMm::switchUState(E5UState state)
     }
 
     if (state != oldState)
+    {
         m_logger->info("UE switches to state [%s]", ToJson(state).str().c_str());
+        m_base->trace->record(ETraceEvent::U5_STATE, static_cast<int>(oldState), static_cast<int>(state));
+    }
 
     triggerMmCycle();
 }
@@ -336,6 +349,13 @@ void NasMm::onSwitchMmState(EMmState oldState, EMmState newState, EMmSubState ol
     // "Timer T3512 is stopped when the UE enters ... the 5GMM-DEREGISTERED state over 3GPP access"
     if (newState == EMmState::MM_DEREGISTERED)
         m_timers->t3512.stop();
+
+    // The MM cycle is not polled for the PLMN search timeout, it is scheduled at the point the search is given up
+    if (newSubSate != oldSubState && (newSubSate == EMmSubState::MM_DEREGISTERED_PLMN_SEARCH ||
+                                      newSubSate == EMmSubState::MM_REGISTERED_PLMN_SEARCH))
+    {
+        m_base->nasTask->scheduleMmCycle(PLMN_SEARCH_TIMEOUT);
+    }
 }
 
 void NasMm::onSwitchRmState(ERmState oldState, ERmState newState)
@@ -182,6 +182,8 @@ EProcRc NasMm::sendNasMessage(const nas::PlainMmMessage &msg)
         }
     }
 
+    m_base->trace->record(ETraceEvent::NAS_SENT, static_cast<int>(msg.messageType));
+
     auto *m = new NmUeNasToRrc(NmUeNasToRrc::UPLINK_NAS_DELIVERY);
     m->pduId = 0;
     m->nasPdu = std::move(pdu);
@@ -295,6 +297,8 @@ void NasMm::receiveNasMessage(const nas::NasMessage &msg)
 
 void NasMm::receiveMmMessage(const nas::PlainMmMessage &msg)
 {
+    m_base->trace->record(ETraceEvent::NAS_RECEIVED, static_cast<int>(msg.messageType));
+
     switch (msg.messageType)
     {
     case nas::EMessageType::REGISTRATION_ACCEPT:
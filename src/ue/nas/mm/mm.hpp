@@ -25,6 +25,9 @@ class NasSm;
 class NasMm
 {
   private:
+    // PLMN search is given up after this duration, and a NO_CELL_AVAILABLE state is selected
+    static constexpr const int64_t PLMN_SEARCH_TIMEOUT = 5'000LL;
+
     TaskBase *m_base;
     NasTimers *m_timers;
     std::unique_ptr<Logger> m_logger;
@@ -196,6 +199,10 @@ class NasMm
     void invokeProcedures();
     bool hasPendingProcedure();
 
+  private: /* Snapshot */
+    void restoreSnapshot();
+    void saveSnapshot();
+
   private: /* Service Access Point */
     void handleRrcEvent(const NmUeRrcToNas &msg);
     void handleNasEvent(const NmUeNasToNas &msg);
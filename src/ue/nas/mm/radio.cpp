@@ -24,7 +24,7 @@ void NasMm::performPlmnSelection()
     int64_t currentTime = utils::CurrentTimeMillis();
 
     // After some timeout in PLMN_SEARCH states, NO_CELL_AVAILABLE state is selected
-    if (currentTime - m_lastTimeMmStateChange >= 5'000LL)
+    if (currentTime - m_lastTimeMmStateChange >= PLMN_SEARCH_TIMEOUT)
     {
         if (m_mmSubState == EMmSubState::MM_REGISTERED_PLMN_SEARCH)
         {
@@ -217,6 +217,7 @@ void NasMm::handleRrcConnectionRelease()
 void NasMm::handleRrcEstablishmentFailure()
 {
     m_logger->err("RRC Establishment failure");
+    m_base->trace->recordFailure(ETraceFailure::RRC_ESTABLISHMENT);
 
     /* Handle NAS count */
     {
@@ -11,6 +11,14 @@
 #include <algorithm>
 #include <lib/nas/utils.hpp>
 #include <ue/nas/task.hpp>
+#include <utils/metrics.hpp>
+
+static auto &g_regAccepted = metrics::Registry::Instance().counter(
+    "nas_registrations_total", "Registration procedures of the UEs by result", "result=\"accept\"");
+static auto &g_regRejected = metrics::Registry::Instance().counter(
+    "nas_registrations_total", "Registration procedures of the UEs by result", "result=\"reject\"");
+static auto &g_regAbnormal = metrics::Registry::Instance().counter(
+    "nas_registrations_total", "Registration procedures of the UEs by result", "result=\"abnormal\"");
 
 namespace nr::ue
 {
@@ -275,6 +283,8 @@ void NasMm::receiveRegistrationAccept(const nas::RegistrationAccept &msg)
         return;
     }
 
+    g_regAccepted.inc();
+
     auto regType = m_lastRegistrationRequest->registrationType.registrationType;
     if (regType == nas::ERegistrationType::INITIAL_REGISTRATION ||
         regType == nas::ERegistrationType::EMERGENCY_REGISTRATION)
@@ -587,6 +597,8 @@ void NasMm::receiveRegistrationReject(const nas::RegistrationReject &msg)
     auto regType = m_lastRegistrationRequest->registrationType.registrationType;
 
     m_logger->err("%s failed [%s]", nas::utils::EnumToString(regType), nas::utils::EnumToString(cause));
+    m_base->trace->recordFailure(ETraceFailure::REGISTRATION_REJECT, static_cast<int>(cause));
+    g_regRejected.inc();
 
     if (regType == nas::ERegistrationType::INITIAL_REGISTRATION ||
         regType == nas::ERegistrationType::EMERGENCY_REGISTRATION)
@@ -926,6 +938,9 @@ void NasMm::receiveMobilityRegistrationReject(const nas::RegistrationReject &msg
 
 void NasMm::handleAbnormalInitialRegFailure(nas::ERegistrationType regType)
 {
+    m_base->trace->recordFailure(ETraceFailure::REGISTRATION_ABNORMAL, static_cast<int>(regType));
+    g_regAbnormal.inc();
+
     // Timer T3510 shall be stopped if still running
     m_timers->t3510.stop();
 
@@ -970,6 +985,9 @@ void NasMm::handleAbnormalInitialRegFailure(nas::ERegistrationType regType)
 
 void NasMm::handleAbnormalMobilityRegFailure(nas::ERegistrationType regType)
 {
+    m_base->trace->recordFailure(ETraceFailure::REGISTRATION_ABNORMAL, static_cast<int>(regType));
+    g_regAbnormal.inc();
+
     // "Timer T3510 shall be stopped if still running"
     m_timers->t3510.stop();
 
@@ -74,6 +74,7 @@ void NasMm::handleNasEvent(const NmUeNasToNas &msg)
         break;
     case NmUeNasToNas::NAS_TIMER_EXPIRE:
         onTimerExpire(*msg.timer);
+        triggerMmCycle();
         break;
     default:
         break;
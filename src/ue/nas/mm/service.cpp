@@ -10,6 +10,12 @@
 
 #include <lib/nas/utils.hpp>
 #include <ue/nas/sm/sm.hpp>
+#include <utils/metrics.hpp>
+
+static auto &g_serviceAccepted = metrics::Registry::Instance().counter(
+    "nas_service_requests_total", "Service request procedures of the UEs by result", "result=\"accept\"");
+static auto &g_serviceRejected = metrics::Registry::Instance().counter(
+    "nas_service_requests_total", "Service request procedures of the UEs by result", "result=\"reject\"");
 
 namespace nr::ue
 {
@@ -218,6 +224,8 @@ void NasMm::receiveServiceAccept(const nas::ServiceAccept &msg)
         return;
     }
 
+    g_serviceAccepted.inc();
+
     if (m_lastServiceReqCause != EServiceReqCause::EMERGENCY_FALLBACK)
     {
         m_logger->info("Service Accept received");
@@ -276,6 +284,9 @@ void NasMm::receiveServiceReject(const nas::ServiceReject &msg)
     if (msg.sht == nas::ESecurityHeaderType::NOT_PROTECTED)
         m_logger->warn("Not protected Service Reject message received");
 
+    m_base->trace->recordFailure(ETraceFailure::SERVICE_REJECT, static_cast<int>(msg.mmCause.value));
+    g_serviceRejected.inc();
+
     // "On receipt of the SERVICE REJECT message, if the UE is in state 5GMM-SERVICE-REQUEST-INITIATED and the message
     // is integrity protected, the UE shall reset the service request attempt counter and stop timer T3517 if running."
     m_serCounter = 0;
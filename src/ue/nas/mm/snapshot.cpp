@@ -0,0 +1,134 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "mm.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+static void CopyKey(const OctetString &key, uint8_t *target, size_t size)
+{
+    std::memset(target, 0, size);
+    if (static_cast<size_t>(key.length()) == size)
+        std::memcpy(target, key.data(), size);
+}
+
+static OctetString RestoreKey(const uint8_t *source, size_t size)
+{
+    return OctetString::FromArray(source, size);
+}
+
+namespace nr::ue
+{
+
+void NasMm::restoreSnapshot()
+{
+    if (m_base->snapshot == nullptr)
+        return;
+
+    UeStateRecord record{};
+    if (!m_base->snapshot->load(m_base->snapshotIndex, m_base->config->getNodeName(), record))
+        return;
+
+    m_usim->m_sqnMng->setSqnArray(std::vector<uint64_t>(record.sqn, record.sqn + UeStateRecord::SQN_COUNT));
+
+    if (!(record.flags & UeStateRecord::FLAG_REGISTERED))
+        return;
+
+    nas::IE5gsMobileIdentity guti{};
+    guti.type = nas::EIdentityType::GUTI;
+    guti.gutiOrTmsi = GutiMobileIdentity{Plmn{record.gutiMcc, record.gutiMnc, record.gutiLongMnc != 0},
+                                         record.gutiAmfRegionId, record.gutiAmfSetId, record.gutiAmfPointer,
+                                         octet4{record.gutiTmsi}};
+    m_storage->storedGuti->set(guti);
+    m_storage->lastVisitedRegisteredTai->set(Tai{record.taiMcc, record.taiMnc, record.taiLongMnc != 0, record.tac});
+
+    // The UE resumes in the registered state as if the process was never stopped, and performs mobility registration
+    // with the stored GUTI when it finds a cell, since the TAI list is not kept in the snapshot
+    switchMmState(EMmSubState::MM_REGISTERED_PS);
+    switchUState(static_cast<E5UState>(record.uState));
+
+    // The security context is restored after the state switch, since leaving MM-DEREGISTERED deletes it
+    auto ctx = std::make_unique<NasSecurityContext>();
+    ctx->tsc = static_cast<nas::ETypeOfSecurityContext>(record.tsc);
+    ctx->ngKsi = record.ngKsi;
+    ctx->integrity = static_cast<nas::ETypeOfIntegrityProtectionAlgorithm>(record.integrity);
+    ctx->ciphering = static_cast<nas::ETypeOfCipheringAlgorithm>(record.ciphering);
+    ctx->uplinkCount.overflow = octet2{static_cast<uint32_t>(record.uplinkOverflow)};
+    ctx->uplinkCount.sqn = record.uplinkSqn;
+    ctx->downlinkCount.overflow = octet2{static_cast<uint32_t>(record.downlinkOverflow)};
+    ctx->downlinkCount.sqn = record.downlinkSqn;
+    ctx->keys.abba = RestoreKey(record.abba, std::min<size_t>(record.abbaLength, sizeof(record.abba)));
+    ctx->keys.kAusf = RestoreKey(record.kAusf, sizeof(record.kAusf));
+    ctx->keys.kSeaf = RestoreKey(record.kSeaf, sizeof(record.kSeaf));
+    ctx->keys.kAmf = RestoreKey(record.kAmf, sizeof(record.kAmf));
+    ctx->keys.kNasInt = RestoreKey(record.kNasInt, sizeof(record.kNasInt));
+    ctx->keys.kNasEnc = RestoreKey(record.kNasEnc, sizeof(record.kNasEnc));
+    m_usim->m_currentNsCtx = std::move(ctx);
+
+    m_logger->info("NAS state restored from the snapshot, resuming with the stored 5G-GUTI");
+}
+
+void NasMm::saveSnapshot()
+{
+    if (m_base->snapshot == nullptr)
+        return;
+
+    UeStateRecord record{};
+    std::string nodeName = m_base->config->getNodeName();
+    std::strncpy(record.nodeName, nodeName.c_str(), UeStateRecord::NODE_NAME_SIZE - 1);
+    record.uState = static_cast<uint8_t>(m_storage->uState->get());
+
+    auto &sqnArr = m_usim->m_sqnMng->getSqnArray();
+    if (sqnArr.size() == UeStateRecord::SQN_COUNT)
+        std::copy(sqnArr.begin(), sqnArr.end(), record.sqn);
+
+    // Only a registration with a GUTI and a security context can be resumed, otherwise initial registration is needed
+    auto &guti = m_storage->storedGuti->get();
+    auto &ctx = m_usim->m_currentNsCtx;
+    if (m_rmState == ERmState::RM_REGISTERED && guti.type == nas::EIdentityType::GUTI && ctx != nullptr)
+    {
+        record.flags |= UeStateRecord::FLAG_REGISTERED;
+
+        record.gutiMcc = static_cast<uint16_t>(guti.gutiOrTmsi.plmn.mcc);
+        record.gutiMnc = static_cast<uint16_t>(guti.gutiOrTmsi.plmn.mnc);
+        record.gutiLongMnc = guti.gutiOrTmsi.plmn.isLongMnc;
+        record.gutiAmfRegionId = guti.gutiOrTmsi.amfRegionId;
+        record.gutiAmfSetId = static_cast<uint16_t>(guti.gutiOrTmsi.amfSetId);
+        record.gutiAmfPointer = static_cast<uint8_t>(guti.gutiOrTmsi.amfPointer);
+        record.gutiTmsi = static_cast<uint32_t>(guti.gutiOrTmsi.tmsi);
+
+        auto &tai = m_storage->lastVisitedRegisteredTai->get();
+        record.taiMcc = static_cast<uint16_t>(tai.plmn.mcc);
+        record.taiMnc = static_cast<uint16_t>(tai.plmn.mnc);
+        record.taiLongMnc = tai.plmn.isLongMnc;
+        record.tac = tai.tac;
+
+        record.tsc = static_cast<uint8_t>(ctx->tsc);
+        record.ngKsi = static_cast<uint8_t>(ctx->ngKsi);
+        record.integrity = static_cast<uint8_t>(ctx->integrity);
+        record.ciphering = static_cast<uint8_t>(ctx->ciphering);
+        record.uplinkOverflow = static_cast<uint16_t>(static_cast<uint32_t>(ctx->uplinkCount.overflow));
+        record.uplinkSqn = ctx->uplinkCount.sqn;
+        record.downlinkOverflow = static_cast<uint16_t>(static_cast<uint32_t>(ctx->downlinkCount.overflow));
+        record.downlinkSqn = ctx->downlinkCount.sqn;
+
+        record.abbaLength = static_cast<uint8_t>(std::min<size_t>(ctx->keys.abba.length(), sizeof(record.abba)));
+        if (record.abbaLength > 0)
+            std::memcpy(record.abba, ctx->keys.abba.data(), record.abbaLength);
+        CopyKey(ctx->keys.kAusf, record.kAusf, sizeof(record.kAusf));
+        CopyKey(ctx->keys.kSeaf, record.kSeaf, sizeof(record.kSeaf));
+        CopyKey(ctx->keys.kAmf, record.kAmf, sizeof(record.kAmf));
+        CopyKey(ctx->keys.kNasInt, record.kNasInt, sizeof(record.kNasInt));
+        CopyKey(ctx->keys.kNasEnc, record.kNasEnc, sizeof(record.kNasEnc));
+    }
+
+    m_base->snapshot->store(m_base->snapshotIndex, record);
+}
+
+} // namespace nr::ue
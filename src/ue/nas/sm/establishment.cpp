@@ -12,10 +12,16 @@
 #include <lib/nas/utils.hpp>
 #include <ue/app/task.hpp>
 #include <ue/nas/mm/mm.hpp>
+#include <utils/metrics.hpp>
 
 namespace nr::ue
 {
 
+static auto &g_sessionAccepted = metrics::Registry::Instance().counter(
+    "nas_pdu_session_establishments_total", "PDU session establishment procedures by result", "result=\"accept\"");
+static auto &g_sessionRejected = metrics::Registry::Instance().counter(
+    "nas_pdu_session_establishments_total", "PDU session establishment procedures by result", "result=\"reject\"");
+
 static nas::IE5gSmCapability MakeSmCapability()
 {
     nas::IE5gSmCapability cap{};
@@ -124,7 +130,7 @@ void NasSm::sendEstablishmentRequest(const SessionConfig &config)
     /* Set relevant fields of the PT, and start T3580 */
     auto &pt = m_procedureTransactions[pti];
     pt.state = EPtState::PENDING;
-    pt.timer = newTransactionTimer(3580);
+    pt.timer = newTransactionTimer(3580, pti);
     pt.message = std::move(req);
     pt.psi = psi;
 
@@ -174,6 +180,7 @@ void NasSm::receiveEstablishmentAccept(const nas::PduSessionEstablishmentAccept
     statusUpdate->pduSession = pduSession;
     m_base->appTask->push(statusUpdate);
 
+    g_sessionAccepted.inc();
     m_logger->info("PDU Session establishment is successful PSI[%d]", pduSession->psi);
 }
 
@@ -196,6 +203,7 @@ void NasSm::receiveEstablishmentReject(const nas::PduSessionEstablishmentReject
     }
 
     pduSession->psState = EPsState::INACTIVE;
+    g_sessionRejected.inc();
 
     if (pduSession->isEmergency)
     {
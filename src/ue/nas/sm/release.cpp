@@ -50,7 +50,7 @@ void NasSm::sendReleaseRequest(int psi)
     /* Set relevant fields of the PT, and start T3582 */
     auto &pt = m_procedureTransactions[pti];
     pt.state = EPtState::PENDING;
-    pt.timer = newTransactionTimer(3582);
+    pt.timer = newTransactionTimer(3582, pti);
     pt.message = std::move(req);
     pt.psi = psi;
 
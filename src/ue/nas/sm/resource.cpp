@@ -125,7 +125,10 @@ void NasSm::establishRequiredSessions()
         return;
     }
 
-    for (auto &config : m_base->config->defaultSessions)
+    if (m_defaultSessionsDeferred)
+        return;
+
+    for (auto &config : *m_base->config->defaultSessions)
     {
         if (!anySessionMatches(config))
             sendEstablishmentRequest(config);
@@ -33,18 +33,16 @@ void NasSm::handleNasEvent(const NmUeNasToNas &msg)
     }
 }
 
-void NasSm::onTimerTick()
+void NasSm::onTransactionTimerTick(int pti)
 {
     if (m_mm->m_mmState == EMmState::MM_NULL)
         return;
+    if (pti < 0 || pti >= static_cast<int>(m_procedureTransactions.size()))
+        return;
 
-    int pti = 0;
-    for (auto &pt : m_procedureTransactions)
-    {
-        if (pt.timer && pt.timer->performTick())
-            onTransactionTimerExpire(pti);
-        pti++;
-    }
+    auto &pt = m_procedureTransactions[pti];
+    if (pt.timer && pt.timer->performTick())
+        onTransactionTimerExpire(pti);
 }
 
 void NasSm::handleUplinkDataRequest(int psi, OctetString &&data)
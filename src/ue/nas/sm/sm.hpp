@@ -30,6 +30,8 @@ class NasSm
 
     std::array<PduSession *, 16> m_pduSessions{};
     std::array<ProcedureTransaction, 255> m_procedureTransactions{};
+    // Indicates that the default sessions are established on demand of the load profile, not after the registration
+    bool m_defaultSessionsDeferred{};
 
     friend class UeCmdHandler;
     friend class NasMm;
@@ -80,7 +82,7 @@ class NasSm
     void receiveReleaseCommand(const nas::PduSessionReleaseCommand &msg);
 
   private: /* Timer */
-    std::unique_ptr<UeTimer> newTransactionTimer(int code);
+    std::unique_ptr<UeTimer> newTransactionTimer(int code, int pti);
     void onTimerExpire(UeTimer &timer);
     void onTransactionTimerExpire(int pti);
 
@@ -91,7 +93,7 @@ class NasSm
 
   private: /* Service Access Point */
     void handleNasEvent(const NmUeNasToNas &msg);
-    void onTimerTick();
+    void onTransactionTimerTick(int pti);
     void handleUplinkDataRequest(int psi, OctetString &&data);
     void handleDownlinkDataRequest(int psi, OctetString &&data);
 };
@@ -12,11 +12,12 @@
 #include <lib/nas/utils.hpp>
 #include <ue/app/task.hpp>
 #include <ue/nas/mm/mm.hpp>
+#include <ue/nas/task.hpp>
 
 namespace nr::ue
 {
 
-std::unique_ptr<UeTimer> NasSm::newTransactionTimer(int code)
+std::unique_ptr<UeTimer> NasSm::newTransactionTimer(int code, int pti)
 {
     std::unique_ptr<UeTimer> timer;
 
@@ -36,6 +37,7 @@ std::unique_ptr<UeTimer> NasSm::newTransactionTimer(int code)
         return nullptr;
     }
 
+    timer->attach(m_base->nasTask, NasTask::TIMER_ID_TRANSACTION_TIMER_BASE + pti, m_base->trace);
     timer->start();
     return timer;
 }
@@ -59,6 +59,8 @@ static ENasTransportHint MapMsgTypeToHint(nas::EMessageType msgType)
 
 void NasSm::sendSmMessage(int psi, const nas::SmMessage &msg)
 {
+    m_base->trace->record(ETraceEvent::NAS_SENT, static_cast<int>(msg.messageType));
+
     auto &session = m_pduSessions[psi];
 
     nas::UlNasTransport m;
@@ -84,6 +86,8 @@ void NasSm::sendSmMessage(int psi, const nas::SmMessage &msg)
 
 void NasSm::receiveSmMessage(const nas::SmMessage &msg)
 {
+    m_base->trace->record(ETraceEvent::NAS_RECEIVED, static_cast<int>(msg.messageType));
+
     switch (msg.messageType)
     {
     case nas::EMessageType::PDU_SESSION_ESTABLISHMENT_ACCEPT:
@@ -9,10 +9,9 @@
 #include "task.hpp"
 #include <ue/nts.hpp>
 
-static const int NTS_TIMER_ID_NAS_TIMER_CYCLE = 1;
 static const int NTS_TIMER_ID_MM_CYCLE = 2;
-static const int NTS_TIMER_INTERVAL_NAS_TIMER_CYCLE = 1000;
-static const int NTS_TIMER_INTERVAL_MM_CYCLE = 1100;
+static const int NTS_TIMER_ID_MM_DEFERRED_CYCLE = 3;
+static const int NTS_TIMER_INTERVAL_MM_CYCLE = 5000; // Safety net only, the MM cycle is triggered by the events
 
 namespace nr::ue
 {
@@ -24,6 +23,10 @@ NasTask::NasTask(TaskBase *base) : base{base}, timers{}
     mm = new NasMm(base, &timers);
     sm = new NasSm(base, &timers);
     usim = new Usim();
+
+    int index = 0;
+    for (auto *timer : timers.all())
+        timer->attach(this, TIMER_ID_NAS_TIMER_BASE + index++, base->trace);
 }
 
 void NasTask::onStart()
@@ -33,10 +36,14 @@ void NasTask::onStart()
     sm->onStart(mm);
     mm->onStart(sm, usim);
 
-    setTimer(NTS_TIMER_ID_NAS_TIMER_CYCLE, NTS_TIMER_INTERVAL_NAS_TIMER_CYCLE);
     setTimer(NTS_TIMER_ID_MM_CYCLE, NTS_TIMER_INTERVAL_MM_CYCLE);
 }
 
+void NasTask::scheduleMmCycle(int64_t delayMs)
+{
+    setTimer(NTS_TIMER_ID_MM_DEFERRED_CYCLE, delayMs);
+}
+
 void NasTask::onQuit()
 {
     mm->onQuit();
@@ -105,19 +112,44 @@ void NasTask::onLoop()
 
         break;
     }
+    case NtsMessageType::UE_LOAD_COMMAND: {
+        auto *w = dynamic_cast<NmUeLoadCommand *>(msg);
+        switch (w->action)
+        {
+        case ELoadAction::ESTABLISH_SESSIONS: {
+            // The sessions are established by the MM cycle as soon as the UE is registered
+            sm->m_defaultSessionsDeferred = false;
+            mm->triggerMmCycle();
+            break;
+        }
+        case ELoadAction::RELEASE_SESSIONS: {
+            sm->m_defaultSessionsDeferred = true;
+            sm->sendReleaseRequestForAll();
+            break;
+        }
+        case ELoadAction::DE_REGISTER: {
+            mm->deregistrationRequired(EDeregCause::SWITCH_OFF);
+            break;
+        }
+        default:
+            break;
+        }
+        break;
+    }
     case NtsMessageType::TIMER_EXPIRED: {
         auto *w = dynamic_cast<NmTimerExpired *>(msg);
         int timerId = w->timerId;
-        if (timerId == NTS_TIMER_ID_NAS_TIMER_CYCLE)
-        {
-            setTimer(NTS_TIMER_ID_NAS_TIMER_CYCLE, NTS_TIMER_INTERVAL_NAS_TIMER_CYCLE);
-            performTick();
-        }
+        if (timerId >= TIMER_ID_TRANSACTION_TIMER_BASE)
+            sm->onTransactionTimerTick(timerId - TIMER_ID_TRANSACTION_TIMER_BASE);
+        else if (timerId >= TIMER_ID_NAS_TIMER_BASE)
+            onNasTimerExpired(timerId - TIMER_ID_NAS_TIMER_BASE);
         if (timerId == NTS_TIMER_ID_MM_CYCLE)
         {
             setTimer(NTS_TIMER_ID_MM_CYCLE, NTS_TIMER_INTERVAL_MM_CYCLE);
             mm->handleNasEvent(NmUeNasToNas{NmUeNasToNas::PERFORM_MM_CYCLE});
         }
+        if (timerId == NTS_TIMER_ID_MM_DEFERRED_CYCLE)
+            mm->handleNasEvent(NmUeNasToNas{NmUeNasToNas::PERFORM_MM_CYCLE});
         break;
     }
     default:
@@ -125,53 +157,30 @@ void NasTask::onLoop()
         break;
     }
 
+    // The NAS state may have been changed by the message, except the user plane data which is not related to MM
+    if (msg->msgType != NtsMessageType::UE_APP_TO_NAS && msg->msgType != NtsMessageType::UE_RLS_TO_NAS)
+        mm->saveSnapshot();
+
     delete msg;
 }
 
-void NasTask::performTick()
+void NasTask::onNasTimerExpired(int index)
 {
-    auto sendExpireMsg = [this](UeTimer *timer) {
-        auto *m = new NmUeNasToNas(NmUeNasToNas::NAS_TIMER_EXPIRE);
-        m->timer = timer;
-        push(m);
-    };
-
-    if (timers.t3346.performTick())
-        sendExpireMsg(&timers.t3346);
-    if (timers.t3396.performTick())
-        sendExpireMsg(&timers.t3396);
-    if (timers.t3444.performTick())
-        sendExpireMsg(&timers.t3444);
-    if (timers.t3445.performTick())
-        sendExpireMsg(&timers.t3445);
-    if (timers.t3502.performTick())
-        sendExpireMsg(&timers.t3502);
-    if (timers.t3510.performTick())
-        sendExpireMsg(&timers.t3510);
-    if (timers.t3511.performTick())
-        sendExpireMsg(&timers.t3511);
-    if (timers.t3512.performTick())
-        sendExpireMsg(&timers.t3512);
-    if (timers.t3516.performTick())
-        sendExpireMsg(&timers.t3516);
-    if (timers.t3517.performTick())
-        sendExpireMsg(&timers.t3517);
-    if (timers.t3519.performTick())
-        sendExpireMsg(&timers.t3519);
-    if (timers.t3520.performTick())
-        sendExpireMsg(&timers.t3520);
-    if (timers.t3521.performTick())
-        sendExpireMsg(&timers.t3521);
-    if (timers.t3525.performTick())
-        sendExpireMsg(&timers.t3525);
-    if (timers.t3540.performTick())
-        sendExpireMsg(&timers.t3540);
-    if (timers.t3584.performTick())
-        sendExpireMsg(&timers.t3584);
-    if (timers.t3585.performTick())
-        sendExpireMsg(&timers.t3585);
-
-    sm->onTimerTick();
+    auto all = timers.all();
+    if (index >= static_cast<int>(all.size()))
+        return;
+
+    auto *timer = all[index];
+    if (!timer->performTick())
+        return;
+
+    NmUeNasToNas msg{NmUeNasToNas::NAS_TIMER_EXPIRE};
+    msg.timer = timer;
+
+    if (timer->isMmTimer())
+        mm->handleNasEvent(msg);
+    else
+        sm->handleNasEvent(msg);
 }
 
 } // namespace nr::ue
\ No newline at end of file
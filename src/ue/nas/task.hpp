@@ -37,13 +37,21 @@ class NasTask : public NtsTask
     explicit NasTask(TaskBase *base);
     ~NasTask() override = default;
 
+  public:
+    /* NTS timer IDs of the attached NAS timers, and the transaction timers of the SM indexed by PTI */
+    static constexpr const int TIMER_ID_NAS_TIMER_BASE = 1000;
+    static constexpr const int TIMER_ID_TRANSACTION_TIMER_BASE = 2000;
+
+    // Runs the MM cycle once after the given delay, for the MM transitions that are due to a timeout
+    void scheduleMmCycle(int64_t delayMs);
+
   protected:
     void onStart() override;
     void onLoop() override;
     void onQuit() override;
 
   private:
-    void performTick();
+    void onNasTimerExpired(int index);
 };
 
 } // namespace nr::ue
\ No newline at end of file
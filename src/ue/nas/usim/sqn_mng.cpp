@@ -70,4 +70,15 @@ OctetString SqnManager::getSqn() const
     return OctetString::FromOctet8(getSqnMs()).subCopy(2);
 }
 
+const std::vector<uint64_t> &SqnManager::getSqnArray() const
+{
+    return m_sqnArr;
+}
+
+void SqnManager::setSqnArray(const std::vector<uint64_t> &sqnArr)
+{
+    if (sqnArr.size() == m_sqnArr.size())
+        m_sqnArr = sqnArr;
+}
+
 } // namespace nr::ue
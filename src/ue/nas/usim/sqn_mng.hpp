@@ -38,6 +38,10 @@ class SqnManager
   public:
     [[nodiscard]] OctetString getSqn() const;
     bool checkSqn(const OctetString &sqn);
+
+    [[nodiscard]] const std::vector<uint64_t> &getSqnArray() const;
+    /* Ignored if the array size does not match the index bit length */
+    void setSqnArray(const std::vector<uint64_t> &sqnArr);
 };
 
 } // namespace nr::ue
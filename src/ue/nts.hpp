@@ -128,7 +128,6 @@ struct NmUeRrcToRls : NtsMessage
 
     // RRC_PDU_DELIVERY
     rrc::RrcChannel channel{};
-    uint32_t pduId{};
     OctetString pdu{};
 
     explicit NmUeRrcToRls(PR present) : NtsMessage(NtsMessageType::UE_RRC_TO_RLS), present(present)
@@ -192,6 +191,15 @@ struct NmUeNasToNas : NtsMessage
     }
 };
 
+struct NmUeLoadCommand : NtsMessage
+{
+    ELoadAction action;
+
+    explicit NmUeLoadCommand(ELoadAction action) : NtsMessage(NtsMessageType::UE_LOAD_COMMAND), action(action)
+    {
+    }
+};
+
 struct NmUeNasToApp : NtsMessage
 {
     enum PR
@@ -299,9 +307,6 @@ struct NmUeRlsToRls : NtsMessage
     // DOWNLINK_RRC
     rrc::RrcChannel rrcChannel{};
 
-    // UPLINK_RRC
-    uint32_t pduId{};
-
     // RADIO_LINK_FAILURE
     rls::ERlfCause rlfCause{};
 
@@ -8,22 +8,18 @@
 
 #include "ctl_task.hpp"
 
-#include <utils/common.hpp>
-
-static constexpr const size_t MAX_PDU_COUNT = 128;
-static constexpr const int MAX_PDU_TTL = 3000;
+#include <cstdint>
 
-static constexpr const int TIMER_ID_ACK_CONTROL = 1;
-static constexpr const int TIMER_ID_ACK_SEND = 2;
+#include <utils/common.hpp>
 
-static constexpr const int TIMER_PERIOD_ACK_CONTROL = 1500;
-static constexpr const int TIMER_PERIOD_ACK_SEND = 2250;
+static constexpr const int TIMER_ID_ARQ = 1;
 
 namespace nr::ue
 {
 
 RlsControlTask::RlsControlTask(TaskBase *base, RlsSharedContext *shCtx)
-    : m_shCtx{shCtx}, m_servingCell{}, m_mainTask{}, m_udpTask{}, m_pduMap{}, m_pendingAck{}
+    : m_shCtx{shCtx}, m_servingCell{}, m_mainTask{}, m_udpTask{}, m_arq{this, base->config->rlsArq},
+      m_arqTimerSet{}
 {
     m_logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "rls-ctl");
 }
@@ -36,8 +32,6 @@ void RlsControlTask::initialize(NtsTask *mainTask, RlsUdpTask *udpTask)
 
 void RlsControlTask::onStart()
 {
-    setTimer(TIMER_ID_ACK_CONTROL, TIMER_PERIOD_ACK_CONTROL);
-    setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
 }
 
 void RlsControlTask::onLoop()
@@ -62,7 +56,7 @@ void RlsControlTask::onLoop()
             handleUplinkDataDelivery(w->psi, std::move(w->data));
             break;
         case NmUeRlsToRls::UPLINK_RRC:
-            handleUplinkRrcDelivery(w->cellId, w->pduId, w->rrcChannel, std::move(w->data));
+            handleUplinkRrcDelivery(w->cellId, w->rrcChannel, std::move(w->data));
             break;
         case NmUeRlsToRls::ASSIGN_CURRENT_CELL:
             m_servingCell = w->cellId;
@@ -75,15 +69,10 @@ void RlsControlTask::onLoop()
     }
     case NtsMessageType::TIMER_EXPIRED: {
         auto *w = dynamic_cast<NmTimerExpired *>(msg);
-        if (w->timerId == TIMER_ID_ACK_CONTROL)
+        if (w->timerId == TIMER_ID_ARQ)
         {
-            setTimer(TIMER_ID_ACK_CONTROL, TIMER_PERIOD_ACK_CONTROL);
-            onAckControlTimerExpired();
-        }
-        else if (w->timerId == TIMER_ID_ACK_SEND)
-        {
-            setTimer(TIMER_ID_ACK_SEND, TIMER_PERIOD_ACK_SEND);
-            onAckSendTimerExpired();
+            m_arqTimerSet = false;
+            m_arq.timerCycle(utils::CurrentTimeMillis(), m_shCtx->sti);
         }
         break;
     }
@@ -92,6 +81,8 @@ void RlsControlTask::onLoop()
         break;
     }
 
+    setArqTimer();
+
     delete msg;
 }
 
@@ -103,15 +94,13 @@ void RlsControlTask::handleRlsMessage(int cellId, rls::RlsMessage &msg)
 {
     if (msg.msgType == rls::EMessageType::PDU_TRANSMISSION_ACK)
     {
-        auto &m = (rls::RlsPduTransmissionAck &)msg;
-        for (auto pduId : m.pduIds)
-            m_pduMap.erase(pduId);
+        m_arq.receiveAck(cellId, (rls::RlsPduTransmissionAck &)msg, utils::CurrentTimeMillis());
     }
     else if (msg.msgType == rls::EMessageType::PDU_TRANSMISSION)
     {
         auto &m = (rls::RlsPduTransmission &)msg;
-        if (m.pduId != 0)
-            m_pendingAck[cellId].push_back(m.pduId);
+        if (!m_arq.receivePdu(cellId, m, utils::CurrentTimeMillis()))
+            return; // Duplicate PDU
 
         if (m.pduType == rls::EPduType::DATA)
         {
@@ -148,50 +137,18 @@ void RlsControlTask::handleRlsMessage(int cellId, rls::RlsMessage &msg)
 
 void RlsControlTask::handleSignalChange(int cellId, int dbm)
 {
+    if (dbm == INT32_MIN)
+        m_arq.removeEndPoint(cellId); // Signal lost
+
     auto *w = new NmUeRlsToRls(NmUeRlsToRls::SIGNAL_CHANGED);
     w->cellId = cellId;
     w->dbm = dbm;
     m_mainTask->push(w);
 }
 
-void RlsControlTask::handleUplinkRrcDelivery(int cellId, uint32_t pduId, rrc::RrcChannel channel, OctetString &&data)
+void RlsControlTask::handleUplinkRrcDelivery(int cellId, rrc::RrcChannel channel, OctetString &&data)
 {
-    if (pduId != 0)
-    {
-        if (m_pduMap.count(pduId))
-        {
-            m_pduMap.clear();
-
-            auto *w = new NmUeRlsToRls(NmUeRlsToRls::RADIO_LINK_FAILURE);
-            w->rlfCause = rls::ERlfCause::PDU_ID_EXISTS;
-            m_mainTask->push(w);
-            return;
-        }
-
-        if (m_pduMap.size() > MAX_PDU_COUNT)
-        {
-            m_pduMap.clear();
-
-            auto *w = new NmUeRlsToRls(NmUeRlsToRls::RADIO_LINK_FAILURE);
-            w->rlfCause = rls::ERlfCause::PDU_ID_FULL;
-            m_mainTask->push(w);
-            return;
-        }
-
-        m_pduMap[pduId].endPointId = cellId;
-        m_pduMap[pduId].id = pduId;
-        m_pduMap[pduId].pdu = data.copy();
-        m_pduMap[pduId].rrcChannel = channel;
-        m_pduMap[pduId].sentTime = utils::CurrentTimeMillis();
-    }
-
-    rls::RlsPduTransmission msg{m_shCtx->sti};
-    msg.pduType = rls::EPduType::RRC;
-    msg.pdu = std::move(data);
-    msg.payload = static_cast<uint32_t>(channel);
-    msg.pduId = pduId;
-
-    m_udpTask->send(cellId, msg);
+    m_arq.sendReliable(cellId, channel, std::move(data), m_shCtx->sti, utils::CurrentTimeMillis());
 }
 
 void RlsControlTask::handleUplinkDataDelivery(int psi, OctetString &&data)
@@ -200,54 +157,36 @@ void RlsControlTask::handleUplinkDataDelivery(int psi, OctetString &&data)
     msg.pduType = rls::EPduType::DATA;
     msg.pdu = std::move(data);
     msg.payload = static_cast<uint32_t>(psi);
-    msg.pduId = 0;
 
-    m_udpTask->send(m_servingCell, msg);
+    m_arq.sendUnreliable(m_servingCell, msg);
 }
 
-void RlsControlTask::onAckControlTimerExpired()
+void RlsControlTask::setArqTimer()
 {
-    int64_t current = utils::CurrentTimeMillis();
-
-    std::vector<uint32_t> transmissionFailureIds;
-    std::vector<rls::PduInfo> transmissionFailures;
-
-    for (auto &pdu : m_pduMap)
-    {
-        auto delta = current - pdu.second.sentTime;
-        if (delta > MAX_PDU_TTL)
-        {
-            transmissionFailureIds.push_back(pdu.first);
-            transmissionFailures.push_back(std::move(pdu.second));
-        }
-    }
-
-    for (auto id : transmissionFailureIds)
-        m_pduMap.erase(id);
-
-    if (!transmissionFailures.empty())
+    if (!m_arqTimerSet && m_arq.hasTimer())
     {
-        auto *w = new NmUeRlsToRls(NmUeRlsToRls::TRANSMISSION_FAILURE);
-        w->pduList = std::move(transmissionFailures);
-        m_mainTask->push(w);
+        m_arqTimerSet = true;
+        setTimer(TIMER_ID_ARQ, m_arq.getTickPeriod());
     }
 }
 
-void RlsControlTask::onAckSendTimerExpired()
+void RlsControlTask::sendRlsMessage(int cellId, const rls::RlsMessage &msg)
 {
-    auto copy = m_pendingAck;
-    m_pendingAck.clear();
-
-    for (auto &item : copy)
-    {
-        if (!item.second.empty())
-            continue;
+    m_udpTask->send(cellId, msg);
+}
 
-        rls::RlsPduTransmissionAck msg{m_shCtx->sti};
-        msg.pduIds = std::move(item.second);
+void RlsControlTask::transmissionFailure(std::vector<rls::PduInfo> &&pduList)
+{
+    auto *w = new NmUeRlsToRls(NmUeRlsToRls::TRANSMISSION_FAILURE);
+    w->pduList = std::move(pduList);
+    m_mainTask->push(w);
+}
 
-        m_udpTask->send(item.first, msg);
-    }
+void RlsControlTask::radioLinkFailure(int cellId, rls::ERlfCause cause)
+{
+    auto *w = new NmUeRlsToRls(NmUeRlsToRls::RADIO_LINK_FAILURE);
+    w->rlfCause = cause;
+    m_mainTask->push(w);
 }
 
 } // namespace nr::ue
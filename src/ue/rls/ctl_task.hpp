@@ -10,9 +10,9 @@
 
 #include "udp_task.hpp"
 
-#include <unordered_map>
 #include <vector>
 
+#include <lib/rls/rls_arq.hpp>
 #include <lib/rrc/rrc.hpp>
 #include <ue/nts.hpp>
 #include <ue/types.hpp>
@@ -21,7 +21,7 @@
 namespace nr::ue
 {
 
-class RlsControlTask : public NtsTask
+class RlsControlTask : public NtsTask, private rls::IArqConsumer
 {
   private:
     std::unique_ptr<Logger> m_logger;
@@ -29,8 +29,8 @@ class RlsControlTask : public NtsTask
     int m_servingCell;
     NtsTask *m_mainTask;
     RlsUdpTask *m_udpTask;
-    std::unordered_map<uint32_t, rls::PduInfo> m_pduMap;
-    std::unordered_map<int, std::vector<uint32_t>> m_pendingAck;
+    rls::RlsArq m_arq;
+    bool m_arqTimerSet;
 
   public:
     explicit RlsControlTask(TaskBase *base, RlsSharedContext *shCtx);
@@ -47,10 +47,14 @@ class RlsControlTask : public NtsTask
   private:
     void handleRlsMessage(int cellId, rls::RlsMessage &msg);
     void handleSignalChange(int cellId, int dbm);
-    void handleUplinkRrcDelivery(int cellId, uint32_t pduId, rrc::RrcChannel channel, OctetString &&data);
+    void handleUplinkRrcDelivery(int cellId, rrc::RrcChannel channel, OctetString &&data);
     void handleUplinkDataDelivery(int psi, OctetString &&data);
-    void onAckControlTimerExpired();
-    void onAckSendTimerExpired();
+    void setArqTimer();
+
+    /* ARQ consumer */
+    void sendRlsMessage(int cellId, const rls::RlsMessage &msg) override;
+    void transmissionFailure(std::vector<rls::PduInfo> &&pduList) override;
+    void radioLinkFailure(int cellId, rls::ERlfCause cause) override;
 };
 
 } // namespace nr::ue
\ No newline at end of file
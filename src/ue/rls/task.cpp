@@ -24,7 +24,7 @@ UeRlsTask::UeRlsTask(TaskBase *base) : m_base{base}
     m_shCtx = new RlsSharedContext();
     m_shCtx->sti = utils::Random64();
 
-    m_udpTask = new RlsUdpTask(base, m_shCtx, base->config->gnbSearchList);
+    m_udpTask = new RlsUdpTask(base, m_shCtx, *base->config->gnbSearchList);
     m_ctlTask = new RlsControlTask(base, m_shCtx);
 
     m_udpTask->initialize(m_ctlTask);
@@ -102,7 +102,6 @@ void UeRlsTask::onLoop()
             auto *m = new NmUeRlsToRls(NmUeRlsToRls::UPLINK_RRC);
             m->cellId = w->cellId;
             m->rrcChannel = w->channel;
-            m->pduId = w->pduId;
             m->data = std::move(w->pdu);
             m_ctlTask->push(m);
             break;
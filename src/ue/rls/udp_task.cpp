@@ -12,6 +12,7 @@
 #include <cstring>
 #include <set>
 
+#include <lib/rls/propagation.hpp>
 #include <ue/nts.hpp>
 #include <utils/common.hpp>
 #include <utils/constants.hpp>
@@ -25,17 +26,31 @@ namespace nr::ue
 {
 
 RlsUdpTask::RlsUdpTask(TaskBase *base, RlsSharedContext *shCtx, const std::vector<std::string> &searchSpace)
-    : m_server{}, m_ctlTask{}, m_shCtx{shCtx}, m_searchSpace{}, m_cells{}, m_cellIdToSti{}, m_lastLoop{},
-      m_cellIdCounter{}
+    : m_server{}, m_ctlTask{}, m_shCtx{shCtx}, m_searchSpace{}, m_radioEnv{base->radioEnv}, m_searchCells{},
+      m_cellToSearch{}, m_hbTargets{}, m_hbSent{}, m_cells{}, m_cellIdToSti{}, m_lastLoop{}, m_mobility{base->mobility},
+      m_mobilityIndex{}, m_cellIdCounter{}
 {
     m_logger = base->logBase->makeUniqueLogger(base->config->getLoggerPrefix() + "rls-udp");
 
     m_server = new udp::UdpServer();
 
     for (auto &ip : searchSpace)
+    {
+        int cell = m_radioEnv->registerCell(ip);
+        if (m_cellToSearch.count(cell))
+            continue;
+
+        m_cellToSearch[cell] = m_searchSpace.size();
         m_searchSpace.emplace_back(ip, cons::PortalPort);
+        m_searchCells.push_back(cell);
+    }
 
     m_simPos = Vector3{};
+    if (m_mobility)
+    {
+        m_mobilityIndex = m_mobility->addUe();
+        m_simPos = m_mobility->getPosition(m_mobilityIndex);
+    }
 }
 
 void RlsUdpTask::onStart()
@@ -48,6 +63,8 @@ void RlsUdpTask::onLoop()
     if (current - m_lastLoop > LOOP_PERIOD)
     {
         m_lastLoop = current;
+        if (m_mobility)
+            m_simPos = m_mobility->getPosition(m_mobilityIndex);
         heartbeatCycle(current, m_simPos);
     }
 
@@ -55,7 +72,11 @@ void RlsUdpTask::onLoop()
     InetAddress peerAddress;
 
     int size = m_server->Receive(buffer, BUFFER_SIZE, RECEIVE_TIMEOUT, peerAddress);
-    if (size > 0)
+    if (size > 0 && buffer[0] == rls::COMPACT_DATA_INDICATOR)
+    {
+        receiveCompactData(peerAddress, OctetView{buffer, static_cast<size_t>(size)});
+    }
+    else if (size > 0)
     {
         auto rlsMsg = rls::DecodeRlsMessage(OctetView{buffer, static_cast<size_t>(size)});
         if (rlsMsg == nullptr)
@@ -78,12 +99,24 @@ void RlsUdpTask::sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg)
     m_server->Send(addr, stream.data(), static_cast<size_t>(stream.length()));
 }
 
+void RlsUdpTask::sendCompactData(const InetAddress &addr, uint32_t handle, const rls::RlsPduTransmission &msg)
+{
+    uint8_t header[rls::COMPACT_HEADER_MAX_SIZE];
+    size_t headerSize = rls::EncodeCompactDataHeader(msg, handle, header);
+
+    m_server->Send(addr, header, headerSize, msg.pdu.data(), static_cast<size_t>(msg.pdu.length()));
+}
+
 void RlsUdpTask::send(int cellId, const rls::RlsMessage &msg)
 {
     if (m_cellIdToSti.count(cellId))
     {
         auto sti = m_cellIdToSti[cellId];
-        sendRlsPdu(m_cells[sti].address, msg);
+        auto &cell = m_cells[sti];
+        if (cell.peerHandle != 0 && rls::IsCompactFramingApplicable(msg))
+            sendCompactData(cell.address, cell.peerHandle, (const rls::RlsPduTransmission &)msg);
+        else
+            sendRlsPdu(cell.address, msg);
     }
 }
 
@@ -91,6 +124,14 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
 {
     if (msg->msgType == rls::EMessageType::HEARTBEAT_ACK)
     {
+        updateRadioEnvironment(addr, (const rls::RlsHeartBeatAck &)*msg);
+
+        if (((const rls::RlsHeartBeatAck &)*msg).dbm == rls::OUT_OF_RANGE_DBM)
+        {
+            // The cell only tells its position and range, it is not detected
+            return;
+        }
+
         if (!m_cells.count(msg->sti))
         {
             m_cells[msg->sti].cellId = ++m_cellIdCounter;
@@ -106,6 +147,7 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
 
         int newDbm = ((const rls::RlsHeartBeatAck &)*msg).dbm;
         m_cells[msg->sti].dbm = newDbm;
+        m_cells[msg->sti].peerHandle = ((const rls::RlsHeartBeatAck &)*msg).handle;
 
         if (oldDbm != newDbm)
             onSignalChangeOrLost(m_cells[msg->sti].cellId);
@@ -124,6 +166,35 @@ void RlsUdpTask::receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::Rls
     m_ctlTask->push(w);
 }
 
+void RlsUdpTask::receiveCompactData(const InetAddress &addr, const OctetView &stream)
+{
+    uint32_t handle;
+    if (!rls::DecodeCompactDataHandle(stream, handle))
+    {
+        m_logger->err("Unable to decode RLS message");
+        return;
+    }
+
+    auto it = m_cellIdToSti.find(static_cast<int>(handle));
+    if (it == m_cellIdToSti.end() || m_cells[it->second].address != addr)
+    {
+        // Unknown or stale handle, ignore the message
+        return;
+    }
+
+    auto rlsMsg = rls::DecodeCompactData(stream, it->second);
+    if (rlsMsg == nullptr)
+    {
+        m_logger->err("Unable to decode RLS message");
+        return;
+    }
+
+    auto *w = new NmUeRlsToRls(NmUeRlsToRls::RECEIVE_RLS_MESSAGE);
+    w->cellId = it->first;
+    w->msg = std::move(rlsMsg);
+    m_ctlTask->push(w);
+}
+
 void RlsUdpTask::onSignalChangeOrLost(int cellId)
 {
     int dbm = INT32_MIN;
@@ -159,14 +230,49 @@ void RlsUdpTask::heartbeatCycle(uint64_t time, const Vector3 &simPos)
     for (auto cell : toRemove)
         onSignalChangeOrLost(cell.second);
 
-    for (auto &addr : m_searchSpace)
+    // Only the cells in range and the cells to be probed are considered, instead of the whole search space
+    m_hbTargets.clear();
+    m_hbSent.assign(m_searchSpace.size(), false);
+    m_radioEnv->findHeartbeatTargets(simPos, m_searchCells, static_cast<int64_t>(time), m_hbTargets);
+
+    for (int target : m_hbTargets)
     {
+        auto it = m_cellToSearch.find(target);
+        if (it == m_cellToSearch.end() || m_hbSent[it->second])
+            continue;
+        m_hbSent[it->second] = true;
+
+        auto &addr = m_searchSpace[it->second];
+
         rls::RlsHeartBeat msg{m_shCtx->sti};
         msg.simPos = simPos;
+
+        // Let the cell know its handle, so that it can use compact framing
+        for (auto &cell : m_cells)
+        {
+            if (cell.second.address == addr)
+            {
+                msg.handle = static_cast<uint32_t>(cell.second.cellId);
+                break;
+            }
+        }
+
         sendRlsPdu(addr, msg);
     }
 }
 
+void RlsUdpTask::updateRadioEnvironment(const InetAddress &addr, const rls::RlsHeartBeatAck &msg)
+{
+    for (size_t i = 0; i < m_searchSpace.size(); i++)
+    {
+        if (m_searchSpace[i] == addr)
+        {
+            m_radioEnv->updateCell(m_searchCells[i], msg.simPos, msg.range, utils::CurrentTimeMillis());
+            break;
+        }
+    }
+}
+
 void RlsUdpTask::initialize(NtsTask *ctlTask)
 {
     m_ctlTask = ctlTask;
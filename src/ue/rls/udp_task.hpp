@@ -12,6 +12,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include <lib/rls/mobility.hpp>
+#include <lib/rls/radio_env.hpp>
 #include <lib/rls/rls_pdu.hpp>
 #include <lib/udp/server.hpp>
 #include <ue/types.hpp>
@@ -29,6 +31,7 @@ class RlsUdpTask : public NtsTask
         int64_t lastSeen{};
         int dbm{};
         int cellId{};
+        uint32_t peerHandle{}; // Handle of this UE at the cell, used for compact framing
     };
 
   private:
@@ -37,10 +40,17 @@ class RlsUdpTask : public NtsTask
     NtsTask *m_ctlTask;
     RlsSharedContext* m_shCtx;
     std::vector<InetAddress> m_searchSpace;
+    rls::RadioEnvironment *m_radioEnv;
+    std::vector<int> m_searchCells;                  // Radio environment indices of the search space
+    std::unordered_map<int, size_t> m_cellToSearch; // Radio environment index to search space index
+    std::vector<int> m_hbTargets;
+    std::vector<bool> m_hbSent;
     std::unordered_map<uint64_t, CellInfo> m_cells;
     std::unordered_map<int, uint64_t> m_cellIdToSti;
     int64_t m_lastLoop;
     Vector3 m_simPos;
+    rls::MobilityEngine *m_mobility;
+    int m_mobilityIndex;
     int m_cellIdCounter;
 
     friend class UeCmdHandler;
@@ -56,9 +66,12 @@ class RlsUdpTask : public NtsTask
 
   private:
     void sendRlsPdu(const InetAddress &addr, const rls::RlsMessage &msg);
+    void sendCompactData(const InetAddress &addr, uint32_t handle, const rls::RlsPduTransmission &msg);
     void receiveRlsPdu(const InetAddress &addr, std::unique_ptr<rls::RlsMessage> &&msg);
+    void receiveCompactData(const InetAddress &addr, const OctetView &stream);
     void onSignalChangeOrLost(int cellId);
     void heartbeatCycle(uint64_t time, const Vector3 &simPos);
+    void updateRadioEnvironment(const InetAddress &addr, const rls::RlsHeartBeatAck &msg);
 
   public:
     void initialize(NtsTask *ctlTask);
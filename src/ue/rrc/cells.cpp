@@ -99,6 +99,9 @@ void UeRrcTask::updateAvailablePlmns()
     });
 
     m_base->nasTask->push(new NmUeRrcToNas(NmUeRrcToNas::NAS_NOTIFY));
+
+    // The set of cells or their system information changed, cell selection is performed without waiting the cycle
+    triggerCycle();
 }
 
 } // namespace nr::ue
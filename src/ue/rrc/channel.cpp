@@ -16,6 +16,16 @@
 #include <asn/rrc/ASN_RRC_UL-CCCH-Message.h>
 #include <asn/rrc/ASN_RRC_UL-DCCH-Message.h>
 
+/* Index of the message among the alternatives of 'c1', which is the first alternative of the message type of every
+ * channel, or zero if the message is an extension */
+template <typename T>
+static int MessageChoice(const T &msg)
+{
+    if (static_cast<int>(msg.message.present) != 1 || msg.message.choice.c1 == nullptr)
+        return 0;
+    return static_cast<int>(msg.message.choice.c1->present);
+}
+
 namespace nr::ue
 {
 
@@ -24,6 +34,9 @@ void UeRrcTask::handleDownlinkRrc(int cellId, rrc::RrcChannel channel, const Oct
     if (!hasSignalToCell(cellId))
         return;
 
+    // The received PDU, and the responses built by the handlers are all released at the end of this function
+    asn::ArenaScope arenaScope{m_asnArena};
+
     switch (channel)
     {
     case rrc::RrcChannel::BCCH_BCH: {
@@ -93,6 +106,8 @@ void UeRrcTask::sendRrcMessage(int cellId, ASN_RRC_UL_CCCH_Message *msg)
         return;
     }
 
+    m_base->trace->record(ETraceEvent::RRC_SENT, static_cast<int>(rrc::RrcChannel::UL_CCCH), MessageChoice(*msg));
+
     auto *m = new NmUeRrcToRls(NmUeRrcToRls::RRC_PDU_DELIVERY);
     m->cellId = cellId;
     m->channel = rrc::RrcChannel::UL_CCCH;
@@ -109,6 +124,8 @@ void UeRrcTask::sendRrcMessage(int cellId, ASN_RRC_UL_CCCH1_Message *msg)
         return;
     }
 
+    m_base->trace->record(ETraceEvent::RRC_SENT, static_cast<int>(rrc::RrcChannel::UL_CCCH1), MessageChoice(*msg));
+
     auto *m = new NmUeRrcToRls(NmUeRrcToRls::RRC_PDU_DELIVERY);
     m->cellId = cellId;
     m->channel = rrc::RrcChannel::UL_CCCH1;
@@ -125,6 +142,8 @@ void UeRrcTask::sendRrcMessage(ASN_RRC_UL_DCCH_Message *msg)
         return;
     }
 
+    m_base->trace->record(ETraceEvent::RRC_SENT, static_cast<int>(rrc::RrcChannel::UL_DCCH), MessageChoice(*msg));
+
     auto *m = new NmUeRrcToRls(NmUeRrcToRls::RRC_PDU_DELIVERY);
     m->cellId = m_base->shCtx.currentCell.get<int>([](auto &value) { return value.cellId; });
     m->channel = rrc::RrcChannel::UL_DCCH;
@@ -156,6 +175,8 @@ void UeRrcTask::receiveRrcMessage(int cellId, ASN_RRC_BCCH_DL_SCH_Message *msg)
 
 void UeRrcTask::receiveRrcMessage(int cellId, ASN_RRC_DL_CCCH_Message *msg)
 {
+    m_base->trace->record(ETraceEvent::RRC_RECEIVED, static_cast<int>(rrc::RrcChannel::DL_CCCH), MessageChoice(*msg));
+
     if (msg->message.present != ASN_RRC_DL_CCCH_MessageType_PR_c1)
         return;
 
@@ -175,6 +196,8 @@ void UeRrcTask::receiveRrcMessage(int cellId, ASN_RRC_DL_CCCH_Message *msg)
 
 void UeRrcTask::receiveRrcMessage(ASN_RRC_DL_DCCH_Message *msg)
 {
+    m_base->trace->record(ETraceEvent::RRC_RECEIVED, static_cast<int>(rrc::RrcChannel::DL_DCCH), MessageChoice(*msg));
+
     if (msg->message.present != ASN_RRC_DL_DCCH_MessageType_PR_c1)
         return;
 
@@ -194,6 +217,8 @@ void UeRrcTask::receiveRrcMessage(ASN_RRC_DL_DCCH_Message *msg)
 
 void UeRrcTask::receiveRrcMessage(ASN_RRC_PCCH_Message *msg)
 {
+    m_base->trace->record(ETraceEvent::RRC_RECEIVED, static_cast<int>(rrc::RrcChannel::PCCH), MessageChoice(*msg));
+
     if (msg->message.present != ASN_RRC_PCCH_MessageType_PR_c1)
         return;
 
@@ -11,6 +11,7 @@
 #include <lib/rrc/encode.hpp>
 #include <ue/nas/task.hpp>
 #include <ue/nts.hpp>
+#include <utils/metrics.hpp>
 
 #include <asn/rrc/ASN_RRC_RRCSetup-IEs.h>
 #include <asn/rrc/ASN_RRC_RRCSetup.h>
@@ -19,6 +20,11 @@
 #include <asn/rrc/ASN_RRC_RRCSetupRequest-IEs.h>
 #include <asn/rrc/ASN_RRC_RRCSetupRequest.h>
 
+static auto &g_establishmentSuccess = metrics::Registry::Instance().counter(
+    "rrc_connection_establishments_total", "RRC connection establishments of the UEs", "result=\"success\"");
+static auto &g_establishmentFailure = metrics::Registry::Instance().counter(
+    "rrc_connection_establishments_total", "RRC connection establishments of the UEs", "result=\"failure\"");
+
 namespace nr::ue
 {
 
@@ -57,6 +63,8 @@ void UeRrcTask::startConnectionEstablishment(OctetString &&nasPdu)
 
     if (m_initialId.present == ASN_RRC_InitialUE_Identity_PR_NOTHING)
     {
+        // Kept for the whole lifetime of the task
+        asn::ArenaScope heapScope{nullptr};
         m_initialId.present = ASN_RRC_InitialUE_Identity_PR_randomValue;
         asn::SetBitStringLong<39>(static_cast<int64_t>(utils::Random64()), m_initialId.choice.randomValue);
     }
@@ -99,6 +107,7 @@ void UeRrcTask::receiveRrcSetup(int cellId, const ASN_RRC_RRCSetup &msg)
     sendRrcMessage(pdu);
 
     m_logger->info("RRC connection established");
+    g_establishmentSuccess.inc();
     switchState(ERrcState::RRC_CONNECTED);
     m_base->nasTask->push(new NmUeRrcToNas(NmUeRrcToNas::RRC_CONNECTION_SETUP));
 }
@@ -122,6 +131,7 @@ void UeRrcTask::receiveRrcRelease(const ASN_RRC_RRCRelease &msg)
 
 void UeRrcTask::handleEstablishmentFailure()
 {
+    g_establishmentFailure.inc();
     m_base->nasTask->push(new NmUeRrcToNas(NmUeRrcToNas::RRC_ESTABLISHMENT_FAILURE));
 }
 
@@ -11,6 +11,10 @@
 #include <lib/rrc/encode.hpp>
 #include <ue/nas/task.hpp>
 #include <ue/nts.hpp>
+#include <utils/metrics.hpp>
+
+static auto &g_radioLinkFailures =
+    metrics::Registry::Instance().counter("rrc_radio_link_failures_total", "Radio link failures detected by the UEs");
 
 namespace nr::ue
 {
@@ -22,6 +26,10 @@ void UeRrcTask::declareRadioLinkFailure(rls::ERlfCause cause)
 
 void UeRrcTask::handleRadioLinkFailure(rls::ERlfCause cause)
 {
+    g_radioLinkFailures.inc();
+    m_base->trace->record(ETraceEvent::RRC_STATE, static_cast<int>(m_state), static_cast<int>(ERrcState::RRC_IDLE));
+    m_base->trace->recordFailure(ETraceFailure::RADIO_LINK, static_cast<int>(cause));
+
     m_state = ERrcState::RRC_IDLE;
     m_base->nasTask->push(new NmUeRrcToNas(NmUeRrcToNas::RADIO_LINK_FAILURE));
 }
@@ -24,9 +24,9 @@ void UeRrcTask::performCellSelection()
 
     int64_t currentTime = utils::CurrentTimeMillis();
 
-    if (currentTime - m_startedTime <= 1000LL && m_cellDesc.empty())
-        return;
-    if (currentTime - m_startedTime <= 4000LL && !m_base->shCtx.selectedPlmn.get().hasValue())
+    // Cell selection is triggered as soon as a cell, its system information or a selected PLMN arrives. Only the
+    // fallback to an acceptable cell waits for a while after switch on, so that NAS has the chance to select a PLMN.
+    if (currentTime - m_startedTime < STARTUP_SELECTION_GRACE && !m_base->shCtx.selectedPlmn.get().hasValue())
         return;
 
     auto lastCell = m_base->shCtx.currentCell.get();
@@ -18,6 +18,11 @@ namespace nr::ue
 
 void UeRrcTask::triggerCycle()
 {
+    // Multiple events in a row (e.g. MIB and SIB1 of several cells) are handled with a single cycle
+    if (m_cycleTriggered)
+        return;
+    m_cycleTriggered = true;
+
     push(new NmUeRrcToRrc(NmUeRrcToRrc::TRIGGER_CYCLE));
 }
 
@@ -42,6 +47,7 @@ void UeRrcTask::switchState(ERrcState state)
     m_state = state;
 
     m_logger->info("UE switches to state [%s]", ToJson(state).str().c_str());
+    m_base->trace->record(ETraceEvent::RRC_STATE, static_cast<int>(oldState), static_cast<int>(state));
 
     if (m_base->nodeListener)
     {
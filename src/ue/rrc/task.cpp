@@ -18,7 +18,8 @@
 #include <utils/common.hpp>
 
 static constexpr const int TIMER_ID_MACHINE_CYCLE = 1;
-static constexpr const int TIMER_PERIOD_MACHINE_CYCLE = 2500;
+static constexpr const int TIMER_ID_STARTUP_GRACE = 2;
+static constexpr const int TIMER_PERIOD_MACHINE_CYCLE = 5000; // Safety net only, the cycle is triggered by the events
 
 namespace nr::ue
 {
@@ -37,6 +38,7 @@ void UeRrcTask::onStart()
     triggerCycle();
 
     setTimer(TIMER_ID_MACHINE_CYCLE, TIMER_PERIOD_MACHINE_CYCLE);
+    setTimer(TIMER_ID_STARTUP_GRACE, STARTUP_SELECTION_GRACE);
 }
 
 void UeRrcTask::onQuit()
@@ -65,6 +67,7 @@ void UeRrcTask::onLoop()
         switch (w->present)
         {
         case NmUeRrcToRrc::TRIGGER_CYCLE:
+            m_cycleTriggered = false;
             performCycle();
             break;
         }
@@ -77,6 +80,10 @@ void UeRrcTask::onLoop()
             setTimer(TIMER_ID_MACHINE_CYCLE, TIMER_PERIOD_MACHINE_CYCLE);
             performCycle();
         }
+        else if (w->timerId == TIMER_ID_STARTUP_GRACE)
+        {
+            performCycle();
+        }
         break;
     }
     default:
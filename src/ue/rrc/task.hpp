@@ -14,6 +14,7 @@
 #include <vector>
 
 #include <ue/nts.hpp>
+#include <lib/asn/arena.hpp>
 #include <ue/types.hpp>
 #include <utils/logger.hpp>
 #include <utils/nts.hpp>
@@ -47,13 +48,19 @@ namespace nr::ue
 
 class UeRrcTask : public NtsTask
 {
+  private:
+    // Duration after switch on, in which only suitable cells are selected
+    static constexpr const int64_t STARTUP_SELECTION_GRACE = 4000LL;
+
   private:
     TaskBase *m_base;
     std::unique_ptr<Logger> m_logger;
 
     int64_t m_startedTime;
+    bool m_cycleTriggered{};
     ERrcState m_state;
     RrcTimers m_timers;
+    asn::Arena m_asnArena{}; // Received PDUs and the PDUs built while handling them
 
     /* Cell and PLMN related */
     std::unordered_map<int, UeCellDesc> m_cellDesc{};
@@ -0,0 +1,161 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "snapshot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utils/libc_error.hpp>
+
+static constexpr const char SNAPSHOT_MAGIC[8] = {'U', 'E', 'R', 'S', 'N', 'A', 'P', '\0'};
+static constexpr const size_t HEADER_SIZE = 64;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t slotSize;
+    uint32_t recordSize;
+    uint32_t slotCount;
+};
+
+static_assert(sizeof(FileHeader) <= HEADER_SIZE);
+
+static bool IsCompatible(const FileHeader &header, size_t fileSize)
+{
+    return std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+           header.version == nr::ue::StateSnapshot::VERSION &&
+           header.slotSize == nr::ue::StateSnapshot::SLOT_SIZE && header.recordSize == sizeof(nr::ue::UeStateRecord) &&
+           fileSize == HEADER_SIZE + static_cast<size_t>(header.slotCount) * nr::ue::StateSnapshot::SLOT_SIZE;
+}
+
+namespace nr::ue
+{
+
+StateSnapshot::StateSnapshot(const std::string &path, int slotCount)
+    : m_fd{-1}, m_data{}, m_size{}, m_slotCount{slotCount}
+{
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0)
+        throw LibError("State snapshot could not be opened: " + path, errno);
+
+    struct stat st = {};
+    if (::fstat(m_fd, &st) < 0)
+    {
+        int err = errno;
+        ::close(m_fd);
+        throw LibError("State snapshot could not be opened: " + path, err);
+    }
+
+    FileHeader header{};
+    bool compatible = static_cast<size_t>(st.st_size) >= HEADER_SIZE &&
+                      ::pread(m_fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                      IsCompatible(header, static_cast<size_t>(st.st_size));
+
+    // The slots of an existing file are kept, even if it was written by a process with more UEs
+    uint32_t totalSlots = static_cast<uint32_t>(slotCount);
+    if (compatible)
+        totalSlots = std::max(totalSlots, header.slotCount);
+    else if (::ftruncate(m_fd, 0) < 0)
+    {
+        int err = errno;
+        ::close(m_fd);
+        throw LibError("State snapshot could not be reset: " + path, err);
+    }
+
+    m_size = HEADER_SIZE + static_cast<size_t>(totalSlots) * SLOT_SIZE;
+    if (::ftruncate(m_fd, static_cast<off_t>(m_size)) < 0)
+    {
+        int err = errno;
+        ::close(m_fd);
+        throw LibError("State snapshot could not be resized: " + path, err);
+    }
+
+    void *data = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        int err = errno;
+        ::close(m_fd);
+        throw LibError("State snapshot could not be mapped: " + path, err);
+    }
+    m_data = static_cast<uint8_t *>(data);
+
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = VERSION;
+    header.slotSize = SLOT_SIZE;
+    header.recordSize = sizeof(UeStateRecord);
+    header.slotCount = totalSlots;
+    std::memcpy(m_data, &header, sizeof(header));
+}
+
+StateSnapshot::~StateSnapshot()
+{
+    sync();
+    ::munmap(m_data, m_size);
+    ::close(m_fd);
+}
+
+uint8_t *StateSnapshot::slot(int index) const
+{
+    if (index < 0 || index >= m_slotCount)
+        return nullptr;
+    return m_data + HEADER_SIZE + static_cast<size_t>(index) * SLOT_SIZE;
+}
+
+bool StateSnapshot::load(int index, const std::string &nodeName, UeStateRecord &record) const
+{
+    uint8_t *ptr = slot(index);
+    if (ptr == nullptr)
+        return false;
+
+    uint64_t sequence;
+    std::memcpy(&sequence, ptr, sizeof(sequence));
+    if (sequence == 0 || sequence % 2 != 0)
+        return false;
+
+    std::memcpy(&record, ptr + sizeof(sequence), sizeof(record));
+    record.nodeName[UeStateRecord::NODE_NAME_SIZE - 1] = '\0';
+    return nodeName == record.nodeName;
+}
+
+void StateSnapshot::store(int index, const UeStateRecord &record)
+{
+    uint8_t *ptr = slot(index);
+    if (ptr == nullptr)
+        return;
+
+    uint64_t sequence;
+    std::memcpy(&sequence, ptr, sizeof(sequence));
+
+    // Odd sequence number marks the slot as being written until the record is copied completely
+    sequence += sequence % 2 == 0 ? 1 : 2;
+    std::memcpy(ptr, &sequence, sizeof(sequence));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(ptr + sizeof(sequence), &record, sizeof(record));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    sequence++;
+    std::memcpy(ptr, &sequence, sizeof(sequence));
+}
+
+void StateSnapshot::sync()
+{
+    if (m_data != nullptr)
+        ::msync(m_data, m_size, MS_SYNC);
+}
+
+} // namespace nr::ue
@@ -0,0 +1,101 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace nr::ue
+{
+
+/* Fixed layout of the NAS state of a UE in a snapshot slot, all the integers are in host byte order */
+struct UeStateRecord
+{
+    static constexpr const uint8_t FLAG_REGISTERED = 0b01;
+
+    static constexpr const size_t NODE_NAME_SIZE = 64;
+    static constexpr const size_t SQN_COUNT = 32;
+
+    char nodeName[NODE_NAME_SIZE];
+    uint8_t flags;
+    uint8_t uState;
+    uint8_t gutiAmfRegionId;
+    uint8_t gutiAmfPointer;
+    uint16_t gutiAmfSetId;
+    uint16_t gutiMcc;
+    uint16_t gutiMnc;
+    uint8_t gutiLongMnc;
+    uint8_t taiLongMnc;
+    uint32_t gutiTmsi;
+    uint16_t taiMcc;
+    uint16_t taiMnc;
+    int32_t tac;
+
+    /* Current NAS security context */
+    uint8_t tsc;
+    uint8_t ngKsi;
+    uint8_t integrity;
+    uint8_t ciphering;
+    uint16_t uplinkOverflow;
+    uint16_t downlinkOverflow;
+    uint8_t uplinkSqn;
+    uint8_t downlinkSqn;
+    uint8_t abbaLength;
+    uint8_t abba[8];
+    uint8_t kAusf[32];
+    uint8_t kSeaf[32];
+    uint8_t kAmf[32];
+    uint8_t kNasInt[16];
+    uint8_t kNasEnc[16];
+
+    uint64_t sqn[SQN_COUNT];
+};
+
+/**
+ * Memory mapped file keeping the NAS state of all the UEs of the process, so that the UEs can resume with their stored
+ * 5G-GUTI and NAS security context after a restart instead of performing initial registration.
+ * <p>
+ * The file consists of a versioned header and a fixed size slot for each UE, indexed by the order of the UE in the
+ * process. Each slot is only written by the NAS task of its UE, and a slot with an odd sequence number is a partially
+ * written one (e.g. the process was killed during the write) which is ignored while loading.
+ */
+class StateSnapshot
+{
+  public:
+    static constexpr const uint32_t VERSION = 1;
+    static constexpr const size_t SLOT_SIZE = 1024;
+
+  private:
+    int m_fd;
+    uint8_t *m_data;
+    size_t m_size;
+    int m_slotCount;
+
+  public:
+    /* Throws LibError if the file cannot be created or mapped. An incompatible existing file is reset. */
+    StateSnapshot(const std::string &path, int slotCount);
+    ~StateSnapshot();
+
+  public:
+    /* Returns false if the slot is empty, partially written or belongs to another node */
+    bool load(int index, const std::string &nodeName, UeStateRecord &record) const;
+    void store(int index, const UeStateRecord &record);
+    /* Writes the dirty pages to the file synchronously */
+    void sync();
+
+  private:
+    uint8_t *slot(int index) const;
+};
+
+static_assert(std::is_trivially_copyable<UeStateRecord>::value);
+static_assert(sizeof(UeStateRecord) + sizeof(uint64_t) <= StateSnapshot::SLOT_SIZE);
+
+} // namespace nr::ue
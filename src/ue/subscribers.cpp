@@ -0,0 +1,296 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "subscribers.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utils/libc_error.hpp>
+
+static constexpr const size_t MIN_CHUNK_SIZE = 64 * 1024;
+static constexpr const size_t KEY_HEX_LENGTH = 32;
+
+struct ChunkResult
+{
+    std::vector<nr::ue::SubscriberEntry> entries{};
+    size_t lineCount{};
+    size_t errorLine{}; // Zero if there is no error
+    std::string error{};
+};
+
+static std::string_view Trim(std::string_view str)
+{
+    while (!str.empty() && (str.front() == ' ' || str.front() == '\t'))
+        str.remove_prefix(1);
+    while (!str.empty() && (str.back() == ' ' || str.back() == '\t' || str.back() == '\r'))
+        str.remove_suffix(1);
+    return str;
+}
+
+static std::vector<std::string_view> Split(std::string_view str, char separator)
+{
+    std::vector<std::string_view> res{};
+    while (true)
+    {
+        size_t pos = str.find(separator);
+        res.push_back(Trim(str.substr(0, pos)));
+        if (pos == std::string_view::npos)
+            return res;
+        str.remove_prefix(pos + 1);
+    }
+}
+
+/* Parses a decimal, or a hexadecimal number with the "0x" prefix */
+static int ParseNumber(std::string_view str, int max, const char *what)
+{
+    int base = 10;
+    if (str.size() > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))
+    {
+        base = 16;
+        str.remove_prefix(2);
+    }
+    if (str.empty() || str.size() > 8)
+        throw std::runtime_error(std::string{"invalid "} + what);
+
+    int value = 0;
+    for (char c : str)
+    {
+        int digit;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (base == 16 && c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (base == 16 && c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            throw std::runtime_error(std::string{"invalid "} + what);
+        value = value * base + digit;
+    }
+
+    if (value > max)
+        throw std::runtime_error(std::string{"invalid "} + what);
+    return value;
+}
+
+static SingleSlice ParseSlice(const std::vector<std::string_view> &parts, size_t start)
+{
+    SingleSlice slice{};
+    slice.sst = ParseNumber(parts[start], 0xFF, "SST");
+    if (parts.size() > start + 1)
+        slice.sd = octet3{ParseNumber(parts[start + 1], 0xFFFFFF, "SD")};
+    return slice;
+}
+
+static NetworkSlice ParseNssai(std::string_view str)
+{
+    NetworkSlice nssai{};
+    for (auto &item : Split(str, ';'))
+    {
+        auto parts = Split(item, ':');
+        if (parts.size() > 2)
+            throw std::runtime_error("invalid S-NSSAI");
+        nssai.slices.push_back(ParseSlice(parts, 0));
+    }
+    return nssai;
+}
+
+static nr::ue::SessionConfig ParseSession(std::string_view str)
+{
+    auto parts = Split(str, ':');
+    if (parts.size() > 4)
+        throw std::runtime_error("invalid session");
+
+    nr::ue::SessionConfig session{};
+    if (parts[0] == "IPv4")
+        session.type = nas::EPduSessionType::IPV4;
+    else if (parts[0] == "IPv6")
+        session.type = nas::EPduSessionType::IPV6;
+    else if (parts[0] == "IPv4v6")
+        session.type = nas::EPduSessionType::IPV4V6;
+    else if (parts[0] == "Ethernet")
+        session.type = nas::EPduSessionType::ETHERNET;
+    else if (parts[0] == "Unstructured")
+        session.type = nas::EPduSessionType::UNSTRUCTURED;
+    else
+        throw std::runtime_error("invalid PDU session type: " + std::string{parts[0]});
+
+    if (parts.size() > 1 && !parts[1].empty())
+        session.apn = std::string{parts[1]};
+    if (parts.size() > 2)
+        session.sNssai = ParseSlice(parts, 2);
+
+    session.isEmergency = false;
+    return session;
+}
+
+static OctetString ParseKey(std::string_view str, const char *what)
+{
+    if (str.size() != KEY_HEX_LENGTH)
+        throw std::runtime_error(std::string{"invalid "} + what + ", 32 hex digits expected");
+    return OctetString::FromHex(std::string{str});
+}
+
+static nr::ue::SubscriberEntry ParseLine(std::string_view line)
+{
+    auto fields = Split(line, ',');
+    if (fields.size() > 5)
+        throw std::runtime_error("too many fields");
+    fields.resize(5);
+
+    nr::ue::SubscriberEntry entry{};
+    if (!fields[0].empty())
+    {
+        if (fields[0].size() < 5)
+            throw std::runtime_error("invalid SUPI value");
+        entry.supi = Supi::Parse(std::string{fields[0]});
+    }
+    if (!fields[1].empty())
+        entry.key = ParseKey(fields[1], "key");
+    if (!fields[2].empty())
+        entry.opC = ParseKey(fields[2], "OPc");
+    if (!fields[3].empty())
+        entry.configuredNssai = ParseNssai(fields[3]);
+    if (fields[4] == "none")
+        entry.sessions = std::make_shared<const std::vector<nr::ue::SessionConfig>>();
+    else if (!fields[4].empty())
+    {
+        std::vector<nr::ue::SessionConfig> sessions{};
+        for (auto &item : Split(fields[4], ';'))
+            sessions.push_back(ParseSession(item));
+        entry.sessions = std::make_shared<const std::vector<nr::ue::SessionConfig>>(std::move(sessions));
+    }
+    return entry;
+}
+
+static void ParseChunk(std::string_view chunk, ChunkResult &result)
+{
+    while (!chunk.empty())
+    {
+        size_t end = chunk.find('\n');
+        std::string_view line = Trim(chunk.substr(0, end));
+        chunk.remove_prefix(end == std::string_view::npos ? chunk.size() : end + 1);
+        result.lineCount++;
+
+        if (line.empty() || line[0] == '#' || line == "supi" || line.substr(0, 5) == "supi,")
+            continue;
+
+        try
+        {
+            result.entries.push_back(ParseLine(line));
+        }
+        catch (const std::runtime_error &e)
+        {
+            result.errorLine = result.lineCount;
+            result.error = e.what();
+            return;
+        }
+    }
+}
+
+namespace nr::ue
+{
+
+std::vector<SubscriberEntry> LoadSubscriberDatabase(const std::string &file)
+{
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw LibError("Subscriber database could not be opened: " + file, errno);
+
+    struct stat st = {};
+    if (::fstat(fd, &st) < 0)
+    {
+        int err = errno;
+        ::close(fd);
+        throw LibError("Subscriber database could not be opened: " + file, err);
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    if (size == 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Subscriber database is empty: " + file);
+    }
+
+    void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    ::close(fd);
+    if (data == MAP_FAILED)
+        throw LibError("Subscriber database could not be mapped: " + file, err);
+
+    std::string_view content{static_cast<const char *>(data), size};
+
+    // The chunks are split at the line boundaries, and parsed by a thread each
+    size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    size_t chunkCount = std::clamp<size_t>(size / MIN_CHUNK_SIZE, 1, threadCount);
+
+    std::vector<std::string_view> chunks{};
+    size_t start = 0;
+    for (size_t i = 1; i <= chunkCount && start < size; i++)
+    {
+        size_t end = i == chunkCount ? size : std::max(start, i * size / chunkCount);
+        if (end < size)
+        {
+            end = content.find('\n', end);
+            end = end == std::string_view::npos ? size : end + 1;
+        }
+        chunks.push_back(content.substr(start, end - start));
+        start = end;
+    }
+
+    std::vector<ChunkResult> results(chunks.size());
+    std::vector<std::thread> threads{};
+    for (size_t i = 1; i < chunks.size(); i++)
+        threads.emplace_back(ParseChunk, chunks[i], std::ref(results[i]));
+    ParseChunk(chunks[0], results[0]);
+    for (auto &thread : threads)
+        thread.join();
+
+    ::munmap(data, size);
+
+    size_t lineOffset = 0;
+    size_t total = 0;
+    for (auto &result : results)
+    {
+        if (result.errorLine != 0)
+        {
+            throw std::runtime_error("Subscriber database line " + std::to_string(lineOffset + result.errorLine) +
+                                     ": " + result.error);
+        }
+        lineOffset += result.lineCount;
+        total += result.entries.size();
+    }
+
+    std::vector<SubscriberEntry> entries{};
+    entries.reserve(total);
+    for (auto &result : results)
+        std::move(result.entries.begin(), result.entries.end(), std::back_inserter(entries));
+
+    std::unordered_set<std::string> supis{};
+    supis.reserve(total);
+    for (auto &entry : entries)
+    {
+        if (entry.supi.has_value() && !supis.insert(entry.supi->value).second)
+            throw std::runtime_error("Subscriber database contains a duplicate SUPI: imsi-" + entry.supi->value);
+    }
+
+    return entries;
+}
+
+} // namespace nr::ue
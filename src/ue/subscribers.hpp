@@ -0,0 +1,48 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <ue/types.hpp>
+#include <utils/common_types.hpp>
+#include <utils/octet_string.hpp>
+
+namespace nr::ue
+{
+
+/* Values of a subscriber, the absent ones are taken from the UE config file */
+struct SubscriberEntry
+{
+    std::optional<Supi> supi{};
+    std::optional<OctetString> key{};
+    std::optional<OctetString> opC{};
+    std::optional<NetworkSlice> configuredNssai{};
+    std::shared_ptr<const std::vector<SessionConfig>> sessions{};
+};
+
+/**
+ * Loads a subscriber database, i.e. a CSV file with a line for each UE in the following format:
+ * <p>
+ * supi,key,opc,nssai,sessions
+ * <p>
+ * e.g. "imsi-001010000000001,465B5CE8B199B49FAA5F0A2EE238A6BC,E8ED289DEBA952E4283B54E88E6183CA,1:0x000001;2,
+ * IPv4:internet:1:0x000001;IPv6:ims". The slices of the NSSAI are given as "sst[:sd]", and the sessions as
+ * "type[:apn[:sst[:sd]]]", both separated by ';'. The sessions field can be "none" for a UE without default sessions.
+ * Empty and trailing fields are taken from the config file, lines starting with '#' and the header line are ignored.
+ * <p>
+ * The file is memory mapped and its parts are parsed in parallel. Throws std::runtime_error if the file cannot be
+ * read, or a line is malformed.
+ */
+std::vector<SubscriberEntry> LoadSubscriberDatabase(const std::string &file);
+
+} // namespace nr::ue
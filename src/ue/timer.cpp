@@ -14,10 +14,17 @@
 
 UeTimer::UeTimer(int timerCode, bool isMmTimer, int defaultInterval)
     : m_code(timerCode), m_isMm(isMmTimer), m_interval(defaultInterval), m_startMillis(0), m_isRunning(false),
-      m_expiryCount(0), m_lastDebugPrintMs(0)
+      m_expiryCount(0), m_task(nullptr), m_taskTimerId(0), m_trace(nullptr)
 {
 }
 
+void UeTimer::attach(NtsTask *task, int taskTimerId, nr::ue::EventTrace *trace)
+{
+    m_task = task;
+    m_taskTimerId = taskTimerId;
+    m_trace = trace;
+}
+
 bool UeTimer::isRunning() const
 {
     return m_isRunning;
@@ -39,6 +46,8 @@ void UeTimer::start(bool clearExpiryCount)
         resetExpiryCount();
     m_startMillis = utils::CurrentTimeMillis();
     m_isRunning = true;
+
+    onStarted();
 }
 
 void UeTimer::start(const nas::IEGprsTimer2 &v, bool clearExpiryCount)
@@ -48,6 +57,8 @@ void UeTimer::start(const nas::IEGprsTimer2 &v, bool clearExpiryCount)
     m_interval = v.value;
     m_startMillis = utils::CurrentTimeMillis();
     m_isRunning = true;
+
+    onStarted();
 }
 
 void UeTimer::start(const nas::IEGprsTimer3 &v, bool clearExpiryCount)
@@ -76,6 +87,8 @@ void UeTimer::start(const nas::IEGprsTimer3 &v, bool clearExpiryCount)
     m_interval = secs;
     m_startMillis = utils::CurrentTimeMillis();
     m_isRunning = true;
+
+    onStarted();
 }
 
 void UeTimer::stop(bool clearExpiryCount)
@@ -87,30 +100,35 @@ void UeTimer::stop(bool clearExpiryCount)
     {
         m_startMillis = utils::CurrentTimeMillis();
         m_isRunning = false;
+
+        if (m_trace)
+            m_trace->record(nr::ue::ETraceEvent::TIMER_STOPPED, m_code);
     }
 }
 
 bool UeTimer::performTick()
 {
-    if (m_isRunning)
+    if (m_isRunning && utils::CurrentTimeMillis() - m_startMillis >= m_interval * 1000LL)
     {
-        long currentMs = utils::CurrentTimeMillis();
-        long deltaSec = (currentMs - m_startMillis) / 1000LL;
-        long remainingSec = m_interval - deltaSec;
-
-        if (currentMs - m_lastDebugPrintMs > 10LL * 1000LL)
-            m_lastDebugPrintMs = currentMs;
-
-        if (remainingSec <= 0LL)
-        {
-            stop(false);
-            m_expiryCount++;
-            return true;
-        }
+        m_startMillis = utils::CurrentTimeMillis();
+        m_isRunning = false;
+        m_expiryCount++;
+
+        if (m_trace)
+            m_trace->record(nr::ue::ETraceEvent::TIMER_EXPIRED, m_code, m_expiryCount);
+        return true;
     }
     return false;
 }
 
+void UeTimer::onStarted()
+{
+    if (m_task)
+        m_task->setTimer(m_taskTimerId, m_interval * 1000LL);
+    if (m_trace)
+        m_trace->record(nr::ue::ETraceEvent::TIMER_STARTED, m_code, m_interval);
+}
+
 int UeTimer::getInterval() const
 {
     return m_interval;
@@ -8,9 +8,20 @@
 
 #pragma once
 
+#include "trace.hpp"
+
 #include <lib/nas/ie4.hpp>
 #include <utils/json.hpp>
-
+#include <utils/nts.hpp>
+
+/**
+ * NAS and RRC timer with an interval in seconds.
+ * <p>
+ * A timer attached to an NTS task arms an NTS timer of the task each time it is started, so the expiry is delivered
+ * precisely by the task's timer service and an idle timer costs nothing. NTS timers cannot be cancelled, hence the
+ * owner calls performTick() upon the NTS timer expiry, which ignores the ones left over by stop() or by a restart.
+ * Starts, stops and expiries are recorded to the event trace of the UE, if attached.
+ */
 class UeTimer
 {
   private:
@@ -22,12 +33,15 @@ class UeTimer
     bool m_isRunning;
     int m_expiryCount;
 
-    long m_lastDebugPrintMs;
+    NtsTask *m_task;
+    int m_taskTimerId;
+    nr::ue::EventTrace *m_trace;
 
   public:
     UeTimer(int timerCode, bool isMmTimer, int defaultInterval);
 
   public:
+    void attach(NtsTask *task, int taskTimerId, nr::ue::EventTrace *trace);
     void start(bool clearExpiryCount = true);
     void start(const nas::IEGprsTimer2 &v, bool clearExpiryCount = true);
     void start(const nas::IEGprsTimer3 &v, bool clearExpiryCount = true);
@@ -40,6 +54,9 @@ class UeTimer
     [[nodiscard]] int getInterval() const;
     [[nodiscard]] int getRemaining() const;
     [[nodiscard]] int getExpiryCount() const;
+
+  private:
+    void onStarted();
 };
 
 Json ToJson(const UeTimer &v);
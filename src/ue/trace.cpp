@@ -0,0 +1,407 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "trace.hpp"
+
+#include <ctime>
+#include <exception>
+#include <unordered_map>
+
+#include <asn/rrc/ASN_RRC_DL-CCCH-MessageType.h>
+#include <asn/rrc/ASN_RRC_DL-DCCH-MessageType.h>
+#include <asn/rrc/ASN_RRC_PCCH-MessageType.h>
+#include <asn/rrc/ASN_RRC_UL-CCCH-MessageType.h>
+#include <asn/rrc/ASN_RRC_UL-CCCH1-MessageType.h>
+#include <asn/rrc/ASN_RRC_UL-DCCH-MessageType.h>
+#include <lib/nas/utils.hpp>
+#include <lib/rrc/rrc.hpp>
+#include <ue/types.hpp>
+#include <utils/common.hpp>
+#include <utils/io.hpp>
+#include <utils/json.hpp>
+
+namespace
+{
+
+enum ETraceLane
+{
+    LANE_RRC_STATE = 1,
+    LANE_RM_STATE,
+    LANE_CM_STATE,
+    LANE_MM_STATE,
+    LANE_U5_STATE,
+    LANE_NAS,
+    LANE_RRC,
+    LANE_TIMERS,
+    LANE_FAILURES,
+};
+
+} // namespace
+
+static const char *ChannelName(rrc::RrcChannel channel)
+{
+    switch (channel)
+    {
+    case rrc::RrcChannel::BCCH_BCH:
+        return "BCCH-BCH";
+    case rrc::RrcChannel::BCCH_DL_SCH:
+        return "BCCH-DL-SCH";
+    case rrc::RrcChannel::DL_CCCH:
+        return "DL-CCCH";
+    case rrc::RrcChannel::DL_DCCH:
+        return "DL-DCCH";
+    case rrc::RrcChannel::PCCH:
+        return "PCCH";
+    case rrc::RrcChannel::UL_CCCH:
+        return "UL-CCCH";
+    case rrc::RrcChannel::UL_CCCH1:
+        return "UL-CCCH1";
+    case rrc::RrcChannel::UL_DCCH:
+        return "UL-DCCH";
+    default:
+        return "?";
+    }
+}
+
+static std::string RrcMessageName(rrc::RrcChannel channel, int choice)
+{
+    asn_TYPE_descriptor_t *type;
+    switch (channel)
+    {
+    case rrc::RrcChannel::DL_CCCH:
+        type = &asn_DEF_ASN_RRC_DL_CCCH_MessageType;
+        break;
+    case rrc::RrcChannel::DL_DCCH:
+        type = &asn_DEF_ASN_RRC_DL_DCCH_MessageType;
+        break;
+    case rrc::RrcChannel::PCCH:
+        type = &asn_DEF_ASN_RRC_PCCH_MessageType;
+        break;
+    case rrc::RrcChannel::UL_CCCH:
+        type = &asn_DEF_ASN_RRC_UL_CCCH_MessageType;
+        break;
+    case rrc::RrcChannel::UL_CCCH1:
+        type = &asn_DEF_ASN_RRC_UL_CCCH1_MessageType;
+        break;
+    case rrc::RrcChannel::UL_DCCH:
+        type = &asn_DEF_ASN_RRC_UL_DCCH_MessageType;
+        break;
+    default:
+        return ChannelName(channel);
+    }
+
+    // The first alternative of the message type is 'c1', whose alternatives are the messages of the channel
+    auto *c1 = type->elements[0].type;
+    if (choice <= 0 || choice > static_cast<int>(c1->elements_count))
+        return ChannelName(channel);
+    return c1->elements[choice - 1].name;
+}
+
+static const char *FailureName(nr::ue::ETraceFailure failure)
+{
+    switch (failure)
+    {
+    case nr::ue::ETraceFailure::RRC_ESTABLISHMENT:
+        return "RRC establishment failure";
+    case nr::ue::ETraceFailure::RADIO_LINK:
+        return "Radio link failure";
+    case nr::ue::ETraceFailure::REGISTRATION_REJECT:
+        return "Registration reject";
+    case nr::ue::ETraceFailure::REGISTRATION_ABNORMAL:
+        return "Registration failure";
+    case nr::ue::ETraceFailure::SERVICE_REJECT:
+        return "Service reject";
+    case nr::ue::ETraceFailure::AUTHENTICATION_REJECT:
+        return "Authentication reject";
+    default:
+        return "?";
+    }
+}
+
+static std::string FailureCause(nr::ue::ETraceFailure failure, int cause)
+{
+    switch (failure)
+    {
+    case nr::ue::ETraceFailure::RADIO_LINK:
+        return static_cast<rls::ERlfCause>(cause) == rls::ERlfCause::PDU_ID_FULL ? "PDU_ID_FULL"
+                                                                                : "SIGNAL_LOST_TO_CONNECTED_CELL";
+    case nr::ue::ETraceFailure::REGISTRATION_REJECT:
+    case nr::ue::ETraceFailure::SERVICE_REJECT:
+        return nas::utils::EnumToString(static_cast<nas::EMmCause>(cause));
+    case nr::ue::ETraceFailure::REGISTRATION_ABNORMAL:
+        return nas::utils::EnumToString(static_cast<nas::ERegistrationType>(cause));
+    default:
+        return "";
+    }
+}
+
+/* Name of the state switched to, or of the message, timer or failure */
+static std::string EventName(const nr::ue::TraceEvent &event)
+{
+    using nr::ue::ETraceEvent;
+
+    switch (event.type)
+    {
+    case ETraceEvent::RM_STATE:
+        return ToJson(static_cast<nr::ue::ERmState>(event.b)).str();
+    case ETraceEvent::CM_STATE:
+        return ToJson(static_cast<nr::ue::ECmState>(event.b)).str();
+    case ETraceEvent::MM_STATE:
+        return ToJson(static_cast<nr::ue::EMmSubState>(event.b)).str();
+    case ETraceEvent::U5_STATE:
+        return ToJson(static_cast<nr::ue::E5UState>(event.b)).str();
+    case ETraceEvent::RRC_STATE:
+        return ToJson(static_cast<nr::ue::ERrcState>(event.b)).str();
+    case ETraceEvent::NAS_SENT:
+    case ETraceEvent::NAS_RECEIVED:
+        return nas::utils::EnumToString(static_cast<nas::EMessageType>(event.a));
+    case ETraceEvent::RRC_SENT:
+    case ETraceEvent::RRC_RECEIVED:
+        return RrcMessageName(static_cast<rrc::RrcChannel>(event.a), event.b);
+    case ETraceEvent::TIMER_STARTED:
+    case ETraceEvent::TIMER_STOPPED:
+    case ETraceEvent::TIMER_EXPIRED:
+        return "T" + std::to_string(event.a);
+    case ETraceEvent::FAILURE:
+        return FailureName(static_cast<nr::ue::ETraceFailure>(event.a));
+    default:
+        return "?";
+    }
+}
+
+static std::string OldStateName(const nr::ue::TraceEvent &event)
+{
+    nr::ue::TraceEvent old = event;
+    old.b = event.a;
+    return EventName(old);
+}
+
+static Json ChromeEvent(const std::string &name, const std::string &phase, int lane, int64_t time)
+{
+    return Json::Obj({
+        {"name", name},
+        {"ph", phase},
+        {"pid", 1},
+        {"tid", lane},
+        {"ts", time},
+    });
+}
+
+static Json ChromeSlice(const std::string &name, int lane, int64_t start, int64_t end)
+{
+    Json json = ChromeEvent(name, "X", lane, start);
+    json.put("dur", std::max(end - start, static_cast<int64_t>(1)));
+    return json;
+}
+
+static Json ChromeInstant(const std::string &name, int lane, int64_t time, Json args)
+{
+    Json json = ChromeEvent(name, "i", lane, time);
+    json.put("s", "t");
+    json.put("args", std::move(args));
+    return json;
+}
+
+static Json ChromeMetadata(const std::string &kind, int lane, const std::string &name)
+{
+    return Json::Obj({
+        {"name", kind},
+        {"ph", "M"},
+        {"pid", 1},
+        {"tid", lane},
+        {"args", Json::Obj({{"name", name}})},
+    });
+}
+
+namespace nr::ue
+{
+
+EventTrace::EventTrace(std::string nodeName, std::string dumpDir)
+    : m_events{}, m_count{}, m_nodeName{std::move(nodeName)}, m_dumpDir{std::move(dumpDir)}
+{
+}
+
+void EventTrace::recordFailure(ETraceFailure failure, int cause)
+{
+    record(ETraceEvent::FAILURE, static_cast<int>(failure), cause);
+
+    if (m_dumpDir.empty())
+        return;
+
+    std::string path = m_dumpDir;
+    io::AppendPath(path, m_nodeName + "-" + std::to_string(utils::CurrentTimeMillis()) + ".json");
+    try
+    {
+        io::WriteAllText(path, TraceToChromeJson(snapshot(), m_nodeName));
+    }
+    catch (const std::exception &)
+    {
+        // The trace is a debugging aid, failing to write it must not affect the UE
+    }
+}
+
+std::vector<TraceEvent> EventTrace::snapshot() const
+{
+    uint64_t count = m_count.load(std::memory_order_relaxed);
+    uint64_t first = count > CAPACITY ? count - CAPACITY : 0;
+
+    std::vector<TraceEvent> events;
+    events.reserve(static_cast<size_t>(count - first));
+    for (uint64_t i = first; i < count; i++)
+        events.push_back(m_events[i % CAPACITY]);
+    return events;
+}
+
+std::string TraceEventToString(const TraceEvent &event)
+{
+    time_t seconds = static_cast<time_t>(event.time / 1'000'000);
+    struct tm tm
+    {
+    };
+    localtime_r(&seconds, &tm);
+
+    char time[32];
+    size_t n = strftime(time, sizeof(time), "%H:%M:%S", &tm);
+    snprintf(time + n, sizeof(time) - n, ".%06d", static_cast<int>(event.time % 1'000'000));
+
+    std::string name = EventName(event);
+    std::string text;
+
+    switch (event.type)
+    {
+    case ETraceEvent::RM_STATE:
+    case ETraceEvent::CM_STATE:
+    case ETraceEvent::MM_STATE:
+    case ETraceEvent::U5_STATE:
+    case ETraceEvent::RRC_STATE:
+        text = "state [" + OldStateName(event) + "] -> [" + name + "]";
+        break;
+    case ETraceEvent::NAS_SENT:
+        text = "NAS sent [" + name + "]";
+        break;
+    case ETraceEvent::NAS_RECEIVED:
+        text = "NAS received [" + name + "]";
+        break;
+    case ETraceEvent::RRC_SENT:
+        text = "RRC sent [" + name + "] on " + ChannelName(static_cast<rrc::RrcChannel>(event.a));
+        break;
+    case ETraceEvent::RRC_RECEIVED:
+        text = "RRC received [" + name + "] on " + ChannelName(static_cast<rrc::RrcChannel>(event.a));
+        break;
+    case ETraceEvent::TIMER_STARTED:
+        text = "timer " + name + " started for " + std::to_string(event.b) + "s";
+        break;
+    case ETraceEvent::TIMER_STOPPED:
+        text = "timer " + name + " stopped";
+        break;
+    case ETraceEvent::TIMER_EXPIRED:
+        text = "timer " + name + " expired, count " + std::to_string(event.b);
+        break;
+    case ETraceEvent::FAILURE: {
+        std::string cause = FailureCause(static_cast<ETraceFailure>(event.a), event.b);
+        text = name + (cause.empty() ? "" : " [" + cause + "]");
+        break;
+    }
+    }
+
+    return std::string{time} + " " + text;
+}
+
+std::string TraceToChromeJson(const std::vector<TraceEvent> &events, const std::string &nodeName)
+{
+    Json list = Json::Arr({});
+    list.push(Json::Obj({
+        {"name", "process_name"},
+        {"ph", "M"},
+        {"pid", 1},
+        {"args", Json::Obj({{"name", nodeName}})},
+    }));
+    list.push(ChromeMetadata("thread_name", LANE_RRC_STATE, "RRC state"));
+    list.push(ChromeMetadata("thread_name", LANE_RM_STATE, "RM state"));
+    list.push(ChromeMetadata("thread_name", LANE_CM_STATE, "CM state"));
+    list.push(ChromeMetadata("thread_name", LANE_MM_STATE, "MM state"));
+    list.push(ChromeMetadata("thread_name", LANE_U5_STATE, "5U state"));
+    list.push(ChromeMetadata("thread_name", LANE_NAS, "NAS messages"));
+    list.push(ChromeMetadata("thread_name", LANE_RRC, "RRC messages"));
+    list.push(ChromeMetadata("thread_name", LANE_TIMERS, "Timers"));
+    list.push(ChromeMetadata("thread_name", LANE_FAILURES, "Failures"));
+
+    if (events.empty())
+        return Json::Obj({{"traceEvents", list}}).dumpJson();
+
+    int64_t endTime = events.back().time;
+
+    // States are shown as slices lasting until the next switch, and timers as slices from the start to the end
+    std::unordered_map<int, std::pair<int64_t, std::string>> openStates{};
+    std::unordered_map<int, int64_t> openTimers{};
+
+    for (auto &event : events)
+    {
+        std::string name = EventName(event);
+
+        switch (event.type)
+        {
+        case ETraceEvent::RM_STATE:
+        case ETraceEvent::CM_STATE:
+        case ETraceEvent::MM_STATE:
+        case ETraceEvent::U5_STATE:
+        case ETraceEvent::RRC_STATE: {
+            int lane = event.type == ETraceEvent::RM_STATE   ? LANE_RM_STATE
+                       : event.type == ETraceEvent::CM_STATE ? LANE_CM_STATE
+                       : event.type == ETraceEvent::MM_STATE ? LANE_MM_STATE
+                       : event.type == ETraceEvent::U5_STATE ? LANE_U5_STATE
+                                                             : LANE_RRC_STATE;
+            auto it = openStates.find(lane);
+            if (it != openStates.end())
+                list.push(ChromeSlice(it->second.second, lane, it->second.first, event.time));
+            openStates[lane] = {event.time, name};
+            break;
+        }
+        case ETraceEvent::NAS_SENT:
+        case ETraceEvent::NAS_RECEIVED:
+            list.push(ChromeInstant(name, LANE_NAS, event.time,
+                                    Json::Obj({{"direction", std::string{event.type == ETraceEvent::NAS_SENT ? "uplink"
+                                                                                                              : "downlink"}}})));
+            break;
+        case ETraceEvent::RRC_SENT:
+        case ETraceEvent::RRC_RECEIVED:
+            list.push(ChromeInstant(name, LANE_RRC, event.time,
+                                    Json::Obj({{"channel", std::string{ChannelName(static_cast<rrc::RrcChannel>(event.a))}}})));
+            break;
+        case ETraceEvent::TIMER_STARTED:
+        case ETraceEvent::TIMER_STOPPED:
+        case ETraceEvent::TIMER_EXPIRED: {
+            auto it = openTimers.find(event.a);
+            if (it != openTimers.end())
+            {
+                list.push(ChromeSlice(name, LANE_TIMERS, it->second, event.time));
+                openTimers.erase(it);
+            }
+            if (event.type == ETraceEvent::TIMER_STARTED)
+                openTimers[event.a] = event.time;
+            else if (event.type == ETraceEvent::TIMER_EXPIRED)
+                list.push(ChromeInstant(name + " expired", LANE_TIMERS, event.time, Json::Obj({})));
+            break;
+        }
+        case ETraceEvent::FAILURE:
+            list.push(ChromeInstant(
+                name, LANE_FAILURES, event.time,
+                Json::Obj({{"cause", FailureCause(static_cast<ETraceFailure>(event.a), event.b)}})));
+            break;
+        }
+    }
+
+    for (auto &item : openStates)
+        list.push(ChromeSlice(item.second.second, item.first, item.second.first, endTime));
+    for (auto &item : openTimers)
+        list.push(ChromeSlice("T" + std::to_string(item.first), LANE_TIMERS, item.second, endTime));
+
+    return Json::Obj({{"traceEvents", list}}).dumpJson();
+}
+
+} // namespace nr::ue
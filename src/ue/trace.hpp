@@ -0,0 +1,104 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nr::ue
+{
+
+enum class ETraceEvent : uint8_t
+{
+    RM_STATE,      // Old and new ERmState
+    CM_STATE,      // Old and new ECmState
+    MM_STATE,      // Old and new EMmSubState
+    U5_STATE,      // Old and new E5UState
+    RRC_STATE,     // Old and new ERrcState
+    NAS_SENT,      // nas::EMessageType
+    NAS_RECEIVED,  // nas::EMessageType
+    RRC_SENT,      // rrc::RrcChannel and the message choice of the channel
+    RRC_RECEIVED,  // rrc::RrcChannel and the message choice of the channel
+    TIMER_STARTED, // Timer code and the interval in seconds
+    TIMER_STOPPED, // Timer code
+    TIMER_EXPIRED, // Timer code and the expiry count
+    FAILURE,       // ETraceFailure and the cause value if any
+};
+
+enum class ETraceFailure
+{
+    RRC_ESTABLISHMENT,
+    RADIO_LINK,
+    REGISTRATION_REJECT,
+    REGISTRATION_ABNORMAL,
+    SERVICE_REJECT,
+    AUTHENTICATION_REJECT,
+};
+
+struct TraceEvent
+{
+    int64_t time; // Microseconds since epoch
+    ETraceEvent type;
+    int a;
+    int b;
+};
+
+/**
+ * Fixed size in-memory trace of the recent events of a UE.
+ * <p>
+ * Recording only stores a few integers into the next slot of a ring, the events are converted to text only when the
+ * trace is dumped. Recording is safe from any task of the UE. Dumping is meant to be done while the tasks are paused,
+ * such as in CLI commands, otherwise the events being recorded during the dump may be seen partially.
+ */
+class EventTrace
+{
+  public:
+    static constexpr const size_t CAPACITY = 256;
+
+  private:
+    std::array<TraceEvent, CAPACITY> m_events;
+    std::atomic<uint64_t> m_count;
+    std::string m_nodeName;
+    std::string m_dumpDir;
+
+  public:
+    /* Empty dump directory disables dumping the trace on failures */
+    EventTrace(std::string nodeName, std::string dumpDir);
+
+  public:
+    inline void record(ETraceEvent type, int a = 0, int b = 0)
+    {
+        uint64_t index = m_count.fetch_add(1, std::memory_order_relaxed);
+        m_events[index % CAPACITY] = TraceEvent{CurrentTimeMicros(), type, a, b};
+    }
+
+    /* Records the failure, and writes the trace in Chrome trace format to the dump directory if any */
+    void recordFailure(ETraceFailure failure, int cause = 0);
+
+    /* Returns the events in the ring, oldest first */
+    [[nodiscard]] std::vector<TraceEvent> snapshot() const;
+
+  private:
+    static inline int64_t CurrentTimeMicros()
+    {
+        auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count();
+    }
+};
+
+std::string TraceEventToString(const TraceEvent &event);
+
+/* Converts the events to the Trace Event Format of Chrome, viewable by chrome://tracing or Perfetto */
+std::string TraceToChromeJson(const std::vector<TraceEvent> &events, const std::string &nodeName);
+
+} // namespace nr::ue
@@ -21,6 +21,12 @@ NasTimers::NasTimers()
 {
 }
 
+std::array<UeTimer *, 17> NasTimers::all()
+{
+    return {&t3346, &t3396, &t3444, &t3445, &t3502, &t3510, &t3511, &t3512, &t3516,
+            &t3517, &t3519, &t3520, &t3521, &t3525, &t3540, &t3584, &t3585};
+}
+
 Json ToJson(const ECmState &state)
 {
     switch (state)
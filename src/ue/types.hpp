@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include "snapshot.hpp"
 #include "timer.hpp"
+#include "trace.hpp"
 
 #include <array>
 #include <atomic>
@@ -21,6 +23,10 @@
 #include <lib/app/monitor.hpp>
 #include <lib/app/ue_ctl.hpp>
 #include <lib/nas/nas.hpp>
+#include <lib/rls/mobility.hpp>
+#include <lib/rls/radio_env.hpp>
+#include <lib/rls/rls_arq.hpp>
+#include <ue/load/profile.hpp>
 #include <utils/common_types.hpp>
 #include <utils/json.hpp>
 #include <utils/locked.hpp>
@@ -101,11 +107,15 @@ struct UeConfig
     std::optional<std::string> imei{};
     std::optional<std::string> imeiSv{};
     SupportedAlgs supportedAlgs{};
-    std::vector<std::string> gnbSearchList{};
-    std::vector<SessionConfig> defaultSessions{};
+    // Shared by all the UEs of the process, since they are never modified after the config is read
+    std::shared_ptr<const std::vector<std::string>> gnbSearchList{};
+    std::shared_ptr<const std::vector<SessionConfig>> defaultSessions{};
     IntegrityMaxDataRateConfig integrityMaxRate{};
     NetworkSlice defaultConfiguredNssai{};
     NetworkSlice configuredNssai{};
+    rls::ArqConfig rlsArq{};
+    rls::MobilityConfig mobility{};
+    LoadProfileConfig loadProfile{};
 
     struct
     {
@@ -126,6 +136,8 @@ struct UeConfig
     /* Assigned by program */
     bool configureRouting{};
     bool prefixLogger{};
+    bool deferSessions{};
+    std::string traceDumpDir{};
 
     [[nodiscard]] std::string getNodeName() const
     {
@@ -199,6 +211,11 @@ struct TaskBase
     app::IUeController *ueController{};
     app::INodeListener *nodeListener{};
     NtsTask *cliCallbackTask{};
+    rls::RadioEnvironment *radioEnv{};
+    rls::MobilityEngine *mobility{};
+    EventTrace *trace{};
+    StateSnapshot *snapshot{}; // Null if the snapshots are disabled
+    int snapshotIndex{};
 
     UeSharedContext shCtx{};
 
@@ -239,6 +256,8 @@ struct NasTimers
     UeTimer t3585; /* SM - ... */
 
     NasTimers();
+
+    [[nodiscard]] std::array<UeTimer *, 17> all();
 };
 
 enum class ERmState
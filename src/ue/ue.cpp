@@ -13,56 +13,95 @@
 #include "rls/task.hpp"
 #include "rrc/task.hpp"
 
+#include <lib/app/cli_base.hpp>
+
 namespace nr::ue
 {
 
 UserEquipment::UserEquipment(UeConfig *config, app::IUeController *ueController, app::INodeListener *nodeListener,
-                             NtsTask *cliCallbackTask)
+                             NtsTask *cliCallbackTask, rls::RadioEnvironment *radioEnv,
+                             rls::MobilityEngine *mobility, StateSnapshot *snapshot, int snapshotIndex)
+    : started{}
 {
     auto *base = new TaskBase();
     base->ue = this;
     base->config = config;
-    base->logBase = new LogBase("logs/ue-" + config->getNodeName() + ".log");
     base->ueController = ueController;
     base->nodeListener = nodeListener;
     base->cliCallbackTask = cliCallbackTask;
-
-    base->nasTask = new NasTask(base);
-    base->rrcTask = new UeRrcTask(base);
-    base->appTask = new UeAppTask(base);
-    base->rlsTask = new UeRlsTask(base);
+    base->radioEnv = radioEnv;
+    base->mobility = mobility;
+    base->snapshot = snapshot;
+    base->snapshotIndex = snapshotIndex;
 
     taskBase = base;
 }
 
 UserEquipment::~UserEquipment()
 {
-    taskBase->nasTask->quit();
-    taskBase->rrcTask->quit();
-    taskBase->rlsTask->quit();
-    taskBase->appTask->quit();
+    if (started)
+    {
+        taskBase->nasTask->quit();
+        taskBase->rrcTask->quit();
+        taskBase->rlsTask->quit();
+        taskBase->appTask->quit();
 
-    delete taskBase->nasTask;
-    delete taskBase->rrcTask;
-    delete taskBase->rlsTask;
-    delete taskBase->appTask;
+        delete taskBase->nasTask;
+        delete taskBase->rrcTask;
+        delete taskBase->rlsTask;
+        delete taskBase->appTask;
 
-    delete taskBase->logBase;
+        delete taskBase->logBase;
+        delete taskBase->trace;
+    }
 
     delete taskBase;
 }
 
 void UserEquipment::start()
 {
-    taskBase->nasTask->start();
-    taskBase->rrcTask->start();
-    taskBase->rlsTask->start();
-    taskBase->appTask->start();
+    if (started)
+        return;
+
+    auto *base = taskBase;
+    base->logBase = new LogBase("logs/ue-" + base->config->getNodeName() + ".log");
+    base->trace = new EventTrace(base->config->getNodeName(), base->config->traceDumpDir);
+
+    base->nasTask = new NasTask(base);
+    base->rrcTask = new UeRrcTask(base);
+    base->appTask = new UeAppTask(base);
+    base->rlsTask = new UeRlsTask(base);
+
+    base->nasTask->start();
+    base->rrcTask->start();
+    base->rlsTask->start();
+    base->appTask->start();
+
+    // Released only after all the tasks are created, since the commands are pushed from the CLI thread
+    started.store(true, std::memory_order_release);
+}
+
+bool UserEquipment::isStarted() const
+{
+    return started.load(std::memory_order_acquire);
 }
 
 void UserEquipment::pushCommand(std::unique_ptr<app::UeCliCommand> cmd, const InetAddress &address)
 {
+    if (!isStarted())
+    {
+        taskBase->cliCallbackTask->push(new app::NwCliSendResponse(address, "UE is not powered on yet", true,
+                                                                   taskBase->config->getNodeName()));
+        return;
+    }
     taskBase->appTask->push(new NmUeCliCommand(std::move(cmd), address));
 }
 
+void UserEquipment::pushLoadAction(ELoadAction action)
+{
+    if (!isStarted())
+        return;
+    taskBase->nasTask->push(new NmUeLoadCommand(action));
+}
+
 } // namespace nr::ue
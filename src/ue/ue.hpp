@@ -9,6 +9,7 @@
 #pragma once
 
 #include "types.hpp"
+#include <atomic>
 #include <lib/app/cli_cmd.hpp>
 #include <memory>
 #include <utils/network.hpp>
@@ -17,19 +18,28 @@
 namespace nr::ue
 {
 
+/**
+ * The per-UE resources, i.e. the logger, the event trace, the tasks and their threads and sockets, are only created
+ * when the UE is started (powered on), so that a large population of UEs can be set up quickly and the UEs scheduled
+ * for later do not hold any threads or sockets in the meantime.
+ */
 class UserEquipment
 {
   private:
     TaskBase *taskBase;
+    std::atomic<bool> started;
 
   public:
     UserEquipment(UeConfig *config, app::IUeController *ueController, app::INodeListener *nodeListener,
-                  NtsTask *cliCallbackTask);
+                  NtsTask *cliCallbackTask, rls::RadioEnvironment *radioEnv, rls::MobilityEngine *mobility,
+                  StateSnapshot *snapshot, int snapshotIndex);
     virtual ~UserEquipment();
 
   public:
     void start();
+    [[nodiscard]] bool isStarted() const;
     void pushCommand(std::unique_ptr<app::UeCliCommand> cmd, const InetAddress &address);
+    void pushLoadAction(ELoadAction action);
 };
 
 } // namespace nr::ue
\ No newline at end of file
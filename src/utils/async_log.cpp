@@ -0,0 +1,636 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "async_log.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+static constexpr const size_t RING_CAPACITY = 64 * 1024;
+static constexpr const uint32_t PADDING_ID = UINT32_MAX;
+static constexpr const int IDLE_SLEEP_MS = 2;
+static constexpr const int FLUSH_TIMEOUT_MS = 1000;
+static constexpr const char BINARY_MAGIC[8] = {'U', 'E', 'L', 'O', 'G', '\0', '\1', '\0'};
+
+namespace
+{
+
+struct LogRing
+{
+    std::unique_ptr<uint8_t[]> data{new uint8_t[RING_CAPACITY]};
+    std::atomic<uint64_t> head{}; // Written by the producer thread only
+    std::atomic<uint64_t> tail{}; // Written by the backend thread only
+    std::atomic<bool> closed{};
+    uint64_t pendingHead{};
+    size_t pendingSize{};
+};
+
+struct RingHandle
+{
+    LogRing *ring{};
+
+    ~RingHandle()
+    {
+        // The backend releases the ring once it is drained
+        if (ring)
+            ring->closed = true;
+    }
+};
+
+struct Backend
+{
+    std::mutex mutex{};
+    std::vector<LogRing *> rings{};
+    std::vector<std::string> loggers{};
+    std::atomic<uint64_t> dropped{};
+
+    std::mutex passMutex{};
+    std::condition_variable passCv{};
+    uint64_t passCount{};
+
+    /* Used by the backend thread only */
+    FILE *file{};
+    std::shared_ptr<spdlog::sinks::sink> console{};
+    std::unordered_map<const char *, uint32_t> formatIds{};
+    std::vector<bool> loggerWritten{};
+    std::vector<uint8_t> batch{};
+    std::vector<std::pair<int64_t, size_t>> order{};
+};
+
+Backend *g_backend = nullptr;
+thread_local RingHandle t_ring{};
+
+spdlog::level::level_enum SpdlogLevel(int severity)
+{
+    switch (severity)
+    {
+    case 0:
+        return spdlog::level::debug;
+    case 1:
+        return spdlog::level::info;
+    case 2:
+        return spdlog::level::warn;
+    case 3:
+        return spdlog::level::err;
+    default:
+        return spdlog::level::critical;
+    }
+}
+
+template <typename T>
+void AppendFormatted(std::string &out, const std::string &spec, T value)
+{
+    char buffer[128];
+    int size = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+    if (size < 0)
+        return;
+    if (static_cast<size_t>(size) < sizeof(buffer))
+    {
+        out.append(buffer, static_cast<size_t>(size));
+        return;
+    }
+    size_t offset = out.size();
+    out.resize(offset + static_cast<size_t>(size) + 1);
+    snprintf(&out[offset], static_cast<size_t>(size) + 1, spec.c_str(), value);
+    out.resize(offset + static_cast<size_t>(size));
+}
+
+/* Returns the length of the encoded argument at p, or 0 if it exceeds the end */
+size_t EncodedArgSize(const uint8_t *p, const uint8_t *end)
+{
+    if (p >= end)
+        return 0;
+    if (static_cast<logging::EArgType>(*p) != logging::EArgType::STRING)
+        return end - p >= 9 ? 9 : 0;
+    if (end - p < 5)
+        return 0;
+    uint32_t length;
+    std::memcpy(&length, p + 1, 4);
+    return static_cast<size_t>(end - p) >= 5 + static_cast<size_t>(length) ? 5 + length : 0;
+}
+
+void WriteChunk(FILE *file, logging::EChunkType type, uint32_t id, const std::string &value)
+{
+    auto t = static_cast<uint8_t>(type);
+    auto length = static_cast<uint32_t>(value.size());
+    fwrite(&t, 1, 1, file);
+    fwrite(&id, 4, 1, file);
+    fwrite(&length, 4, 1, file);
+    fwrite(value.data(), 1, value.size(), file);
+}
+
+void EmitBinary(Backend &b, const logging::RecordHeader &header, const uint8_t *args, size_t length)
+{
+    auto it = b.formatIds.find(header.format);
+    uint32_t formatId;
+    if (it == b.formatIds.end())
+    {
+        formatId = static_cast<uint32_t>(b.formatIds.size());
+        b.formatIds[header.format] = formatId;
+        WriteChunk(b.file, logging::EChunkType::FORMAT, formatId, header.format);
+    }
+    else
+    {
+        formatId = it->second;
+    }
+
+    if (header.loggerId >= b.loggerWritten.size() || !b.loggerWritten[header.loggerId])
+    {
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(b.mutex);
+            if (header.loggerId < b.loggers.size())
+                name = b.loggers[header.loggerId];
+        }
+        if (header.loggerId >= b.loggerWritten.size())
+            b.loggerWritten.resize(header.loggerId + 1);
+        b.loggerWritten[header.loggerId] = true;
+        WriteChunk(b.file, logging::EChunkType::LOGGER, header.loggerId, name);
+    }
+
+    // Padding at the end of the record is not written
+    const uint8_t *p = args, *end = args + length;
+    for (int i = 0; i < header.argCount; i++)
+    {
+        size_t size = EncodedArgSize(p, end);
+        if (size == 0)
+            break;
+        p += size;
+    }
+
+    auto type = static_cast<uint8_t>(logging::EChunkType::RECORD);
+    fwrite(&type, 1, 1, b.file);
+    fwrite(&header.time, 8, 1, b.file);
+    fwrite(&header.loggerId, 4, 1, b.file);
+    fwrite(&header.severity, 1, 1, b.file);
+    fwrite(&formatId, 4, 1, b.file);
+    fwrite(&header.argCount, 1, 1, b.file);
+    fwrite(args, 1, static_cast<size_t>(p - args), b.file);
+}
+
+void EmitConsole(Backend &b, const logging::RecordHeader &header, const uint8_t *args, size_t length)
+{
+    std::string name;
+    {
+        std::lock_guard<std::mutex> lock(b.mutex);
+        if (header.loggerId < b.loggers.size())
+            name = b.loggers[header.loggerId];
+    }
+
+    std::string text = logging::FormatMessage(header.format, args, length, header.argCount);
+
+    auto time = spdlog::log_clock::time_point{std::chrono::duration_cast<spdlog::log_clock::duration>(
+        std::chrono::microseconds{header.time})};
+    spdlog::details::log_msg msg{time, spdlog::source_loc{}, name, SpdlogLevel(header.severity), text};
+    b.console->log(msg);
+}
+
+void DrainRing(Backend &b, LogRing &ring)
+{
+    uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+
+    while (tail < head)
+    {
+        const uint8_t *p = ring.data.get() + tail % RING_CAPACITY;
+        uint32_t size, loggerId;
+        std::memcpy(&size, p, 4);
+        std::memcpy(&loggerId, p + 4, 4);
+
+        if (loggerId != PADDING_ID)
+        {
+            int64_t time;
+            std::memcpy(&time, p + offsetof(logging::RecordHeader, time), 8);
+            b.order.emplace_back(time, b.batch.size());
+            b.batch.insert(b.batch.end(), p, p + size);
+        }
+        tail += size;
+    }
+
+    ring.tail.store(tail, std::memory_order_release);
+}
+
+bool PerformPass(Backend &b)
+{
+    std::vector<LogRing *> rings;
+    {
+        std::lock_guard<std::mutex> lock(b.mutex);
+        rings = b.rings;
+    }
+
+    b.batch.clear();
+    b.order.clear();
+
+    for (auto *ring : rings)
+    {
+        // Checked before draining, so that nothing committed before the thread exited is lost
+        bool closed = ring->closed;
+        DrainRing(b, *ring);
+        if (closed)
+        {
+            std::lock_guard<std::mutex> lock(b.mutex);
+            b.rings.erase(std::find(b.rings.begin(), b.rings.end(), ring));
+            delete ring;
+        }
+    }
+
+    // Records of different threads are emitted in the order of their timestamps
+    std::stable_sort(b.order.begin(), b.order.end(),
+                     [](auto &x, auto &y) { return x.first < y.first; });
+
+    for (auto &item : b.order)
+    {
+        logging::RecordHeader header{};
+        std::memcpy(&header, b.batch.data() + item.second, sizeof(header));
+        const uint8_t *args = b.batch.data() + item.second + sizeof(header);
+        size_t length = header.size - sizeof(header);
+
+        if (b.file)
+            EmitBinary(b, header, args, length);
+        else
+            EmitConsole(b, header, args, length);
+    }
+
+    uint64_t dropped = b.dropped.exchange(0);
+    if (dropped != 0)
+    {
+        if (b.file)
+        {
+            auto type = static_cast<uint8_t>(logging::EChunkType::DROPPED);
+            fwrite(&type, 1, 1, b.file);
+            fwrite(&dropped, 8, 1, b.file);
+        }
+        else
+        {
+            std::string text = "[" + std::to_string(dropped) + "] log records dropped";
+            b.console->log(spdlog::details::log_msg{"log", spdlog::level::warn, text});
+        }
+    }
+
+    bool any = !b.order.empty() || dropped != 0;
+    if (any)
+    {
+        if (b.file)
+            fflush(b.file);
+        else
+            b.console->flush();
+    }
+    return any;
+}
+
+void BackendLoop(Backend *b)
+{
+    while (true)
+    {
+        bool any = PerformPass(*b);
+        {
+            std::lock_guard<std::mutex> lock(b->passMutex);
+            b->passCount++;
+        }
+        b->passCv.notify_all();
+
+        if (!any)
+            std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_SLEEP_MS));
+    }
+}
+
+std::string FormatTime(int64_t micros)
+{
+    time_t seconds = static_cast<time_t>(micros / 1'000'000);
+    struct tm tm
+    {
+    };
+    localtime_r(&seconds, &tm);
+
+    char buffer[64];
+    size_t n = strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+    snprintf(buffer + n, sizeof(buffer) - n, ".%03d", static_cast<int>((micros / 1000) % 1000));
+    return buffer;
+}
+
+} // namespace
+
+namespace logging
+{
+
+void StartAsync(const std::optional<std::string> &binaryFile)
+{
+    if (g_backend)
+        return;
+
+    auto *b = new Backend();
+    if (binaryFile.has_value())
+    {
+        b->file = fopen(binaryFile->c_str(), "wb");
+        if (b->file == nullptr)
+            throw std::runtime_error("Binary log file could not be opened: " + *binaryFile);
+        fwrite(BINARY_MAGIC, 1, sizeof(BINARY_MAGIC), b->file);
+    }
+    else
+    {
+        b->console = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        b->console->set_level(spdlog::level::trace);
+    }
+
+    g_backend = b;
+    std::thread{BackendLoop, b}.detach();
+    std::atexit(Flush);
+}
+
+bool IsAsync()
+{
+    return g_backend != nullptr;
+}
+
+uint32_t RegisterLogger(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(g_backend->mutex);
+    g_backend->loggers.push_back(name);
+    return static_cast<uint32_t>(g_backend->loggers.size() - 1);
+}
+
+void Flush()
+{
+    if (!g_backend)
+        return;
+
+    // Two complete passes guarantee that everything committed before the call is drained and written
+    std::unique_lock<std::mutex> lock(g_backend->passMutex);
+    uint64_t target = g_backend->passCount + 2;
+    g_backend->passCv.wait_for(lock, std::chrono::milliseconds(FLUSH_TIMEOUT_MS),
+                               [target] { return g_backend->passCount >= target; });
+}
+
+uint8_t *Reserve(size_t size)
+{
+    if (!g_backend)
+        return nullptr;
+
+    if (t_ring.ring == nullptr)
+    {
+        t_ring.ring = new LogRing();
+        std::lock_guard<std::mutex> lock(g_backend->mutex);
+        g_backend->rings.push_back(t_ring.ring);
+    }
+
+    LogRing &ring = *t_ring.ring;
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    uint64_t tail = ring.tail.load(std::memory_order_acquire);
+
+    size_t offset = head % RING_CAPACITY;
+    size_t contiguous = RING_CAPACITY - offset;
+    size_t needed = size <= contiguous ? size : contiguous + size;
+
+    if (size > RING_CAPACITY / 2 || RING_CAPACITY - (head - tail) < needed)
+    {
+        g_backend->dropped++;
+        return nullptr;
+    }
+
+    if (size > contiguous)
+    {
+        // The rest of the ring is skipped, records are never split
+        auto padding = static_cast<uint32_t>(contiguous);
+        std::memcpy(ring.data.get() + offset, &padding, 4);
+        std::memcpy(ring.data.get() + offset + 4, &PADDING_ID, 4);
+        head += contiguous;
+        offset = 0;
+    }
+
+    ring.pendingHead = head;
+    ring.pendingSize = size;
+    return ring.data.get() + offset;
+}
+
+void Commit()
+{
+    LogRing &ring = *t_ring.ring;
+    ring.head.store(ring.pendingHead + ring.pendingSize, std::memory_order_release);
+}
+
+std::string FormatMessage(const char *format, const uint8_t *args, size_t length, int argCount)
+{
+    std::string out;
+    const uint8_t *cursor = args, *end = args + length;
+    int remaining = argCount;
+
+    const char *p = format;
+    while (*p)
+    {
+        if (*p != '%')
+        {
+            out.push_back(*p++);
+            continue;
+        }
+        if (p[1] == '%')
+        {
+            out.push_back('%');
+            p += 2;
+            continue;
+        }
+
+        // Flags, width and precision are kept, length modifiers are replaced according to the encoded type
+        const char *start = p++;
+        while (*p && std::strchr("-+ #0", *p))
+            p++;
+        while ((*p >= '0' && *p <= '9') || *p == '.')
+            p++;
+        std::string spec{start, p};
+        while (*p && std::strchr("hlLqjzt", *p))
+            p++;
+        char conversion = *p;
+        if (conversion == '\0')
+            break;
+        p++;
+
+        size_t size = remaining > 0 ? EncodedArgSize(cursor, end) : 0;
+        if (size == 0)
+        {
+            out += "<?>";
+            continue;
+        }
+
+        auto type = static_cast<EArgType>(*cursor);
+        uint64_t raw{};
+        std::string str{};
+        if (type == EArgType::STRING)
+            str.assign(reinterpret_cast<const char *>(cursor + 5), size - 5);
+        else
+            std::memcpy(&raw, cursor + 1, 8);
+        cursor += size;
+        remaining--;
+
+        double real;
+        std::memcpy(&real, &raw, 8);
+        if (type != EArgType::DOUBLE)
+            real = type == EArgType::INT ? static_cast<double>(static_cast<int64_t>(raw)) : static_cast<double>(raw);
+        if (type == EArgType::DOUBLE)
+            raw = static_cast<uint64_t>(static_cast<int64_t>(real));
+
+        switch (conversion)
+        {
+        case 'd':
+        case 'i':
+            AppendFormatted(out, spec + "lld", static_cast<long long>(raw));
+            break;
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            AppendFormatted(out, spec + "ll" + conversion, static_cast<unsigned long long>(raw));
+            break;
+        case 'c':
+            AppendFormatted(out, spec + "c", static_cast<int>(raw));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            AppendFormatted(out, spec + conversion, real);
+            break;
+        case 's':
+            if (type == EArgType::STRING)
+                AppendFormatted(out, spec + "s", str.c_str());
+            else
+                out += "<?>";
+            break;
+        case 'p':
+            AppendFormatted(out, spec + "p", reinterpret_cast<void *>(static_cast<uintptr_t>(raw)));
+            break;
+        default:
+            out.append(start, p);
+            break;
+        }
+    }
+    return out;
+}
+
+std::string SeverityName(int severity)
+{
+    switch (severity)
+    {
+    case 0:
+        return "debug";
+    case 1:
+        return "info";
+    case 2:
+        return "warning";
+    case 3:
+        return "error";
+    default:
+        return "critical";
+    }
+}
+
+int64_t detail::CurrentTimeMicros()
+{
+    auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count();
+}
+
+BinaryLogReader::BinaryLogReader(const std::string &path) : m_stream{path, std::ios::binary}, m_formats{}, m_loggers{}
+{
+    if (!m_stream)
+        throw std::runtime_error("Binary log file could not be opened: " + path);
+
+    char magic[sizeof(BINARY_MAGIC)];
+    if (!m_stream.read(magic, sizeof(magic)) || std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0)
+        throw std::runtime_error("Not a binary log file: " + path);
+}
+
+bool BinaryLogReader::next(std::string &line)
+{
+    auto read = [this](void *target, size_t size) {
+        if (!m_stream.read(reinterpret_cast<char *>(target), static_cast<std::streamsize>(size)))
+            throw std::runtime_error("Binary log file is truncated");
+    };
+
+    while (true)
+    {
+        uint8_t type;
+        if (!m_stream.read(reinterpret_cast<char *>(&type), 1))
+            return false;
+
+        switch (static_cast<EChunkType>(type))
+        {
+        case EChunkType::FORMAT:
+        case EChunkType::LOGGER: {
+            uint32_t id, length;
+            read(&id, 4);
+            read(&length, 4);
+            std::string value(length, '\0');
+            read(value.data(), length);
+            (static_cast<EChunkType>(type) == EChunkType::FORMAT ? m_formats : m_loggers)[id] = std::move(value);
+            break;
+        }
+        case EChunkType::DROPPED: {
+            uint64_t count;
+            read(&count, 8);
+            line = "[" + std::to_string(count) + "] log records dropped";
+            return true;
+        }
+        case EChunkType::RECORD: {
+            int64_t time;
+            uint32_t loggerId, formatId;
+            uint8_t severity, argCount;
+            read(&time, 8);
+            read(&loggerId, 4);
+            read(&severity, 1);
+            read(&formatId, 4);
+            read(&argCount, 1);
+
+            std::vector<uint8_t> args;
+            for (int i = 0; i < argCount; i++)
+            {
+                uint8_t argType;
+                read(&argType, 1);
+                args.push_back(argType);
+
+                size_t size = 8;
+                if (static_cast<EArgType>(argType) == EArgType::STRING)
+                {
+                    uint32_t length;
+                    read(&length, 4);
+                    args.insert(args.end(), reinterpret_cast<uint8_t *>(&length),
+                                reinterpret_cast<uint8_t *>(&length) + 4);
+                    size = length;
+                }
+                size_t offset = args.size();
+                args.resize(offset + size);
+                read(args.data() + offset, size);
+            }
+
+            auto format = m_formats.find(formatId);
+            if (format == m_formats.end())
+                throw std::runtime_error("Binary log file refers to an undefined format");
+
+            line = "[" + FormatTime(time) + "] [" + m_loggers[loggerId] + "] [" + SeverityName(severity) + "] " +
+                   FormatMessage(format->second.c_str(), args.data(), args.size(), argCount);
+            return true;
+        }
+        default:
+            throw std::runtime_error("Binary log file is corrupted");
+        }
+    }
+}
+
+} // namespace logging
@@ -0,0 +1,199 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Asynchronous logging backend with deferred formatting.
+ * <p>
+ * Each logging thread owns a lock-free single producer ring buffer. A log call copies only the format string pointer,
+ * a timestamp and the raw arguments into the ring, and a background thread drains all the rings, then either formats
+ * the records to the console, or writes them to a binary log file without formatting at all. The format strings must
+ * be string literals, since only their address is recorded.
+ * <p>
+ * Binary log file starts with the 8 byte magic "UELOG\0\1\0", followed by chunks starting with a type octet. Integers
+ * are in the byte order of the host:
+ * <ul>
+ * <li>FORMAT: u32 format id, u32 length, format string</li>
+ * <li>LOGGER: u32 logger id, u32 length, logger name</li>
+ * <li>RECORD: i64 time in microseconds since epoch, u32 logger id, u8 severity, u32 format id, u8 argument count,
+ * then for each argument u8 type and either an 8 byte value, or u32 length and the string</li>
+ * <li>DROPPED: u64 number of records dropped because of full rings</li>
+ * </ul>
+ * A format and a logger are defined in the file before the first record using them. nr-logdec decodes the file.
+ */
+namespace logging
+{
+
+enum class EArgType : uint8_t
+{
+    INT,
+    UINT,
+    DOUBLE,
+    STRING,
+    POINTER
+};
+
+enum class EChunkType : uint8_t
+{
+    FORMAT = 1,
+    LOGGER = 2,
+    RECORD = 3,
+    DROPPED = 4
+};
+
+struct RecordHeader
+{
+    uint32_t size; // Including the header, padded to 8 octets
+    uint32_t loggerId;
+    uint8_t severity;
+    uint8_t argCount;
+    uint16_t reserved;
+    int64_t time;
+    const char *format;
+};
+
+static constexpr const size_t MAX_STRING_ARG = 4096;
+
+/* Starts the backend. Output goes to the given binary file if any, otherwise it is formatted to the console. */
+void StartAsync(const std::optional<std::string> &binaryFile);
+bool IsAsync();
+uint32_t RegisterLogger(const std::string &name);
+/* Blocks until the records logged so far are written, up to a timeout */
+void Flush();
+
+uint8_t *Reserve(size_t size);
+void Commit();
+
+/* Formats printf-style format string with the encoded arguments */
+std::string FormatMessage(const char *format, const uint8_t *args, size_t length, int argCount);
+std::string SeverityName(int severity);
+
+namespace detail
+{
+
+template <typename T>
+inline size_t ArgSize(const T &value)
+{
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, const char *> || std::is_same_v<D, char *>)
+    {
+        const char *s = value; // Also decays the char arrays
+        return 1 + 4 + (s ? std::min(std::strlen(s), MAX_STRING_ARG) : 6);
+    }
+    else if constexpr (std::is_arithmetic_v<D> || std::is_enum_v<D> || std::is_pointer_v<D>)
+        return 1 + 8;
+    else
+        static_assert(sizeof(D) == 0, "Unsupported log argument type");
+}
+
+template <typename T>
+inline void WriteArg(uint8_t *&p, const T &value)
+{
+    using D = std::decay_t<T>;
+    if constexpr (std::is_same_v<D, const char *> || std::is_same_v<D, char *>)
+    {
+        const char *s = value; // Also decays the char arrays
+        if (s == nullptr)
+            s = "(null)";
+        auto length = static_cast<uint32_t>(std::min(std::strlen(s), MAX_STRING_ARG));
+        *p++ = static_cast<uint8_t>(EArgType::STRING);
+        std::memcpy(p, &length, 4);
+        std::memcpy(p + 4, s, length);
+        p += 4 + length;
+    }
+    else
+    {
+        EArgType type;
+        uint64_t raw;
+        if constexpr (std::is_floating_point_v<D>)
+        {
+            type = EArgType::DOUBLE;
+            double v = static_cast<double>(value);
+            std::memcpy(&raw, &v, 8);
+        }
+        else if constexpr (std::is_pointer_v<D>)
+        {
+            type = EArgType::POINTER;
+            raw = reinterpret_cast<uintptr_t>(value);
+        }
+        else if constexpr (std::is_enum_v<D> || std::is_signed_v<D>)
+        {
+            type = EArgType::INT;
+            raw = static_cast<uint64_t>(static_cast<int64_t>(value));
+        }
+        else
+        {
+            type = EArgType::UINT;
+            raw = static_cast<uint64_t>(value);
+        }
+        *p++ = static_cast<uint8_t>(type);
+        std::memcpy(p, &raw, 8);
+        p += 8;
+    }
+}
+
+int64_t CurrentTimeMicros();
+
+} // namespace detail
+
+template <typename... Args>
+inline void Write(uint32_t loggerId, int severity, const char *format, const Args &...args)
+{
+    size_t size = sizeof(RecordHeader) + (detail::ArgSize(args) + ... + 0);
+    size = (size + 7) & ~static_cast<size_t>(7);
+
+    uint8_t *record = Reserve(size);
+    if (record == nullptr)
+        return;
+
+    RecordHeader header{};
+    header.size = static_cast<uint32_t>(size);
+    header.loggerId = loggerId;
+    header.severity = static_cast<uint8_t>(severity);
+    header.argCount = static_cast<uint8_t>(sizeof...(Args));
+    header.time = detail::CurrentTimeMicros();
+    header.format = format;
+    std::memcpy(record, &header, sizeof(RecordHeader));
+
+    uint8_t *p = record + sizeof(RecordHeader);
+    (detail::WriteArg(p, args), ...);
+
+    Commit();
+}
+
+/**
+ * Reads a binary log file written by the backend, record by record.
+ */
+class BinaryLogReader
+{
+  private:
+    std::ifstream m_stream;
+    std::unordered_map<uint32_t, std::string> m_formats;
+    std::unordered_map<uint32_t, std::string> m_loggers;
+
+  public:
+    /* Throws std::runtime_error if the file cannot be opened or is not a binary log file */
+    explicit BinaryLogReader(const std::string &path);
+
+  public:
+    /* Returns false at the end of the file. Throws std::runtime_error if the file is corrupted. */
+    bool next(std::string &line);
+};
+
+} // namespace logging
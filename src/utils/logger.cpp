@@ -13,10 +13,16 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
-Logger::Logger(const std::string &name, const std::vector<std::shared_ptr<spdlog::sinks::sink>> &sinks)
+std::atomic<int> Logger::s_minSeverity{0};
+
+Logger::Logger(const std::string &name, const std::vector<std::shared_ptr<spdlog::sinks::sink>> &sinks) : m_asyncId{}
 {
     logger = new spdlog::logger(name, std::begin(sinks), std::end(sinks));
 
+    // Loggers without a sink are not registered, in order not to write their logs to the asynchronous backend
+    if (logging::IsAsync() && !sinks.empty())
+        m_asyncId = logging::RegisterLogger(name);
+
     logger->set_level(spdlog::level::debug);
     logger->flush_on(spdlog::level::warn);
 }
@@ -26,6 +32,23 @@ Logger::~Logger()
     delete logger;
 }
 
+void Logger::SetMinSeverity(Severity severity)
+{
+    s_minSeverity = static_cast<int>(severity);
+}
+
+std::string &Logger::FormatBuffer()
+{
+    thread_local std::string buffer{};
+    return buffer;
+}
+
+void Logger::fatalAsync()
+{
+    logging::Flush();
+    std::terminate();
+}
+
 void Logger::logImpl(Severity severity, const std::string &msg)
 {
     switch (severity)
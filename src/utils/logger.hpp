@@ -8,9 +8,13 @@
 
 #pragma once
 
+#include "async_log.hpp"
 #include "nts.hpp"
 
+#include <atomic>
+#include <cstdio>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <spdlog/fwd.h>
@@ -24,82 +28,135 @@ enum class Severity
     FATAL
 };
 
+#ifndef UERANSIM_MIN_SEVERITY
+#define UERANSIM_MIN_SEVERITY 0
+#endif
+
 class Logger
 {
   private:
+    static std::atomic<int> s_minSeverity;
+
     spdlog::logger *logger;
+    std::optional<uint32_t> m_asyncId;
 
   public:
     Logger(const std::string &name, const std::vector<std::shared_ptr<spdlog::sinks::sink>> &sinks);
     virtual ~Logger();
 
+    /* Logs below the given severity are discarded before formatting, FATAL is never discarded */
+    static void SetMinSeverity(Severity severity);
+
   private:
     void logImpl(Severity severity, const std::string &msg);
+    void fatalAsync();
+
+    static std::string &FormatBuffer();
 
   public:
     template <typename... Args>
-    inline void debug(const std::string &fmt, Args &&...args)
+    inline void debug(const char *fmt, Args &&...args)
     {
         log(Severity::DEBUG, fmt, args...);
     }
 
-    inline void debug(const std::string &fmt)
+    inline void debug(const std::string &msg)
     {
-        log(Severity::DEBUG, fmt);
+        log(Severity::DEBUG, msg.c_str());
     }
 
     template <typename... Args>
-    inline void info(const std::string &fmt, Args &&...args)
+    inline void info(const char *fmt, Args &&...args)
     {
         log(Severity::INFO, fmt, args...);
     }
 
-    inline void info(const std::string &fmt)
+    inline void info(const std::string &msg)
     {
-        log(Severity::INFO, fmt);
+        log(Severity::INFO, msg.c_str());
     }
 
     template <typename... Args>
-    inline void warn(const std::string &fmt, Args &&...args)
+    inline void warn(const char *fmt, Args &&...args)
     {
         log(Severity::WARN, fmt, args...);
     }
 
-    inline void warn(const std::string &fmt)
+    inline void warn(const std::string &msg)
     {
-        log(Severity::WARN, fmt);
+        log(Severity::WARN, msg.c_str());
     }
 
     template <typename... Args>
-    inline void err(const std::string &fmt, Args &&...args)
+    inline void err(const char *fmt, Args &&...args)
     {
         log(Severity::ERR, fmt, args...);
     }
 
-    inline void err(const std::string &fmt)
+    inline void err(const std::string &msg)
     {
-        log(Severity::ERR, fmt);
+        log(Severity::ERR, msg.c_str());
     }
 
     template <typename... Args>
-    inline void fatal(const std::string &fmt, Args &&...args)
+    inline void fatal(const char *fmt, Args &&...args)
     {
         log(Severity::FATAL, fmt, args...);
     }
 
-    inline void fatal(const std::string &fmt)
+    inline void fatal(const std::string &msg)
     {
-        log(Severity::FATAL, fmt);
+        log(Severity::FATAL, msg.c_str());
     }
 
+    /**
+     * Formats and logs the message unless its severity is filtered out. The format string must be a string literal if
+     * there is any argument, since the asynchronous backend records its address only. A message without arguments is
+     * logged as is, without interpreting it as a format string.
+     */
     template <typename... Args>
-    inline void log(Severity severity, const std::string &fmt, Args &&...args)
+    inline void log(Severity severity, const char *fmt, Args &&...args)
     {
-        int size = snprintf(nullptr, 0, fmt.c_str(), args...);
-        std::string res;
-        res.resize(size);
-        snprintf(&res[0], size + 1, fmt.c_str(), args...);
-        logImpl(severity, res);
+        if (severity != Severity::FATAL)
+        {
+            if (static_cast<int>(severity) < UERANSIM_MIN_SEVERITY)
+                return;
+            if (static_cast<int>(severity) < s_minSeverity.load(std::memory_order_relaxed))
+                return;
+        }
+
+        if (m_asyncId.has_value())
+        {
+            if constexpr (sizeof...(Args) == 0)
+                logging::Write(*m_asyncId, static_cast<int>(severity), "%s", fmt);
+            else
+                logging::Write(*m_asyncId, static_cast<int>(severity), fmt, args...);
+
+            if (severity == Severity::FATAL)
+                fatalAsync();
+            return;
+        }
+
+        if constexpr (sizeof...(Args) == 0)
+        {
+            logImpl(severity, fmt);
+        }
+        else
+        {
+            // The buffer is reused, so the message is formatted once in the common case without any allocation
+            std::string &res = FormatBuffer();
+            res.resize(res.capacity());
+            int size = snprintf(&res[0], res.size() + 1, fmt, args...);
+            if (size < 0)
+                return;
+            if (static_cast<size_t>(size) > res.size())
+            {
+                res.resize(static_cast<size_t>(size));
+                snprintf(&res[0], res.size() + 1, fmt, args...);
+            }
+            res.resize(static_cast<size_t>(size));
+            logImpl(severity, res);
+        }
     }
 
     void flush();
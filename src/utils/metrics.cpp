@@ -0,0 +1,277 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+static std::string SeriesName(const std::string &name, const std::string &suffix, const std::string &labels,
+                              const std::string &extraLabel = "")
+{
+    std::string res = name + suffix;
+    if (labels.empty() && extraLabel.empty())
+        return res;
+
+    res += "{";
+    res += labels;
+    if (!labels.empty() && !extraLabel.empty())
+        res += ",";
+    res += extraLabel;
+    res += "}";
+    return res;
+}
+
+static std::string CsvQuoted(const std::string &str)
+{
+    std::string res = "\"";
+    for (char c : str)
+    {
+        if (c == '"')
+            res += '"';
+        res += c;
+    }
+    res += "\"";
+    return res;
+}
+
+namespace metrics
+{
+
+int64_t Counter::value() const
+{
+    int64_t sum = 0;
+    for (auto &cell : m_cells)
+        sum += cell.value.load(std::memory_order_relaxed);
+    return sum;
+}
+
+int64_t Gauge::value() const
+{
+    int64_t sum = 0;
+    for (auto &cell : m_cells)
+        sum += cell.value.load(std::memory_order_relaxed);
+    return sum;
+}
+
+Histogram::Histogram(std::vector<int64_t> bounds) : m_bounds{std::move(bounds)}, m_shards{}
+{
+    if (!std::is_sorted(m_bounds.begin(), m_bounds.end()))
+        throw std::runtime_error("histogram bounds must be in ascending order");
+
+    for (auto &shard : m_shards)
+    {
+        shard.buckets = std::make_unique<std::atomic<int64_t>[]>(m_bounds.size() + 1);
+        for (size_t i = 0; i <= m_bounds.size(); i++)
+            shard.buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+const std::vector<int64_t> &Histogram::bounds() const
+{
+    return m_bounds;
+}
+
+std::vector<int64_t> Histogram::bucketCounts() const
+{
+    std::vector<int64_t> res(m_bounds.size() + 1);
+    for (auto &shard : m_shards)
+        for (size_t i = 0; i < res.size(); i++)
+            res[i] += shard.buckets[i].load(std::memory_order_relaxed);
+    return res;
+}
+
+int64_t Histogram::sum() const
+{
+    int64_t res = 0;
+    for (auto &shard : m_shards)
+        res += shard.sum.load(std::memory_order_relaxed);
+    return res;
+}
+
+int64_t Histogram::count() const
+{
+    int64_t res = 0;
+    for (auto &shard : m_shards)
+        res += shard.count.load(std::memory_order_relaxed);
+    return res;
+}
+
+Registry &Registry::Instance()
+{
+    // Never destroyed, since the metrics may be updated by the tasks until the very end of the process
+    static auto *registry = new Registry();
+    return *registry;
+}
+
+Registry::Entry &Registry::findOrAdd(const std::string &name, const std::string &help, const std::string &labels,
+                                     EType type)
+{
+    std::string key = name + "{" + labels + "}";
+
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        if (it->second->type != type)
+            throw std::runtime_error("metric registered with a different type: " + name);
+        return *it->second;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->labels = labels;
+    entry->type = type;
+
+    auto *ptr = entry.get();
+    m_entries.push_back(std::move(entry));
+    m_index[key] = ptr;
+    return *ptr;
+}
+
+Counter &Registry::counter(const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto &entry = findOrAdd(name, help, labels, EType::COUNTER);
+    if (!entry.counter)
+        entry.counter = std::make_unique<Counter>();
+    return *entry.counter;
+}
+
+Gauge &Registry::gauge(const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto &entry = findOrAdd(name, help, labels, EType::GAUGE);
+    if (!entry.gauge)
+        entry.gauge = std::make_unique<Gauge>();
+    return *entry.gauge;
+}
+
+Histogram &Registry::histogram(const std::string &name, const std::string &help, const std::vector<int64_t> &bounds,
+                               const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto &entry = findOrAdd(name, help, labels, EType::HISTOGRAM);
+    if (!entry.histogram)
+        entry.histogram = std::make_unique<Histogram>(bounds);
+    return *entry.histogram;
+}
+
+std::vector<const Registry::Entry *> Registry::sortedEntries()
+{
+    // Series of the same metric must be adjacent in the exposition format
+    std::vector<const Entry *> res;
+    for (auto &entry : m_entries)
+        res.push_back(entry.get());
+
+    std::stable_sort(res.begin(), res.end(), [](const Entry *a, const Entry *b) { return a->name < b->name; });
+    return res;
+}
+
+/* Calls the visitor for each series of the entry, histograms are expanded to cumulative buckets, sum and count */
+static void VisitSeries(const std::string &name, const std::string &labels, const Histogram &histogram,
+                        const std::function<void(const std::string &, int64_t)> &visitor)
+{
+    auto &bounds = histogram.bounds();
+    auto counts = histogram.bucketCounts();
+
+    int64_t cumulative = 0;
+    for (size_t i = 0; i < counts.size(); i++)
+    {
+        cumulative += counts[i];
+        std::string le = i < bounds.size() ? std::to_string(bounds[i]) : "+Inf";
+        visitor(SeriesName(name, "_bucket", labels, "le=\"" + le + "\""), cumulative);
+    }
+    visitor(SeriesName(name, "_sum", labels), histogram.sum());
+    visitor(SeriesName(name, "_count", labels), histogram.count());
+}
+
+std::string Registry::renderPrometheus()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::stringstream ss;
+    std::string lastName;
+
+    for (auto *entry : sortedEntries())
+    {
+        if (entry->name != lastName)
+        {
+            lastName = entry->name;
+            ss << "# HELP " << entry->name << " " << entry->help << "\n";
+            ss << "# TYPE " << entry->name << " "
+               << (entry->type == EType::COUNTER ? "counter" : entry->type == EType::GAUGE ? "gauge" : "histogram")
+               << "\n";
+        }
+
+        if (entry->type == EType::COUNTER)
+            ss << SeriesName(entry->name, "", entry->labels) << " " << entry->counter->value() << "\n";
+        else if (entry->type == EType::GAUGE)
+            ss << SeriesName(entry->name, "", entry->labels) << " " << entry->gauge->value() << "\n";
+        else
+            VisitSeries(entry->name, entry->labels, *entry->histogram,
+                        [&ss](const std::string &series, int64_t value) { ss << series << " " << value << "\n"; });
+    }
+
+    return ss.str();
+}
+
+std::string Registry::renderSummary()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::stringstream ss;
+    for (auto *entry : sortedEntries())
+    {
+        ss << SeriesName(entry->name, "", entry->labels) << " ";
+        if (entry->type == EType::COUNTER)
+            ss << entry->counter->value();
+        else if (entry->type == EType::GAUGE)
+            ss << entry->gauge->value();
+        else
+        {
+            int64_t count = entry->histogram->count();
+            int64_t sum = entry->histogram->sum();
+            ss << "count=" << count << " avg=" << (count == 0 ? 0 : sum / count);
+        }
+        ss << "\n";
+    }
+
+    return ss.str();
+}
+
+std::string Registry::CsvHeader()
+{
+    return "time_ms,series,value\n";
+}
+
+std::string Registry::renderCsv(int64_t timeMs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::stringstream ss;
+    auto visitor = [&ss, timeMs](const std::string &series, int64_t value) {
+        ss << timeMs << "," << CsvQuoted(series) << "," << value << "\n";
+    };
+
+    for (auto *entry : sortedEntries())
+    {
+        if (entry->type == EType::COUNTER)
+            visitor(SeriesName(entry->name, "", entry->labels), entry->counter->value());
+        else if (entry->type == EType::GAUGE)
+            visitor(SeriesName(entry->name, "", entry->labels), entry->gauge->value());
+        else
+            VisitSeries(entry->name, entry->labels, *entry->histogram, visitor);
+    }
+
+    return ss.str();
+}
+
+} // namespace metrics
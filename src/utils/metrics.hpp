@@ -0,0 +1,174 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace metrics
+{
+
+static constexpr const size_t SHARD_COUNT = 16;
+
+/* Each thread is assigned to one of the shards in round-robin manner on its first update */
+inline size_t ShardIndex()
+{
+    static std::atomic<size_t> s_nextShard{};
+    thread_local size_t index = s_nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return index;
+}
+
+struct alignas(64) Cell
+{
+    std::atomic<int64_t> value{};
+};
+
+/**
+ * Monotonically increasing value.
+ * <p>
+ * Updates only touch the cache line of the shard of the calling thread, so that the tasks do not contend with each
+ * other. Reading sums up all the shards.
+ */
+class Counter
+{
+  private:
+    std::array<Cell, SHARD_COUNT> m_cells{};
+
+  public:
+    inline void inc(int64_t n = 1)
+    {
+        m_cells[ShardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] int64_t value() const;
+};
+
+/**
+ * Value that can go up and down, such as queue depths. Same sharding as the counter, so there is no "set" operation.
+ */
+class Gauge
+{
+  private:
+    std::array<Cell, SHARD_COUNT> m_cells{};
+
+  public:
+    inline void add(int64_t n = 1)
+    {
+        m_cells[ShardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    inline void sub(int64_t n = 1)
+    {
+        m_cells[ShardIndex()].value.fetch_sub(n, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] int64_t value() const;
+};
+
+/**
+ * Distribution of the observed values in buckets with the given inclusive upper bounds, in ascending order.
+ */
+class Histogram
+{
+  private:
+    struct alignas(64) Shard
+    {
+        std::unique_ptr<std::atomic<int64_t>[]> buckets; // One more than the bounds, for +Inf
+        std::atomic<int64_t> sum{};
+        std::atomic<int64_t> count{};
+    };
+
+    std::vector<int64_t> m_bounds;
+    std::array<Shard, SHARD_COUNT> m_shards;
+
+  public:
+    explicit Histogram(std::vector<int64_t> bounds);
+
+  public:
+    inline void observe(int64_t value)
+    {
+        size_t i = 0;
+        while (i < m_bounds.size() && value > m_bounds[i])
+            i++;
+
+        auto &shard = m_shards[ShardIndex()];
+        shard.buckets[i].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] const std::vector<int64_t> &bounds() const;
+    [[nodiscard]] std::vector<int64_t> bucketCounts() const; // Non-cumulative, the last one is for +Inf
+    [[nodiscard]] int64_t sum() const;
+    [[nodiscard]] int64_t count() const;
+};
+
+/**
+ * Process-wide registry of the metrics.
+ * <p>
+ * Registration takes a lock and is meant to be done once, the returned references stay valid until the process exits
+ * and can be cached by the callers. Registering the same name and labels again returns the existing metric. Labels
+ * are given in the Prometheus format without braces, such as: result="success"
+ */
+class Registry
+{
+  private:
+    enum class EType
+    {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    struct Entry
+    {
+        std::string name;
+        std::string help;
+        std::string labels;
+        EType type;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+  private:
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<Entry>> m_entries;
+    std::unordered_map<std::string, Entry *> m_index;
+
+  public:
+    static Registry &Instance();
+
+  public:
+    Counter &counter(const std::string &name, const std::string &help, const std::string &labels = "");
+    Gauge &gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+    Histogram &histogram(const std::string &name, const std::string &help, const std::vector<int64_t> &bounds,
+                         const std::string &labels = "");
+
+    /* Prometheus text exposition format (version 0.0.4) */
+    std::string renderPrometheus();
+    /* One line per series without the help texts and buckets, for the CLI */
+    std::string renderSummary();
+    /* Header line of the CSV dump */
+    static std::string CsvHeader();
+    /* CSV rows of all series in long format, i.e. time_ms,"series",value */
+    std::string renderCsv(int64_t timeMs);
+
+  private:
+    Entry &findOrAdd(const std::string &name, const std::string &help, const std::string &labels, EType type);
+    std::vector<const Entry *> sortedEntries();
+};
+
+} // namespace metrics
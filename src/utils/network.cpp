@@ -16,6 +16,7 @@
 #include <stdexcept>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 static std::string OctetStringToIpString(const OctetString &address)
@@ -108,6 +109,31 @@ uint16_t InetAddress::getPort() const
     return 0;
 }
 
+bool InetAddress::operator==(const InetAddress &other) const
+{
+    if (storage.ss_family != other.storage.ss_family)
+        return false;
+
+    if (storage.ss_family == AF_INET)
+    {
+        auto &a = reinterpret_cast<const sockaddr_in &>(storage);
+        auto &b = reinterpret_cast<const sockaddr_in &>(other.storage);
+        return a.sin_port == b.sin_port && a.sin_addr.s_addr == b.sin_addr.s_addr;
+    }
+    else if (storage.ss_family == AF_INET6)
+    {
+        auto &a = reinterpret_cast<const sockaddr_in6 &>(storage);
+        auto &b = reinterpret_cast<const sockaddr_in6 &>(other.storage);
+        return a.sin6_port == b.sin6_port && std::memcmp(&a.sin6_addr, &b.sin6_addr, sizeof(a.sin6_addr)) == 0;
+    }
+    return len == other.len && std::memcmp(&storage, &other.storage, len) == 0;
+}
+
+bool InetAddress::operator!=(const InetAddress &other) const
+{
+    return !(*this == other);
+}
+
 Socket::Socket(int domain, int type, int protocol)
 {
     int sd = socket(domain, type, protocol);
@@ -196,6 +222,30 @@ void Socket::send(const InetAddress &address, const uint8_t *buffer, size_t size
     }
 }
 
+void Socket::send(const InetAddress &address, const uint8_t *header, size_t headerSize, const uint8_t *payload,
+                  size_t payloadSize) const
+{
+    iovec iov[2];
+    iov[0].iov_base = const_cast<uint8_t *>(header);
+    iov[0].iov_len = headerSize;
+    iov[1].iov_base = const_cast<uint8_t *>(payload);
+    iov[1].iov_len = payloadSize;
+
+    msghdr msg{};
+    msg.msg_name = const_cast<sockaddr *>(address.getSockAddr());
+    msg.msg_namelen = address.getSockLen();
+    msg.msg_iov = iov;
+    msg.msg_iovlen = 2;
+
+    ssize_t rc = sendmsg(fd, &msg, MSG_DONTWAIT);
+    if (rc == -1)
+    {
+        int err = errno;
+        if (err != EAGAIN)
+            throw LibError("sendmsg failed: ", errno);
+    }
+}
+
 bool Socket::hasFd() const
 {
     return fd >= 0;
@@ -39,6 +39,9 @@ struct InetAddress
     }
 
     [[nodiscard]] uint16_t getPort() const;
+
+    bool operator==(const InetAddress &other) const;
+    bool operator!=(const InetAddress &other) const;
 };
 
 class Socket
@@ -54,6 +57,8 @@ class Socket
     void bind(const InetAddress &address) const;
     int receive(uint8_t *buffer, size_t bufferSize, int timeoutMs, InetAddress &outAddress) const;
     void send(const InetAddress &address, const uint8_t *buffer, size_t size) const;
+    void send(const InetAddress &address, const uint8_t *header, size_t headerSize, const uint8_t *payload,
+              size_t payloadSize) const;
     void close();
     [[nodiscard]] bool hasFd() const;
     [[nodiscard]] InetAddress getAddress() const;
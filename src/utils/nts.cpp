@@ -8,15 +8,26 @@
 
 #include "nts.hpp"
 #include "common.hpp"
+#include "metrics.hpp"
 
 #include <stdexcept>
 
 #define WAIT_TIME_IF_NO_TIMER 500
 #define PAUSE_POLLING_PERIOD 20
 
+static auto &g_pushedMessages =
+    metrics::Registry::Instance().counter("nts_messages_pushed_total", "Messages pushed to the NTS task queues");
+static auto &g_queuedMessages =
+    metrics::Registry::Instance().gauge("nts_messages_queued", "Messages waiting in the NTS task queues");
+static auto &g_expiredTimers =
+    metrics::Registry::Instance().counter("nts_timers_expired_total", "NTS timers expired");
+
 static NtsMessage *TimerExpiredMessage(TimerInfo *timerInfo)
 {
-    return timerInfo ? new NmTimerExpired(timerInfo->timerId) : nullptr;
+    if (timerInfo == nullptr)
+        return nullptr;
+    g_expiredTimers.inc();
+    return new NmTimerExpired(timerInfo->timerId);
 }
 
 void TimerBase::setTimerAbsolute(int timerId, int64_t timeMs)
@@ -75,6 +86,9 @@ bool NtsTask::push(NtsMessage *msg)
         msgQueue.push_back(msg);
     }
 
+    g_pushedMessages.inc();
+    g_queuedMessages.add();
+
     cv.notify_one();
     return true;
 }
@@ -92,6 +106,9 @@ bool NtsTask::pushFront(NtsMessage *msg)
         msgQueue.push_front(msg);
     }
 
+    g_pushedMessages.inc();
+    g_queuedMessages.add();
+
     cv.notify_one();
     return true;
 }
@@ -123,6 +140,7 @@ NtsMessage *NtsTask::poll()
         {
             NtsMessage *ret = msgQueue.front();
             msgQueue.pop_front();
+            g_queuedMessages.sub();
             return ret;
         }
     }
@@ -158,6 +176,7 @@ NtsMessage *NtsTask::poll(int64_t timeout)
         {
             NtsMessage *ret = msgQueue.front();
             msgQueue.pop_front();
+            g_queuedMessages.sub();
             return ret;
         }
         cv.wait_for(lock, std::chrono::milliseconds(std::min(timerBase.getNextWaitTime(), timeout)));
@@ -172,6 +191,7 @@ NtsMessage *NtsTask::poll(int64_t timeout)
         {
             NtsMessage *ret = msgQueue.front();
             msgQueue.pop_front();
+            g_queuedMessages.sub();
             return ret;
         }
     }
@@ -240,6 +260,7 @@ void NtsTask::quit()
         {
             NtsMessage *msg = msgQueue.front();
             msgQueue.pop_front();
+            g_queuedMessages.sub();
 
             // Since we have the ownership at this time, we should delete the messages.
             delete msg;
@@ -34,6 +34,7 @@ enum class NtsMessageType
 
     UDP_SERVER_RECEIVE,
     CLI_SEND_RESPONSE,
+    CLI_BULK_START,
 
     GNB_RLS_TO_RRC,
     GNB_RLS_TO_GTP,
@@ -58,6 +59,7 @@ enum class NtsMessageType
     UE_RLS_TO_RLS,
 	UE_NAS_TO_APP,
 	UE_NAS_TO_RLS,
+    UE_LOAD_COMMAND,
 };
 
 struct NtsMessage
@@ -0,0 +1,88 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include "octet.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Non-owning, read-only view of a contiguous range of octets. It is used by the APIs that only read their input, so
+ * that callers can pass an OctetString, a part of it, or any other buffer without copying.
+ * <p>
+ * The viewed memory must outlive the span. An owned copy is made explicitly via OctetString::FromSpan.
+ */
+class OctetSpan
+{
+  private:
+    const uint8_t *m_data;
+    size_t m_length;
+
+  public:
+    constexpr OctetSpan() : m_data{}, m_length{}
+    {
+    }
+
+    constexpr OctetSpan(const uint8_t *data, size_t length) : m_data{data}, m_length{length}
+    {
+    }
+
+  public:
+    [[nodiscard]] inline const uint8_t *data() const
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] inline int length() const
+    {
+        return static_cast<int>(m_length);
+    }
+
+    [[nodiscard]] inline size_t size() const
+    {
+        return m_length;
+    }
+
+    [[nodiscard]] inline bool empty() const
+    {
+        return m_length == 0;
+    }
+
+    [[nodiscard]] inline octet get(int index) const
+    {
+        return m_data[index];
+    }
+
+    [[nodiscard]] inline int getI(int index) const
+    {
+        return m_data[index];
+    }
+
+    [[nodiscard]] inline OctetSpan subSpan(int index) const
+    {
+        return OctetSpan{m_data + index, m_length - static_cast<size_t>(index)};
+    }
+
+    [[nodiscard]] inline OctetSpan subSpan(int index, int length) const
+    {
+        return OctetSpan{m_data + index, static_cast<size_t>(length)};
+    }
+
+    inline bool operator==(const OctetSpan &other) const
+    {
+        return m_length == other.m_length && (m_length == 0 || std::memcmp(m_data, other.m_data, m_length) == 0);
+    }
+
+    inline bool operator!=(const OctetSpan &other) const
+    {
+        return !(*this == other);
+    }
+};
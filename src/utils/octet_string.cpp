@@ -9,38 +9,125 @@
 #include "octet_string.hpp"
 #include "common.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
 
-void OctetString::append(const OctetString &v)
+OctetString::OctetString(const std::vector<uint8_t> &data) : OctetString()
 {
-    m_data.insert(m_data.end(), v.m_data.begin(), v.m_data.end());
+    append(data.data(), data.size());
 }
 
-void OctetString::appendUtf8(const std::string &v)
+OctetString::OctetString(OctetString &&octetString) noexcept
+    : m_heap{octetString.m_heap}, m_length{octetString.m_length}, m_capacity{octetString.m_capacity}
+{
+    if (m_heap == nullptr)
+        std::memcpy(m_inline, octetString.m_inline, m_length);
+
+    octetString.m_heap = nullptr;
+    octetString.m_length = 0;
+    octetString.m_capacity = INLINE_CAPACITY;
+}
+
+OctetString::~OctetString()
+{
+    std::free(m_heap);
+}
+
+OctetString &OctetString::operator=(OctetString &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    std::free(m_heap);
+
+    m_heap = other.m_heap;
+    m_length = other.m_length;
+    m_capacity = other.m_capacity;
+    if (m_heap == nullptr)
+        std::memcpy(m_inline, other.m_inline, m_length);
+
+    other.m_heap = nullptr;
+    other.m_length = 0;
+    other.m_capacity = INLINE_CAPACITY;
+    return *this;
+}
+
+void OctetString::reserve(int capacity)
+{
+    if (capacity <= 0 || static_cast<size_t>(capacity) <= m_capacity)
+        return;
+
+    auto *heap = static_cast<uint8_t *>(std::malloc(static_cast<size_t>(capacity)));
+    if (heap == nullptr)
+        throw std::bad_alloc();
+    if (m_length > 0)
+        std::memcpy(heap, data(), m_length);
+
+    std::free(m_heap);
+    m_heap = heap;
+    m_capacity = static_cast<size_t>(capacity);
+}
+
+void OctetString::clear()
+{
+    m_length = 0;
+}
+
+uint8_t *OctetString::grow(size_t length)
+{
+    if (m_length + length > m_capacity)
+    {
+        size_t capacity = std::max(m_capacity * 2, m_length + length);
+        if (capacity > static_cast<size_t>(std::numeric_limits<int>::max()))
+            throw std::length_error("OctetString is too long");
+        reserve(static_cast<int>(capacity));
+    }
+
+    uint8_t *res = data() + m_length;
+    m_length += length;
+    return res;
+}
+
+void OctetString::append(OctetSpan v)
 {
-    m_data.insert(m_data.end(), v.begin(), v.end());
+    append(v.data(), v.size());
 }
 
-void OctetString::appendOctet(uint8_t v)
+void OctetString::append(const uint8_t *data, size_t length)
 {
-    m_data.push_back(v);
+    if (length == 0)
+        return;
+
+    // The source may be a part of this buffer, which may be reallocated while growing
+    const uint8_t *base = this->data();
+    bool overlaps = data >= base && data < base + m_length;
+    size_t sourceOffset = overlaps ? static_cast<size_t>(data - base) : 0;
+
+    uint8_t *target = grow(length);
+    std::memmove(target, overlaps ? this->data() + sourceOffset : data, length);
 }
 
-void OctetString::appendOctet(int v)
+void OctetString::appendUtf8(const std::string &v)
 {
-    m_data.push_back(v & 0xFF);
+    append(reinterpret_cast<const uint8_t *>(v.data()), v.size());
 }
 
 void OctetString::appendOctet2(octet2 v)
 {
-    m_data.push_back(v[0]);
-    m_data.push_back(v[1]);
+    uint8_t *p = grow(2);
+    p[0] = v[0];
+    p[1] = v[1];
 }
 
 void OctetString::appendOctet2(uint16_t v)
 {
-    appendOctet(static_cast<uint8_t>(v >> 8 & 0xFF));
-    appendOctet(static_cast<uint8_t>(v & 0xFF));
+    uint8_t *p = grow(2);
+    p[0] = static_cast<uint8_t>(v >> 8 & 0xFF);
+    p[1] = static_cast<uint8_t>(v & 0xFF);
 }
 
 void OctetString::appendOctet2(int v)
@@ -50,9 +137,10 @@ void OctetString::appendOctet2(int v)
 
 void OctetString::appendOctet3(octet3 v)
 {
-    m_data.push_back(v[0]);
-    m_data.push_back(v[1]);
-    m_data.push_back(v[2]);
+    uint8_t *p = grow(3);
+    p[0] = v[0];
+    p[1] = v[1];
+    p[2] = v[2];
 }
 
 void OctetString::appendOctet3(int v)
@@ -62,22 +150,18 @@ void OctetString::appendOctet3(int v)
 
 void OctetString::appendOctet4(octet4 v)
 {
-    m_data.push_back(v[0]);
-    m_data.push_back(v[1]);
-    m_data.push_back(v[2]);
-    m_data.push_back(v[3]);
+    uint8_t *p = grow(4);
+    p[0] = v[0];
+    p[1] = v[1];
+    p[2] = v[2];
+    p[3] = v[3];
 }
 
 void OctetString::appendOctet8(octet8 v)
 {
-    m_data.push_back(v[0]);
-    m_data.push_back(v[1]);
-    m_data.push_back(v[2]);
-    m_data.push_back(v[3]);
-    m_data.push_back(v[4]);
-    m_data.push_back(v[5]);
-    m_data.push_back(v[6]);
-    m_data.push_back(v[7]);
+    uint8_t *p = grow(8);
+    for (int i = 0; i < 8; i++)
+        p[i] = v[i];
 }
 
 void OctetString::appendOctet8(int64_t v)
@@ -100,11 +184,6 @@ void OctetString::appendOctet4(uint32_t v)
     appendOctet4(octet4{v});
 }
 
-int OctetString::length() const
-{
-    return static_cast<int>(m_data.size());
-}
-
 void OctetString::appendOctet(int bigHalf, int littleHalf)
 {
     bigHalf &= 0xF;
@@ -112,20 +191,11 @@ void OctetString::appendOctet(int bigHalf, int littleHalf)
     appendOctet(bigHalf << 4 | littleHalf);
 }
 
-const uint8_t *OctetString::data() const
-{
-    return m_data.data();
-}
-
-uint8_t *OctetString::data()
-{
-    return m_data.data();
-}
-
 void OctetString::appendPadding(int length)
 {
-    for (int i = 0; i < length; i++)
-        appendOctet(0);
+    if (length <= 0)
+        return;
+    std::memset(grow(static_cast<size_t>(length)), 0, static_cast<size_t>(length));
 }
 
 OctetString OctetString::FromHex(const std::string &hex)
@@ -135,7 +205,16 @@ OctetString OctetString::FromHex(const std::string &hex)
 
 std::string OctetString::toHexString() const
 {
-    return utils::VectorToHexString(m_data);
+    static constexpr const char DIGITS[] = "0123456789ABCDEF";
+
+    std::string res(m_length * 2, '0');
+    const uint8_t *p = data();
+    for (size_t i = 0; i < m_length; i++)
+    {
+        res[2 * i] = DIGITS[p[i] >> 4];
+        res[2 * i + 1] = DIGITS[p[i] & 0xF];
+    }
+    return res;
 }
 
 OctetString OctetString::subCopy(int index) const
@@ -145,12 +224,12 @@ OctetString OctetString::subCopy(int index) const
 
 OctetString OctetString::subCopy(int index, int length) const
 {
-    return OctetString{std::vector<uint8_t>{m_data.data() + index, m_data.data() + index + length}};
+    return FromSpan(subSpan(index, length));
 }
 
 octet OctetString::get(int index) const
 {
-    return m_data[index];
+    return data()[index];
 }
 
 octet2 OctetString::get2(int index) const
@@ -209,24 +288,20 @@ uint64_t OctetString::get8UL(int index) const
     return static_cast<uint64_t>(get8(index));
 }
 
-OctetString OctetString::Concat(const OctetString &a, const OctetString &b)
+OctetString OctetString::Concat(OctetSpan a, OctetSpan b)
 {
-    std::vector<uint8_t> v1 = a.m_data;
-    std::vector<uint8_t> v2 = b.m_data;
-    std::vector<uint8_t> v3;
-
-    v3.reserve(v1.size() + v2.size());
-    v3.insert(v3.end(), v1.begin(), v1.end());
-    v3.insert(v3.end(), v2.begin(), v2.end());
-
-    return OctetString{std::move(v3)};
+    OctetString res{};
+    res.reserve(a.length() + b.length());
+    res.append(a);
+    res.append(b);
+    return res;
 }
 
 OctetString OctetString::FromOctet(uint8_t value)
 {
-    std::vector<uint8_t> v(1);
-    v[0] = value;
-    return OctetString{std::move(v)};
+    OctetString res{};
+    res.appendOctet(value);
+    return res;
 }
 
 OctetString OctetString::FromOctet(int value)
@@ -236,10 +311,9 @@ OctetString OctetString::FromOctet(int value)
 
 OctetString OctetString::FromOctet2(octet2 value)
 {
-    std::vector<uint8_t> v(2);
-    v[0] = value[0];
-    v[1] = value[1];
-    return OctetString{std::move(v)};
+    OctetString res{};
+    res.appendOctet2(value);
+    return res;
 }
 
 OctetString OctetString::FromOctet2(int value)
@@ -249,12 +323,9 @@ OctetString OctetString::FromOctet2(int value)
 
 OctetString OctetString::FromOctet4(octet4 value)
 {
-    std::vector<uint8_t> v(4);
-    v[0] = value[0];
-    v[1] = value[1];
-    v[2] = value[2];
-    v[3] = value[3];
-    return OctetString{std::move(v)};
+    OctetString res{};
+    res.appendOctet4(value);
+    return res;
 }
 
 OctetString OctetString::FromOctet4(int value)
@@ -269,16 +340,9 @@ OctetString OctetString::FromOctet4(uint32_t value)
 
 OctetString OctetString::FromOctet8(octet8 value)
 {
-    std::vector<uint8_t> v(8);
-    v[0] = value[0];
-    v[1] = value[1];
-    v[2] = value[2];
-    v[3] = value[3];
-    v[4] = value[4];
-    v[5] = value[5];
-    v[6] = value[6];
-    v[7] = value[7];
-    return OctetString{std::move(v)};
+    OctetString res{};
+    res.appendOctet8(value);
+    return res;
 }
 
 OctetString OctetString::FromOctet8(long value)
@@ -298,12 +362,16 @@ OctetString OctetString::copy() const
 
 OctetString OctetString::FromAscii(const std::string &ascii)
 {
-    return OctetString{std::vector<uint8_t>{ascii.c_str(), ascii.c_str() + ascii.length()}};
+    OctetString res{};
+    res.appendUtf8(ascii);
+    return res;
 }
 
 OctetString OctetString::FromSpare(int length)
 {
-    return OctetString{std::vector<uint8_t>(length)};
+    OctetString res{};
+    res.appendPadding(length);
+    return res;
 }
 
 OctetString OctetString::Xor(const OctetString &a, const OctetString &b)
@@ -324,7 +392,13 @@ OctetString OctetString::Empty()
 
 OctetString OctetString::FromArray(const uint8_t *arr, size_t len)
 {
-    std::vector<uint8_t> v(len);
-    std::memcpy(v.data(), arr, len);
-    return OctetString(std::move(v));
+    OctetString res{};
+    res.reserve(static_cast<int>(len));
+    res.append(arr, len);
+    return res;
+}
+
+OctetString OctetString::FromSpan(OctetSpan span)
+{
+    return FromArray(span.data(), span.size());
 }
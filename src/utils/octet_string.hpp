@@ -9,35 +9,62 @@
 #pragma once
 
 #include "octet.hpp"
+#include "octet_span.hpp"
 
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
+/**
+ * Owned, growable octet buffer used by all encoders and decoders.
+ * <p>
+ * Contents of up to INLINE_CAPACITY octets are kept inside the object, which covers most IEs and short messages
+ * without any heap allocation. Larger contents move to the heap, and reserve() can be used to avoid reallocations
+ * when the final size is known. Copying is always explicit (copy, subCopy, FromSpan); read-only users should take an
+ * OctetSpan instead.
+ */
 class OctetString
 {
+  public:
+    static constexpr const size_t INLINE_CAPACITY = 64;
+
   private:
-    std::vector<uint8_t> m_data;
+    uint8_t *m_heap;
+    size_t m_length;
+    size_t m_capacity;
+    uint8_t m_inline[INLINE_CAPACITY];
 
   public:
-    OctetString() : m_data()
+    OctetString() : m_heap{}, m_length{}, m_capacity{INLINE_CAPACITY}
     {
     }
 
-    explicit OctetString(std::vector<uint8_t> &&data) : m_data(std::move(data))
+    explicit OctetString(const std::vector<uint8_t> &data);
+    OctetString(OctetString &&octetString) noexcept;
+    ~OctetString();
+
+  public:
+    void reserve(int capacity);
+    void clear();
+    void append(OctetSpan v);
+    void append(const uint8_t *data, size_t length);
+    void appendUtf8(const std::string &v);
+
+    inline void appendOctet(uint8_t v)
     {
+        if (m_length < m_capacity)
+            data()[m_length++] = v;
+        else
+            *grow(1) = v;
     }
 
-    OctetString(OctetString &&octetString) noexcept : m_data(std::move(octetString.m_data))
+    inline void appendOctet(int v)
     {
+        appendOctet(static_cast<uint8_t>(v & 0xFF));
     }
 
-  public:
-    void append(const OctetString &v);
-    void appendUtf8(const std::string &v);
-    void appendOctet(uint8_t v);
-    void appendOctet(int v);
     void appendOctet(int bigHalf, int littleHalf);
     void appendOctet2(octet2 v);
     void appendOctet2(uint16_t v);
@@ -53,9 +80,45 @@ class OctetString
     void appendPadding(int length);
 
   public:
-    [[nodiscard]] const uint8_t *data() const;
-    [[nodiscard]] int length() const;
-    uint8_t *data();
+    [[nodiscard]] inline const uint8_t *data() const
+    {
+        return m_heap ? m_heap : m_inline;
+    }
+
+    [[nodiscard]] inline uint8_t *data()
+    {
+        return m_heap ? m_heap : m_inline;
+    }
+
+    [[nodiscard]] inline int length() const
+    {
+        return static_cast<int>(m_length);
+    }
+
+    [[nodiscard]] inline int capacity() const
+    {
+        return static_cast<int>(m_capacity);
+    }
+
+    [[nodiscard]] inline OctetSpan span() const
+    {
+        return OctetSpan{data(), m_length};
+    }
+
+    [[nodiscard]] inline OctetSpan subSpan(int index) const
+    {
+        return span().subSpan(index);
+    }
+
+    [[nodiscard]] inline OctetSpan subSpan(int index, int length) const
+    {
+        return span().subSpan(index, length);
+    }
+
+    inline operator OctetSpan() const // NOLINT(google-explicit-constructor)
+    {
+        return span();
+    }
 
   public:
     [[nodiscard]] octet get(int index) const;
@@ -78,20 +141,16 @@ class OctetString
     [[nodiscard]] OctetString subCopy(int index, int length) const;
 
   public:
-    inline OctetString &operator=(OctetString &&other) noexcept
-    {
-        m_data = std::move(other.m_data);
-        return *this;
-    }
+    OctetString &operator=(OctetString &&other) noexcept;
 
-    inline bool operator==(const OctetString &other)
+    inline bool operator==(const OctetString &other) const
     {
-        return m_data == other.m_data;
+        return span() == other.span();
     }
 
-    inline bool operator!=(const OctetString &other)
+    inline bool operator!=(const OctetString &other) const
     {
-        return m_data != other.m_data;
+        return span() != other.span();
     }
 
   public:
@@ -99,6 +158,7 @@ class OctetString
     static OctetString FromHex(const std::string &hex);
     static OctetString FromAscii(const std::string &ascii);
     static OctetString FromArray(const uint8_t *arr, size_t len);
+    static OctetString FromSpan(OctetSpan span);
     static OctetString FromSpare(int length);
     static OctetString FromOctet(uint8_t value);
     static OctetString FromOctet(int value);
@@ -111,6 +171,9 @@ class OctetString
     static OctetString FromOctet8(long value);
     static OctetString FromOctet8(uint64_t value);
 
-    static OctetString Concat(const OctetString &a, const OctetString &b);
+    static OctetString Concat(OctetSpan a, OctetSpan b);
     static OctetString Xor(const OctetString &a, const OctetString &b);
+
+  private:
+    uint8_t *grow(size_t length);
 };
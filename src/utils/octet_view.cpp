@@ -17,11 +17,15 @@ OctetView::OctetView(const uint8_t *data, size_t size) : data(data), index(0), s
 {
 }
 
+OctetView::OctetView(OctetSpan data) : data(data.data()), index(0), size(data.size())
+{
+}
+
 OctetString OctetView::readOctetString(int length) const
 {
-    std::vector<uint8_t> v{data + index, data + index + length};
+    auto res = OctetString::FromArray(data + index, static_cast<size_t>(length));
     index += length;
-    return OctetString(std::move(v));
+    return res;
 }
 
 OctetString OctetView::readOctetString(size_t length) const
@@ -34,6 +38,18 @@ OctetString OctetView::readOctetString() const
     return readOctetString(static_cast<int>(size - index));
 }
 
+OctetSpan OctetView::readSpan(int length) const
+{
+    OctetSpan res{data + index, static_cast<size_t>(length)};
+    index += length;
+    return res;
+}
+
+OctetSpan OctetView::readSpan() const
+{
+    return readSpan(static_cast<int>(size - index));
+}
+
 std::string OctetView::readUtf8String(int length) const
 {
     auto res = std::string(data + index, data + index + length);
@@ -10,6 +10,7 @@
 
 #include "bits.hpp"
 #include "octet.hpp"
+#include "octet_span.hpp"
 
 #include <cstdint>
 #include <cstdlib>
@@ -27,6 +28,7 @@ class OctetView
   public:
     OctetView(const uint8_t *data, size_t size);
     explicit OctetView(const OctetString &data);
+    explicit OctetView(OctetSpan data);
 
     inline octet peek() const
     {
@@ -123,9 +125,16 @@ class OctetView
         return index < size;
     }
 
+    inline void skip(int length) const
+    {
+        index += length;
+    }
+
     OctetString readOctetString(int length) const;
     OctetString readOctetString(size_t length) const;
     OctetString readOctetString() const;
+    OctetSpan readSpan(int length) const; // Non-owning, valid as long as the underlying buffer
+    OctetSpan readSpan() const;
     std::string readUtf8String(int length) const;
     std::string readUtf8String(size_t length) const;
 };
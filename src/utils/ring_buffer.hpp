@@ -0,0 +1,141 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * Double-ended circular buffer over a power-of-two sized contiguous storage. Storage grows by doubling when full and
+ * is never shrunk, so that steady-state operation performs no allocation.
+ */
+template <typename T>
+class RingBuffer
+{
+    std::vector<T> m_data;
+    size_t m_head;
+    size_t m_count;
+
+  public:
+    explicit RingBuffer(size_t initialCapacity = 16) : m_data{}, m_head{}, m_count{}
+    {
+        size_t capacity = 1;
+        while (capacity < initialCapacity)
+            capacity <<= 1;
+        m_data.resize(capacity);
+    }
+
+  private:
+    [[nodiscard]] inline size_t mask() const
+    {
+        return m_data.size() - 1;
+    }
+
+    void grow()
+    {
+        std::vector<T> data(m_data.size() * 2);
+        for (size_t i = 0; i < m_count; i++)
+            data[i] = std::move(m_data[(m_head + i) & mask()]);
+        m_data = std::move(data);
+        m_head = 0;
+    }
+
+  public:
+    [[nodiscard]] inline size_t getCount() const
+    {
+        return m_count;
+    }
+
+    [[nodiscard]] inline bool isEmpty() const
+    {
+        return m_count == 0;
+    }
+
+    [[nodiscard]] inline size_t getCapacity() const
+    {
+        return m_data.size();
+    }
+
+    inline T &getFirst()
+    {
+        assert(m_count > 0);
+        return m_data[m_head];
+    }
+
+    inline T &getLast()
+    {
+        assert(m_count > 0);
+        return m_data[(m_head + m_count - 1) & mask()];
+    }
+
+    // Index is relative to the first element
+    inline T &operator[](size_t index)
+    {
+        assert(index < m_count);
+        return m_data[(m_head + index) & mask()];
+    }
+
+    inline const T &operator[](size_t index) const
+    {
+        assert(index < m_count);
+        return m_data[(m_head + index) & mask()];
+    }
+
+    void addLast(T value)
+    {
+        if (m_count == m_data.size())
+            grow();
+        m_data[(m_head + m_count) & mask()] = std::move(value);
+        m_count++;
+    }
+
+    void addFirst(T value)
+    {
+        if (m_count == m_data.size())
+            grow();
+        m_head = (m_head - 1) & mask();
+        m_data[m_head] = std::move(value);
+        m_count++;
+    }
+
+    T removeFirst()
+    {
+        assert(m_count > 0);
+        T value = std::move(m_data[m_head]);
+        m_head = (m_head + 1) & mask();
+        m_count--;
+        return value;
+    }
+
+    T removeLast()
+    {
+        assert(m_count > 0);
+        m_count--;
+        return std::move(m_data[(m_head + m_count) & mask()]);
+    }
+
+    // Removes the element at the given index by shifting the later elements. O(n), intended for rare operations.
+    T removeAt(size_t index)
+    {
+        assert(index < m_count);
+        T value = std::move((*this)[index]);
+        for (size_t i = index; i + 1 < m_count; i++)
+            (*this)[i] = std::move((*this)[i + 1]);
+        m_count--;
+        return value;
+    }
+
+    inline void clear()
+    {
+        m_head = 0;
+        m_count = 0;
+    }
+};
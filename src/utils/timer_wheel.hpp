@@ -0,0 +1,131 @@
+//
+// This file is a part of UERANSIM open source project.
+// Copyright (c) 2021 ALİ GÜNGÖR.
+//
+// The software and all associated files are licensed under GPL-3.0
+// and subject to the terms and conditions defined in LICENSE file.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Hashed timing wheel. Each slot covers 'tickMs' milliseconds and the wheel spans (slotCount * tickMs) ms. Timers
+ * further than the span are kept in their slot until the wheel comes around enough times.
+ * <p>
+ * Scheduling is O(1) and advancing is proportional to the passed ticks plus the number of visited timers. There is no
+ * cancellation, users are expected to validate an expired item against their own state (lazy cancellation).
+ */
+template <typename T>
+class TimerWheel
+{
+    struct Entry
+    {
+        int64_t expiry;
+        T item;
+    };
+
+    std::vector<std::vector<Entry>> m_slots;
+    int64_t m_tickMs;
+    int64_t m_currentTick;
+    size_t m_count;
+    std::vector<Entry> m_expired;
+
+  public:
+    explicit TimerWheel(size_t slotCount = 256, int64_t tickMs = 10)
+        : m_slots{}, m_tickMs{tickMs}, m_currentTick{-1}, m_count{}, m_expired{}
+    {
+        size_t capacity = 1;
+        while (capacity < slotCount)
+            capacity <<= 1;
+        m_slots.resize(capacity);
+    }
+
+  private:
+    [[nodiscard]] inline size_t slotOf(int64_t tick) const
+    {
+        return static_cast<size_t>(tick) & (m_slots.size() - 1);
+    }
+
+  public:
+    [[nodiscard]] inline size_t getCount() const
+    {
+        return m_count;
+    }
+
+    [[nodiscard]] inline bool isEmpty() const
+    {
+        return m_count == 0;
+    }
+
+    [[nodiscard]] inline int64_t getTickPeriod() const
+    {
+        return m_tickMs;
+    }
+
+    void schedule(int64_t expiry, T item)
+    {
+        int64_t tick = expiry / m_tickMs;
+        if (m_currentTick == -1)
+            m_currentTick = tick - 1;
+        if (tick <= m_currentTick)
+            tick = m_currentTick + 1;
+
+        m_slots[slotOf(tick)].push_back(Entry{expiry, std::move(item)});
+        m_count++;
+    }
+
+    /**
+     * Advances the wheel up to the given time and invokes the given function for each expired item. The function
+     * may schedule new timers.
+     */
+    template <typename TFun>
+    void advance(int64_t now, TFun fun)
+    {
+        if (m_currentTick == -1)
+            return;
+
+        int64_t target = now / m_tickMs;
+        if (target <= m_currentTick)
+            return;
+
+        // Visiting each slot once is enough if more time than the span is passed
+        int64_t first = m_currentTick + 1;
+        if (target - first >= static_cast<int64_t>(m_slots.size()))
+            first = target - static_cast<int64_t>(m_slots.size()) + 1;
+
+        for (int64_t tick = first; tick <= target; tick++)
+        {
+            auto &slot = m_slots[slotOf(tick)];
+            for (size_t i = 0; i < slot.size();)
+            {
+                if (slot[i].expiry <= now)
+                {
+                    m_expired.push_back(std::move(slot[i]));
+                    slot[i] = std::move(slot.back());
+                    slot.pop_back();
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+
+        // The current tick is not fully passed yet, so its slot is visited again in the next call
+        m_currentTick = target - 1;
+        m_count -= m_expired.size();
+
+        // Expired items are moved out first, so that the function can safely schedule new timers
+        auto expired = std::move(m_expired);
+        m_expired.clear();
+        for (auto &entry : expired)
+            fun(entry.item);
+        expired.clear();
+        m_expired = std::move(expired);
+    }
+};